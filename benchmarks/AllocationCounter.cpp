@@ -0,0 +1,67 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<size_t> allocations_count{0};
+std::atomic<size_t> allocated_bytes{0};
+std::atomic<bool> track_allocations{false};
+
+} // namespace
+
+void * operator new(size_t size)
+{
+  if(track_allocations)
+  {
+    allocated_bytes += size;
+    allocations_count++;
+  }
+  void * p = std::malloc(size);
+  if(!p) { throw std::bad_alloc(); }
+  return p;
+}
+
+void operator delete(void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+  std::free(p);
+}
+
+AllocationCounter::AllocationCounter()
+{
+  allocations_count = 0;
+  allocated_bytes = 0;
+  track_allocations = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+  stop();
+}
+
+void AllocationCounter::stop() noexcept
+{
+  track_allocations = false;
+}
+
+size_t AllocationCounter::allocations() const noexcept
+{
+  return allocations_count;
+}
+
+size_t AllocationCounter::bytes() const noexcept
+{
+  return allocated_bytes;
+}
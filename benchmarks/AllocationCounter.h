@@ -0,0 +1,33 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/** Counts the calls to the global operator new while it is alive
+ *
+ * Benchmarks using this must link with mc_rtc_benchmark_allocations which replaces the global operator new and
+ * operator delete. Only one counter should be alive at a time.
+ */
+struct AllocationCounter
+{
+  /** Reset the counts and start counting */
+  AllocationCounter();
+
+  /** Stop counting */
+  ~AllocationCounter();
+
+  AllocationCounter(const AllocationCounter &) = delete;
+  AllocationCounter & operator=(const AllocationCounter &) = delete;
+
+  /** Stop counting, the counts are kept */
+  void stop() noexcept;
+
+  /** Number of allocations since the counter was created */
+  size_t allocations() const noexcept;
+
+  /** Number of bytes allocated since the counter was created */
+  size_t bytes() const noexcept;
+};
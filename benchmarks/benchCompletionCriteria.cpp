@@ -11,6 +11,8 @@
 
 #include "benchmark/benchmark.h"
 
+#include "AllocationCounter.h"
+
 MC_RTC_diagnostic_push
 MC_RTC_diagnostic_ignored(GCC, "-Wpedantic")
 MC_RTC_diagnostic_ignored(GCC, "-Wconversion")
@@ -30,10 +32,15 @@ mc_rbdyn::Robots & get_robots()
   return *robots_ptr;
 }
 
+/** Task whose error and speed are evaluated without allocating */
 struct MockTask : public mc_tasks::CoMTask
 {
   MockTask() : mc_tasks::CoMTask(get_robots(), 0) {}
+};
 
+/** Task that overrides eval()/speed(), the criteria go through these allocating functions */
+struct AllocatingMockTask : public MockTask
+{
   Eigen::VectorXd eval() const override { return eval_; }
   Eigen::VectorXd speed() const override { return speed_; }
 
@@ -41,6 +48,18 @@ struct MockTask : public mc_tasks::CoMTask
   Eigen::Vector3d speed_ = Eigen::Vector3d::UnitZ();
 };
 
+/** Check the criteria and report the number of allocations per check */
+template<typename TaskT>
+static void check_criteria(benchmark::State & state, mc_control::CompletionCriteria & criteria, const TaskT & task)
+{
+  bool b;
+  AllocationCounter counter;
+  while(state.KeepRunning()) { b = criteria.completed(task); }
+  counter.stop();
+  state.counters["allocs"] =
+      benchmark::Counter(static_cast<double>(counter.allocations()), benchmark::Counter::kAvgIterations);
+}
+
 static void BM_DirectTimeout(benchmark::State & state)
 {
   unsigned int tick = 0;
@@ -101,10 +120,10 @@ static void BM_DirectEvalAndSpeedOrTimeout(benchmark::State & state)
 }
 BENCHMARK(BM_DirectEvalAndSpeedOrTimeout);
 
+template<typename TaskT>
 static void BM_EvalAndSpeedOrTimeout(benchmark::State & state)
 {
-  bool b;
-  MockTask task;
+  TaskT task;
   double norm = 1e-3;
   double timeout = 5.0;
   mc_rtc::Configuration config;
@@ -139,9 +158,10 @@ static void BM_EvalAndSpeedOrTimeout(benchmark::State & state)
       }());
   mc_control::CompletionCriteria criteria;
   criteria.configure(task, dt, config);
-  while(state.KeepRunning()) { b = criteria.completed(task); }
+  check_criteria(state, criteria, task);
 }
-BENCHMARK(BM_EvalAndSpeedOrTimeout);
+BENCHMARK_TEMPLATE(BM_EvalAndSpeedOrTimeout, AllocatingMockTask);
+BENCHMARK_TEMPLATE(BM_EvalAndSpeedOrTimeout, MockTask);
 
 static void BM_TimeoutConfigure(benchmark::State & state)
 {
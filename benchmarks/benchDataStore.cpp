@@ -0,0 +1,80 @@
+/*
+ * Copyright 2015-2019 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rtc/DataStore.h>
+#include <mc_rtc/pragma.h>
+
+#include "benchmark/benchmark.h"
+
+MC_RTC_diagnostic_push
+MC_RTC_diagnostic_ignored(GCC, "-Wpedantic")
+MC_RTC_diagnostic_ignored(GCC, "-Wconversion")
+MC_RTC_diagnostic_ignored(GCC, "-Wunknown-pragmas")
+
+using anchor_fn_t = std::function<Eigen::Vector3d(const Eigen::Vector3d &)>;
+
+/** Fill a datastore with a realistic number of entries */
+static void populate(mc_rtc::DataStore & store, size_t n)
+{
+  for(size_t i = 0; i < n; ++i) { store.make<double>("Entry::" + std::to_string(i), static_cast<double>(i)); }
+  store.make<double>("Stabilizer::dcmBias", 1.0);
+  store.make_call("KinematicAnchorFrame::robot", [](const Eigen::Vector3d & v) -> Eigen::Vector3d { return 2 * v; });
+}
+
+static void BM_Get(benchmark::State & state)
+{
+  mc_rtc::DataStore store;
+  populate(store, static_cast<size_t>(state.range(0)));
+  for(auto _ : state) { benchmark::DoNotOptimize(store.get<double>("Stabilizer::dcmBias")); }
+}
+BENCHMARK(BM_Get)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_Handle(benchmark::State & state)
+{
+  mc_rtc::DataStore store;
+  populate(store, static_cast<size_t>(state.range(0)));
+  auto h = store.handle<double>("Stabilizer::dcmBias");
+  for(auto _ : state) { benchmark::DoNotOptimize(*h); }
+}
+BENCHMARK(BM_Handle)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_Call(benchmark::State & state)
+{
+  mc_rtc::DataStore store;
+  populate(store, static_cast<size_t>(state.range(0)));
+  Eigen::Vector3d v = Eigen::Vector3d::UnitZ();
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(store.call<Eigen::Vector3d, const Eigen::Vector3d &>("KinematicAnchorFrame::robot", v));
+  }
+}
+BENCHMARK(BM_Call)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_HandleCall(benchmark::State & state)
+{
+  mc_rtc::DataStore store;
+  populate(store, static_cast<size_t>(state.range(0)));
+  Eigen::Vector3d v = Eigen::Vector3d::UnitZ();
+  auto h = store.handle<anchor_fn_t>("KinematicAnchorFrame::robot");
+  for(auto _ : state) { benchmark::DoNotOptimize((*h)(v)); }
+}
+BENCHMARK(BM_HandleCall)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_HandleChanged(benchmark::State & state)
+{
+  mc_rtc::DataStore store;
+  populate(store, 100);
+  auto h = store.handle<double>("Stabilizer::dcmBias");
+  size_t i = 0;
+  for(auto _ : state)
+  {
+    if(++i % 10 == 0) { h.touch(); }
+    benchmark::DoNotOptimize(h.changed());
+  }
+}
+BENCHMARK(BM_HandleChanged);
+
+BENCHMARK_MAIN();
+
+MC_RTC_diagnostic_pop
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_filter/LowPass.h>
+#include <mc_filter/LowPassBank.h>
+#include <mc_filter/LowPassFiniteDifferences.h>
+#include <mc_filter/LowPassFiniteDifferencesBank.h>
+#include <mc_rtc/pragma.h>
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+MC_RTC_diagnostic_push
+MC_RTC_diagnostic_ignored(GCC, "-Wpedantic")
+MC_RTC_diagnostic_ignored(GCC, "-Wconversion")
+MC_RTC_diagnostic_ignored(GCC, "-Wunknown-pragmas")
+MC_RTC_diagnostic_ignored(GCC, "-Wunused-but-set-variable")
+
+const double dt = 0.005;
+const double period = 0.05;
+
+using Vector1d = Eigen::Matrix<double, 1, 1>;
+
+/** Joint-like readings for N channels */
+Eigen::VectorXd readings(Eigen::Index size)
+{
+  return Eigen::VectorXd::LinSpaced(size, -1.0, 1.0);
+}
+
+static void BM_LowPass(benchmark::State & state)
+{
+  auto size = static_cast<Eigen::Index>(state.range(0));
+  std::vector<mc_filter::LowPass<Vector1d>> filters(static_cast<size_t>(size), {dt, period});
+  Eigen::VectorXd values = readings(size);
+  for(auto _ : state)
+  {
+    for(Eigen::Index i = 0; i < size; ++i) { filters[static_cast<size_t>(i)].update(values.segment<1>(i)); }
+    values.array() += 1e-6;
+  }
+}
+BENCHMARK(BM_LowPass)->Arg(6)->Arg(32)->Arg(64);
+
+static void BM_LowPassBank(benchmark::State & state)
+{
+  auto size = static_cast<Eigen::Index>(state.range(0));
+  mc_filter::LowPassBank filter(dt, size, period);
+  Eigen::VectorXd values = readings(size);
+  for(auto _ : state)
+  {
+    filter.update(values);
+    values.array() += 1e-6;
+  }
+}
+BENCHMARK(BM_LowPassBank)->Arg(6)->Arg(32)->Arg(64);
+
+static void BM_LowPassFiniteDifferences(benchmark::State & state)
+{
+  auto size = static_cast<Eigen::Index>(state.range(0));
+  std::vector<mc_filter::LowPassFiniteDifferences<Vector1d>> filters(static_cast<size_t>(size), {dt, period});
+  for(auto & f : filters) { f.reset(Vector1d::Zero(), Vector1d::Zero()); }
+  Eigen::VectorXd values = readings(size);
+  for(auto _ : state)
+  {
+    for(Eigen::Index i = 0; i < size; ++i) { filters[static_cast<size_t>(i)].update(values.segment<1>(i)); }
+    values.array() += 1e-6;
+  }
+}
+BENCHMARK(BM_LowPassFiniteDifferences)->Arg(6)->Arg(32)->Arg(64);
+
+static void BM_LowPassFiniteDifferencesBank(benchmark::State & state)
+{
+  auto size = static_cast<Eigen::Index>(state.range(0));
+  mc_filter::LowPassFiniteDifferencesBank filter(dt, size, period);
+  Eigen::VectorXd values = readings(size);
+  for(auto _ : state)
+  {
+    filter.update(values);
+    values.array() += 1e-6;
+  }
+}
+BENCHMARK(BM_LowPassFiniteDifferencesBank)->Arg(6)->Arg(32)->Arg(64);
+
+BENCHMARK_MAIN();
+
+MC_RTC_diagnostic_pop
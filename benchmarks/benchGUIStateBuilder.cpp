@@ -0,0 +1,117 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rtc/gui/Button.h>
+#include <mc_rtc/gui/Label.h>
+#include <mc_rtc/gui/StateBuilder.h>
+#include <mc_rtc/pragma.h>
+
+#include "benchmark/benchmark.h"
+
+MC_RTC_diagnostic_push
+MC_RTC_diagnostic_ignored(GCC, "-Wpedantic")
+MC_RTC_diagnostic_ignored(GCC, "-Wconversion")
+MC_RTC_diagnostic_ignored(GCC, "-Wunknown-pragmas")
+
+static double value = 42.0;
+
+/** Fill the GUI with n elements spread over 50 nested categories, one source per category */
+static void populate(mc_rtc::gui::StateBuilder & gui, std::vector<int> & sources, size_t n)
+{
+  sources.resize(50);
+  for(size_t i = 0; i < n; ++i)
+  {
+    size_t c = i % sources.size();
+    gui.addElement(&sources[c], {"Tasks", "Task" + std::to_string(c), "Details"},
+                   mc_rtc::gui::Label("value" + std::to_string(i), []() { return value; }));
+  }
+}
+
+/** Add and remove the elements of a source, like an FSM state that comes and goes */
+static void BM_AddRemoveSource(benchmark::State & state)
+{
+  mc_rtc::gui::StateBuilder gui;
+  std::vector<int> sources;
+  populate(gui, sources, static_cast<size_t>(state.range(0)));
+  int source = 0;
+  for(auto _ : state)
+  {
+    for(size_t i = 0; i < 100; ++i)
+    {
+      gui.addElement(&source, {"FSM", "State"}, mc_rtc::gui::Button("button" + std::to_string(i), []() {}));
+    }
+    gui.removeElements(&source);
+  }
+}
+BENCHMARK(BM_AddRemoveSource)->Arg(500)->Arg(5000);
+
+/** Remove the elements of a source in a category and its sub-categories */
+static void BM_AddRemoveSourceInCategory(benchmark::State & state)
+{
+  mc_rtc::gui::StateBuilder gui;
+  std::vector<int> sources;
+  populate(gui, sources, static_cast<size_t>(state.range(0)));
+  int source = 0;
+  for(auto _ : state)
+  {
+    for(size_t i = 0; i < 100; ++i)
+    {
+      gui.addElement(&source, {"Tasks", "Task0", "Monitors"},
+                     mc_rtc::gui::Button("button" + std::to_string(i), []() {}));
+    }
+    gui.removeElements({"Tasks"}, &source, true);
+  }
+}
+BENCHMARK(BM_AddRemoveSourceInCategory)->Arg(500)->Arg(5000);
+
+/** Add and remove a single element in a crowded category */
+static void BM_AddRemoveElement(benchmark::State & state)
+{
+  mc_rtc::gui::StateBuilder gui;
+  std::vector<int> sources;
+  populate(gui, sources, static_cast<size_t>(state.range(0)));
+  for(auto _ : state)
+  {
+    gui.addElement({"Tasks", "Task0", "Details"}, mc_rtc::gui::Button("button", []() {}));
+    gui.removeElement({"Tasks", "Task0", "Details"}, "button");
+  }
+}
+BENCHMARK(BM_AddRemoveElement)->Arg(500)->Arg(5000);
+
+static void BM_RequestByName(benchmark::State & state)
+{
+  mc_rtc::gui::StateBuilder gui;
+  std::vector<int> sources;
+  populate(gui, sources, static_cast<size_t>(state.range(0)));
+  gui.addElement({"Tasks", "Task0", "Details"}, mc_rtc::gui::Button("button", []() {}));
+  mc_rtc::Configuration data;
+  for(auto _ : state) { benchmark::DoNotOptimize(gui.handleRequest({"Tasks", "Task0", "Details"}, "button", data)); }
+}
+BENCHMARK(BM_RequestByName)->Arg(500)->Arg(5000);
+
+static void BM_RequestById(benchmark::State & state)
+{
+  mc_rtc::gui::StateBuilder gui;
+  std::vector<int> sources;
+  populate(gui, sources, static_cast<size_t>(state.range(0)));
+  gui.addElement({"Tasks", "Task0", "Details"}, mc_rtc::gui::Button("button", []() {}));
+  auto id = gui.elementId({"Tasks", "Task0", "Details"}, "button");
+  mc_rtc::Configuration data;
+  for(auto _ : state) { benchmark::DoNotOptimize(gui.handleRequest(id, data)); }
+}
+BENCHMARK(BM_RequestById)->Arg(500)->Arg(5000);
+
+static void BM_Update(benchmark::State & state)
+{
+  mc_rtc::gui::StateBuilder gui;
+  std::vector<int> sources;
+  populate(gui, sources, static_cast<size_t>(state.range(0)));
+  std::vector<char> buffer;
+  for(auto _ : state) { benchmark::DoNotOptimize(gui.update(buffer)); }
+}
+BENCHMARK(BM_Update)->Arg(500)->Arg(5000);
+
+BENCHMARK_MAIN();
+
+MC_RTC_diagnostic_pop
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_control/GUISharedMemory.h>
+#include <mc_rtc/pragma.h>
+
+#ifndef MC_RTC_DISABLE_NETWORK
+#  include <nanomsg/nn.h>
+#  include <nanomsg/pubsub.h>
+#endif
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <thread>
+
+MC_RTC_diagnostic_push
+MC_RTC_diagnostic_ignored(GCC, "-Wpedantic")
+MC_RTC_diagnostic_ignored(GCC, "-Wconversion")
+MC_RTC_diagnostic_ignored(GCC, "-Wunknown-pragmas")
+
+/** Publish a GUI state of state.range(0) bytes and receive it on the same host, one state per iteration */
+static void BM_SharedMemory(benchmark::State & state)
+{
+  auto server = mc_control::GUISharedMemory::create("mc_rtc_bench_gui_shm", 64 * 1024 * 1024);
+  auto client = mc_control::GUISharedMemory::open("mc_rtc_bench_gui_shm");
+  std::vector<char> data(static_cast<size_t>(state.range(0)), 'a');
+  std::vector<char> buffer(data.size());
+  uint64_t seq = 0;
+  for(auto _ : state)
+  {
+    server->write(data.data(), data.size());
+    benchmark::DoNotOptimize(client->read(buffer, seq));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SharedMemory)->Range(4 << 10, 16 << 20)->Unit(benchmark::kMicrosecond);
+
+#ifndef MC_RTC_DISABLE_NETWORK
+
+/** Same as BM_SharedMemory with a PUB/SUB socket pair, this is what ControllerServer/ControllerClient use */
+static void BM_Socket(benchmark::State & state, const char * uri)
+{
+  int pub = nn_socket(AF_SP, NN_PUB);
+  int sub = nn_socket(AF_SP, NN_SUB);
+  int max_size = -1;
+  nn_setsockopt(sub, NN_SUB, NN_SUB_SUBSCRIBE, "", 0);
+  nn_setsockopt(sub, NN_SOL_SOCKET, NN_RCVMAXSIZE, &max_size, sizeof(max_size));
+  if(nn_bind(pub, uri) < 0 || nn_connect(sub, uri) < 0)
+  {
+    state.SkipWithError(nn_strerror(nn_errno()));
+    nn_close(pub);
+    nn_close(sub);
+    return;
+  }
+  // Let the SUB socket connect, the first messages would be dropped otherwise
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::vector<char> data(static_cast<size_t>(state.range(0)), 'a');
+  std::vector<char> buffer(data.size());
+  for(auto _ : state)
+  {
+    nn_send(pub, data.data(), data.size(), 0);
+    benchmark::DoNotOptimize(nn_recv(sub, buffer.data(), buffer.size(), 0));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+  nn_close(pub);
+  nn_close(sub);
+}
+BENCHMARK_CAPTURE(BM_Socket, IPC, "ipc:///tmp/mc_rtc_bench_gui.ipc")
+    ->Range(4 << 10, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Socket, TCP, "tcp://127.0.0.1:4545")->Range(4 << 10, 16 << 20)->Unit(benchmark::kMicrosecond);
+
+#endif
+
+BENCHMARK_MAIN();
+MC_RTC_diagnostic_pop
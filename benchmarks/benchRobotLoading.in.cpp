@@ -8,6 +8,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "AllocationCounter.h"
 #include "benchmark/benchmark.h"
 
 class RobotLoadingFixture : public benchmark::Fixture
@@ -49,11 +50,22 @@ BENCHMARK_DEFINE_F(RobotLoadingFixture, RobotCopy)(benchmark::State & state)
   auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
   auto robots_ptr = mc_rbdyn::loadRobot(*rm);
   const auto & robots = *robots_ptr;
+  size_t bytes = 0;
+  size_t allocs = 0;
   while(state.KeepRunning())
   {
     auto robots_copy = mc_rbdyn::Robots::make();
-    for(const auto & r : robots) { robots_copy->robotCopy(r, r.name()); }
+    {
+      AllocationCounter counter;
+      for(const auto & r : robots) { robots_copy->robotCopy(r, r.name()); }
+      counter.stop();
+      bytes += counter.bytes();
+      allocs += counter.allocations();
+    }
   }
+  state.counters["AllocatedBytes"] =
+      benchmark::Counter(static_cast<double>(bytes), benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+  state.counters["Allocations"] = benchmark::Counter(static_cast<double>(allocs), benchmark::Counter::kAvgIterations);
 }
 BENCHMARK_REGISTER_F(RobotLoadingFixture, RobotCopy)->Unit(benchmark::kMicrosecond);
 
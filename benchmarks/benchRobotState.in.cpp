@@ -0,0 +1,161 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotConverter.h>
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+#include <mc_rtc/pragma.h>
+
+#include <RBDyn/MultiBodyConfig.h>
+
+#include <spdlog/spdlog.h>
+
+#include "benchmark/benchmark.h"
+
+class RobotStateFixture : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State &)
+  {
+    MC_RTC_diagnostic_push
+    MC_RTC_diagnostic_ignored(GCC, "-Wunused-variable")
+    static bool initialized = []()
+    {
+      spdlog::set_level(spdlog::level::err);
+      mc_rbdyn::RobotLoader::clear();
+      mc_rtc::Loader::debug_suffix = "";
+      mc_rbdyn::RobotLoader::update_robot_module_path({"@CMAKE_CURRENT_BINARY_DIR@/../src/mc_robots"});
+      return true;
+    }();
+    MC_RTC_diagnostic_pop
+    if(!robots)
+    {
+      auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+      robots = mc_rbdyn::loadRobot(*rm);
+      outputRobots = mc_rbdyn::loadRobot(*rm);
+    }
+  }
+
+  void TearDown(const ::benchmark::State &) {}
+
+  mc_rbdyn::RobotsPtr robots;
+  mc_rbdyn::RobotsPtr outputRobots;
+};
+
+BENCHMARK_DEFINE_F(RobotStateFixture, ParamToVector)(benchmark::State & state)
+{
+  const auto & robot = robots->robot();
+  Eigen::VectorXd q(robot.mb().nrParams());
+  for(auto _ : state)
+  {
+    rbd::paramToVector(robot.mbc().q, q);
+    benchmark::DoNotOptimize(q.data());
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, ParamToVector);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, FlatParamGather)(benchmark::State & state)
+{
+  const auto & robot = robots->robot();
+  Eigen::VectorXd q(robot.paramMap().size());
+  for(auto _ : state)
+  {
+    robot.paramMap().gather(robot.mbc().q, q);
+    benchmark::DoNotOptimize(q.data());
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, FlatParamGather);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, VectorToParam)(benchmark::State & state)
+{
+  auto & robot = robots->robot();
+  Eigen::VectorXd alphaD = Eigen::VectorXd::Zero(robot.mb().nrDof());
+  for(auto _ : state)
+  {
+    rbd::vectorToParam(alphaD, robot.alphaD());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, VectorToParam);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, FlatDofScatter)(benchmark::State & state)
+{
+  auto & robot = robots->robot();
+  Eigen::VectorXd alphaD = Eigen::VectorXd::Zero(robot.dofMap().size());
+  for(auto _ : state)
+  {
+    robot.dofMap().scatter(alphaD, robot.alphaD());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, FlatDofScatter);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, RefJointOrderLoop)(benchmark::State & state)
+{
+  const auto & robot = robots->robot();
+  std::vector<double> qOut(robot.refJointOrder().size(), 0);
+  for(auto _ : state)
+  {
+    for(size_t i = 0; i < qOut.size(); ++i)
+    {
+      auto mbcIndex = robot.jointIndexInMBC(i);
+      if(mbcIndex != -1) { qOut[i] = robot.mbc().q[static_cast<size_t>(mbcIndex)][0]; }
+    }
+    benchmark::DoNotOptimize(qOut.data());
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, RefJointOrderLoop);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, RefJointOrderGather)(benchmark::State & state)
+{
+  const auto & robot = robots->robot();
+  std::vector<double> qOut(robot.refJointOrder().size(), 0);
+  for(auto _ : state)
+  {
+    robot.refJointOrderMap().gather(robot.mbc().q, qOut);
+    benchmark::DoNotOptimize(qOut.data());
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, RefJointOrderGather);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, RobotConverter)(benchmark::State & state)
+{
+  const auto & robot = robots->robot();
+  auto & outputRobot = outputRobots->robot();
+  mc_rbdyn::RobotConverterConfig config;
+  config.copyPosWorld(false);
+  mc_rbdyn::RobotConverter converter(robot, outputRobot, config);
+  for(auto _ : state)
+  {
+    converter.convert(robot, outputRobot);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, RobotConverter);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, ForceSensorRecompute)(benchmark::State & state)
+{
+  const auto & robot = robots->robot();
+  // A copy is not owned by the robot and always computes the quantities
+  mc_rbdyn::ForceSensor fs = robot.forceSensor("LeftFootForceSensor");
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(fs.worldWrenchWithoutGravity(robot));
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, ForceSensorRecompute);
+
+BENCHMARK_DEFINE_F(RobotStateFixture, ForceSensorCached)(benchmark::State & state)
+{
+  const auto & robot = robots->robot();
+  const auto & fs = robot.forceSensor("LeftFootForceSensor");
+  robot.refreshForceSensorsCache();
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(fs.worldWrenchWithoutGravity(robot));
+  }
+}
+BENCHMARK_REGISTER_F(RobotStateFixture, ForceSensorCached);
+
+BENCHMARK_MAIN();
@@ -5,6 +5,7 @@
 #include <mc_control/SimulationContactPair.h>
 #include <mc_rbdyn/RobotLoader.h>
 #include <mc_rbdyn/Robots.h>
+#include <mc_rbdyn/surface_hull.h>
 
 #include <spdlog/spdlog.h>
 
@@ -48,6 +49,19 @@ BENCHMARK_DEFINE_F(SimulationContactPairFixture, Creation)(benchmark::State & st
 }
 BENCHMARK_REGISTER_F(SimulationContactPairFixture, Creation)->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_DEFINE_F(SimulationContactPairFixture, CreationUncached)(benchmark::State & state)
+{
+  auto & robots = get_robots();
+  auto & robot = robots.robot();
+  auto & env = robots.env();
+  while(state.KeepRunning())
+  {
+    mc_rbdyn::clear_sch_hull_cache();
+    mc_control::SimulationContactPair pair(robot.surfaces().at("LeftFoot"), env.surfaces().at("AllGround"));
+  }
+}
+BENCHMARK_REGISTER_F(SimulationContactPairFixture, CreationUncached)->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_DEFINE_F(SimulationContactPairFixture, Update)(benchmark::State & state)
 {
   auto & robots = get_robots();
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+/** Runs the sample controllers headless with every available solver backend
+ *
+ * For each controller/backend pair this reports:
+ * - CreationTime: time to create and initialize the controller (ms)
+ * - SolveTime: solver build and solve time per tick (ms)
+ * - TrackingError: sum of the tasks' error norms per tick
+ *
+ * This uses the installed sample controllers, it must be run after installing mc_rtc
+ */
+
+#include <mc_control/Ticker.h>
+#include <mc_solver/TVMQPSolver.h>
+#include <mc_tasks/MetaTask.h>
+
+#include <mc_rtc/clock.h>
+
+#include <spdlog/spdlog.h>
+
+#include "benchmark/benchmark.h"
+
+#include <boost/filesystem.hpp>
+namespace bfs = boost::filesystem;
+
+namespace
+{
+
+/** Number of control ticks simulated for each benchmark (10s at 5ms) */
+constexpr benchmark::IterationCount TICKS = 2000;
+
+void runController(benchmark::State & state, const std::string & controller, const mc_rtc::Configuration & solver)
+{
+  mc_rtc::Configuration config;
+  config.add("MainRobot", "JVRC1");
+  config.add("Enabled", controller);
+  config.add("Timestep", 0.005);
+  config.add("Log", false);
+  auto path = (bfs::temp_directory_path() / bfs::unique_path("benchSolverBackends-%%%%-%%%%.yaml")).string();
+  config.save(path);
+
+  auto start = mc_rtc::clock::now();
+  mc_control::Ticker::Configuration ticker_config;
+  ticker_config.mc_rtc_configuration = path;
+  ticker_config.no_sync = true;
+  mc_control::Ticker ticker(ticker_config);
+  bfs::remove(path);
+  auto & ctl = ticker.controller().controller();
+  ctl.solver().configure(solver);
+  mc_rtc::duration_ms creation = mc_rtc::clock::now() - start;
+
+  double solveTime = 0.0;
+  double trackingError = 0.0;
+  for(auto _ : state)
+  {
+    if(!ticker.step())
+    {
+      state.SkipWithError("Controller failed to run");
+      break;
+    }
+    solveTime += ctl.solver().solveAndBuildTime();
+    for(const auto * t : ctl.solver().tasks()) { trackingError += t->eval().norm(); }
+  }
+  state.counters["CreationTime"] = creation.count();
+  state.counters["SolveTime"] = benchmark::Counter(solveTime, benchmark::Counter::kAvgIterations);
+  state.counters["TrackingError"] = benchmark::Counter(trackingError, benchmark::Counter::kAvgIterations);
+}
+
+void registerController(const std::string & controller)
+{
+  benchmark::RegisterBenchmark((controller + "/Tasks").c_str(),
+                               [controller](benchmark::State & state)
+                               { runController(state, controller, mc_rtc::Configuration{}); })
+      ->Iterations(TICKS)
+      ->Unit(benchmark::kMillisecond);
+  for(const auto & solver : mc_solver::TVMQPSolver::availableSolvers())
+  {
+    mc_rtc::Configuration solverConfig;
+    solverConfig.add("solver", solver);
+    benchmark::RegisterBenchmark((controller + "/TVM/" + solver).c_str(),
+                                 [controller, solverConfig](benchmark::State & state)
+                                 { runController(state, controller + "_TVM", solverConfig); })
+        ->Iterations(TICKS)
+        ->Unit(benchmark::kMillisecond);
+  }
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+  spdlog::set_level(spdlog::level::err);
+  for(const auto & controller : {"Posture", "EndEffector", "CoM", "LIPMStabilizer"}) { registerController(controller); }
+  benchmark::Initialize(&argc, argv);
+  if(benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
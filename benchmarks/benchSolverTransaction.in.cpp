@@ -0,0 +1,131 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+#include <mc_rtc/config.h>
+#include <mc_rtc/gui/StateBuilder.h>
+#include <mc_solver/CollisionsConstraint.h>
+#include <mc_solver/ContactConstraint.h>
+#include <mc_solver/KinematicsConstraint.h>
+#include <mc_solver/TasksQPSolver.h>
+#include <mc_tasks/CoMTask.h>
+#include <mc_tasks/OrientationTask.h>
+#include <mc_tasks/SurfaceTransformTask.h>
+#include <mc_tasks/TransformTask.h>
+
+#include <spdlog/spdlog.h>
+
+#include "benchmark/benchmark.h"
+
+/** Simulates an FSM transition between two states using a typical set of tasks and constraints
+ *
+ * - state A: both feet in contact, CoM and torso orientation tasks, self-collisions
+ * - state B: right foot in the air, right foot/hands tasks, no self-collisions
+ */
+class SolverTransactionFixture : public benchmark::Fixture
+{
+public:
+  SolverTransactionFixture()
+  {
+    spdlog::set_level(spdlog::level::err);
+    auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+    auto env = mc_rbdyn::RobotLoader::get_robot_module("env", std::string(mc_rtc::MC_ENV_DESCRIPTION_PATH),
+                                                       std::string("ground"));
+    for(auto * robots : {&solver.robots(), &solver.realRobots()})
+    {
+      robots->load(*rm);
+      robots->load(*env);
+    }
+    // Collisions constraints require a GUI and controllers always provide one
+    solver.gui(std::make_shared<mc_rtc::gui::StateBuilder>());
+    auto & robot = solver.robot();
+    contactsA = {{solver.robots(), "LeftFoot", "AllGround"}, {solver.robots(), "RightFoot", "AllGround"}};
+    contactsB = {{solver.robots(), "LeftFoot", "AllGround"}};
+    kinematicsConstraint = std::make_unique<mc_solver::KinematicsConstraint>(solver.robots(), 0, solver.dt());
+    contactConstraint = std::make_unique<mc_solver::ContactConstraint>(solver.dt());
+    selfCollisionConstraint = std::make_unique<mc_solver::CollisionsConstraint>(solver.robots(), 0, 0, solver.dt());
+    tasksA = {std::make_shared<mc_tasks::CoMTask>(solver.robots(), 0),
+              std::make_shared<mc_tasks::OrientationTask>(robot.frame("WAIST_R_S")),
+              std::make_shared<mc_tasks::OrientationTask>(robot.frame("PELVIS_S"))};
+    tasksB = {std::make_shared<mc_tasks::CoMTask>(solver.robots(), 0),
+              std::make_shared<mc_tasks::SurfaceTransformTask>("RightFoot", solver.robots(), 0),
+              std::make_shared<mc_tasks::TransformTask>(robot.frame("L_WRIST_Y_S")),
+              std::make_shared<mc_tasks::TransformTask>(robot.frame("R_WRIST_Y_S"))};
+    solver.addConstraintSet(*kinematicsConstraint);
+    solver.addConstraintSet(*contactConstraint);
+    solver.addConstraintSet(*selfCollisionConstraint);
+    selfCollisionConstraint->addCollisions(solver, robot.module().minimalSelfCollisions());
+    solver.removeConstraintSet(*selfCollisionConstraint);
+  }
+
+  void SetUp(const ::benchmark::State &)
+  {
+    solver.setContacts(contactsA);
+    solver.addConstraintSet(*selfCollisionConstraint);
+    for(auto & t : tasksA) { solver.addTask(t); }
+  }
+
+  void TearDown(const ::benchmark::State &)
+  {
+    for(auto & t : tasksA) { solver.removeTask(t); }
+    for(auto & t : tasksB) { solver.removeTask(t); }
+    solver.removeConstraintSet(*selfCollisionConstraint);
+  }
+
+  /** Go from state A to state B */
+  void transitionAB()
+  {
+    for(auto & t : tasksA) { solver.removeTask(t); }
+    solver.removeConstraintSet(*selfCollisionConstraint);
+    solver.setContacts(contactsB);
+    for(auto & t : tasksB) { solver.addTask(t); }
+  }
+
+  /** Go from state B to state A */
+  void transitionBA()
+  {
+    for(auto & t : tasksB) { solver.removeTask(t); }
+    solver.addConstraintSet(*selfCollisionConstraint);
+    solver.setContacts(contactsA);
+    for(auto & t : tasksA) { solver.addTask(t); }
+  }
+
+  mc_solver::TasksQPSolver solver{0.005};
+  std::vector<mc_rbdyn::Contact> contactsA;
+  std::vector<mc_rbdyn::Contact> contactsB;
+  std::unique_ptr<mc_solver::KinematicsConstraint> kinematicsConstraint;
+  std::unique_ptr<mc_solver::ContactConstraint> contactConstraint;
+  std::unique_ptr<mc_solver::CollisionsConstraint> selfCollisionConstraint;
+  std::vector<std::shared_ptr<mc_tasks::MetaTask>> tasksA;
+  std::vector<std::shared_ptr<mc_tasks::MetaTask>> tasksB;
+};
+
+BENCHMARK_DEFINE_F(SolverTransactionFixture, Transition)(benchmark::State & state)
+{
+  for(auto _ : state)
+  {
+    transitionAB();
+    transitionBA();
+  }
+}
+BENCHMARK_REGISTER_F(SolverTransactionFixture, Transition)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(SolverTransactionFixture, TransitionWithTransaction)(benchmark::State & state)
+{
+  for(auto _ : state)
+  {
+    {
+      mc_solver::QPSolver::Transaction transaction(solver);
+      transitionAB();
+    }
+    {
+      mc_solver::QPSolver::Transaction transaction(solver);
+      transitionBA();
+    }
+  }
+}
+BENCHMARK_REGISTER_F(SolverTransactionFixture, TransitionWithTransaction)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
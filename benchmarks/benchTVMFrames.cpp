@@ -0,0 +1,89 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+#include <mc_rtc/config.h>
+#include <mc_solver/KinematicsConstraint.h>
+#include <mc_solver/TVMQPSolver.h>
+#include <mc_tasks/TransformTask.h>
+#include <mc_tvm/TransformFunction.h>
+
+#include <tvm/graph/CallGraph.h>
+#include <tvm/graph/internal/Inputs.h>
+
+#include <spdlog/spdlog.h>
+
+#include "benchmark/benchmark.h"
+
+/** Measures the cost of the TVM graph update for a humanoid with many frames
+ *
+ * Every frame of JVRC1 (bodies, surfaces, sensors...) is used, many of them share the same parent body
+ */
+class TVMFramesFixture : public benchmark::Fixture
+{
+public:
+  TVMFramesFixture()
+  {
+    spdlog::set_level(spdlog::level::err);
+    auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+    auto env = mc_rbdyn::RobotLoader::get_robot_module("env", std::string(mc_rtc::MC_ENV_DESCRIPTION_PATH),
+                                                       std::string("ground"));
+    for(auto * robots : {&solver.robots(), &solver.realRobots()})
+    {
+      robots->load(*rm);
+      robots->load(*env);
+    }
+    kinematicsConstraint = std::make_unique<mc_solver::KinematicsConstraint>(solver.robots(), 0, solver.dt());
+    solver.addConstraintSet(*kinematicsConstraint);
+    frames = solver.robot().frames();
+  }
+
+  /** Number of frames used by a benchmark */
+  size_t nFrames(const ::benchmark::State & state) const
+  {
+    return std::min(static_cast<size_t>(state.range(0)), frames.size());
+  }
+
+  mc_solver::TVMQPSolver solver{0.005};
+  std::unique_ptr<mc_solver::KinematicsConstraint> kinematicsConstraint;
+  std::vector<std::string> frames;
+};
+
+/** Update of the transform functions of N frames (value, velocity, jacobian and normal acceleration) */
+BENCHMARK_DEFINE_F(TVMFramesFixture, GraphUpdate)(benchmark::State & state)
+{
+  using Output = tvm::function::abstract::Function::Output;
+  auto inputs = std::make_shared<tvm::graph::internal::Inputs>();
+  std::vector<std::shared_ptr<mc_tvm::TransformFunction>> functions;
+  for(size_t i = 0; i < nFrames(state); ++i)
+  {
+    auto f = std::make_shared<mc_tvm::TransformFunction>(solver.robot().frame(frames[i]));
+    inputs->addInput(f, Output::Value, Output::Velocity, Output::Jacobian, Output::NormalAcceleration);
+    functions.push_back(f);
+  }
+  tvm::graph::CallGraph graph;
+  graph.add(inputs);
+  graph.update();
+  for(auto _ : state) { graph.execute(); }
+  state.counters["Frames"] = static_cast<double>(functions.size());
+}
+BENCHMARK_REGISTER_F(TVMFramesFixture, GraphUpdate)->RangeMultiplier(2)->Range(1, 128)->Unit(benchmark::kMicrosecond);
+
+/** Full solver iteration with a transform task on N frames */
+BENCHMARK_DEFINE_F(TVMFramesFixture, SolverRun)(benchmark::State & state)
+{
+  std::vector<std::shared_ptr<mc_tasks::TransformTask>> tasks;
+  for(size_t i = 0; i < nFrames(state); ++i)
+  {
+    tasks.push_back(std::make_shared<mc_tasks::TransformTask>(solver.robot().frame(frames[i])));
+    solver.addTask(tasks.back());
+  }
+  for(auto _ : state) { solver.run(); }
+  for(auto & t : tasks) { solver.removeTask(t); }
+  state.counters["Frames"] = static_cast<double>(tasks.size());
+}
+BENCHMARK_REGISTER_F(TVMFramesFixture, SolverRun)->RangeMultiplier(2)->Range(1, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
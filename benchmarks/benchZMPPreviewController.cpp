@@ -0,0 +1,60 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_planning/ZMPPreviewController.h>
+#include <mc_rtc/pragma.h>
+
+#include "benchmark/benchmark.h"
+
+#include "AllocationCounter.h"
+
+MC_RTC_diagnostic_push
+MC_RTC_diagnostic_ignored(GCC, "-Wpedantic")
+MC_RTC_diagnostic_ignored(GCC, "-Wconversion")
+MC_RTC_diagnostic_ignored(GCC, "-Wunknown-pragmas")
+MC_RTC_diagnostic_ignored(GCC, "-Wunused-but-set-variable")
+
+const double dt = 0.005;
+const double height = 0.8;
+
+/** Cost of computing the gains for a new set of parameters */
+static void BM_ZMPPreviewGains(benchmark::State & state)
+{
+  auto horizon = static_cast<Eigen::Index>(state.range(0));
+  for(auto _ : state) { mc_planning::ZMPPreviewGains gains(dt, height, horizon, 1.0, 1e-6); }
+}
+BENCHMARK(BM_ZMPPreviewGains)->Arg(160)->Arg(320)->Arg(640)->Unit(benchmark::kMicrosecond);
+
+/** Per-tick cost while walking, a footstep is pushed whenever there is room for it */
+static void BM_ZMPPreviewController(benchmark::State & state)
+{
+  double horizon = static_cast<double>(state.range(0)) * dt;
+  mc_planning::ZMPPreviewController preview(dt, height, horizon);
+  preview.reset({0, 0, height});
+  Eigen::Vector2d step{0, 0.1};
+  auto fill = [&]()
+  {
+    while(preview.capacity() - preview.size() >= 160)
+    {
+      preview.push(step, 0.8);
+      step.x() += 0.2;
+      step.y() = -step.y();
+    }
+  };
+  AllocationCounter counter;
+  for(auto _ : state)
+  {
+    fill();
+    preview.update();
+    benchmark::DoNotOptimize(preview.zmpRef().data());
+  }
+  counter.stop();
+  state.counters["allocs"] =
+      benchmark::Counter(static_cast<double>(counter.allocations()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ZMPPreviewController)->Arg(160)->Arg(320)->Arg(640);
+
+BENCHMARK_MAIN();
+
+MC_RTC_diagnostic_pop
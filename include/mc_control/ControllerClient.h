@@ -11,6 +11,9 @@
 #include <mc_rtc/gui/plot/types.h>
 #include <mc_rtc/gui/types.h>
 
+#include <chrono>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -34,12 +37,19 @@ struct MC_CONTROL_CLIENT_DLLAPI ElementId
 
   ElementId(const std::vector<std::string> & category, const std::string & name) : ElementId(category, name, -1) {}
 
+  ElementId(const std::vector<std::string> & category, const std::string & name, int sid, uint64_t uid)
+  : category(category), name(name), sid(sid), uid(uid)
+  {
+  }
+
   /** Category the element belongs to */
   std::vector<std::string> category = {};
   /** Name of the element */
   std::string name = {};
   /** Stack id, the elements that share the same stack id should be displayed on the same line */
   int sid = -1;
+  /** Unique id of the element on the server side, 0 if the server did not provide it */
+  uint64_t uid = 0;
 };
 
 /** Receives data and interact with a ControllerServer
@@ -47,6 +57,8 @@ struct MC_CONTROL_CLIENT_DLLAPI ElementId
  * - Uses a SUB socket to receive the data stream
  *
  * - Uses a REQ socket to send requests
+ *
+ * - Or uses shared memory to do both with a server on the same host, see \ref connect_shared_memory
  */
 struct MC_CONTROL_CLIENT_DLLAPI ControllerClient
 {
@@ -77,6 +89,7 @@ struct MC_CONTROL_CLIENT_DLLAPI ControllerClient
    *
    * \param gui GUI updated by the server
    *
+   * \see connect(ControllerServer &, mc_rtc::gui::StateBuilder &)
    */
   ControllerClient(ControllerServer & server, mc_rtc::gui::StateBuilder & gui);
 
@@ -88,9 +101,24 @@ struct MC_CONTROL_CLIENT_DLLAPI ControllerClient
   /** Connect to the provided uris */
   void connect(const std::string & sub_conn_uri, const std::string & push_conn_uri);
 
-  /** Connect to an in-memory server */
+  /** Connect to an in-memory server
+   *
+   * The client reads the state published by the server in place (see ControllerServer::snapshot) and its requests are
+   * queued on the server without serialization, they are handled in the next ControllerServer::handle_requests call
+   */
   void connect(ControllerServer & server, mc_rtc::gui::StateBuilder & gui);
 
+  /** Connect to a server on the same host through shared memory
+   *
+   * See ControllerServerConfiguration::shm_config, if a timeout is set (see \ref timeout) the client re-opens the
+   * shared memory when the server has been silent for that long so it survives a server restart
+   *
+   * \param name Name of the shared-memory segment
+   *
+   * \throws If the segment does not exist
+   */
+  void connect_shared_memory(const std::string & name);
+
   /** Send a request to the given element in the given category using data */
   void send_request(const ElementId & id, const mc_rtc::Configuration & data);
 
@@ -124,6 +152,16 @@ struct MC_CONTROL_CLIENT_DLLAPI ControllerClient
   /** Helper for the void case */
   void raw_request(const ElementId & id, std::string & out);
 
+  /** Subscribe to some categories of the GUI
+   *
+   * If the server enables subscriptions (see ControllerServerConfiguration::subscriptions), only the elements of the
+   * subscribed categories and their sub-categories are sent, the other categories are received without elements. The
+   * subscription is renewed while the client receives data.
+   *
+   * \param categories Categories displayed by the client, an empty category subscribes to the whole GUI
+   */
+  void subscribe(const std::vector<std::vector<std::string>> & categories);
+
   /** Set the timeout of the SUB socket */
   void timeout(double t);
 
@@ -944,12 +982,38 @@ protected:
   /* Hold data from the server */
   mc_rtc::Configuration data_;
 
+  /* Elements' ids in the current message and index of the next element */
+  mc_rtc::Configuration ids_;
+  size_t next_id_ = 0;
+
+  /* Subscribed categories, see subscribe */
+  std::optional<std::vector<std::vector<std::string>>> subscriptions_;
+  /* Identify this client's subscriptions on the server */
+  std::string client_id_;
+  /* Last time the subscriptions were sent */
+  std::chrono::steady_clock::time_point subscriptions_sent_;
+  std::mutex subscriptions_mutex_;
+
+  /* Shared memory if connected through shared memory, shm_ and shm_seq_ are only accessed under shm_mutex_ */
+  std::unique_ptr<GUISharedMemory> shm_;
+  std::mutex shm_mutex_;
+  /* Sequence number of the last state read from the shared memory */
+  uint64_t shm_seq_ = 0;
+
   /* Pointer to the server if connected in-memory */
   ControllerServer * server_ = nullptr;
   /* Pointer to the GUI if connected in-memory */
   mc_rtc::gui::StateBuilder * gui_ = nullptr;
+  /* Sequence number of the last state read from the in-memory server */
+  uint64_t server_seq_ = 0;
 
 private:
+  /** Send a raw request to the server */
+  void send(const std::string & out);
+
+  /** Send the subscriptions to the server if they were last sent more than \p period ago */
+  void send_subscriptions(std::chrono::steady_clock::duration period);
+
   /** Default implementations for widgets' creations display a warning message to the user */
   virtual void default_impl(const std::string & type, const ElementId & id);
 
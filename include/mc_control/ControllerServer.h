@@ -5,12 +5,16 @@
 #pragma once
 
 #include <mc_control/ControllerServerConfiguration.h>
+#include <mc_control/GUISharedMemory.h>
 #include <mc_control/MCController.h>
 
 #include <mc_rtc/gui/StateBuilder.h>
 #include <mc_rtc/log/Logger.h>
 
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mc_control
@@ -21,6 +25,8 @@ namespace mc_control
  * - Uses a PUB socket to send the data stream
  *
  * - Uses a PULL socket to handle requests
+ *
+ * - Optionally, uses a shared-memory segment to do both with clients on the same host, see \ref GUISharedMemory
  */
 struct MC_CONTROL_DLLAPI ControllerServer
 {
@@ -61,9 +67,43 @@ struct MC_CONTROL_DLLAPI ControllerServer
   /** Publish the current GUI state */
   void publish(mc_rtc::gui::StateBuilder & gui_builder);
 
-  /** Get latest published data */
+  /** Get latest published data
+   *
+   * The size is zero if nothing was published during the last call to \ref publish
+   *
+   * The data is only valid until the next call to \ref publish so this must be called from the thread that publishes,
+   * other threads should use \ref snapshot
+   */
   std::pair<const char *, size_t> data() const;
 
+  /** GUI state published by the server */
+  struct Snapshot
+  {
+    /** Increases with every publication */
+    uint64_t seq = 0;
+    /** Serialized state, only the first size bytes are meaningful */
+    std::vector<char> buffer;
+    size_t size = 0;
+  };
+
+  /** Latest published state, nullptr if nothing has been published yet
+   *
+   * The server never writes into a snapshot that is still referenced so in-process clients can read it without
+   * copying it while the server keeps publishing. This can be called from any thread.
+   */
+  std::shared_ptr<const Snapshot> snapshot() const;
+
+  /** Queue a request from an in-process client
+   *
+   * The request is handled in the next call to \ref handle_requests. This can be called from any thread.
+   *
+   * \param id Unique id of the element (see mc_rtc::gui::StateBuilder::handleRequest), 0 to look it up by category and
+   * name
+   *
+   * \param request Request to the element
+   */
+  void push_request(uint64_t id, mc_rtc::Logger::GUIEvent request);
+
   /** Attach a logger to the server */
   inline void set_logger(std::shared_ptr<mc_rtc::Logger> logger) noexcept { logger_ = logger; }
 
@@ -76,6 +116,17 @@ struct MC_CONTROL_DLLAPI ControllerServer
   /** Update the rate of the server */
   void update_rate(double dt, double server_dt);
 
+  /** Set the subscriptions of a client
+   *
+   * This has no effect if subscriptions are disabled in the server configuration. Clients send this request (see
+   * ControllerClient::subscribe) and must renew it before \ref ControllerServerConfiguration::subscription_timeout
+   *
+   * \param client Unique identifier of the client
+   *
+   * \param categories Categories the client displays, see mc_rtc::gui::StateBuilder::subscriptions
+   */
+  void subscribe(const std::string & client, const std::vector<std::vector<std::string>> & categories);
+
 private:
   unsigned int iter_;
   unsigned int rate_;
@@ -83,12 +134,53 @@ private:
   int pub_socket_;
   int pull_socket_;
 
-  std::vector<char> buffer_;
+  /** Snapshots written by \ref publish, a snapshot is re-used once the server is its only owner */
+  std::vector<std::shared_ptr<Snapshot>> snapshots_;
+  /** Latest published snapshot */
+  std::shared_ptr<const Snapshot> latest_;
+  mutable std::mutex latest_mutex_;
+  uint64_t published_ = 0;
   size_t buffer_size_ = 0;
 
+  /** Shared-memory transport, nullptr if disabled */
+  std::unique_ptr<GUISharedMemory> shm_;
+  /** Receives the requests from the shared memory */
+  std::vector<char> shm_request_;
+  /** True once we warned that the GUI state does not fit in the shared memory */
+  bool shm_overflow_ = false;
+
   std::shared_ptr<mc_rtc::Logger> logger_;
 
   std::vector<mc_rtc::Logger::GUIEvent> requests_;
+
+  /** Requests queued by in-process clients and their element id */
+  std::vector<std::pair<uint64_t, mc_rtc::Logger::GUIEvent>> pending_requests_;
+  /** Requests being handled, swapped with pending_requests_ to keep both allocations */
+  std::vector<std::pair<uint64_t, mc_rtc::Logger::GUIEvent>> handled_requests_;
+  std::mutex pending_requests_mutex_;
+
+  /** Returns a snapshot that is not referenced outside of the server */
+  const std::shared_ptr<Snapshot> & next_snapshot();
+
+  /** True if clients' subscriptions are honored */
+  bool subscriptions_ = false;
+  /** Subscription timeout */
+  std::chrono::duration<double> subscription_timeout_{5.0};
+  struct Subscription
+  {
+    std::vector<std::vector<std::string>> categories;
+    std::chrono::steady_clock::time_point time;
+  };
+  /** Subscriptions by client, in-memory clients subscribe from their own thread */
+  std::unordered_map<std::string, Subscription> clients_;
+  std::mutex clients_mutex_;
+  /** True if the subscriptions changed since they were last given to the GUI */
+  bool subscriptions_changed_ = true;
+  /** GUI that received the subscriptions */
+  const mc_rtc::gui::StateBuilder * subscriptions_gui_ = nullptr;
+
+  /** Drop the expired subscriptions and forward the changes to the GUI */
+  void update_subscriptions(mc_rtc::gui::StateBuilder & gui_builder);
 };
 
 } // namespace mc_control
@@ -34,6 +34,15 @@ struct SocketConfiguration
   uint16_t pull_port = default_pull_port;
 };
 
+/** Shared-memory configuration, see \ref mc_control::GUISharedMemory */
+struct SharedMemoryConfiguration
+{
+  /** Name of the shared-memory segment */
+  std::string name = "mc_rtc_gui";
+  /** Maximum size (in bytes) of the GUI state, larger states are not published on the shared memory */
+  uint64_t size = 16 * 1024 * 1024;
+};
+
 } // namespace details
 
 /** Configuration for \ref mc_control::ControllerServer */
@@ -71,6 +80,24 @@ struct MC_CONTROL_DLLAPI ControllerServerConfiguration
    */
   std::optional<WebSocketConfiguration> websocket_config = std::nullopt;
 
+  using SharedMemoryConfiguration = details::SharedMemoryConfiguration;
+
+  /** Configuration for the shared-memory transport, clients on the same host can use it instead of the sockets
+   *
+   * Shared memory is disabled if this is nullopt (default)
+   */
+  std::optional<SharedMemoryConfiguration> shm_config = std::nullopt;
+
+  /** If true, clients can subscribe to parts of the GUI and only the subscribed parts are fully serialized
+   *
+   * The other categories are sent without their elements so clients that do not subscribe (e.g. clients built against
+   * an older version of mc_rtc) will only see the structure of the GUI, hence this is disabled by default
+   */
+  bool subscriptions = false;
+
+  /** Time (in seconds) after which a subscription that has not been renewed by its client expires */
+  double subscription_timeout = 5.0;
+
   /** Loads from a configuration object */
   void load(const mc_rtc::Configuration & config);
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_control/api.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mc_control
+{
+
+/** Shared-memory transport between a ControllerServer and the ControllerClient(s) running on the same host
+ *
+ * The segment holds:
+ *
+ * - the latest GUI state written by the server, it is protected by a sequence lock: the server never waits for the
+ *   clients and a client retries its copy if the server published a new state meanwhile
+ *
+ * - a bounded queue of requests written by the clients and read by the server
+ */
+struct MC_CONTROL_DLLAPI GUISharedMemory
+{
+  /** Maximum size of a request */
+  static constexpr size_t request_capacity = 65536 - 2 * sizeof(uint64_t);
+
+  /** Number of requests that can be queued */
+  static constexpr size_t request_slots = 64;
+
+  /** Create a segment, this is done by the server
+   *
+   * An existing segment with the same name is replaced, the segment is removed when the returned object is destroyed
+   *
+   * \param name Name of the segment
+   *
+   * \param state_capacity Maximum size of a GUI state
+   *
+   * \throws If the segment cannot be created
+   */
+  static std::unique_ptr<GUISharedMemory> create(const std::string & name, size_t state_capacity);
+
+  /** Open an existing segment, this is done by the clients
+   *
+   * \param name Name of the segment
+   *
+   * \returns nullptr if the segment does not exist or has not been initialized by the server yet
+   */
+  static std::unique_ptr<GUISharedMemory> open(const std::string & name);
+
+  GUISharedMemory(const GUISharedMemory &) = delete;
+  GUISharedMemory & operator=(const GUISharedMemory &) = delete;
+
+  ~GUISharedMemory();
+
+  /** Name of the segment */
+  const std::string & name() const noexcept;
+
+  /** Maximum size of a GUI state */
+  size_t state_capacity() const noexcept;
+
+  /** Publish a new GUI state
+   *
+   * \returns False if the state is larger than \ref state_capacity(), it is not published then
+   */
+  bool write(const char * data, size_t size) noexcept;
+
+  /** Copy the latest GUI state if it is newer than the last read
+   *
+   * \param buffer Receives the state, it is resized if it is too small
+   *
+   * \param seq Sequence number of the last read state, 0 before the first read, it is updated on success
+   *
+   * \returns The size of the state or 0 if no new state was published or if no consistent state could be read
+   * within a few milliseconds (e.g. the server died while writing)
+   */
+  size_t read(std::vector<char> & buffer, uint64_t & seq) const;
+
+  /** Queue a request for the server
+   *
+   * \returns False if the request is larger than \ref request_capacity or the queue is full
+   */
+  bool push_request(const char * data, size_t size) noexcept;
+
+  /** Take the oldest request
+   *
+   * \param buffer Receives the request, it is resized if it is too small
+   *
+   * \returns False if the queue is empty
+   */
+  bool pop_request(std::vector<char> & buffer);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+
+  GUISharedMemory(std::unique_ptr<Impl> impl);
+};
+
+} // namespace mc_control
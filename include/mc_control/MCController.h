@@ -82,6 +82,12 @@ struct MC_CONTROL_DLLAPI ControllerParameters
    * overwrite_config is true and the configuration are loaded into the root
    */
   ADD_PARAMETER(std::vector<std::string>, extra_configurations, {})
+  /** Backend-specific solver options, see mc_solver::QPSolver::configure
+   *
+   * This is applied at construction, \ref MCGlobalController also applies the "QPSolver" section of the controller's
+   * configuration once the controller is created
+   */
+  ADD_PARAMETER(mc_rtc::Configuration, solver_configuration, {})
 
   /** For backward compatibility purpose */
   inline ControllerParameters(mc_solver::QPSolver::Backend backend) : backend_(backend) {}
@@ -9,7 +9,11 @@
 #include <mc_tasks/EndEffectorTask.h>
 #include <mc_tasks/PostureTask.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 namespace mc_control
 {
@@ -124,6 +128,12 @@ private:
   /** Teardown the idle state */
   void teardownIdleState();
 
+  /** Apply the changes in the states files between two iterations */
+  void reloadStatesFiles();
+
+  /** Stop the states files watcher thread */
+  void stopStatesFilesWatcher();
+
 protected:
   /** Creates a posture task for each actuated robots
    * (i.e. robot.dof() - robot.joint(0).dof() > 0 ) */
@@ -148,6 +158,14 @@ protected:
   bool first_reset_ = true;
   /** Main executor */
   Executor executor_;
+
+  /** Reads the states files changes outside of the control loop (enabled by ReloadStatesFiles) */
+  std::thread states_files_watcher_;
+  std::mutex states_files_watcher_mutex_;
+  std::condition_variable states_files_watcher_cv_;
+  bool states_files_watcher_stop_ = false;
+  /** Set by the watcher when changes are ready to be applied */
+  std::atomic<bool> states_files_changed_{false};
 };
 
 namespace details
@@ -7,6 +7,9 @@
 #include <mc_control/fsm/State.h>
 #include <mc_rtc/loader.h>
 
+#include <cstdint>
+#include <ctime>
+#include <mutex>
 #include <unordered_map>
 
 namespace mc_rtc
@@ -44,9 +47,33 @@ struct MC_CONTROL_FSM_DLLAPI StateFactory : public mc_rtc::ObjectLoader<State>
   /** Load more states libraries */
   void load_libraries(const std::vector<std::string> & paths);
 
-  /** Load more states files */
+  /** Load more states files
+   *
+   * The files and directories are watched by \ref read_files_changes
+   */
   void load_files(const std::vector<std::string> & files);
 
+  /** Read the states files that changed since they were loaded
+   *
+   * Only the files whose modification time or size changed are parsed again, the files added to the directories given
+   * to \ref load_files are read and the states of deleted files will be removed. The available states are not modified
+   * until \ref apply_files_changes is called so this can be called from a different thread.
+   *
+   * \returns True if some files changed
+   */
+  bool read_files_changes();
+
+  /** Apply the changes read by \ref read_files_changes
+   *
+   * States that were already created are not affected, the new configuration is used the next time a state is created.
+   *
+   * \returns The states that were added, modified or removed, including the states that inherit from them
+   */
+  std::vector<std::string> apply_files_changes();
+
+  /** Read and apply the changes in the states files */
+  std::vector<std::string> reload_files();
+
   /** Load from an mc_rtc::Configuration entry */
   void load(const std::map<std::string, mc_rtc::Configuration> & states);
 
@@ -144,9 +171,33 @@ private:
   /** Callback on state loading */
   void update(const std::string & cn);
 
+  /** Remove a state loaded from a file */
+  void unload(const std::string & state);
+
+  /** Content of a states file read by \ref read_files_changes */
+  struct FileChange
+  {
+    std::string path;
+    /** True if the file was deleted */
+    bool removed;
+    std::map<std::string, mc_rtc::Configuration> states;
+  };
+
 private:
   std::vector<std::string> states_;
   std::unordered_map<std::string, StateConfiguration> states_configurations_;
+
+  /** States defined by each loaded file */
+  std::unordered_map<std::string, std::vector<std::string>> files_states_;
+
+  /** Protects the members below which are used by \ref read_files_changes */
+  std::mutex files_mutex_;
+  /** Last write time and size of the loaded files, the size catches modifications within the time resolution */
+  std::unordered_map<std::string, std::pair<std::time_t, uintmax_t>> files_;
+  /** Directories given to \ref load_files */
+  std::vector<std::string> directories_;
+  /** Changes waiting for \ref apply_files_changes */
+  std::vector<FileChange> files_changes_;
 };
 
 } // namespace fsm
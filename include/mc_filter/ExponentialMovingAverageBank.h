@@ -0,0 +1,120 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_rtc/logging.h>
+
+#include <Eigen/Core>
+
+#include <cmath>
+
+namespace mc_filter
+{
+
+/** Bank of exponential moving averages
+ *
+ * This filters N scalar channels the same way N ExponentialMovingAverage<double> would, the channels are stored
+ * contiguously and updated together.
+ *
+ * Each channel has its own time constant. If the new value of a channel is NaN, the channel keeps its current value.
+ */
+struct ExponentialMovingAverageBank
+{
+  /** Constructor.
+   *
+   * \param dt Time in [s] between two readings.
+   *
+   * \param size Number of channels, all channels start at zero
+   *
+   * \param timeConstant Informally, length of the recent-past window, in [s].
+   */
+  ExponentialMovingAverageBank(double dt, Eigen::Index size, double timeConstant) : dt_(dt)
+  {
+    average_.setZero(size);
+    timeConstant_.resize(size);
+    alpha_.resize(size);
+    this->timeConstant(timeConstant);
+  }
+
+  /** Number of channels */
+  Eigen::Index size() const noexcept { return average_.size(); }
+
+  /** Append new readings to the series.
+   *
+   * \param value New values, its size must be size()
+   */
+  template<typename Derived>
+  void append(const Eigen::MatrixBase<Derived> & value)
+  {
+    average_.array() =
+        value.array().isNaN().select(average_.array(), average_.array() + alpha_ * (value.array() - average_.array()));
+    if(saturation_ > 0.) { average_ = average_.cwiseMax(-saturation_).cwiseMin(saturation_); }
+  }
+
+  /** Evaluate the smoothed statistic.
+   */
+  const Eigen::VectorXd & eval() const noexcept { return average_; }
+
+  /** Set output saturation; disable by providing a negative value.
+   *
+   * \param limit Output will saturate between -limit and +limit.
+   */
+  void saturation(double limit) noexcept { saturation_ = limit; }
+
+  /** Reset averages to provided values.
+   *
+   * \param initVal initial value of the averages
+   */
+  template<typename Derived>
+  void reset(const Eigen::MatrixBase<Derived> & initVal)
+  {
+    average_ = initVal;
+  }
+
+  /** Reset one channel */
+  void reset(Eigen::Index channel, double initVal) { average_(channel) = initVal; }
+
+  /** Get time constants of the filters.
+   */
+  const Eigen::ArrayXd & timeConstant() const noexcept { return timeConstant_; }
+
+  /** Update the time constant of all channels.
+   *
+   * \param T New time constant of the filters.
+   *
+   * \note T is explicitely enforced to respect the Nyquist–Shannon sampling theorem, that is T is at least 2*timestep.
+   */
+  void timeConstant(double T)
+  {
+    timeConstant_.setConstant(checkTimeConstant(T));
+    alpha_ = 1. - (-dt_ / timeConstant_).exp();
+  }
+
+  /** Update the time constant of a channel, see timeConstant(double) */
+  void timeConstant(Eigen::Index channel, double T)
+  {
+    timeConstant_(channel) = checkTimeConstant(T);
+    alpha_(channel) = 1. - std::exp(-dt_ / timeConstant_(channel));
+  }
+
+protected:
+  Eigen::VectorXd average_;
+  Eigen::ArrayXd alpha_;
+  double dt_;
+  Eigen::ArrayXd timeConstant_;
+  double saturation_ = -1.;
+
+  double checkTimeConstant(double T) const
+  {
+    if(T < 2 * dt_)
+    {
+      mc_rtc::log::warning("Time constant must be at least twice the timestep (Nyquist–Shannon sampling theorem)");
+      return 2 * dt_;
+    }
+    return T;
+  }
+};
+
+} // namespace mc_filter
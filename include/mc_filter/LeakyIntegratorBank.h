@@ -0,0 +1,84 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+
+namespace mc_filter
+{
+
+/** Bank of leaky integrators
+ *
+ * This integrates N scalar channels the same way N LeakyIntegrator<double> would, the channels are stored
+ * contiguously and updated together.
+ *
+ * Each channel has its own leak rate. If the input of a channel is NaN, the channel keeps its current value.
+ */
+struct LeakyIntegratorBank
+{
+  /** Constructor
+   *
+   * \param size Number of channels, all channels start at zero with a 0.1 leak rate
+   */
+  LeakyIntegratorBank(Eigen::Index size)
+  {
+    integral_.setZero(size);
+    rate_.setConstant(size, 0.1);
+  }
+
+  /** Number of channels */
+  Eigen::Index size() const noexcept { return integral_.size(); }
+
+  /** Add constant inputs for a fixed duration.
+   *
+   * \param value Constant inputs, its size must be size()
+   *
+   * \param dt Fixed duration.
+   */
+  template<typename Derived>
+  void add(const Eigen::MatrixBase<Derived> & value, double dt)
+  {
+    integral_.array() = value.array().isNaN().select(integral_.array(),
+                                                      (1. - rate_ * dt) * integral_.array() + dt * value.array());
+    if(saturation_ > 0.) { integral_ = integral_.cwiseMax(-saturation_).cwiseMin(saturation_); }
+  }
+
+  /** Evaluate the output of the integrators.
+   */
+  const Eigen::VectorXd & eval() const noexcept { return integral_; }
+
+  /** Get leak rates.
+   */
+  const Eigen::ArrayXd & rate() const noexcept { return rate_; }
+
+  /** Set the leak rate of all integrators.
+   *
+   * \param rate New leak rate.
+   */
+  void rate(double rate) { rate_.setConstant(rate); }
+
+  /** Set the leak rate of one integrator */
+  void rate(Eigen::Index channel, double rate) { rate_(channel) = rate; }
+
+  /** Set output saturation. Disable by providing a negative value.
+   *
+   * \param s Output will saturate between -s and +s.
+   */
+  void saturation(double s) noexcept { saturation_ = s; }
+
+  /** Reset integrals to zero.
+   */
+  void reset() { integral_.setZero(); }
+
+  /** Reset one integral to zero */
+  void reset(Eigen::Index channel) { integral_(channel) = 0; }
+
+private:
+  Eigen::VectorXd integral_;
+  Eigen::ArrayXd rate_;
+  double saturation_ = -1.;
+};
+
+} // namespace mc_filter
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_rtc/logging.h>
+
+#include <Eigen/Core>
+
+namespace mc_filter
+{
+
+/** Bank of low-pass filters
+ *
+ * This filters N scalar channels the same way N LowPass<double> would, the channels are stored contiguously and
+ * updated together.
+ *
+ * Each channel has its own cutoff period. If the new value of a channel is NaN, the channel keeps its current value.
+ */
+struct LowPassBank
+{
+  /** Constructor with cutoff period.
+   *
+   * \param dt Sampling period.
+   *
+   * \param size Number of channels, all channels start at zero
+   *
+   * \param period Cutoff period of all channels.
+   *
+   */
+  LowPassBank(double dt, Eigen::Index size, double period = 0) : dt_(dt)
+  {
+    resize(size);
+    cutoffPeriod_.setConstant(period);
+    updateAlpha();
+  }
+
+  /** Number of channels */
+  Eigen::Index size() const noexcept { return eval_.size(); }
+
+  /** Change the number of channels
+   *
+   * Existing channels keep their value and cutoff period, new channels start at zero with a null cutoff period
+   */
+  void resize(Eigen::Index size)
+  {
+    auto prev = eval_.size();
+    eval_.conservativeResize(size);
+    cutoffPeriod_.conservativeResize(size);
+    alpha_.conservativeResize(size);
+    if(size > prev)
+    {
+      eval_.tail(size - prev).setZero();
+      cutoffPeriod_.tail(size - prev).setZero();
+      alpha_.tail(size - prev).setOnes();
+    }
+  }
+
+  /** Get cutoff periods. */
+  const Eigen::ArrayXd & cutoffPeriod() const noexcept { return cutoffPeriod_; }
+
+  /** Set the cutoff period of all channels.
+   *
+   * \param period New cutoff period.
+   *
+   * \note period is explicitely enforced to respect the Nyquist–Shannon sampling theorem, that is T is at least
+   * 2*timestep.
+   */
+  void cutoffPeriod(double period)
+  {
+    cutoffPeriod_.setConstant(checkPeriod(period));
+    updateAlpha();
+  }
+
+  /** Set the cutoff period of a channel, see cutoffPeriod(double) */
+  void cutoffPeriod(Eigen::Index channel, double period)
+  {
+    cutoffPeriod_(channel) = checkPeriod(period);
+    updateAlpha();
+  }
+
+  /** Reset all channels.
+   *
+   * \param value New value of the channels, its size must be size()
+   *
+   */
+  template<typename Derived>
+  void reset(const Eigen::MatrixBase<Derived> & value)
+  {
+    eval_ = value;
+  }
+
+  /** Reset one channel */
+  void reset(Eigen::Index channel, double value) { eval_(channel) = value; }
+
+  /** Update the filters from new values.
+   *
+   * \param newValue New observed values, its size must be size()
+   *
+   */
+  template<typename Derived>
+  void update(const Eigen::MatrixBase<Derived> & newValue)
+  {
+    eval_.array() =
+        newValue.array().isNaN().select(eval_.array(), alpha_ * newValue.array() + (1. - alpha_) * eval_.array());
+  }
+
+  /** Get filtered values.
+   *
+   */
+  const Eigen::VectorXd & eval() const noexcept { return eval_; }
+
+  /** Get sampling period.
+   *
+   */
+  double dt() const noexcept { return dt_; }
+
+  /** Set sampling period.
+   *
+   * \param dt Sampling period.
+   *
+   * \note the cutoff periods are updated to satisfy the Nyquist–Shannon sampling theorem according the new sampling
+   * period.
+   */
+  void dt(double dt)
+  {
+    dt_ = dt;
+    if((cutoffPeriod_ < 2 * dt_).any())
+    {
+      mc_rtc::log::warning("Time constant must be at least twice the timestep (Nyquist–Shannon sampling theorem)");
+      cutoffPeriod_ = cutoffPeriod_.max(2 * dt_);
+    }
+    updateAlpha();
+  }
+
+private:
+  Eigen::VectorXd eval_;
+  Eigen::ArrayXd cutoffPeriod_;
+  /** Weight of the new value of each channel */
+  Eigen::ArrayXd alpha_;
+
+  double checkPeriod(double period) const
+  {
+    if(period < 2 * dt_)
+    {
+      mc_rtc::log::warning("Time constant must be at least twice the timestep (Nyquist–Shannon sampling theorem)");
+      return 2 * dt_;
+    }
+    return period;
+  }
+
+  void updateAlpha() { alpha_ = (cutoffPeriod_ <= dt_).select(1., dt_ / cutoffPeriod_); }
+
+protected:
+  double dt_ = 0.005; // [s]
+};
+
+} // namespace mc_filter
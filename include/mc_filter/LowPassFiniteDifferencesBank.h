@@ -0,0 +1,97 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_filter/LowPassBank.h>
+
+namespace mc_filter
+{
+
+/** Bank of low-pass velocity filters from series of position measurements.
+ *
+ * This filters N scalar channels the same way N LowPassFiniteDifferences<double> would, see LowPassBank
+ *
+ * If the new position of a channel is NaN, the channel keeps its previous position and velocity. The first valid
+ * position after such a gap is differentiated over the whole gap.
+ */
+struct LowPassFiniteDifferencesBank : public LowPassBank
+{
+  /** Constructor with cutoff period.
+   *
+   * \param dt Sampling period.
+   *
+   * \param size Number of channels, all channels start at rest at zero
+   *
+   * \param period Cutoff period of all channels, with a null period this computes the finite differences
+   *
+   */
+  LowPassFiniteDifferencesBank(double dt, Eigen::Index size, double period = 0) : LowPassBank(dt, size, period)
+  {
+    prevValue_.setZero(size);
+    elapsed_.setOnes(size);
+  }
+
+  /** Change the number of channels, see LowPassBank::resize */
+  void resize(Eigen::Index size)
+  {
+    auto prev = prevValue_.size();
+    LowPassBank::resize(size);
+    prevValue_.conservativeResize(size);
+    elapsed_.conservativeResize(size);
+    if(size > prev)
+    {
+      prevValue_.tail(size - prev).setZero();
+      elapsed_.tail(size - prev).setOnes();
+    }
+  }
+
+  /** Reset filter to initial rest value.
+   *
+   * \param pos Initial position.
+   * \param vel Initial velocity.
+   */
+  template<typename DerivedP, typename DerivedV>
+  void reset(const Eigen::MatrixBase<DerivedP> & pos, const Eigen::MatrixBase<DerivedV> & vel)
+  {
+    LowPassBank::reset(vel);
+    prevValue_ = pos;
+    elapsed_.setOnes();
+  }
+
+  /** Reset one channel */
+  void reset(Eigen::Index channel, double pos, double vel)
+  {
+    LowPassBank::reset(channel, vel);
+    prevValue_(channel) = pos;
+    elapsed_(channel) = 1;
+  }
+
+  /** Update velocity estimate from new position value.
+   *
+   * \param newPos New observed position.
+   *
+   */
+  template<typename Derived>
+  void update(const Eigen::MatrixBase<Derived> & newPos)
+  {
+    // A NaN position yields a NaN difference so the velocity of that channel is held as well
+    LowPassBank::update(((newPos - prevValue_).array() / (dt_ * elapsed_)).matrix());
+    prevValue_.array() = newPos.array().isNaN().select(prevValue_.array(), newPos.array());
+    elapsed_ = newPos.array().isNaN().select(elapsed_ + 1, 1.);
+  }
+
+  const Eigen::VectorXd & prevValue() const noexcept { return prevValue_; }
+
+protected:
+  Eigen::VectorXd prevValue_;
+  /** Number of samples since the last valid position of each channel */
+  Eigen::ArrayXd elapsed_;
+
+private:
+  // Prevent calling the single-argument reset from LowPassBank
+  using LowPassBank::reset;
+};
+
+} // namespace mc_filter
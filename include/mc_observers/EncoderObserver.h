@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mc_filter/LowPassFiniteDifferencesBank.h>
 #include <mc_observers/Observer.h>
 #include <mc_observers/api.h>
 #include <mc_rbdyn/Robot.h>
@@ -46,7 +47,7 @@ struct MC_OBSERVER_DLLAPI EncoderObserver : public Observer
   /*! \brief Computes encoder velocity if necessary:
    *
    * - If VelUpdate::EncoderFiniteDifferences, computes velocity from finite
-   *   differences of encoder position
+   *   differences of encoder position, low-pass filtered if velocityCutoffPeriod is set
    **/
   bool run(const mc_control::MCController & ctl) override;
 
@@ -87,8 +88,12 @@ protected:
   std::string robot_ = ""; ///< Robot estimated by this observer
   std::string updateRobot_ = ""; ///< Robot to update (defaults to robot_)
 
-  std::vector<double> prevEncoders_; ///< Previous encoder values (for VelUpdate::EncoderFiniteDifferences)
+  /** Velocity filter of all joints (for VelUpdate::EncoderFiniteDifferences) */
+  mc_filter::LowPassFiniteDifferencesBank velocityFilter_{0.005, 0};
+  /** Cutoff period of the velocity filter, 0 computes plain finite differences */
+  double velocityCutoffPeriod_ = 0;
   std::vector<double> encodersVelocity_; ///< Estimated encoder velocity
+  mc_rbdyn::FlatParamMap jointsMap_; ///< Maps the updated 1-dof joints between refJointOrder and the mbc
 
   bool logPosition_ = false;
   bool logVelocity_ = true;
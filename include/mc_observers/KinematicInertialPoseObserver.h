@@ -10,6 +10,7 @@
 #include <mc_observers/Observer.h>
 #include <mc_observers/api.h>
 #include <mc_rbdyn/Robot.h>
+#include <mc_rtc/DataStore.h>
 
 #include <SpaceVecAlg/SpaceVecAlg>
 
@@ -107,6 +108,8 @@ protected:
   std::string imuSensor_; /**< BodySensor containting IMU readings */
 
   std::string anchorFrameFunction_ = ""; ///< Name of datastore entry for the anchor frame function
+  using AnchorFrameFunction = std::function<sva::PTransformd(const mc_rbdyn::Robot &)>;
+  mc_rtc::DataHandle<const AnchorFrameFunction> anchorFrameHandle_; ///< Resolved anchor frame function
   sva::PTransformd X_0_anchorFrame_ =
       sva::PTransformd::Identity(); ///< Control anchor frame (provided through the datastore)
   sva::PTransformd X_0_anchorFrameReal_ =
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+#include <mc_planning/api.h>
+
+#include <Eigen/Core>
+
+#include <memory>
+
+namespace mc_planning
+{
+
+/** Gains of the ZMP preview controller
+ *
+ * They only depend on the sampling period, the CoM height, the preview horizon and the cost weights. Use
+ * ZMPPreviewGains::get to share them between controllers.
+ */
+struct MC_PLANNING_DLLAPI ZMPPreviewGains
+{
+  /** Compute the gains
+   *
+   * \param dt Sampling period [s]
+   *
+   * \param height CoM height above the ZMP plane [m]
+   *
+   * \param horizon Number of previewed samples
+   *
+   * \param zmpWeight Weight of the ZMP tracking error
+   *
+   * \param jerkWeight Weight of the CoM jerk
+   *
+   * \throws std::runtime_error if the parameters are not strictly positive or the Riccati equation does not converge
+   */
+  ZMPPreviewGains(double dt, double height, Eigen::Index horizon, double zmpWeight, double jerkWeight);
+
+  /** Returns the gains for the given parameters, they are computed on the first call and cached afterwards */
+  static std::shared_ptr<const ZMPPreviewGains> get(double dt,
+                                                   double height,
+                                                   Eigen::Index horizon,
+                                                   double zmpWeight = 1.0,
+                                                   double jerkWeight = 1e-6);
+
+  double dt;
+  double height;
+  /** State transition of the cart-table model, the state is (CoM, CoM velocity, CoM acceleration) */
+  Eigen::Matrix3d A;
+  /** Jerk input of the cart-table model */
+  Eigen::Vector3d B;
+  /** ZMP output of the cart-table model */
+  Eigen::RowVector3d C;
+  /** State feedback gain */
+  Eigen::RowVector3d K;
+  /** Preview gains, F(j) applies to the ZMP reference j + 1 samples ahead */
+  Eigen::VectorXd F;
+  /** FTail(j) is the sum of F(j) to F(horizon - 1), used to hold the last reference */
+  Eigen::VectorXd FTail;
+};
+
+/** Generates CoM and ZMP references for a ZMP reference trajectory using preview control
+ *
+ * This implements the preview control of the cart-table model (Kajita et al., ICRA 2003) on both horizontal axes. The
+ * gains are computed once per set of parameters (see ZMPPreviewGains::get) and each update() costs O(horizon) without
+ * allocating memory.
+ *
+ * The ZMP reference is stored in a fixed-size ring buffer: push() appends samples at the end of the previewed
+ * trajectory and update() consumes one sample. When fewer samples than the horizon are available the last reference
+ * is held over the rest of the horizon.
+ *
+ * The outputs are meant to be given to mc_tasks::lipm_stabilizer::StabilizerTask::target:
+ * \code{.cpp}
+ * preview.update();
+ * stabilizer->target(preview.com(), preview.comd(), preview.comdd(), preview.zmp(), preview.zmpd());
+ * \endcode
+ */
+struct MC_PLANNING_DLLAPI ZMPPreviewController
+{
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /** Constructor
+   *
+   * \param dt Sampling period [s]
+   *
+   * \param height CoM height above the ZMP plane [m]
+   *
+   * \param horizon Preview duration [s], rounded to the nearest number of samples
+   *
+   * \param capacity Maximum number of queued ZMP reference samples, defaults to twice the number of previewed samples
+   */
+  ZMPPreviewController(double dt, double height, double horizon, Eigen::Index capacity = 0);
+
+  /** Reset the CoM state and clear the reference buffer
+   *
+   * The ZMP reference is held at the ZMP of the given state until new samples are pushed.
+   *
+   * \param com CoM position, the ZMP plane is height below it
+   *
+   * \param comd CoM velocity
+   *
+   * \param comdd CoM acceleration
+   */
+  void reset(const Eigen::Vector3d & com,
+             const Eigen::Vector3d & comd = Eigen::Vector3d::Zero(),
+             const Eigen::Vector3d & comdd = Eigen::Vector3d::Zero());
+
+  /** Append a ZMP reference sample
+   *
+   * \returns False if the buffer is full
+   */
+  bool push(const Eigen::Vector2d & zmp);
+
+  /** Append a constant ZMP reference for a given duration, e.g. the single support phase of a footstep
+   *
+   * \returns The number of samples that were appended, this is less than the duration when the buffer is full
+   *
+   * \throws std::invalid_argument if \p duration is negative or NaN
+   */
+  Eigen::Index push(const Eigen::Vector2d & zmp, double duration);
+
+  /** Number of queued reference samples */
+  Eigen::Index size() const noexcept { return size_; }
+
+  /** Maximum number of queued reference samples */
+  Eigen::Index capacity() const noexcept { return refs_.cols(); }
+
+  /** Number of previewed samples */
+  Eigen::Index horizon() const noexcept { return gains_->F.size(); }
+
+  /** Advance by one sampling period, consuming one reference sample */
+  void update();
+
+  /** CoM position */
+  Eigen::Vector3d com() const noexcept { return {x_(0, 0), x_(0, 1), zmpHeight_ + gains_->height}; }
+
+  /** CoM velocity */
+  Eigen::Vector3d comd() const noexcept { return {x_(1, 0), x_(1, 1), 0}; }
+
+  /** CoM acceleration */
+  Eigen::Vector3d comdd() const noexcept { return {x_(2, 0), x_(2, 1), 0}; }
+
+  /** ZMP of the cart-table model */
+  Eigen::Vector3d zmp() const noexcept;
+
+  /** ZMP velocity of the cart-table model */
+  Eigen::Vector3d zmpd() const noexcept;
+
+  /** ZMP reference of the last update */
+  const Eigen::Vector2d & zmpRef() const noexcept { return zmpRef_; }
+
+  /** Gains used by this controller */
+  const ZMPPreviewGains & gains() const noexcept { return *gains_; }
+
+private:
+  std::shared_ptr<const ZMPPreviewGains> gains_;
+  /** State on both axes, each column is (CoM, CoM velocity, CoM acceleration) */
+  Eigen::Matrix<double, 3, 2> x_ = Eigen::Matrix<double, 3, 2>::Zero();
+  /** CoM jerk of the last update */
+  Eigen::RowVector2d u_ = Eigen::RowVector2d::Zero();
+  double zmpHeight_ = 0;
+  /** Ring buffer of ZMP references */
+  Eigen::Matrix2Xd refs_;
+  Eigen::Index head_ = 0;
+  Eigen::Index size_ = 0;
+  /** Reference held when the buffer runs out */
+  Eigen::Vector2d zmpRef_ = Eigen::Vector2d::Zero();
+
+  /** Column of the i-th queued reference in refs_ */
+  Eigen::Index index(Eigen::Index i) const noexcept
+  {
+    auto idx = head_ + i;
+    return idx < refs_.cols() ? idx : idx - refs_.cols();
+  }
+};
+
+} // namespace mc_planning
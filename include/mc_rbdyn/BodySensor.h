@@ -52,6 +52,7 @@ struct MC_RBDYN_DLLAPI BodySensor : public Device
     name_ = bs.name_;
     parent_ = bs.parent_;
     X_p_s_ = bs.X_p_s_;
+    generation_ = bs.generation_;
     position_ = bs.position_;
     orientation_ = bs.orientation_;
     linear_velocity_ = bs.linear_velocity_;
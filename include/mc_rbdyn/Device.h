@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <mc_rbdyn/Generation.h>
 #include <mc_rbdyn/api.h>
 
 #include <SpaceVecAlg/SpaceVecAlg>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -55,7 +57,11 @@ struct MC_RBDYN_DLLAPI Device
   inline const std::string & parent() const { return parent_; }
 
   /** Change the parent body of the sensor */
-  inline void parent(const std::string & p) { parent_ = p; }
+  inline void parent(const std::string & p)
+  {
+    parent_ = p;
+    generation_ = nextGeneration();
+  }
 
   /** Returns the transformation from the parent body to the device */
   inline const sva::PTransformd & X_p_d() const { return X_p_s_; }
@@ -64,10 +70,14 @@ struct MC_RBDYN_DLLAPI Device
   inline const sva::PTransformd & X_p_s() const { return X_p_s_; }
 
   /** Change the parent to device transformation */
-  inline void X_p_d(const sva::PTransformd & pt) { X_p_s_ = pt; }
+  inline void X_p_d(const sva::PTransformd & pt) { X_p_s(pt); }
 
   /** Change the parent to sensor transformation */
-  inline void X_p_s(const sva::PTransformd & pt) { X_p_s_ = pt; }
+  inline void X_p_s(const sva::PTransformd & pt)
+  {
+    X_p_s_ = pt;
+    generation_ = nextGeneration();
+  }
 
   /** Returns the deviec position in the inertial frame (convenience function) */
   inline sva::PTransformd X_0_d(const mc_rbdyn::Robot & robot) const { return X_0_s(robot); }
@@ -75,6 +85,13 @@ struct MC_RBDYN_DLLAPI Device
   /** Returns the sensor position in the inertial frame (convenience function) */
   sva::PTransformd X_0_s(const mc_rbdyn::Robot & robot) const;
 
+  /** Identifies the configuration of the device
+   *
+   * This changes every time the parent or the transformation of the device change, derived devices also change it
+   * when their own configuration changes. Two devices never share a generation unless one is a copy of the other.
+   */
+  inline uint64_t generation() const noexcept { return generation_; }
+
   /** Perform a device copy */
   virtual DevicePtr clone() const = 0;
 
@@ -87,6 +104,11 @@ protected:
   std::string parent_;
   /** Transformation from the parent body frame to the sensor frame */
   sva::PTransformd X_p_s_;
+  /** See \ref generation, derived classes modifying the members above directly must update it */
+  uint64_t generation_ = nextGeneration();
+
+  /** Returns a new unique generation */
+  static uint64_t nextGeneration() noexcept;
 };
 
 } // namespace mc_rbdyn
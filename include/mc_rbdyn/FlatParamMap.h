@@ -0,0 +1,110 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_rbdyn/api.h>
+
+#include <RBDyn/MultiBody.h>
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace mc_rbdyn
+{
+
+/** Precomputed mapping between a joint-wise parameter (rbd::MultiBodyConfig::q, alpha, alphaD, jointTorque) and a
+ * flat vector
+ *
+ * The mapping is computed once for a given rbd::MultiBody so that copies between the joint-wise storage and a
+ * contiguous vector do not need to inspect the joints' structure. Single-dof joints, which make the bulk of a
+ * robot, are handled by a tight index loop and multi-dof joints by block copies.
+ *
+ * Entries of the joint-wise parameter or of the flat vector that are not part of the mapping are never accessed.
+ */
+struct MC_RBDYN_DLLAPI FlatParamMap
+{
+  using param_t = std::vector<std::vector<double>>;
+
+  /** Empty mapping */
+  FlatParamMap() = default;
+
+  /** Mapping with the same layout as rbd::paramToVector(mb, mbc.q) */
+  static FlatParamMap params(const rbd::MultiBody & mb);
+
+  /** Mapping with the same layout as rbd::paramToVector(mb, mbc.alpha) (also alphaD and jointTorque) */
+  static FlatParamMap dofs(const rbd::MultiBody & mb);
+
+  /** Mapping from a reference joint order to the first parameter of each joint
+   *
+   * \param mb MultiBody of the robot
+   *
+   * \param refJointIndexToMBCIndex For each joint in the reference order, the joint index in \p mb or -1 if the joint
+   * is not part of \p mb (see mc_rbdyn::Robot::jointIndexInMBC)
+   *
+   * \param singleDofOnly If true, only 1-dof joints are mapped
+   */
+  static FlatParamMap refJointOrder(const rbd::MultiBody & mb,
+                                    const std::vector<int> & refJointIndexToMBCIndex,
+                                    bool singleDofOnly = false);
+
+  /** Size of the flat vector */
+  inline size_t size() const noexcept { return size_; }
+
+  /** Copy mapped entries from \p param to \p out
+   *
+   * \p out must have at least size() elements
+   */
+  void gather(const param_t & param, double * out) const noexcept;
+
+  /** Copy mapped entries from \p param to \p out */
+  inline void gather(const param_t & param, Eigen::Ref<Eigen::VectorXd> out) const noexcept
+  {
+    gather(param, out.data());
+  }
+
+  /** Copy mapped entries from \p param to \p out */
+  inline void gather(const param_t & param, std::vector<double> & out) const noexcept { gather(param, out.data()); }
+
+  /** Copy mapped entries from \p in to \p param
+   *
+   * \p in must have at least size() elements
+   */
+  void scatter(const double * in, param_t & param) const noexcept;
+
+  /** Copy mapped entries from \p in to \p param */
+  inline void scatter(const Eigen::Ref<const Eigen::VectorXd> & in, param_t & param) const noexcept
+  {
+    scatter(in.data(), param);
+  }
+
+  /** Copy mapped entries from \p in to \p param */
+  inline void scatter(const std::vector<double> & in, param_t & param) const noexcept { scatter(in.data(), param); }
+
+  /** Copy the mapped entries of \p in into \p out, both have the same joint-wise structure */
+  void copy(const param_t & in, param_t & out) const noexcept;
+
+private:
+  /** Maps param[joint][0] and flat[offset] */
+  struct Scalar
+  {
+    unsigned int joint;
+    unsigned int offset;
+  };
+  /** Maps param[joint][0...size] and flat[offset...offset+size] */
+  struct Segment
+  {
+    unsigned int joint;
+    unsigned int offset;
+    unsigned int size;
+  };
+  std::vector<Scalar> scalars_;
+  std::vector<Segment> segments_;
+  size_t size_ = 0;
+
+  static FlatParamMap fromJoints(const rbd::MultiBody & mb, bool params);
+};
+
+} // namespace mc_rbdyn
@@ -7,11 +7,90 @@
 #include <mc_rbdyn/Device.h>
 #include <mc_rbdyn/ForceSensorCalibData.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace mc_rbdyn
 {
 
 struct Robot;
 
+namespace detail
+{
+
+/** Quantities derived from a force sensor reading for a given robot
+ *
+ * These are computed once by \ref Robot for a given state of the sensor and of
+ * the robot's kinematics and re-used until either change
+ *
+ * The values are only written while \ref key does not match the current
+ * state, readers that find a matching key can use them without locking
+ */
+struct ForceSensorCache
+{
+  /** State the values were computed for (see Robot::forceSensorGeneration), 0 if never computed */
+  std::atomic<uint64_t> key{0};
+  /** Generation of the sensor configuration \ref parentIndex was computed for */
+  uint64_t generation = 0;
+  /** Index of the sensor's parent body */
+  unsigned int parentIndex = 0;
+  /** \ref ForceSensor::wrenchWithoutGravity */
+  sva::ForceVecd wrenchWithoutGravity = sva::ForceVecd(Eigen::Vector6d::Zero());
+  /** \ref ForceSensor::worldWrench */
+  sva::ForceVecd worldWrench = sva::ForceVecd(Eigen::Vector6d::Zero());
+  /** \ref ForceSensor::worldWrenchWithoutGravity */
+  sva::ForceVecd worldWrenchWithoutGravity = sva::ForceVecd(Eigen::Vector6d::Zero());
+};
+
+/** Net wrench of a set of force sensors and, if \ref hasZmp is true, the ZMP it yields on a given plane
+ *
+ * Follows the same rules as \ref ForceSensorCache
+ */
+struct NetWrenchCache
+{
+  /** State of all the robot's force sensors the values were computed for, 0 if never computed */
+  std::atomic<uint64_t> key{0};
+  /** Sensors summed in \ref wrench */
+  std::vector<std::string> sensors;
+  /** \ref Robot::netWrench */
+  sva::ForceVecd wrench = sva::ForceVecd(Eigen::Vector6d::Zero());
+  /** True if the entry holds a ZMP computation */
+  bool hasZmp = false;
+  /** Parameters of the ZMP computation */
+  Eigen::Vector3d plane_p = Eigen::Vector3d::Zero();
+  Eigen::Vector3d plane_n = Eigen::Vector3d::Zero();
+  double minimalNetNormalForce = 0;
+  /** Result of the ZMP computation, \ref zmp is only meaningful if \ref zmpValid is true */
+  bool zmpValid = false;
+  Eigen::Vector3d zmp = Eigen::Vector3d::Zero();
+};
+
+/** Cached quantities of all the force sensors of a robot */
+struct ForceSensorsCache
+{
+  /** Serializes the computation of the cached values */
+  std::mutex mutex;
+  /** One entry per sensor, indexed like RobotData::forceSensors */
+  std::unique_ptr<ForceSensorCache[]> entries;
+  /** Number of entries */
+  size_t size = 0;
+  /** Net wrenches and ZMP computed for the current state, an entry is only replaced once it is outdated */
+  std::array<NetWrenchCache, 8> netWrenches;
+
+  /** Discard all entries and make room for \p n sensors, must not be called while the cache is used */
+  inline void resize(size_t n)
+  {
+    entries.reset(new ForceSensorCache[n]);
+    size = n;
+  }
+};
+
+} // namespace detail
+
 /** This struct is intended to hold static information about a force sensor
  * and the current reading of said sensor. If the appropriate data is
  * provided, a gravity-free reading can be provided.
@@ -74,9 +153,23 @@ public:
    *
    * @param wrench New wrench reading
    */
-  inline void wrench(const sva::ForceVecd & wrench) { wrench_ = wrench; }
+  inline void wrench(const sva::ForceVecd & wrench)
+  {
+    wrench_ = wrench;
+    wrenchGeneration_ = nextGeneration();
+  }
+
+  /** Identifies the sensor reading, this changes every time \ref wrench is set
+   *
+   * \see Device::generation
+   */
+  inline uint64_t wrenchGeneration() const noexcept { return wrenchGeneration_; }
 
   /** Return a gravity-free wrench in sensor frame
+   *
+   * When the sensor belongs to \p robot the result is cached by the robot
+   * until the sensor reading or the parent body pose change. This applies to
+   * \ref worldWrench and \ref worldWrenchWithoutGravity as well.
    *
    * @param robot Robot that the sensor belongs to
    *
@@ -161,6 +254,8 @@ public:
 
 private:
   sva::ForceVecd wrench_;
+  /** See \ref wrenchGeneration, copies take a new value */
+  uint64_t wrenchGeneration_ = nextGeneration();
 
   detail::ForceSensorCalibData calibration_;
 };
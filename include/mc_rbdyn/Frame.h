@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mc_rbdyn/Generation.h>
 #include <mc_rbdyn/api.h>
 #include <mc_rbdyn/fwd.h>
 #include <mc_rbdyn/hat.h>
@@ -101,6 +102,7 @@ public:
   inline Frame & position(sva::PTransformd pos) noexcept
   {
     position_ = pos;
+    generation_ = nextGeneration();
     return *this;
   }
 
@@ -136,6 +138,8 @@ protected:
   FramePtr parent_ = nullptr;
   /** Absolute position for a frame with no parent, relative position otherwise */
   sva::PTransformd position_ = sva::PTransformd::Identity();
+  /** Changes every time position_ is set, see mc_rbdyn::nextGeneration */
+  uint64_t generation_ = nextGeneration();
   /** Absolute velocity for a frame with no parent, unused otherwise */
   sva::MotionVecd velocity_ = sva::MotionVecd::Zero();
   /** TVM frame associated to this mc_rbdyn Frame
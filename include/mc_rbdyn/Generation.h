@@ -0,0 +1,21 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_rbdyn/api.h>
+
+#include <cstdint>
+
+namespace mc_rbdyn
+{
+
+/** Returns a new value of a process-wide counter
+ *
+ * Robots, devices and frames take a new generation when their state changes. Since every new value is larger than the
+ * previous ones, the largest generation of several objects changes whenever one of them changes.
+ */
+MC_RBDYN_DLLAPI uint64_t nextGeneration() noexcept;
+
+} // namespace mc_rbdyn
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mc_rbdyn/FlatParamMap.h>
 #include <mc_rbdyn/RobotData.h>
 #include <mc_rbdyn/RobotFrame.h>
 #include <mc_rbdyn/RobotModule.h>
@@ -17,6 +18,7 @@
 #include <RBDyn/MultiBodyConfig.h>
 #include <RBDyn/MultiBodyGraph.h>
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -63,6 +65,7 @@ struct MC_RBDYN_DLLAPI Robot
 {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   friend struct Robots;
+  friend struct ForceSensor;
 
 public:
   using convex_pair_t = std::pair<std::string, S_ObjectPtr>;
@@ -268,6 +271,19 @@ public:
    */
   int jointIndexInMBC(size_t jointIndex) const;
 
+  /** Flat mapping of joint-wise parameters (q) with the layout of rbd::paramToVector */
+  inline const FlatParamMap & paramMap() const noexcept { return paramMap_; }
+
+  /** Flat mapping of joint-wise dofs (alpha, alphaD, jointTorque) with the layout of rbd::dofToVector */
+  inline const FlatParamMap & dofMap() const noexcept { return dofMap_; }
+
+  /** Flat mapping between the first parameter of each joint and refJointOrder
+   *
+   * Entries of the flat vector that correspond to joints that are not in the mbc (see jointIndexInMBC) are not
+   * touched by this mapping
+   */
+  inline const FlatParamMap & refJointOrderMap() const noexcept { return refJointOrderMap_; }
+
   /** Returns the body index of joint named \name
    *
    * \throws If the body does not exist within the robot.
@@ -284,7 +300,16 @@ public:
   /** Access MultiBodyConfig of the robot's mb() (const) */
   const rbd::MultiBodyConfig & mbc() const;
 
-  /** Access MultiBodyGraph that generated the robot's mb() */
+  /** Access MultiBodyGraph that generated the robot's mb()
+   *
+   * The graph is shared with the copies of this robot (e.g. real and output
+   * robots), non-const access is treated as a modification and creates a
+   * private copy if it is shared. Use the const overload to read the graph.
+   *
+   * \note Sharing is detected with the shared pointer's use count, non-const
+   * access must not happen while this robot is copied or its copies access
+   * their graph from another thread
+   */
   rbd::MultiBodyGraph & mbg();
   /** Access MultiBodyGraph that generated the robot's mb() (const) */
   const rbd::MultiBodyGraph & mbg() const;
@@ -819,6 +844,26 @@ public:
   /** Returns all force sensors (const) */
   inline const std::vector<ForceSensor> & forceSensors() const noexcept { return data_->forceSensors; }
 
+  /** Bring the derived quantities of all force sensors up-to-date
+   *
+   * The quantities derived from the force sensors (wrenches, CoP, net
+   * wrench and ZMP) are cached until the sensors or the robot's kinematics
+   * change (see \ref forceSensorGeneration). Up-to-date values are read
+   * without locking from multiple threads but the first query after a change
+   * computes them, calling this beforehand avoids redundant computations
+   */
+  void refreshForceSensorsCache() const;
+
+  /** Identifies the state the quantities derived from \p fs depend on
+   *
+   * This changes when the sensor configuration (Device::generation), its reading (ForceSensor::wrenchGeneration) or
+   * the robot's kinematics (\ref kinematicsGeneration) change
+   */
+  inline uint64_t forceSensorGeneration(const ForceSensor & fs) const noexcept
+  {
+    return std::max({kinematicsGeneration_, fs.generation(), fs.wrenchGeneration()});
+  }
+
   /** @} */
   /* End of Force sensors group */
 
@@ -1006,11 +1051,26 @@ public:
   /** Access the robot's index in robots() */
   unsigned int robotIndex() const;
 
-  /** Apply forward kinematics to the robot */
+  /** Apply forward kinematics to the robot
+   *
+   * This changes \ref kinematicsGeneration
+   */
   void forwardKinematics();
-  /** Apply forward kinematics to \p mbc using the robot's mb() */
+  /** Apply forward kinematics to \p mbc using the robot's mb()
+   *
+   * This changes \ref kinematicsGeneration if \p mbc is the robot's mbc()
+   */
   void forwardKinematics(rbd::MultiBodyConfig & mbc) const;
 
+  /** Identifies the robot's kinematic state, this changes every time forwardKinematics() is applied to the robot
+   *
+   * \note Cached quantities (see \ref refreshForceSensorsCache) rely on this, code that modifies mbc().bodyPosW
+   * without calling forwardKinematics() must call it afterwards
+   *
+   * \see mc_rbdyn::nextGeneration
+   */
+  inline uint64_t kinematicsGeneration() const noexcept { return kinematicsGeneration_; }
+
   /** Apply forward velocity to the robot */
   void forwardVelocity();
   /** Apply forward velocity to \p mbc using the robot's mb() */
@@ -1141,6 +1201,10 @@ private:
   /** Correspondance between refJointOrder (actuated joints) index and
    * mbc index. **/
   std::vector<int> refJointIndexToMBCIndex_;
+  /** Precomputed flat mappings, see paramMap(), dofMap() and refJointOrderMap() */
+  FlatParamMap paramMap_;
+  FlatParamMap dofMap_;
+  FlatParamMap refJointOrderMap_;
   /** Springs in this instance */
   Springs springs_;
   /** Flexibility in this instance */
@@ -1213,6 +1277,33 @@ private:
   /* mutable to allow initialization in const method */
   mutable std::map<std::string, mc_tvm::ConvexPtr> tvm_convexes_;
 
+  /** See \ref kinematicsGeneration, mutable so that forwardKinematics(mbc()) updates it */
+  mutable uint64_t kinematicsGeneration_ = nextGeneration();
+
+  /** Derived force sensor quantities for this robot, updated from const methods under its mutex */
+  std::unique_ptr<detail::ForceSensorsCache> forceSensorsCache_ = std::make_unique<detail::ForceSensorsCache>();
+
+  /** Largest \ref forceSensorGeneration of all the robot's force sensors */
+  uint64_t forceSensorsGeneration() const noexcept;
+
+  /** Get one of the up-to-date cached quantities derived from \p fs
+   *
+   * The cache is recomputed if \ref forceSensorGeneration changed since the last call. This can be called from
+   * multiple threads.
+   *
+   * \param value Quantity to retrieve
+   *
+   * \param out Set to the cached quantity
+   *
+   * \returns False if \p fs is not one of this robot's force sensors
+   */
+  bool forceSensorCache(const ForceSensor & fs,
+                        sva::ForceVecd detail::ForceSensorCache::*value,
+                        sva::ForceVecd & out) const;
+
+  /** Bring the cache entry of \p fs up-to-date, returns nullptr if \p fs is not one of this robot's force sensors */
+  const detail::ForceSensorCache * updateForceSensorCache(const ForceSensor & fs) const;
+
   /** Set the name of the robot
    *
    * \note It is not recommended to call this late in the life cycle of the
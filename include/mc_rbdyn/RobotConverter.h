@@ -58,8 +58,10 @@ protected:
 
 protected:
   RobotConverterConfig config_;
-  // Common joint indices from inputRobot_ -> outputRobot_ robot
+  // Common joint indices from inputRobot_ -> outputRobot_ robot (multi-dof joints)
   std::vector<std::pair<unsigned int, unsigned int>> commonJointIndices_{};
+  // Common 1-dof joint indices from inputRobot_ -> outputRobot_ robot
+  std::vector<std::pair<unsigned int, unsigned int>> commonScalarJointIndices_{};
   // Encoder indices from inputRobot_ -> outputRobot_ robot
   std::vector<std::pair<unsigned int, unsigned int>> commonEncoderToJointIndices_{};
   // Indices of joints with mimics from actuated joints in inputRobot_
@@ -6,6 +6,9 @@
 
 #include <mc_rbdyn/Frame.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace mc_rbdyn
 {
 
@@ -91,6 +94,7 @@ public:
   inline RobotFrame & X_p_f(sva::PTransformd pt) noexcept
   {
     position_ = pt;
+    generation_ = nextGeneration();
     return *this;
   }
 
@@ -104,6 +108,8 @@ public:
   const ForceSensor & forceSensor() const;
 
   /** Returns the force sensor gravity-free wrench in this frame
+   *
+   * The result is cached until \ref forceGeneration changes, this also applies to \ref cop and \ref copW
    *
    * \throws if \ref hasForceSensor() is false
    */
@@ -129,6 +135,15 @@ public:
    */
   Eigen::Vector3d copW(double min_pressure = 0.5) const;
 
+  /** Identifies the state the force quantities of this frame depend on
+   *
+   * This changes with Robot::forceSensorGeneration for the attached sensor and when the transformation from the body
+   * to this frame changes
+   *
+   * \throws if \ref hasForceSensor() is false
+   */
+  uint64_t forceGeneration() const;
+
   /** Create a frame whose parent is this frame
    *
    * \param name Name of the new frame
@@ -154,6 +169,26 @@ protected:
   /** Force sensor attached (directly or indirectly) to this frame, nullptr if none */
   const ForceSensor * sensor_ = nullptr;
 
+  /** Cached force quantities, values are only written while their key is outdated so up-to-date values are read
+   * without locking */
+  struct ForceCache
+  {
+    /** Serializes the computation of the cached values */
+    std::mutex mutex;
+    /** \ref forceGeneration that \ref wrench was computed for */
+    std::atomic<uint64_t> key{0};
+    sva::ForceVecd wrench = sva::ForceVecd(Eigen::Vector6d::Zero());
+    /** \ref forceGeneration that the CoP was computed for with \ref minPressure */
+    std::atomic<uint64_t> copKey{0};
+    double minPressure = 0;
+    Eigen::Vector2d cop = Eigen::Vector2d::Zero();
+    Eigen::Vector3d copW = Eigen::Vector3d::Zero();
+  };
+  mutable ForceCache forceCache_;
+
+  /** Returns the CoP in frame and inertial coordinates */
+  void cachedCoP(double min_pressure, Eigen::Vector2d & cop, Eigen::Vector3d & copW) const;
+
   void init_tvm_frame() const final;
 
   /** Search for a force sensor inside Robot again */
@@ -247,11 +247,13 @@ protected:
   Robots(Robots && robots) = delete;
   Robots & operator=(Robots && robots) = delete;
 
-  RobotModuleVector robot_modules_;
+  /** Robot modules are immutable once loaded, copies of a robot share the same module */
+  std::vector<std::shared_ptr<const RobotModule>> robot_modules_;
   std::vector<RobotPtr> robots_;
   std::vector<rbd::MultiBody> mbs_;
   std::vector<rbd::MultiBodyConfig> mbcs_;
-  std::vector<rbd::MultiBodyGraph> mbgs_;
+  /** Shared between copies of a robot until one of them requests non-const access (see Robot::mbg) */
+  std::vector<std::shared_ptr<rbd::MultiBodyGraph>> mbgs_;
   unsigned int robotIndex_;
   unsigned int envIndex_;
   void updateIndexes();
@@ -40,8 +40,18 @@ MC_RBDYN_DLLAPI void transform(S_Object & obj, const sva::PTransformd & t);
 
 MC_RBDYN_DLLAPI STP_BV * STPBV(const std::string & filename);
 
+/** Load a polyhedron from a qhull output file
+ *
+ * Parsed files are kept in memory, loading the same (unmodified) file again
+ * only costs a copy of the parsed object
+ *
+ * @returns A new object owned by the caller
+ */
 MC_RBDYN_DLLAPI S_Polyhedron * Polyhedron(const std::string & filename);
 
+/** Release the polyhedra kept in memory by \ref Polyhedron */
+MC_RBDYN_DLLAPI void clearPolyhedronCache();
+
 MC_RBDYN_DLLAPI double distance(CD_Pair & pair, Eigen::Vector3d & p1, Eigen::Vector3d & p2);
 
 } // namespace mc_rbdyn
@@ -34,8 +34,19 @@ MC_RBDYN_DLLAPI sch::S_Object * surface_to_sch(const mc_rbdyn::Surface & surface
                                                const double & depth = 0.01,
                                                const unsigned int & slice = 8);
 
+/** Build the convex hull of the given points
+ *
+ * Generated hulls are kept in memory, indexed by the exact input points, so
+ * requesting the same hull again only costs a copy of the cached object. The
+ * least recently used hulls are released once a few hundred are kept.
+ *
+ * @returns A new object owned by the caller
+ */
 MC_RBDYN_DLLAPI sch::S_Object * sch_polyhedron(const std::vector<sva::PTransformd> & points);
 
+/** Release the hulls kept in memory by \ref sch_polyhedron */
+MC_RBDYN_DLLAPI void clear_sch_hull_cache();
+
 MC_RBDYN_DLLAPI sch::S_Object * planar_hull(const mc_rbdyn::PlanarSurface & surface, const double & depth);
 
 MC_RBDYN_DLLAPI sch::S_Object * cylindrical_hull(const mc_rbdyn::CylindricalSurface & surface,
@@ -8,6 +8,7 @@
 #include <mc_rtc/type_name.h>
 #include <mc_rtc/utils_api.h>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <stdexcept>
@@ -91,8 +92,119 @@ struct Allocator<T, typename T::eigen_aligned_operator_new_marker_type> : public
 {
 };
 
+/** Shared state between a stored object and the handles that refer to it
+ *
+ * The slot outlives the stored object, \ref ptr is reset when the object is
+ * removed from the datastore so that handles can detect it
+ */
+struct DataSlot
+{
+  /** Stored object or nullptr if it has been removed */
+  void * ptr = nullptr;
+  /** Incremented every time the object is signaled as changed */
+  uint64_t version = 0;
+};
+
 } // namespace internal
 
+struct DataStore;
+
+/**
+ * @brief Typed handle to an object in a DataStore
+ *
+ * A handle is obtained through \ref DataStore::handle and resolves the key
+ * and checks the type once. Accessing the object through the handle is then
+ * a single indirection.
+ *
+ * The handle remains valid when other objects are added to or removed from
+ * the datastore. If the object it refers to is removed (or the datastore is
+ * cleared/destroyed) the handle becomes invalid, this can be checked with
+ * \ref valid. A new object created with the same name afterwards is not
+ * tracked by the old handle, you must request a new one.
+ *
+ * Each stored object also carries a version that is incremented by \ref
+ * DataStore::assign and \ref DataStore::touch (or \ref touch on a handle).
+ * Consumers can use \ref changed to cheaply know whether the object was
+ * signaled as modified since they last checked.
+ *
+ * \code{cpp}
+ * auto anchor = store.handle<std::function<sva::PTransformd(const mc_rbdyn::Robot &)>>("KinematicAnchorFrame::robot");
+ * // In the control loop
+ * if(anchor.valid()) { X_0_anchor = (*anchor)(robot); }
+ * \endcode
+ *
+ * @tparam T Type of the stored object, might be const-qualified
+ */
+template<typename T>
+struct DataHandle
+{
+  /** Creates an invalid handle */
+  DataHandle() = default;
+
+  /** True if the handle refers to an object that is still in the datastore */
+  inline bool valid() const noexcept { return slot_ && slot_->ptr; }
+
+  /** Same as \ref valid */
+  inline explicit operator bool() const noexcept { return valid(); }
+
+  /** Name of the stored object */
+  inline const std::string & name() const noexcept { return name_; }
+
+  /**
+   * @brief Access the stored object
+   *
+   * @throws std::runtime_error if the handle is not valid
+   */
+  inline T & get() const
+  {
+    if(!valid()) { log::error_and_throw("Invalid DataStore handle for key \"{}\"", name_); }
+    return *static_cast<T *>(slot_->ptr);
+  }
+
+  /** Same as \ref get */
+  inline T & operator*() const { return get(); }
+
+  /** Same as \ref get */
+  inline T * operator->() const { return &get(); }
+
+  /** Current version of the stored object (0 for an invalid handle) */
+  inline uint64_t version() const noexcept { return slot_ ? slot_->version : 0; }
+
+  /**
+   * @brief Returns true if the object version changed since the last call
+   *
+   * On the first call this compares against the version at the time the
+   * handle was created.
+   *
+   * An invalid handle is never changed.
+   */
+  inline bool changed() noexcept
+  {
+    if(!valid() || slot_->version == seen_) { return false; }
+    seen_ = slot_->version;
+    return true;
+  }
+
+  /** Signal that the object was changed through this handle */
+  template<typename U = T, typename std::enable_if<!std::is_const<U>::value, int>::type = 0>
+  inline void touch() const noexcept
+  {
+    if(valid()) { slot_->version++; }
+  }
+
+private:
+  friend struct DataStore;
+
+  DataHandle(const std::string & name, std::shared_ptr<internal::DataSlot> slot)
+  : name_(name), slot_(std::move(slot)), seen_(slot_->version)
+  {
+  }
+
+  std::string name_;
+  std::shared_ptr<internal::DataSlot> slot_;
+  uint64_t seen_ = 0;
+};
+
 /**
  * @brief Generic data store
  *
@@ -128,6 +240,9 @@ struct Allocator<T, typename T::eigen_aligned_operator_new_marker_type> : public
  * auto & base = store.get<A>("data");
  * auto & derived = store.get<B>("data");
  * \endcode
+ *
+ * For objects that are accessed often with the same key, prefer resolving a
+ * \ref DataHandle once with \ref handle and use it afterwards.
  */
 struct DataStore
 {
@@ -211,9 +326,38 @@ struct DataStore
     return defaultValue;
   }
 
+  /**
+   * @brief Get a typed handle to an object on the datastore
+   *
+   * The key lookup and type check are done once here, see \ref DataHandle
+   *
+   * @param name Name of the stored object
+   *
+   * @throws std::runtime_error if the object does not exist or the type of T
+   * does not match the one defined upon creation
+   */
+  template<typename T>
+  DataHandle<T> handle(const std::string & name)
+  {
+    const auto & data = get_data(name);
+    safe_cast<T>(data, name);
+    return {name, data.get_slot()};
+  }
+
+  /** @brief const variant of \ref handle */
+  template<typename T>
+  DataHandle<const T> handle(const std::string & name) const
+  {
+    const auto & data = get_data(name);
+    safe_cast<T>(data, name);
+    return {name, data.get_slot()};
+  }
+
   /**
    * @brief Copies an object to an existing datastore object
    *
+   * This increments the object's version
+   *
    * @param name Name of the stored object
    * @param data Data to copy on the datastore
    *
@@ -222,7 +366,25 @@ struct DataStore
   template<typename T>
   void assign(const std::string & name, const T & data)
   {
-    get<T>(name) = data;
+    const auto & d = get_data(name);
+    const_cast<T &>(safe_cast<T>(d, name)) = data;
+    if(d.slot) { d.slot->version++; }
+  }
+
+  /**
+   * @brief Signal that an object was modified
+   *
+   * This increments the object's version so that handles observing it will
+   * report a change, see \ref DataHandle::changed
+   *
+   * @param name Name of the stored object
+   *
+   * @throws std::runtime_error if the object does not exist
+   */
+  inline void touch(const std::string & name)
+  {
+    const auto & d = get_data(name);
+    d.get_slot()->version++;
   }
 
   /**
@@ -386,12 +548,25 @@ private:
     bool (*same_name)(const std::string &);
     /** Call destructor and delete the buffer */
     void (*destroy)(Data &);
+    /** Shared with handles, created on first request */
+    mutable std::shared_ptr<internal::DataSlot> slot;
     /** Destructor */
     ~Data()
     {
+      if(slot) { slot->ptr = nullptr; }
       if(buffer) { destroy(*this); }
     }
 
+    inline const std::shared_ptr<internal::DataSlot> & get_slot() const
+    {
+      if(!slot)
+      {
+        slot = std::make_shared<internal::DataSlot>();
+        slot->ptr = buffer.get();
+      }
+      return slot;
+    }
+
     template<typename T>
     void allocate(const std::string & name_, const std::string & name)
     {
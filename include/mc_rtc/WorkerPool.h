@@ -0,0 +1,87 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_rtc/utils_api.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mc_rtc
+{
+
+/** A fixed set of worker threads used to run short batches of jobs in parallel
+ *
+ * The pool is meant for the real-time loop: threads are created once, optionally pinned to specific CPUs, and \ref run
+ * does not allocate. The calling thread participates in the work and \ref run only returns once every job has
+ * completed.
+ *
+ * A pool with no worker threads is valid, it runs every job in the calling thread.
+ */
+struct MC_RTC_UTILS_DLLAPI WorkerPool
+{
+  /** Constructor
+   *
+   * \param threads Number of worker threads (not counting the calling thread)
+   *
+   * \param cpus If non-empty, worker i is pinned to cpus[i % cpus.size()]. Pinning is only supported on Linux and a
+   * warning is displayed if it fails.
+   */
+  WorkerPool(size_t threads, const std::vector<int> & cpus = {});
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  /** Stop and join the worker threads */
+  ~WorkerPool();
+
+  /** Number of worker threads (not counting the calling thread) */
+  inline size_t size() const noexcept { return threads_.size(); }
+
+  /** Call job(i) for i in [0, n) and wait for all calls to complete
+   *
+   * Jobs are distributed dynamically among the worker threads and the calling thread, they must be independent from
+   * each other.
+   *
+   * If some jobs throw, the remaining jobs are still executed and the exception thrown by the job with the lowest
+   * index is re-thrown in the calling thread.
+   *
+   * This must not be called concurrently or from within a job.
+   */
+  void run(size_t n, const std::function<void(size_t)> & job);
+
+private:
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable startCv_;
+  std::condition_variable doneCv_;
+  /** Incremented to start a new batch */
+  size_t generation_ = 0;
+  bool stop_ = false;
+
+  /** Current batch */
+  const std::function<void(size_t)> * job_ = nullptr;
+  size_t jobs_ = 0;
+  std::atomic<size_t> next_{0};
+  /** Number of workers that have not finished the current batch */
+  size_t busy_ = 0;
+
+  /** Exception thrown by the job with the lowest index in the current batch */
+  std::exception_ptr error_;
+  size_t errorIndex_ = 0;
+  std::mutex errorMutex_;
+
+  void work();
+
+  void loop();
+};
+
+} // namespace mc_rtc
@@ -8,7 +8,12 @@
 #include <mc_rtc/gui/elements.h>
 #include <mc_rtc/gui/plot.h>
 
+#include <chrono>
+#include <list>
+#include <map>
+#include <set>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace mc_rtc
 {
@@ -41,6 +46,9 @@ struct MC_RTC_GUI_DLLAPI StateBuilder
   /** Constructor */
   StateBuilder();
 
+  StateBuilder(const StateBuilder &) = delete;
+  StateBuilder & operator=(const StateBuilder &) = delete;
+
   /** Add a given element
    *
    * \tparam T Must derive from Element
@@ -171,14 +179,8 @@ struct MC_RTC_GUI_DLLAPI StateBuilder
 
   /** Remove all elements attached to the given source
    *
-   * One should prefer to remove a category or target a specific category, otherwise the whole GUI has to be searched to
-   * find matching elements
-   *
-   * For example, if your source has added a category and a few elements in the root:
-   * gui()->removeCategory({"MyCategory"});
-   * gui()->removeElements({}, this);
-   * Should be used instead of:
-   * gui()->removeElements(this);
+   * Elements are indexed by source so this only visits the elements of the source. Categories that become empty are
+   * removed.
    */
   void removeElements(void * source);
 
@@ -192,6 +194,31 @@ struct MC_RTC_GUI_DLLAPI StateBuilder
    */
   void removeElements(const std::vector<std::string> & category, void * source, bool recurse = false);
 
+  /** Limit the rate at which an element is updated
+   *
+   * Between two updates, the element's callbacks are not invoked and the GUI message re-uses the data serialized at
+   * the last update. This is meant for elements whose data is expensive to compute and changes slowly (e.g.
+   * Polyhedron, Trajectory, Visual...). A request to the element forces an update in the next message.
+   *
+   * \param category Category of the element
+   *
+   * \param name Name of the element, this has no effect if the element does not exist
+   *
+   * \param rate Maximum update rate (Hz), 0 to use the rate of the element's category
+   */
+  void updateRate(const std::vector<std::string> & category, const std::string & name, double rate);
+
+  /** Limit the rate at which the elements of a category are updated
+   *
+   * This applies to the elements of the category and its sub-categories (including the elements added later) that do
+   * not have their own rate, a sub-category with its own rate uses it instead.
+   *
+   * \param category Category, the rate is kept and applies to the category when it is created if it does not exist
+   *
+   * \param rate Maximum update rate (Hz), 0 to use the rate of the parent category
+   */
+  void updateRate(const std::vector<std::string> & category, double rate);
+
   /** Add a plot identified by the provided name
    *
    * In this form, Args are expected to provide 2D data
@@ -336,11 +363,37 @@ struct MC_RTC_GUI_DLLAPI StateBuilder
   /** Update the plots only */
   void update();
 
+  /** Only serialize the elements of the given categories (and their sub-categories)
+   *
+   * The other categories are still sent with their name and sub-categories but without their elements, the elements'
+   * callbacks are not invoked. An empty category is the root of the GUI, i.e. subscribing to {{}} is the same as
+   * \ref clearSubscriptions.
+   *
+   * Plots are not affected.
+   *
+   * \param categories Full name of the subscribed categories, they do not need to exist yet
+   */
+  void subscriptions(const std::vector<std::vector<std::string>> & categories);
+
+  /** Serialize every element (default) */
+  void clearSubscriptions();
+
   /** Handle a request */
   bool handleRequest(const std::vector<std::string> & category,
                      const std::string & name,
                      const mc_rtc::Configuration & data);
 
+  /** Handle a request for the element identified by \p id (see \ref elementId) */
+  bool handleRequest(uint64_t id, const mc_rtc::Configuration & data);
+
+  /** Returns the id of an element or 0 if the element does not exist
+   *
+   * Ids are unique for the lifetime of the StateBuilder: an element keeps its id until it is removed and an id is
+   * never re-used. They are sent to the client after the plots in the GUI message, in the order the elements appear in
+   * the message.
+   */
+  uint64_t elementId(const std::vector<std::string> & category, const std::string & name);
+
   /** Access static data store
    *
    * This assumes you are accessing the data to modify and will trigger a
@@ -350,7 +403,7 @@ struct MC_RTC_GUI_DLLAPI StateBuilder
   mc_rtc::Configuration data();
 
   /** Return the number of elements in the GUI */
-  inline size_t size() const { return elements_.size(); }
+  inline size_t size() const { return ids_.size(); }
 
 private:
   template<typename T>
@@ -392,6 +445,15 @@ private:
     void (*write)(Element &, mc_rtc::MessagePackBuilder &);
     bool (*handleRequest)(Element &, const mc_rtc::Configuration &);
     void * source;
+    /** Unique id of the element, see \ref elementId */
+    uint64_t uid = 0;
+    /** Maximum update rate (Hz), 0 to use the category rate, see \ref updateRate */
+    double update_rate = 0;
+    /** Serialized element and time of the serialization when the element is throttled, the cache is empty if
+     * cache_size is 0 */
+    std::vector<char> cache;
+    size_t cache_size = 0;
+    std::chrono::steady_clock::time_point cache_time;
 
     template<typename T>
     ElementStore(T self, const Category & category, ElementsStacking stacking, void * source);
@@ -399,13 +461,27 @@ private:
   struct Category
   {
     std::string name;
-    std::vector<ElementStore> elements;
-    std::vector<Category> sub;
+    /** Parent category, nullptr for the root */
+    Category * parent = nullptr;
+    /** Elements and sub-categories are kept in insertion order, lists keep the indexes valid on insertion/removal */
+    std::list<ElementStore> elements;
+    std::unordered_map<std::string, std::list<ElementStore>::iterator> elements_index;
+    std::list<Category> sub;
+    std::unordered_map<std::string, std::list<Category>::iterator> sub_index;
     /** If the category has a sub-category of the requested name returns an
      * iterator to it, otherwise returns end() */
-    std::vector<Category>::iterator find(const std::string & name);
+    std::list<Category>::iterator find(const std::string & name);
+    /** If the category has an element of the requested name returns an
+     * iterator to it, otherwise returns end() */
+    std::list<ElementStore>::iterator findElement(const std::string & name);
     /** For each category, keeps track of the line id for next elements added */
     int id = 0;
+    /** True if this category is subscribed, see \ref subscriptions */
+    bool subscribed = false;
+    /** Maximum update rate (Hz) of the elements, 0 to use the parent's rate, see \ref updateRate */
+    double update_rate = 0;
+    /** True if the category has no elements and no sub-categories */
+    inline bool empty() const noexcept { return elements.empty() && sub.empty(); }
     /** Returns the number of elements in this category and its sub-categories */
     inline size_t size() const
     {
@@ -416,6 +492,39 @@ private:
   };
   Category elements_;
 
+  /** Location of an element in the tree */
+  struct ElementRef
+  {
+    Category * category;
+    std::list<ElementStore>::iterator element;
+  };
+  /** Next element id, 0 is never used */
+  uint64_t next_uid_ = 1;
+  /** All elements by id */
+  std::unordered_map<uint64_t, ElementRef> ids_;
+  /** Ids of the elements attached to a source */
+  std::unordered_map<void *, std::unordered_set<uint64_t>> sources_;
+  /** Ids written in the last message, in the same order as the elements */
+  std::vector<uint64_t> update_ids_;
+
+  /** Index the last element added to \p category */
+  void indexElement(Category & category);
+
+  /** Remove an element from \p category and from the indexes */
+  void eraseElement(Category & category, std::list<ElementStore>::iterator it);
+
+  /** Remove the elements of \p category and its sub-categories from the indexes */
+  void unindex(Category & category);
+
+  /** Remove the categories that became empty, starting from the deepest, up-to \p stop (excluded) */
+  void prune(std::vector<Category *> categories, const Category * stop);
+
+  /** Full name of a category */
+  std::vector<std::string> categoryPath(const Category & category);
+
+  /** Handle a request for a given element */
+  bool handleRequest(const Category & category, ElementStore & el, const mc_rtc::Configuration & data);
+
   /** Get a category
    *
    * Returns nullptr if the category does not exist
@@ -429,11 +538,26 @@ private:
   /** Get a category, creates it if does not exist */
   Category & getOrCreateCategory(const std::vector<std::string> & category);
 
-  /** Update the GUI data state for a given category */
-  void update(mc_rtc::MessagePackBuilder & builder, Category & category);
+  /** Update the GUI data state for a given category
+   *
+   * Elements are only written if \p visible is true or the category is subscribed
+   *
+   * \p rate is the update rate of the parent category
+   */
+  void update(mc_rtc::MessagePackBuilder & builder, Category & category, bool visible, double rate);
+
+  /** Write an element that is updated at most at \p rate (Hz) */
+  void write(mc_rtc::MessagePackBuilder & builder, ElementStore & element, double rate);
+
+  /** True if only the subscribed categories are serialized */
+  bool subscriptions_active_ = false;
+  /** Subscribed categories */
+  std::set<std::vector<std::string>> subscriptions_;
+  /** Update rates set by \ref updateRate for categories, including categories that do not exist */
+  std::map<std::vector<std::string>, double> category_rates_;
 
-  /** Remove all elements associated to the given in the given category */
-  void removeElements(Category & category, void * source);
+  /** Update the subscribed flag of \p category and its sub-categories */
+  void updateSubscriptions(Category & category, std::vector<std::string> & path);
 
   std::string cat2str(const std::vector<std::string> & category);
 
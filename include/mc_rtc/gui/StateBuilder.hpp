@@ -49,15 +49,14 @@ void StateBuilder::addElementImpl(void * source,
 {
   static_assert(std::is_base_of<Element, T>::value, "You can only add elements that derive from the Element class");
   Category & cat = getOrCreateCategory(category);
-  auto it = std::find_if(cat.elements.begin(), cat.elements.end(),
-                         [&element](const ElementStore & el) { return el().name() == element.name(); });
-  if(it != cat.elements.end())
+  if(cat.elements_index.count(element.name()))
   {
     log::error("An element named {} already exists in {}", element.name(), cat2str(category));
     log::warning("Discarding request to add this element");
     return;
   }
   cat.elements.emplace_back(element, cat, stacking, source);
+  indexElement(cat);
   if(rem == 0) { cat.id += 1; }
 }
 
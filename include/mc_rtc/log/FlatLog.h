@@ -45,8 +45,11 @@ struct MC_RTC_UTILS_DLLAPI FlatLog
   /** Default constructor, empty log */
   FlatLog() = default;
 
-  /** Load a file into the log */
-  FlatLog(const std::string & fpath);
+  /** Load a file into the log
+   *
+   * \param jobs Number of threads used to decode a binary log, see \ref iterate_binary_log_ranges
+   */
+  FlatLog(const std::string & fpath, size_t jobs = 1);
 
   FlatLog(const FlatLog &) = delete;
   FlatLog & operator=(const FlatLog &) = delete;
@@ -55,10 +58,10 @@ struct MC_RTC_UTILS_DLLAPI FlatLog
   FlatLog & operator=(FlatLog &&) = default;
 
   /** Load a file into the log, erase the current content of the flat log */
-  void load(const std::string & fpath);
+  void load(const std::string & fpath, size_t jobs = 1);
 
   /** Append a file into the flat log, the resulting content is the concatenation of the two logs*/
-  void append(const std::string & fpath);
+  void append(const std::string & fpath, size_t jobs = 1);
 
   /** Returns the size of the log */
   size_t size() const;
@@ -184,7 +187,13 @@ private:
   void appendFlat(const std::string & fpath);
 
   /** Append a binary file to the log */
-  void appendBin(const std::string & fpath);
+  void appendBin(const std::string & fpath, size_t jobs);
+
+  /** Append the records of a binary log to this log */
+  struct BinAppender;
+
+  /** Move the content of another log at the end of this one */
+  void merge(FlatLog && other);
 };
 
 } // namespace mc_rtc::log
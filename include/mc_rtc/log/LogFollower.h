@@ -0,0 +1,98 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_rtc/log/iterate_binary_log.h>
+
+#include <chrono>
+#include <memory>
+
+namespace mc_rtc::log
+{
+
+struct LogFollowerImpl;
+
+/** Incrementally read a binary log while it is being written
+ *
+ * Every call to \ref poll decodes the records appended to the log since the previous call and forwards them to the
+ * subscribers, a record that is only partially written is left for the next call. The key set is kept from one call to
+ * the next so the data received by the subscribers is the same as with \ref iterate_binary_log: keys are only provided
+ * when they changed.
+ *
+ * The followed path can be:
+ * - a binary log;
+ * - a symbolic link to a binary log (e.g. [template]-[controller]-latest.bin), when the link changes the follower
+ *   finishes the current log and moves to the new one;
+ * - a manifest of a segmented log (see mc_rtc::Logger::Segmentation), the follower moves to the next segment when it
+ *   appears in the manifest.
+ *
+ * In the last two cases, the key set is reset when the follower moves to a new file.
+ *
+ * The path does not need to exist when the follower is created.
+ */
+struct MC_RTC_UTILS_DLLAPI LogFollower
+{
+  /** Constructor
+   *
+   * \param path Path to the followed log
+   *
+   * \param extract Extract the records' data, see \ref iterate_binary_log
+   *
+   * \param time Name of the time entry, no time is provided to the subscribers if empty
+   */
+  LogFollower(const std::string & path, bool extract = true, const std::string & time = "t");
+
+  LogFollower(const LogFollower &) = delete;
+  LogFollower & operator=(const LogFollower &) = delete;
+
+  /** Stop following the log (see \ref stop) */
+  ~LogFollower();
+
+  /** Add a subscriber
+   *
+   * The callback is called for every record decoded after the subscription, if it returns false the subscriber is
+   * removed.
+   *
+   * Subscribers are called from the thread that calls \ref poll, they must not subscribe or unsubscribe.
+   *
+   * \returns An id that can be used to \ref unsubscribe
+   */
+  size_t subscribe(const iterate_binary_log_callback & callback);
+
+  /** Remove a subscriber, this has no effect if the subscriber does not exist */
+  void unsubscribe(size_t id);
+
+  /** Decode the records appended since the last call and notify the subscribers
+   *
+   * \returns The number of records decoded
+   */
+  size_t poll();
+
+  /** Call \ref poll periodically in a background thread
+   *
+   * Records are delivered at most \p period (plus the decoding time) after they have been written. This has no effect
+   * if the follower is already started.
+   *
+   * \param period Time between two polls when no new data is available
+   */
+  void start(std::chrono::microseconds period = std::chrono::milliseconds(10));
+
+  /** Stop the background thread started by \ref start */
+  void stop();
+
+  /** Number of records decoded so far (in all followed files) */
+  size_t records() const noexcept;
+
+  /** Currently followed file, empty until the followed path exists */
+  std::string file() const;
+
+  /** False if the followed file is not a valid log, the follower stops reading it until it moves to a new file */
+  bool valid() const noexcept;
+
+private:
+  std::unique_ptr<LogFollowerImpl> impl_;
+};
+
+} // namespace mc_rtc::log
@@ -115,6 +115,47 @@ public:
     std::map<std::string, std::map<std::string, mc_rtc::Configuration>> calibs;
   };
 
+  /*! \brief Split the log into several files
+   *
+   * When a limit is reached the log continues in a new file (a segment). Each segment is a valid binary log on its
+   * own: it starts with the current set of keys and the \ref Meta data. A manifest file lists the segments and the
+   * time at which they start, it can be read in place of a binary log by \ref log::iterate_binary_log (and thus by
+   * mc_rtc::log::FlatLog and the log tools).
+   *
+   * Given a log named [name].bin the segments are named [name].bin, [name].2.bin, [name].3.bin... and the manifest is
+   * [name].manifest
+   *
+   * GUI events are only recorded in the segment during which they happened, they are not repeated at the start of the
+   * next segments since a replay would trigger them again. Read the manifest to get every event of the log.
+   *
+   * With the \ref Policy::THREADED policy the segments are opened and closed by the writer thread
+   */
+  struct Segmentation
+  {
+    /** Start a new segment when the current one is larger than this (in bytes), 0 disables this limit */
+    size_t max_size = 0;
+    /** Start a new segment when the current one is longer than this (in seconds of log time), 0 disables this limit */
+    double max_duration = 0;
+
+    /** True if a limit is set */
+    inline bool enabled() const noexcept { return max_size > 0 || max_duration > 0; }
+  };
+
+  /** A segment listed in a manifest, see \ref Segmentation */
+  struct Segment
+  {
+    /** Path to the segment, relative paths in the manifest are resolved from the manifest's directory */
+    std::string file;
+    /** Time at which the segment starts */
+    double start;
+  };
+
+  /** Read the segments listed in a manifest written by a Logger
+   *
+   * \throws mc_rtc::Configuration::Exception if the manifest cannot be read or is not a valid manifest
+   */
+  static std::vector<Segment> readManifest(const std::string & manifest);
+
 public:
   /*! \brief Constructor
    *
@@ -139,6 +180,16 @@ public:
    */
   void setup(const Policy & policy, const std::string & directory, const std::string & tmpl);
 
+  /*! \brief Set the segmentation limits
+   *
+   * Enabling or disabling the segmentation takes effect the next time \ref start or \ref open is called, the limits
+   * of a segmented log can be changed at any time
+   */
+  inline void segmentation(const Segmentation & segmentation) noexcept { segmentation_ = segmentation; }
+
+  /*! \brief Access the segmentation limits */
+  inline const Segmentation & segmentation() const noexcept { return segmentation_; }
+
   /*! \brief Access the log's metadata */
   inline Meta & meta() noexcept { return meta_; }
 
@@ -348,6 +399,12 @@ public:
    */
   const std::string & path() const;
 
+  /** Access the manifest of the log
+   *
+   * \note This is empty if segmentation is disabled (see \ref Segmentation)
+   */
+  const std::string & manifest() const;
+
   /** Flush the log data to disk (only implemented in the synchronous method) */
   void flush();
 
@@ -383,6 +440,12 @@ private:
   std::vector<LogEvent> log_events_;
   /** Contains all the log entries */
   std::vector<LogEntry> log_entries_;
+  /** Segmentation limits */
+  Segmentation segmentation_;
+  /** Bytes written in the current segment */
+  size_t segment_size_ = 0;
+  /** Time at which the current segment started */
+  double segment_start_ = 0;
 
   std::vector<LogEntry>::iterator find_entry(const std::string & name);
 
@@ -35,6 +35,9 @@ struct MC_RTC_UTILS_DLLAPI IterateBinaryLogData
 
 using iterate_binary_log_callback = std::function<bool(IterateBinaryLogData)>;
 
+/** Callback for \ref iterate_binary_log_ranges, the first argument is the index of the range being decoded */
+using iterate_binary_log_range_callback = std::function<bool(size_t, IterateBinaryLogData)>;
+
 using binary_log_callback =
     std::function<bool(const std::vector<std::string> &, std::vector<FlatLog::record> &, double)>;
 
@@ -52,6 +55,9 @@ using binary_log_copy_callback = std::function<bool(const std::vector<std::strin
  *
  * If the callback returns false the parsing is interrupted.
  *
+ * If \p fpath is a manifest (.manifest extension, see mc_rtc::Logger::Segmentation) the segments are iterated in
+ * order, the keys are reported again at the start of each segment
+ *
  * \returns True if the parsing was successful, false otherwise
  */
 bool MC_RTC_UTILS_DLLAPI iterate_binary_log(const std::string & fpath,
@@ -59,6 +65,27 @@ bool MC_RTC_UTILS_DLLAPI iterate_binary_log(const std::string & fpath,
                                             bool extract,
                                             const std::string & time = "t");
 
+/** Iterate over a given binary log using several threads
+ *
+ * The records are split into ranges of similar size (in bytes) and the ranges are decoded concurrently. A first pass
+ * over the log only decodes the records that hold events to recover the keys and the meta data at the start of each
+ * range.
+ *
+ * \p on_ranges is called with the number of ranges before decoding starts. The callback is then called concurrently
+ * for different ranges but the records of a range are provided in order, from the thread decoding that range. The keys
+ * are always provided with the first record of a range.
+ *
+ * \param jobs Number of threads decoding the log (including the calling thread)
+ *
+ * \returns True if the parsing was successful, false otherwise
+ */
+bool MC_RTC_UTILS_DLLAPI iterate_binary_log_ranges(const std::string & fpath,
+                                                   size_t jobs,
+                                                   const std::function<void(size_t)> & on_ranges,
+                                                   const iterate_binary_log_range_callback & callback,
+                                                   bool extract,
+                                                   const std::string & time = "t");
+
 /** Provided for backward compatibility */
 inline bool iterate_binary_log(const std::string & fpath,
                                const binary_log_copy_callback & callback,
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_solver/api.h>
+
+#include <Eigen/Core>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace mc_solver
+{
+
+/** A dense quadratic program as solved by a QPSolver at a given iteration
+ *
+ * The problem reads:
+ *
+ * \f[
+ *  \begin{array}{ll}
+ *    \min_x & \frac{1}{2} x^T Q x + c^T x \\
+ *    \text{s.t.} & A_{eq} x = b_{eq} \\
+ *                & l_{ineq} \leq A_{ineq} x \leq u_{ineq} \\
+ *                & x_l \leq x \leq x_u
+ *  \end{array}
+ * \f]
+ *
+ * Missing bounds are represented by infinite values
+ */
+struct MC_SOLVER_DLLAPI QPProblem
+{
+  /** Iteration of the solver at which the problem was recorded */
+  uint64_t tick = 0;
+  /** Build and solve time measured when the problem was recorded (ms) */
+  double solveTime = 0;
+
+  Eigen::MatrixXd Q;
+  Eigen::VectorXd c;
+
+  Eigen::MatrixXd Aeq;
+  Eigen::VectorXd beq;
+
+  Eigen::MatrixXd Aineq;
+  Eigen::VectorXd lineq;
+  Eigen::VectorXd uineq;
+
+  Eigen::VectorXd xl;
+  Eigen::VectorXd xu;
+
+  /** Resize the problem, objective and constraints are zero and bounds are infinite */
+  void resize(Eigen::Index nrVars, Eigen::Index nrEq, Eigen::Index nrIneq);
+
+  /** Number of variables */
+  inline Eigen::Index nrVars() const noexcept { return c.size(); }
+
+  /** Number of equality constraints */
+  inline Eigen::Index nrEq() const noexcept { return beq.size(); }
+
+  /** Number of general inequality constraints (not counting the bounds) */
+  inline Eigen::Index nrIneq() const noexcept { return lineq.size(); }
+
+  /** Write this problem to a stream (binary) */
+  void write(std::ostream & os) const;
+
+  /** Read a problem from a stream
+   *
+   * The sizes stored in the stream are checked against sane limits and, if the stream is seekable, against the
+   * remaining data before anything is allocated
+   *
+   * \returns False if the stream does not hold a complete problem
+   */
+  bool read(std::istream & is);
+};
+
+/** Writes QPProblem to a file
+ *
+ * The file starts with a small header followed by the problems written by \ref QPProblem::write
+ *
+ * Problems are serialized in memory by \ref write and written to the file by a background thread so that recording
+ * does not block the caller on disk I/O. The file is complete once the writer is destroyed.
+ */
+struct MC_SOLVER_DLLAPI QPProblemWriter
+{
+  /** Open \p path for writing
+   *
+   * \throws std::runtime_error if the file cannot be opened
+   */
+  QPProblemWriter(const std::string & path);
+
+  QPProblemWriter(const QPProblemWriter &) = delete;
+  QPProblemWriter & operator=(const QPProblemWriter &) = delete;
+
+  /** Wait for the pending problems to be written and close the file */
+  ~QPProblemWriter();
+
+  /** Queue a problem for writing */
+  void write(const QPProblem & problem);
+
+  /** Path of the file */
+  inline const std::string & path() const noexcept { return path_; }
+
+  /** Number of problems queued so far */
+  inline size_t size() const noexcept { return size_; }
+
+private:
+  std::string path_;
+  size_t size_ = 0;
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/** Reads problems written by a QPProblemWriter */
+struct MC_SOLVER_DLLAPI QPProblemReader
+{
+  /** Open \p path for reading
+   *
+   * \throws std::runtime_error if the file cannot be opened or is not a recording
+   */
+  QPProblemReader(const std::string & path);
+
+  /** Read the next problem
+   *
+   * \returns False if there is no more problem to read
+   */
+  bool next(QPProblem & problem);
+
+private:
+  std::ifstream ifs_;
+};
+
+/** Recording options of a QPSolver, see \ref QPSolver::startRecording */
+struct MC_SOLVER_DLLAPI QPRecordingOptions
+{
+  /** Record every problem whose build and solve time exceeds this threshold (ms), ignored if negative */
+  double threshold = -1;
+  /** Record the problems solved at these iterations (counted from the start of the recording) */
+  std::set<uint64_t> ticks = {};
+  /** Record every problem */
+  bool all = false;
+
+  inline bool operator==(const QPRecordingOptions & rhs) const noexcept
+  {
+    return threshold == rhs.threshold && ticks == rhs.ticks && all == rhs.all;
+  }
+  inline bool operator!=(const QPRecordingOptions & rhs) const noexcept { return !(*this == rhs); }
+};
+
+} // namespace mc_solver
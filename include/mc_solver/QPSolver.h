@@ -4,14 +4,17 @@
 
 #pragma once
 
+#include <mc_solver/QPProblem.h>
 #include <mc_solver/api.h>
 
 #include <mc_control/api.h>
 #include <mc_rbdyn/Contact.h>
 #include <mc_rbdyn/Robots.h>
 
+#include <mc_rtc/WorkerPool.h>
 #include <mc_rtc/pragma.h>
 
+#include <exception>
 #include <memory>
 
 namespace mc_tasks
@@ -24,6 +27,7 @@ struct MetaTask;
 namespace mc_rtc
 {
 
+struct Configuration;
 struct Logger;
 
 namespace gui
@@ -208,6 +212,129 @@ public:
     if(task) { removeTask(task.get()); }
   }
 
+  /** Configure backend-specific options of the solver
+   *
+   * This is typically used with the "QPSolver" section of a controller's configuration, the default implementation
+   * handles the "record" (see \ref startRecording) and "parallelUpdate" (see \ref parallelUpdate) entries, see the
+   * backends' documentation for other options
+   *
+   * \throws If the configuration is invalid for this backend
+   */
+  virtual void configure(const mc_rtc::Configuration & config);
+
+  /** Start recording the problems solved by this solver
+   *
+   * Problems are written to \p path and can be replayed offline with the mc_qp_replay tool, see \ref QPProblem.
+   *
+   * Recording is opt-in and has no cost when disabled, when enabled the problem is only extracted at the iterations
+   * selected by \p options.
+   *
+   * This is also available through the "record" entry of \ref configure:
+   * - path: output file
+   * - threshold: record problems whose build and solve time exceeds this threshold (ms)
+   * - ticks: record the problems solved at these iterations
+   * - all: record every problem
+   *
+   * Calling this again with the same path and options while recording has no effect, the recording continues. This
+   * happens when the same configuration is applied several times.
+   *
+   * Only the TVM backend supports recording, see \ref recordingSupported
+   *
+   * \throws std::runtime_error if the backend does not support recording or if the output file cannot be opened
+   */
+  void startRecording(const std::string & path, const QPRecordingOptions & options);
+
+  /** Stop recording the problems */
+  void stopRecording() noexcept;
+
+  /** Record the problem solved during the next run (requires an active recording) */
+  void recordNextProblem();
+
+  /** True if the solver is recording problems */
+  inline bool recording() const noexcept { return static_cast<bool>(recorder_); }
+
+  /** True if this backend can extract its problems, i.e. if \ref startRecording can be used
+   *
+   * The Tasks backend does not support recording: tasks::qp::QPSolver assembles the problem inside its GenQPSolver
+   * implementation (LSSOL, QLD or QuadProg) and does not expose the resulting matrices
+   */
+  virtual bool recordingSupported() const noexcept { return false; }
+
+  /** Update the thread-safe tasks in parallel
+   *
+   * When enabled, consecutive tasks whose mc_tasks::MetaTask::threadSafeUpdate returns true are updated concurrently
+   * on a worker pool, the other tasks are updated in the calling thread. Tasks are still updated in the order they
+   * were added: a task that is not thread-safe sees every task added before it updated and none of the tasks added
+   * after it. All updates complete before the problem is assembled and solved. The force sensors' derived quantities
+   * are refreshed before each parallel update so that tasks can read them concurrently.
+   *
+   * This is disabled by default. It is also available through the "parallelUpdate" entry of \ref configure:
+   * - threads: number of worker threads, 0 disables the parallel update
+   * - cpus: CPUs the workers are pinned to (optional)
+   *
+   * Setting the MC_RTC_SERIAL_TASK_UPDATE environment variable disables the parallel update regardless of the
+   * configuration, it is checked when this is called, this is meant for debugging.
+   *
+   * \param threads Number of worker threads (the calling thread also takes part in the work), 0 disables the
+   * parallel update
+   *
+   * \param cpus If non-empty, worker threads are pinned to these CPUs
+   */
+  void parallelUpdate(size_t threads, const std::vector<int> & cpus = {});
+
+  /** Number of worker threads used by the parallel update (0 if it is disabled) */
+  inline size_t parallelUpdate() const noexcept { return updatePool_ ? updatePool_->size() : 0; }
+
+  /** Begin a transaction
+   *
+   * While a transaction is open, the backend work required by structural changes (adding/removing tasks, constraints
+   * and contacts) is deferred and performed once when the outermost transaction is committed or, at the latest, before
+   * the next run of the solver.
+   *
+   * Transactions can be nested, each call must be matched by a call to \ref commitTransaction, prefer \ref
+   * Transaction for exception-safety.
+   */
+  void beginTransaction() noexcept;
+
+  /** Commit the current transaction
+   *
+   * Pending structural changes are applied if this closes the outermost transaction
+   */
+  void commitTransaction();
+
+  /** Close the current transaction without applying the pending structural changes
+   *
+   * The changes made within the transaction are not reverted: their backend work is performed by the next commit of
+   * an outermost transaction or before the next run of the solver. This is meant for error paths.
+   */
+  void abortTransaction() noexcept;
+
+  /** True if a transaction is currently open */
+  inline bool inTransaction() const noexcept { return transactionDepth_ > 0; }
+
+  /** Scoped transaction, begins a transaction on construction and commits it on destruction
+   *
+   * If the scope is left because of an exception the transaction is aborted instead (see \ref abortTransaction).
+   * Errors raised by the commit are logged, the destructor never throws.
+   */
+  struct MC_SOLVER_DLLAPI Transaction
+  {
+    Transaction(QPSolver & solver) noexcept : solver_(solver), exceptions_(std::uncaught_exceptions())
+    {
+      solver_.beginTransaction();
+    }
+
+    Transaction(const Transaction &) = delete;
+    Transaction & operator=(const Transaction &) = delete;
+
+    ~Transaction() noexcept;
+
+  private:
+    QPSolver & solver_;
+    /** Number of uncaught exceptions when the transaction started */
+    int exceptions_;
+  };
+
   /** Reset all contacts in the solver and use the new set of contacts provided
    * \item contact Set of mc_rbdyn::Contact
    */
@@ -325,6 +452,56 @@ protected:
   /** Can be nullptr if this not associated to any controller */
   mc_control::MCController * controller_ = nullptr;
 
+  /** Active problem recording */
+  struct Recorder
+  {
+    QPProblemWriter writer;
+    QPRecordingOptions options;
+    /** Number of runs since the recording started */
+    uint64_t tick = 0;
+    /** True if the next problem should be recorded */
+    bool recordNext = false;
+  };
+  std::unique_ptr<Recorder> recorder_;
+
+  /** Write the last problem to the recording if it is selected */
+  void recordProblem();
+
+  /** Worker threads for the parallel update, nullptr if disabled */
+  std::unique_ptr<mc_rtc::WorkerPool> updatePool_;
+  /** True if MC_RTC_SERIAL_TASK_UPDATE was set when the parallel update was enabled */
+  bool serialUpdate_ = false;
+
+  /** Contiguous thread-safe tasks waiting to be updated in parallel */
+  std::vector<mc_tasks::MetaTask *> parallelTasks_;
+
+  /** Update the tasks in parallelTasks_ and clear it */
+  void updateParallelTasks();
+
+  /** Update the tasks in the solver, called by the backends before solving the problem
+   *
+   * This calls mc_tasks::MetaTask::scheduledUpdate and mc_tasks::MetaTask::incrementIterInSolver for every task, see
+   * \ref parallelUpdate
+   */
+  void updateTasks();
+
+  /** Number of currently open transactions */
+  unsigned int transactionDepth_ = 0;
+
+  /** Apply structural changes deferred by a transaction
+   *
+   * This is called when the outermost transaction is committed and before each run
+   */
+  virtual void applyStructuralChanges() {}
+
+  /** Extract the problem solved during the last run
+   *
+   * This is only called when \ref recordingSupported returns true
+   *
+   * \returns False if the problem could not be extracted, the default implementation always returns false
+   */
+  virtual bool assembledProblem(QPProblem & problem) const;
+
   /** Should run the control prroblem and update the control robot accordingly */
   virtual bool run_impl(FeedbackType fType = FeedbackType::None) = 0;
 
@@ -6,6 +6,7 @@
 
 #include <mc_solver/QPSolver.h>
 
+#include <mc_rtc/Configuration.h>
 #include <mc_rtc/clock.h>
 
 #include <tvm/ControlProblem.h>
@@ -22,9 +23,18 @@ namespace mc_solver
  */
 struct MC_SOLVER_DLLAPI TVMQPSolver final : public QPSolver
 {
-  TVMQPSolver(mc_rbdyn::RobotsPtr robots, double timeStep);
+  /** Constructor
+   *
+   * \param robots Robots controlled by this solver
+   *
+   * \param timeStep Control timestep
+   *
+   * \param config Solver options, see \ref configure
+   */
+  TVMQPSolver(mc_rbdyn::RobotsPtr robots, double timeStep, const mc_rtc::Configuration & config = {});
 
-  TVMQPSolver(double timeStep);
+  /** Constructor (the solver creates its own Robots instance) */
+  TVMQPSolver(double timeStep, const mc_rtc::Configuration & config = {});
 
   ~TVMQPSolver() final = default;
 
@@ -36,6 +46,28 @@ struct MC_SOLVER_DLLAPI TVMQPSolver final : public QPSolver
 
   double solveAndBuildTime() final;
 
+  /** Select the least-squares solver and its options
+   *
+   * Supported entries:
+   * - solver: one of \ref availableSolvers (default: "default", TVM's default solver)
+   * - verbose: enable the solver's verbose output (default: false)
+   * - scalarizationWeight: weight ratio between priority levels in the weighted scheme (default: 1000)
+   *
+   * Entries that are not provided keep their current value, the solver is only re-created if one of them is
+   * provided. This can be called at any time, the problem is rebuilt on the next run
+   *
+   * \throws std::invalid_argument if the requested solver is not available
+   */
+  void configure(const mc_rtc::Configuration & config) final;
+
+  inline bool recordingSupported() const noexcept final { return true; }
+
+  /** Name of the least-squares solver currently used */
+  inline const std::string & lsSolver() const noexcept { return lsSolver_; }
+
+  /** Least-squares solvers available in this build of TVM */
+  static std::vector<std::string> availableSolvers();
+
   /** Access the internal problem */
   inline tvm::LinearizedControlProblem & problem() noexcept { return problem_; }
 
@@ -70,7 +102,11 @@ private:
   /** Control problem */
   tvm::LinearizedControlProblem problem_;
   /** Solver scheme */
-  tvm::scheme::WeightedLeastSquares solver_;
+  std::unique_ptr<tvm::scheme::WeightedLeastSquares> solver_;
+  /** Name of the least-squares solver */
+  std::string lsSolver_;
+  /** Verbose output of the least-squares solver */
+  bool verbose_ = false;
   /** Contact data on the solver side */
   struct ContactData
   {
@@ -87,6 +123,8 @@ private:
   };
   /** Related contact functions */
   std::vector<ContactData> contactsData_;
+  /** Weight ratio between priority levels used by the scheme */
+  double scalarizationWeight_ = 1000;
   /** Runtime of the latest run call */
   mc_rtc::duration_ms solve_dt_{0};
 
@@ -133,6 +171,12 @@ private:
 
   bool run_impl(FeedbackType fType = FeedbackType::None) final;
 
+  /** Extract the problem as seen by the weighted least-squares scheme
+   *
+   * Inequality objectives have no equivalent in \ref QPProblem and are left out
+   */
+  bool assembledProblem(QPProblem & problem) const final;
+
   void addDynamicsConstraint(mc_solver::DynamicsConstraint * dynamics) final;
 
   void removeDynamicsConstraint(mc_solver::ConstraintSet * maybe_dynamics) final;
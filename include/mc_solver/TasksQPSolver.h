@@ -65,8 +65,8 @@ struct MC_SOLVER_DLLAPI TasksQPSolver final : public QPSolver
   void addConstraint(tasks::qp::ConstraintFunction<Fun...> * constraint)
   {
     constraint->addToSolver(robots().mbs(), solver_);
-    solver_.updateConstrSize();
-    solver_.updateNrVars(robots().mbs());
+    updateConstrSize();
+    updateNrVars(robots());
   }
 
   /** Remove a constraint function from the solver
@@ -76,8 +76,8 @@ struct MC_SOLVER_DLLAPI TasksQPSolver final : public QPSolver
   void removeConstraint(tasks::qp::ConstraintFunction<Fun...> * constraint)
   {
     constraint->removeFromSolver(solver_);
-    solver_.updateConstrSize();
-    solver_.updateNrVars(robots().mbs());
+    updateConstrSize();
+    updateNrVars(robots());
   }
 
   /** Gives access to the tasks::qp::BilateralContact entity in the solver from a contact id
@@ -99,10 +99,15 @@ struct MC_SOLVER_DLLAPI TasksQPSolver final : public QPSolver
    *
    * This should be called when/if you add new robots into the scene after the
    * solver initialization, this is a costly operation.
+   *
+   * \note Deferred until the transaction is committed if called within a transaction
    */
   void updateNrVars();
 
-  /** Update nr vars in tasks and constraints */
+  /** Update nr vars in tasks and constraints
+   *
+   * \note Deferred until the transaction is committed if called within a transaction
+   */
   void updateNrVars(const mc_rbdyn::Robots & robots);
 
   /** Update constraints matrix sizes
@@ -110,6 +115,8 @@ struct MC_SOLVER_DLLAPI TasksQPSolver final : public QPSolver
    * \note This is mainly provided to allow safe usage of raw constraint from
    * Tasks rather than those wrapped in this library, you probably do not need
    * to call this
+   *
+   * \note Deferred until the transaction is committed if called within a transaction
    */
   void updateConstrSize();
 
@@ -164,6 +171,12 @@ private:
   std::vector<tasks::qp::UnilateralContact> uniContacts_;
   /** Holds bilateral contacts in the solver */
   std::vector<tasks::qp::BilateralContact> biContacts_;
+  /** Structural updates deferred by a transaction */
+  bool pendingNrVars_ = false;
+  bool pendingUpdateNrVars_ = false;
+  bool pendingConstrSize_ = false;
+
+  void applyStructuralChanges() final;
   /** Run without feedback (open-loop) */
   bool runOpenLoop();
   /** Run with encoders' feedback */
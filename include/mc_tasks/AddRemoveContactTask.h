@@ -117,9 +117,9 @@ public:
 
   Eigen::VectorXd dimWeight() const override;
 
-  Eigen::VectorXd eval() const override;
+  Eigen::VectorXd eval() const final;
 
-  Eigen::VectorXd speed() const override;
+  Eigen::VectorXd speed() const final;
 
 public:
   const mc_rbdyn::Robots & robots;
@@ -145,6 +145,11 @@ public:
   mc_rtc::void_ptr impl_;
   double targetVelWeight;
 
+protected:
+  void fastEval(Eigen::VectorXd & out) const override;
+
+  void fastSpeed(Eigen::VectorXd & out) const override;
+
 private:
   /* Hide these virtual functions */
   void selectActiveJoints(mc_solver::QPSolver &,
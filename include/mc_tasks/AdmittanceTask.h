@@ -85,6 +85,12 @@ public:
    */
   void reset() override;
 
+  /*! \brief The update only reads the force sensor and updates the task's targets
+   *
+   * This is also true for mc_tasks::force::DampingTask and mc_tasks::force::CoPTask
+   */
+  bool threadSafeUpdate() const noexcept override { return true; }
+
   /*! \brief Get the admittance coefficients of the task
    *
    */
@@ -180,11 +180,16 @@ public:
 
   void resetJointsSelector(mc_solver::QPSolver & solver) override;
 
-  Eigen::VectorXd eval() const override { return wrench_.vector(); }
+  Eigen::VectorXd eval() const final { return evalFromFastPath(); }
 
-  Eigen::VectorXd speed() const override
+  Eigen::VectorXd speed() const final { return speedFromFastPath(); }
+
+protected:
+  void fastEval(Eigen::VectorXd & out) const override { out = wrench_.vector(); }
+
+  void fastSpeed(Eigen::VectorXd & out) const override
   {
-    return robots_.robot(rIndex_).mbc().bodyVelW[robots_.robot(rIndex_).bodyIndexByName(sensor_.parentBody())].vector();
+    out = robots_.robot(rIndex_).mbc().bodyVelW[robots_.robot(rIndex_).bodyIndexByName(sensor_.parentBody())].vector();
   }
 
 private:
@@ -89,9 +89,9 @@ public:
 
   void resetJointsSelector(mc_solver::QPSolver & solver) override;
 
-  Eigen::VectorXd eval() const override;
+  Eigen::VectorXd eval() const final;
 
-  Eigen::VectorXd speed() const override;
+  Eigen::VectorXd speed() const final;
 
   void load(mc_solver::QPSolver & solver, const mc_rtc::Configuration & config) override;
 
@@ -106,6 +106,10 @@ public:
   sva::PTransformd curTransform;
 
 protected:
+  void fastEval(Eigen::VectorXd & out) const override;
+
+  void fastSpeed(Eigen::VectorXd & out) const override;
+
   void removeFromSolver(mc_solver::QPSolver & solver) override;
 
   void addToSolver(mc_solver::QPSolver & solver) override;
@@ -119,6 +123,12 @@ protected:
   void addToGUI(mc_rtc::gui::StateBuilder & gui) override;
 
   inline const mc_rbdyn::RobotFrame & frame() const noexcept { return *positionTask->frame_; }
+
+  /** Receives the sub-tasks' error or speed in fastEval/fastSpeed
+   *
+   * mutable to allow update in const method
+   */
+  mutable Eigen::VectorXd subTaskBuffer_;
 };
 
 } // namespace mc_tasks
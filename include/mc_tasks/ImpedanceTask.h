@@ -95,6 +95,12 @@ public:
    */
   void reset() override;
 
+  /*! \brief The update only reads the force sensor and integrates the task's compliance state
+   *
+   * This is also true for mc_tasks::force::FirstOrderImpedanceTask
+   */
+  bool threadSafeUpdate() const noexcept override { return true; }
+
   /*! \brief Access the impedance gains */
   inline const ImpedanceGains & gains() const noexcept { return gains_; }
 
@@ -81,6 +81,10 @@ struct MC_TASKS_DLLAPI LookAtTask : public VectorOrientationTask
 
   void load(mc_solver::QPSolver & solver, const mc_rtc::Configuration & config) override;
 
+protected:
+  /*! \brief Aim the gaze vector at the last target position from the current frame position */
+  void interpolate(mc_solver::QPSolver &, unsigned int) override;
+
 private:
   void addToLogger(mc_rtc::Logger & logger) override;
   void addToGUI(mc_rtc::gui::StateBuilder & gui) override;
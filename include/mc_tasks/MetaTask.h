@@ -13,6 +13,7 @@
 #include <mc_solver/QPSolver.h>
 #include <mc_solver/api.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace mc_control
@@ -142,6 +143,20 @@ public:
    */
   virtual Eigen::VectorXd speed() const = 0;
 
+  /*! \brief Writes the task error in \p out
+   *
+   * This gives the same result as eval(), it is meant for code that checks the error every iteration (e.g.
+   * mc_control::CompletionCriteria). It does not allocate once \p out has the task dimension if the task enabled its
+   * fast path (see fastEvalEnabled_), otherwise it copies eval().
+   */
+  void evalInto(Eigen::VectorXd & out) const;
+
+  /*! \brief Writes the task velocity in \p out
+   *
+   * Non-allocating counterpart of speed(), see evalInto()
+   */
+  void speedInto(Eigen::VectorXd & out) const;
+
   /*! \brief Load parameters from a Configuration object */
   virtual void load(mc_solver::QPSolver & solver, const mc_rtc::Configuration & config);
 
@@ -149,11 +164,50 @@ public:
   inline size_t iterInSolver() const noexcept { return iterInSolver_; }
 
   /*! \brief Set the number of iterations since the task was added to the solver to zero */
-  inline void resetIterInSolver() noexcept { iterInSolver_ = 0; }
+  inline void resetIterInSolver() noexcept
+  {
+    iterInSolver_ = 0;
+    iterSinceUpdate_ = 0;
+  }
 
   /*! \brief Increment the number of iterations since the task was added to the solver */
   inline void incrementIterInSolver() noexcept { iterInSolver_++; }
 
+  /*! \brief Set the update period of the task
+   *
+   * With a period of N, the solver calls \ref update once every N iterations and \ref interpolate on the other
+   * iterations. This is meant for tasks whose update is expensive and whose targets do not need to be recomputed at
+   * the controller rate.
+   *
+   * This can also be set with the "updatePeriod" (in iterations) or "updateRate" (in Hz) entries of \ref load
+   *
+   * \note Tasks that close a feedback loop in their update (e.g. admittance or stabilization tasks) should keep the
+   * default period
+   *
+   * The update rate and cost of the task are logged while the period is greater than 1
+   *
+   * \param period Update period in iterations, 0 is treated as 1 (update at every iteration, the default)
+   */
+  void updatePeriod(unsigned int period);
+
+  /*! \brief Get the update period of the task (in iterations) */
+  inline unsigned int updatePeriod() const noexcept { return updatePeriod_; }
+
+  /*! \brief True if \ref update and \ref interpolate can run concurrently with other tasks' updates
+   *
+   * When the solver's parallel update is enabled (see mc_solver::QPSolver::parallelUpdate) the updates of these tasks
+   * are executed on a worker pool before the problem is assembled.
+   *
+   * A thread-safe update only modifies the task's own state, only reads the robots' state (including force sensors)
+   * and does not use the solver beyond its const interface, the logger or the GUI.
+   *
+   * The default implementation returns false, derived classes that override \ref update must re-evaluate this.
+   */
+  virtual bool threadSafeUpdate() const noexcept { return false; }
+
+  /*! \brief Duration of the last call to \ref update (ms) */
+  inline double updateCost() const noexcept { return updateCost_; }
+
   inline Backend backend() const noexcept { return backend_; }
 
 protected:
@@ -191,6 +245,35 @@ protected:
   /*! Helper function when using another MetaTask inside a MetaTask */
   static inline void update(MetaTask & t, mc_solver::QPSolver & solver) { t.update(solver); }
 
+  /*! \brief Called in place of \ref update on the iterations where the update is skipped
+   *
+   * This is only called if the task has an \ref updatePeriod greater than 1. Implementations should keep the task's
+   * targets consistent with the elapsed time in a cheap way, e.g. by interpolating or extrapolating the targets
+   * computed by the last update.
+   *
+   * The default implementation keeps the targets set by the last update.
+   *
+   * \param solver Solver in which the task is inserted
+   *
+   * \param iter Number of iterations since the last update (between 1 and updatePeriod() - 1)
+   */
+  virtual void interpolate(mc_solver::QPSolver &, unsigned int /* iter */) {}
+
+  /*! Called by the solver at every iteration, calls \ref update or \ref interpolate according to \ref updatePeriod */
+  void scheduledUpdate(mc_solver::QPSolver & solver);
+
+  /*! Log the update rate and cost of the task in \p logger while its \ref updatePeriod is greater than 1
+   *
+   * This is done by the solver when the task is added, the entries follow later changes of the update period
+   */
+  void addUpdateToLogger(mc_rtc::Logger & logger, double dt);
+
+  /*! Remove the entries added by \ref addUpdateToLogger, if any, and stop following the update period */
+  void removeUpdateFromLogger(mc_rtc::Logger & logger);
+
+  /*! Add or remove the update entries of the logger given to \ref addUpdateToLogger according to the period */
+  void updateUpdateLogEntries();
+
   /** Add entries to the logger
    *
    * This will be called by the solver if it holds a valid logger instance when
@@ -279,6 +362,23 @@ protected:
       double dt,
       const mc_rtc::Configuration & config) const;
 
+  /*! \brief Writes the task error in \p out without allocating once \p out has the task dimension
+   *
+   * This is only used by evalInto() when fastEvalEnabled_ is true, see there.
+   *
+   * The default implementation copies eval().
+   */
+  virtual void fastEval(Eigen::VectorXd & out) const { out = eval(); }
+
+  /*! \brief Non-allocating counterpart of speed(), see fastEval() and fastSpeedEnabled_ */
+  virtual void fastSpeed(Eigen::VectorXd & out) const { out = speed(); }
+
+  /*! \brief Implements eval() with fastEval() */
+  Eigen::VectorXd evalFromFastPath() const;
+
+  /*! \brief Implements speed() with fastSpeed() */
+  Eigen::VectorXd speedFromFastPath() const;
+
   /** QPSolver backend at creation time */
   Backend backend_;
 
@@ -286,6 +386,25 @@ protected:
   std::string name_;
 
   size_t iterInSolver_ = 0;
+  unsigned int updatePeriod_ = 1;
+  unsigned int iterSinceUpdate_ = 0;
+  double updateCost_ = 0;
+  /** Logger given to addUpdateToLogger */
+  mc_rtc::Logger * updateLogger_ = nullptr;
+  /** Timestep given to addUpdateToLogger */
+  double updateLoggerDt_ = 0;
+  /** True if the update entries are in updateLogger_ */
+  bool updateLogged_ = false;
+
+  /** When true, evalInto() calls fastEval() instead of eval()
+   *
+   * Only a task whose eval() is final and implemented with evalFromFastPath() may set this (in its constructor),
+   * otherwise an eval() override in a derived class would be skipped by evalInto()
+   */
+  bool fastEvalEnabled_ = false;
+
+  /** When true, speedInto() calls fastSpeed() instead of speed(), see fastEvalEnabled_ */
+  bool fastSpeedEnabled_ = false;
 };
 
 using MetaTaskPtr = std::shared_ptr<MetaTask>;
@@ -87,7 +87,24 @@ public:
 
   void addToLogger(mc_rtc::Logger & logger) override;
 
+protected:
+  /*! \brief Propagate the last error with the motion of the control frame
+   *
+   * The target is assumed to be static since the last call to \ref error
+   */
+  void interpolate(mc_solver::QPSolver &, unsigned int) override;
+
+  /*! \brief Propagate the error as in \ref interpolate when the task has an update period greater than 1 */
+  void update(mc_solver::QPSolver & solver) override;
+
 private:
+  /** Control frame */
+  mc_rbdyn::ConstRobotFramePtr frame_;
   sva::PTransformd X_t_s_;
+  /** Target pose in world frame estimated from the last error */
+  sva::PTransformd X_0_t_;
+
+  /** Set the error in the backend task without changing the target estimate */
+  void setError(const sva::PTransformd & X_t_s);
 };
 } // namespace mc_tasks
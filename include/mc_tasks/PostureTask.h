@@ -61,9 +61,9 @@ public:
    */
   void resetJointsSelector(mc_solver::QPSolver & solver) override;
 
-  Eigen::VectorXd eval() const override;
+  Eigen::VectorXd eval() const final;
 
-  Eigen::VectorXd speed() const override;
+  Eigen::VectorXd speed() const final;
 
   /** Change posture objective */
   void posture(const std::vector<std::vector<double>> & p);
@@ -146,6 +146,10 @@ public:
   bool inSolver() const;
 
 protected:
+  void fastEval(Eigen::VectorXd & out) const override;
+
+  void fastSpeed(Eigen::VectorXd & out) const override;
+
   void addToSolver(mc_solver::QPSolver & solver) override;
 
   void removeFromSolver(mc_solver::QPSolver & solver) override;
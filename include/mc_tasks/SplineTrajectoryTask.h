@@ -259,7 +259,7 @@ struct SplineTrajectoryTask : public TrajectoryTaskGeneric
    *
    * \returns The error w.r.t the final target
    */
-  Eigen::VectorXd eval() const override;
+  Eigen::VectorXd eval() const final;
 
   /**
    * \brief Returns the trajectory tracking error: transformError between the current robot surface pose
@@ -318,7 +318,13 @@ struct SplineTrajectoryTask : public TrajectoryTaskGeneric
   /** @brief Returns the trajectory's duration */
   inline double duration() const noexcept { return duration_; }
 
+  /** The update only samples the task's own splines */
+  bool threadSafeUpdate() const noexcept override { return true; }
+
 protected:
+  /*! \brief Writes the error w.r.t the final target in \p out, see eval() */
+  void fastEval(Eigen::VectorXd & out) const override;
+
   /**
    * \brief Tracks a reference world pose
    *
@@ -352,6 +358,12 @@ protected:
   /*! \brief Update trajectory target */
   void update(mc_solver::QPSolver &) override;
 
+  /*! \brief Extrapolate the position target from the last sample of the trajectory
+   *
+   * The orientation and gains are still evaluated at every iteration as they are cheap to compute
+   */
+  void interpolate(mc_solver::QPSolver &, unsigned int) override;
+
   /** Interpolate dimWeight, stiffness, damping */
   void interpolateGains();
 
@@ -28,6 +28,7 @@ SplineTrajectoryTask<Derived>::SplineTrajectoryTask(const mc_rbdyn::RobotFrame &
 {
   type_ = "trajectory";
   name_ = "trajectory_" + frame.robot().name() + "_" + frame.name();
+  this->fastEvalEnabled_ = true;
 
   switch(backend_)
   {
@@ -186,6 +187,22 @@ void SplineTrajectoryTask<Derived>::update(mc_solver::QPSolver & solver)
   }
 }
 
+template<typename Derived>
+void SplineTrajectoryTask<Derived>::interpolate(mc_solver::QPSolver & solver, unsigned int)
+{
+  if(paused_ || currTime_ >= duration_) { return; }
+  interpolateGains();
+
+  double dt = solver.dt();
+  Eigen::VectorXd refVel = this->refVel();
+  const Eigen::VectorXd & refAcc = this->refAccel();
+  Eigen::Vector3d pos = refPose().translation() + dt * refVel.tail<3>() + 0.5 * dt * dt * refAcc.tail<3>();
+  refVel.tail<3>() += dt * refAcc.tail<3>();
+  this->refVel(refVel);
+  this->refPose({oriSpline_.eval(currTime_), pos});
+  currTime_ = std::min(currTime_ + dt, duration_);
+}
+
 template<typename Derived>
 void SplineTrajectoryTask<Derived>::interpolateGains()
 {
@@ -311,13 +328,21 @@ const sva::PTransformd SplineTrajectoryTask<Derived>::target() const
 template<typename Derived>
 Eigen::VectorXd SplineTrajectoryTask<Derived>::eval() const
 {
-  return sva::transformError(frame_->position(), target()).vector();
+  return this->evalFromFastPath();
+}
+
+template<typename Derived>
+void SplineTrajectoryTask<Derived>::fastEval(Eigen::VectorXd & out) const
+{
+  out = sva::transformError(frame_->position(), target()).vector();
 }
 
 template<typename Derived>
 Eigen::VectorXd SplineTrajectoryTask<Derived>::evalTracking() const
 {
-  return TrajectoryBase::eval();
+  Eigen::VectorXd out;
+  TrajectoryBase::fastEval(out);
+  return out;
 }
 
 template<typename Derived>
@@ -254,6 +254,10 @@ struct MC_TASKS_DLLAPI TrajectoryTaskGeneric : public MetaTask
   void load(mc_solver::QPSolver & solver, const mc_rtc::Configuration & config) override;
 
 protected:
+  void fastEval(Eigen::VectorXd & out) const override;
+
+  void fastSpeed(Eigen::VectorXd & out) const override;
+
   /*! This function should be called to finalize the task creation, it will
    * create the actual tasks objects */
   /** This function must be called by the derived class to finalize the creation of the task
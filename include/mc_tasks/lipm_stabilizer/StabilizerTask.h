@@ -150,7 +150,7 @@ struct MC_TASKS_DLLAPI StabilizerTask : public MetaTask
    * sub-tasks. The vector's dimensions depend on the underlying task, and the
    * sub-tasks evaluation depends on their order of insertion.
    */
-  Eigen::VectorXd eval() const override;
+  Eigen::VectorXd eval() const final;
 
   /*! \brief Returns the task velocity
    *
@@ -158,7 +158,7 @@ struct MC_TASKS_DLLAPI StabilizerTask : public MetaTask
    * sub-tasks. The vector's dimensions depend on the underlying task, and the
    * sub-tasks evaluation depends on their order of insertion.
    */
-  Eigen::VectorXd speed() const override;
+  Eigen::VectorXd speed() const final;
 
   /**
    * @brief Enables stabilizer
@@ -814,11 +814,21 @@ private:
 
   /* Task-related properties */
 protected:
+  void fastEval(Eigen::VectorXd & out) const override;
+  void fastSpeed(Eigen::VectorXd & out) const override;
   void addToSolver(mc_solver::QPSolver & solver) override;
   void removeFromSolver(mc_solver::QPSolver & solver) override;
   void removeFromGUI(mc_rtc::gui::StateBuilder &) override;
   void update(mc_solver::QPSolver &) override;
 
+  /** Between two runs of the stabilizer, feed the CoM targets to the CoM task
+   *
+   * New targets given to \ref target are corrected with the last ZMP compliance offsets, otherwise the last CoM target
+   * is extrapolated. The measurements, the wrench distribution and the feedback are only updated by \ref update, this
+   * should only be used with short update periods.
+   */
+  void interpolate(mc_solver::QPSolver &, unsigned int) override;
+
   /** Log stabilizer entries.
    *
    * \param logger Logger.
@@ -870,6 +880,8 @@ protected:
   Eigen::Vector2d supportMin_ = Eigen::Vector2d::Zero();
   Eigen::Vector2d supportMax_ = Eigen::Vector2d::Zero();
   std::shared_ptr<mc_tasks::CoMTask> comTask;
+  /** Receives the sub-tasks' error or speed in fastEval/fastSpeed, mutable to allow update in const method */
+  mutable Eigen::VectorXd subTaskBuffer_;
   std::shared_ptr<mc_tasks::OrientationTask> pelvisTask; /**< Pelvis orientation task */
   std::shared_ptr<mc_tasks::OrientationTask> torsoTask; /**< Torso orientation task */
   const mc_rbdyn::Robots & robots_;
@@ -885,6 +897,8 @@ protected:
   Eigen::Vector3d zmpdTarget_ = Eigen::Vector3d::Zero();
   Eigen::Vector3d dcmTarget_ = Eigen::Vector3d::Zero();
   double omega_ = 3.4;
+  /** True if \ref target was called since the targets were last given to the CoM task */
+  bool newTarget_ = false;
 
   double t_ = 0.; /**< Time elapsed since the task is running */
 
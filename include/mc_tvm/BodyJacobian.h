@@ -0,0 +1,98 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_tvm/api.h>
+#include <mc_tvm/fwd.h>
+
+#include <SpaceVecAlg/SpaceVecAlg>
+
+#include <RBDyn/Jacobian.h>
+
+#include <tvm/graph/abstract/Node.h>
+
+namespace mc_tvm
+{
+
+/** Jacobian of a body of a Robot
+ *
+ * The jacobian is expressed at the body's origin in world coordinates and only holds the columns of the joints that
+ * support the body (see rbd::Jacobian).
+ *
+ * There is one such object per body of a robot and it is shared by every frame and function attached to this body so
+ * that the jacobian is computed once per graph update. Quantities for a specific point or frame are obtained by a
+ * simple transformation of this jacobian.
+ *
+ * It is created through \ref Robot::bodyJacobian
+ *
+ * Outputs:
+ * - Jacobian: jacobian of the body
+ * - JDot: derivative of the jacobian of the body
+ *
+ */
+struct MC_TVM_DLLAPI BodyJacobian : public tvm::graph::abstract::Node<BodyJacobian>
+{
+  SET_OUTPUTS(BodyJacobian, Jacobian, JDot)
+  SET_UPDATES(BodyJacobian, Jacobian, JDot)
+
+  friend struct Robot;
+
+private:
+  struct NewBodyJacobianToken
+  {
+  };
+
+public:
+  /** Constructor
+   *
+   * \param robot Robot to which the body belongs
+   *
+   * \param bodyIdx Index of the body in the robot
+   *
+   */
+  BodyJacobian(NewBodyJacobianToken, Robot & robot, unsigned int bodyIdx);
+
+  /** Jacobian of the body (compact form) */
+  inline const Eigen::MatrixXd & jacobian() const noexcept { return jacobian_; }
+
+  /** Derivative of the jacobian of the body (compact form) */
+  inline const Eigen::MatrixXd & JDot() const noexcept { return jacDot_; }
+
+  /** Compute the jacobian at the frame \p X_0_p in this frame's coordinates
+   *
+   * This is equivalent to rbd::Jacobian::jacobian(mb, mbc, X_0_p) but uses the cached body jacobian
+   *
+   * \param X_0_p Frame in world coordinates
+   *
+   * \param out Output (compact form), must be 6 x \ref dof
+   */
+  void jacobian(const sva::PTransformd & X_0_p, Eigen::Ref<Eigen::MatrixXd> out) const;
+
+  /** Number of degrees of freedom that support the body */
+  inline int dof() const noexcept { return jac_.dof(); }
+
+  /** Index of the body in the robot */
+  inline unsigned int bodyIndex() const noexcept { return bodyIdx_; }
+
+  /** Access the underlying RBDyn Jacobian object, e.g. to expand the compact jacobian */
+  inline const rbd::Jacobian & rbdJacobian() const noexcept { return jac_; }
+
+  inline const Robot & robot() const noexcept { return robot_; }
+
+  inline Robot & robot() noexcept { return robot_; }
+
+private:
+  Robot & robot_;
+  unsigned int bodyIdx_;
+  rbd::Jacobian jac_;
+
+  Eigen::MatrixXd jacobian_;
+  void updateJacobian();
+
+  Eigen::MatrixXd jacDot_;
+  void updateJDot();
+};
+
+} // namespace mc_tvm
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mc_tvm/BodyJacobian.h>
 #include <mc_tvm/Convex.h>
 
 #include <tvm/function/abstract/Function.h>
@@ -80,6 +81,8 @@ protected:
   struct ObjectData
   {
     Eigen::Vector3d nearestPoint_;
+    /** Shared jacobian of the convex's body */
+    const BodyJacobian * bodyJac_;
     rbd::Jacobian jac_;
     Eigen::VectorXd selector_;
   };
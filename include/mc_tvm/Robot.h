@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mc_tvm/BodyJacobian.h>
 #include <mc_tvm/CoM.h>
 #include <mc_tvm/Limits.h>
 #include <mc_tvm/Momentum.h>
@@ -146,6 +147,20 @@ public:
   /** Returns the momentum algorithm associated with this robot (const) */
   inline Momentum & momentumAlgo() noexcept { return *momentum_; }
 
+  /** Returns the jacobian of a body, it is created on the first call and shared by every caller
+   *
+   * \param bodyIdx Index of the body
+   *
+   * \throws If the body index is out of bounds
+   */
+  BodyJacobian & bodyJacobian(unsigned int bodyIdx);
+
+  /** Returns the jacobian of a body by name, see \ref bodyJacobian(unsigned int)
+   *
+   * \throws If the robot does not have such a body
+   */
+  inline BodyJacobian & bodyJacobian(const std::string & body) { return bodyJacobian(robot().bodyIndexByName(body)); }
+
   /** Returns the mass matrix */
   inline const Eigen::MatrixXd & H() const noexcept { return fd_.H(); }
 
@@ -213,6 +228,8 @@ private:
   CoMPtr com_;
   /** Momentum algorithm of this robot */
   MomentumPtr momentum_;
+  /** Jacobians of the bodies (created on demand) */
+  std::vector<BodyJacobianPtr> bodyJacobians_;
   /** Correspondance between refJointOrder index and q index. **/
   std::vector<Eigen::DenseIndex> refJointIndexToQIndex_;
   /** Correspondance between refJointOrder index and q dot index. **/
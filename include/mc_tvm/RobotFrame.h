@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mc_tvm/BodyJacobian.h>
 #include <mc_tvm/Frame.h>
 
 #include <mc_rbdyn/RobotFrame.h>
@@ -58,6 +59,12 @@ public:
    */
   inline const rbd::Jacobian & rbdJacobian() const noexcept { return jac_; }
 
+  /** Jacobian of the body this frame is attached to (const) */
+  inline const BodyJacobian & bodyJacobian() const noexcept { return bodyJac_; }
+
+  /** Jacobian of the body this frame is attached to */
+  inline BodyJacobian & bodyJacobian() noexcept { return bodyJac_; }
+
   /** Returns the associated mc_rbdyn RobotFrame */
   inline const mc_rbdyn::RobotFrame & frame() const noexcept
   {
@@ -67,6 +74,8 @@ public:
 protected:
   Eigen::Matrix3d h_ = Eigen::Matrix3d::Zero();
 
+  /** Shared jacobian of the parent body, the frame's jacobians are derived from it */
+  BodyJacobian & bodyJac_;
   rbd::Jacobian jac_;
   rbd::Blocks blocks_;
 
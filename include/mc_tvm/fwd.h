@@ -9,6 +9,9 @@
 namespace mc_tvm
 {
 
+struct BodyJacobian;
+using BodyJacobianPtr = std::unique_ptr<BodyJacobian>;
+
 struct CoM;
 using CoMPtr = std::unique_ptr<CoM>;
 
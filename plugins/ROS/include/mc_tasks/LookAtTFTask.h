@@ -0,0 +1,11 @@
+/*
+ * Copyright 2015-2022 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <mc_rtc/deprecated.h>
+
+MC_RTC_DEPRECATED_HEADER("This header is deprecated, please use mc_tasks_ros/LookAtTFTask.h instead")
+
+#include <mc_tasks_ros/LookAtTFTask.h>
@@ -0,0 +1,915 @@
+/*
+ * Copyright 2015-2019 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/Robots.h>
+#include <mc_rtc/config.h>
+#include <mc_rtc/logging.h>
+#include <mc_rtc_ros/ros.h>
+
+#include <RBDyn/FK.h>
+
+#ifdef MC_RTC_ROS_IS_ROS2
+#  include <geometry_msgs/msg/wrench_stamped.hpp>
+#  include <mc_rtc_msgs/msg/joint_sensors.hpp>
+#  include <nav_msgs/msg/odometry.hpp>
+#  include <sensor_msgs/msg/imu.hpp>
+#  include <sensor_msgs/msg/joint_state.hpp>
+#  include <std_msgs/msg/string.hpp>
+
+#  include <rclcpp/rclcpp.hpp>
+#else
+#  include <geometry_msgs/WrenchStamped.h>
+#  include <mc_rtc_msgs/JointSensors.h>
+#  include <nav_msgs/Odometry.h>
+#  include <sensor_msgs/Imu.h>
+#  include <sensor_msgs/JointState.h>
+
+#  include <ros/ros.h>
+#endif
+
+#include <tf2_ros/transform_broadcaster.h>
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+#ifdef MC_RTC_ROS_IS_ROS2
+
+namespace ros
+{
+
+static inline bool ok()
+{
+  return rclcpp::ok();
+}
+
+} // namespace ros
+
+#endif
+
+namespace mc_rtc
+{
+
+#ifdef MC_RTC_ROS_IS_ROS2
+
+using NodeHandle = rclcpp::Node;
+template<typename MessageT>
+using Publisher = std::shared_ptr<rclcpp::Publisher<MessageT>>;
+using Time = rclcpp::Time;
+
+using Imu = sensor_msgs::msg::Imu;
+using JointSensors = mc_rtc_msgs::msg::JointSensors;
+using JointState = sensor_msgs::msg::JointState;
+using Odometry = nav_msgs::msg::Odometry;
+using TransformStamped = geometry_msgs::msg::TransformStamped;
+using WrenchStamped = geometry_msgs::msg::WrenchStamped;
+
+#else
+
+using NodeHandle = ros::NodeHandle;
+template<typename MessageT>
+using Publisher = ros::Publisher;
+using Time = ros::Time;
+
+using Imu = sensor_msgs::Imu;
+using JointSensors = mc_rtc_msgs::JointSensors;
+using JointState = sensor_msgs::JointState;
+using Odometry = nav_msgs::Odometry;
+using TransformStamped = geometry_msgs::TransformStamped;
+using WrenchStamped = geometry_msgs::WrenchStamped;
+
+#endif
+
+inline TransformStamped PT2TF(const sva::PTransformd & X,
+                              const Time & tm,
+                              const std::string & from,
+                              const std::string & to,
+                              [[maybe_unused]] unsigned int seq)
+{
+  TransformStamped msg;
+#ifndef MC_RTC_ROS_IS_ROS2
+  msg.header.seq = seq;
+#endif
+  msg.header.stamp = tm;
+  msg.header.frame_id = from;
+  msg.child_frame_id = to;
+
+  Eigen::Vector4d q = Eigen::Quaterniond(X.rotation()).inverse().coeffs();
+  q.normalize();
+  const Eigen::Vector3d & t = X.translation();
+
+  msg.transform.translation.x = t.x();
+  msg.transform.translation.y = t.y();
+  msg.transform.translation.z = t.z();
+
+  msg.transform.rotation.w = q.w();
+  msg.transform.rotation.x = q.x();
+  msg.transform.rotation.y = q.y();
+  msg.transform.rotation.z = q.z();
+
+  return msg;
+}
+
+inline void update_tf(TransformStamped & msg, const sva::PTransformd & X)
+{
+  Eigen::Vector4d q = Eigen::Quaterniond(X.rotation()).inverse().coeffs();
+  const Eigen::Vector3d & t = X.translation();
+
+  msg.transform.translation.x = t.x();
+  msg.transform.translation.y = t.y();
+  msg.transform.translation.z = t.z();
+
+  msg.transform.rotation.w = q.w();
+  msg.transform.rotation.x = q.x();
+  msg.transform.rotation.y = q.y();
+  msg.transform.rotation.z = q.z();
+}
+inline void update_tf(TransformStamped & msg,
+                      const sva::PTransformd & X,
+                      const Time & tm,
+                      const std::string & from,
+                      const std::string & to,
+                      [[maybe_unused]] unsigned int seq)
+{
+  update_tf(msg, X);
+#ifndef MC_RTC_ROS_IS_ROS2
+  msg.header.seq = seq;
+#endif
+  msg.header.stamp = tm;
+  msg.header.frame_id = from;
+  msg.child_frame_id = to;
+}
+
+/** Single-producer single-consumer queue of preallocated frames
+ *
+ * The producer writes into the frame returned by acquire() and makes it available with commit(), the consumer reads
+ * front() and releases it with pop(). Frames are never copied.
+ */
+template<typename T>
+struct FrameQueue
+{
+  explicit FrameQueue(size_t capacity) : frames_(capacity + 1) {}
+
+  /** Returns the next frame to write or nullptr if the queue is full */
+  T * acquire()
+  {
+    size_t tail = tail_;
+    if(increment(tail) == head_) { return nullptr; }
+    return &frames_[tail];
+  }
+
+  /** Publish the frame returned by acquire() */
+  void commit() { tail_ = increment(tail_); }
+
+  /** Returns the oldest frame or nullptr if the queue is empty */
+  const T * front() const
+  {
+    size_t head = head_;
+    if(head == tail_) { return nullptr; }
+    return &frames_[head];
+  }
+
+  /** Release the frame returned by front() */
+  void pop() { head_ = increment(head_); }
+
+private:
+  size_t increment(size_t idx) const { return (idx + 1) % frames_.size(); }
+
+  std::vector<T> frames_;
+  std::atomic_size_t tail_{0};
+  std::atomic_size_t head_{0};
+};
+
+struct RobotPublisherImpl
+{
+  RobotPublisherImpl(NodeHandle & nh, const std::string & prefix, double rate, double dt);
+
+  ~RobotPublisherImpl();
+
+  void init(const mc_rbdyn::Robot & robot, bool use_real);
+
+  void update(double dt, const mc_rbdyn::Robot & robot);
+
+  void set_rate(double rate);
+
+private:
+  NodeHandle & nh;
+#if MC_RTC_ROS_IS_ROS2
+  Publisher<std_msgs::msg::String> paramsTopic;
+  Publisher<std_msgs::msg::String> descriptionTopic;
+#endif
+  Publisher<JointState> j_state_pub;
+  Publisher<Imu> imu_pub;
+  Publisher<JointSensors> j_sensor_pub;
+  Publisher<Odometry> odom_pub;
+  std::map<std::string, Publisher<WrenchStamped>> wrenches_pub;
+  tf2_ros::TransformBroadcaster tf_caster;
+  std::string prefix;
+
+  /** Messages published for every frame, the names and frame ids are set in build() and only the numeric fields are
+   * updated for each frame */
+  struct RobotStateData
+  {
+    JointState js;
+    JointSensors j_sensors;
+    std::vector<TransformStamped> tfs;
+    std::vector<TransformStamped> surface_tfs;
+    Imu imu;
+    Odometry odom;
+    std::vector<WrenchStamped> wrenches;
+    /** Publisher of each wrench (points into RobotPublisherImpl::wrenches_pub) */
+    std::vector<Publisher<WrenchStamped> *> wrench_pubs;
+  };
+
+  struct RobotDescription;
+
+  /** Numeric state of the robot written by the control thread */
+  struct RobotStateFrame
+  {
+    int64_t stamp = 0; ///< Time in nanoseconds
+    uint32_t seq = 0;
+    /** Structure of the robot when the frame was written */
+    std::shared_ptr<const RobotDescription> description;
+    std::vector<double> data; ///< See Layout, only resized the first time the frame is used with a new description
+  };
+
+  /** Offsets of each quantity in RobotStateFrame::data */
+  struct Layout
+  {
+    /** Index in mbc of the 1-dof joints */
+    std::vector<size_t> joints;
+    size_t q = 0; ///< Position, velocity and torque of each 1-dof joint
+    size_t alpha = 0;
+    size_t tau = 0;
+    size_t nJointSensors = 0;
+    size_t jointSensors = 0; ///< Motor temperature, driver temperature and motor current of each sensor
+    size_t imu = 0; ///< Linear acceleration (3), angular velocity (3), orientation (4)
+    size_t odom = 0; ///< Position (3), orientation (4), linear velocity (3), angular velocity (3)
+    size_t nForceSensors = 0;
+    size_t wrenches = 0; ///< Couple (3) and force (3) of each sensor
+    size_t nTfs = 0;
+    /** Translation (3) and rotation (9, column-major) of each joint transformation then of the force sensors that are
+     * not attached to a body */
+    size_t tfs = 0;
+    size_t nSurfaces = 0;
+    size_t surfaces = 0; ///< Same as tfs for each surface
+    size_t size = 0;
+  };
+
+  /** Names and frame layout of the robot
+   *
+   * It is created by the control thread when the robot structure changes and is never modified afterwards. Every frame
+   * points to the description it was written with so the publication thread rebuilds its messages when it meets a new
+   * one.
+   */
+  struct RobotDescription
+  {
+    Layout layout;
+    std::vector<std::string> joints; ///< Name of the 1-dof joints
+    std::vector<std::string> jointSensors; ///< Joint of each joint sensor
+    std::string odomFrame; ///< Child frame of the odometry
+    std::vector<std::string> forceSensors;
+    /** Parent and child frames of the transformations, see Layout::tfs */
+    std::vector<std::pair<std::string, std::string>> tfs;
+    /** Parent and child frames of the surfaces */
+    std::vector<std::pair<std::string, std::string>> surfaces;
+    /** Name and parent body of the force sensors then of the surfaces the description was created with */
+    std::vector<std::pair<std::string, std::string>> frames;
+
+    /** True if the force sensors and surfaces of \p robot are those of this description
+     *
+     * Names are compared rather than counts so that renamed or replaced sensors and surfaces are detected
+     */
+    bool matches(const mc_rbdyn::Robot & robot) const
+    {
+      if(robot.forceSensors().size() + robot.surfaces().size() != frames.size()) { return false; }
+      auto it = frames.begin();
+      for(const auto & fs : robot.forceSensors())
+      {
+        if(it->first != fs.name() || it->second != fs.parentBody()) { return false; }
+        ++it;
+      }
+      for(const auto & s : robot.surfaces())
+      {
+        if(it->first != s.second->name() || it->second != s.second->bodyName()) { return false; }
+        ++it;
+      }
+      return true;
+    }
+  };
+
+  /* Hold the address of the last init/update call */
+  const mc_rbdyn::Robot * previous_robot = nullptr;
+  bool use_real;
+
+  /** Control thread state */
+  uint32_t seq;
+  std::shared_ptr<const RobotDescription> description;
+  unsigned int skip;
+
+  /** Publication thread state */
+  RobotStateData data;
+  /** Description used to build data */
+  std::shared_ptr<const RobotDescription> built;
+
+  /** Publication details */
+  std::atomic<bool> running;
+  FrameQueue<RobotStateFrame> msgs{128};
+  /** Publication rate, the publication thread adjusts its rate when it changes */
+  std::atomic<double> rate;
+  std::thread th;
+
+  void publishThread();
+
+  /** Describe the robot structure, called by the control thread when it changes */
+  void describe(const mc_rbdyn::Robot & robot);
+
+  /** Build the message templates and the wrench publishers, called by the publication thread */
+  void build(const RobotDescription & desc);
+
+  /** Fill the message templates from a frame and publish them */
+  void publish(const RobotStateFrame & frame);
+
+  int64_t now_ns()
+  {
+#ifdef MC_RTC_ROS_IS_ROS2
+    return nh.now().nanoseconds();
+#else
+    return static_cast<int64_t>(Time::now().toNSec());
+#endif
+  }
+
+  Time from_ns(int64_t ns)
+  {
+#ifdef MC_RTC_ROS_IS_ROS2
+    return Time(ns, nh.get_clock()->get_clock_type());
+#else
+    return Time().fromNSec(static_cast<uint64_t>(ns));
+#endif
+  }
+
+  static void write(double * out, const sva::PTransformd & X)
+  {
+    Eigen::Map<Eigen::Vector3d>(out) = X.translation();
+    Eigen::Map<Eigen::Matrix3d>(out + 3) = X.rotation();
+  }
+
+  static sva::PTransformd read(const double * in)
+  {
+    return {Eigen::Map<const Eigen::Matrix3d>(in + 3), Eigen::Map<const Eigen::Vector3d>(in)};
+  }
+};
+
+RobotPublisherImpl::RobotPublisherImpl(NodeHandle & nh, const std::string & prefix, double rate, double dt)
+: nh(nh),
+#if MC_RTC_ROS_IS_ROS2
+  paramsTopic(
+      this->nh.create_publisher<std_msgs::msg::String>(prefix + "robot_module", rclcpp::QoS(1).transient_local())),
+  descriptionTopic(
+      this->nh.create_publisher<std_msgs::msg::String>(prefix + "robot_description", rclcpp::QoS(1).transient_local())),
+  j_state_pub(this->nh.create_publisher<JointState>(prefix + "joint_states", 1)),
+  imu_pub(this->nh.create_publisher<Imu>(prefix + "imu", 1)),
+  j_sensor_pub(this->nh.create_publisher<JointSensors>(prefix + "joint_sensors", 1)),
+  odom_pub(this->nh.create_publisher<Odometry>(prefix + "odom", 1)), tf_caster(nh),
+#else
+  j_state_pub(this->nh.advertise<JointState>(prefix + "joint_states", 1)),
+  imu_pub(this->nh.advertise<Imu>(prefix + "imu", 1)),
+  j_sensor_pub(this->nh.advertise<JointSensors>(prefix + "joint_sensors", 1)),
+  odom_pub(this->nh.advertise<Odometry>(prefix + "odom", 1)), tf_caster(),
+#endif
+  prefix(prefix), use_real(false), seq(0), skip(static_cast<unsigned int>(ceil(1 / (rate * dt)))), running(true),
+  rate(rate), th(std::bind(&RobotPublisherImpl::publishThread, this))
+{
+}
+
+RobotPublisherImpl::~RobotPublisherImpl()
+{
+  running = false;
+  th.join();
+}
+
+void RobotPublisherImpl::init(const mc_rbdyn::Robot & robot, bool use_real)
+{
+  if(&robot == previous_robot) { return; }
+  this->use_real = use_real;
+  previous_robot = &robot;
+
+  describe(robot);
+
+#ifdef MC_RTC_ROS_IS_ROS2
+  {
+    std_msgs::msg::String msg;
+    const auto & params = robot.module().parameters();
+    for(size_t i = 0; i < params.size(); ++i)
+    {
+      msg.data += params[i];
+      if(i + 1 < params.size()) { msg.data += "#"; }
+    }
+    paramsTopic->publish(msg);
+  }
+#else
+  nh.setParam(prefix + "/robot_module", robot.module().parameters());
+#endif
+  const auto & urdf_path = use_real ? robot.module().real_urdf() : robot.module().urdf_path;
+  std::ifstream ifs(urdf_path);
+  if(!ifs.is_open())
+  {
+    mc_rtc::log::error("{} URDF: {} is not readable", robot.name(), urdf_path);
+    return;
+  }
+  std::stringstream urdf;
+  urdf << ifs.rdbuf();
+#ifdef MC_RTC_ROS_IS_ROS2
+  {
+    std_msgs::msg::String msg;
+    msg.data = urdf.str();
+    descriptionTopic->publish(msg);
+  }
+#else
+  nh.setParam(prefix + "/robot_description", urdf.str());
+#endif
+}
+
+void RobotPublisherImpl::describe(const mc_rbdyn::Robot & robot)
+{
+  auto desc = std::make_shared<RobotDescription>();
+  auto & layout = desc->layout;
+
+  for(int jIdx = 0; jIdx < robot.mb().nrJoints(); ++jIdx)
+  {
+    const auto & j = robot.mb().joint(jIdx);
+    if(j.dof() == 1)
+    {
+      desc->joints.push_back(j.name());
+      layout.joints.push_back(static_cast<size_t>(jIdx));
+    }
+  }
+
+  for(const auto & js : robot.jointSensors()) { desc->jointSensors.push_back(js.joint()); }
+
+  desc->odomFrame = prefix + robot.bodySensor().parentBody();
+
+  desc->tfs.emplace_back("robot_map", prefix + robot.mb().body(0).name());
+  for(int j = 1; j < robot.mb().nrJoints(); ++j)
+  {
+    const auto & predName = robot.mb().body(robot.mb().predecessor(j)).name();
+    const auto & succName = robot.mb().body(robot.mb().successor(j)).name();
+    desc->tfs.emplace_back(prefix + predName, prefix + succName);
+  }
+  for(const auto & fs : robot.forceSensors())
+  {
+    desc->forceSensors.push_back(fs.name());
+    desc->frames.emplace_back(fs.name(), fs.parentBody());
+    if(!robot.hasBody(fs.name())) { desc->tfs.emplace_back(prefix + fs.parentBody(), prefix + fs.name()); }
+  }
+
+  // Joint transformations followed by the force sensors that are not attached to a body
+  layout.nTfs = desc->tfs.size();
+
+  for(const auto & s : robot.surfaces())
+  {
+    const auto & surf = s.second;
+    desc->surfaces.emplace_back(prefix + surf->bodyName(), prefix + "surfaces/" + surf->name());
+    desc->frames.emplace_back(surf->name(), surf->bodyName());
+  }
+
+  auto nJoints = layout.joints.size();
+  layout.q = 0;
+  layout.alpha = layout.q + nJoints;
+  layout.tau = layout.alpha + nJoints;
+  layout.nJointSensors = robot.jointSensors().size();
+  layout.jointSensors = layout.tau + nJoints;
+  layout.imu = layout.jointSensors + 3 * layout.nJointSensors;
+  layout.odom = layout.imu + 10;
+  layout.nForceSensors = robot.forceSensors().size();
+  layout.wrenches = layout.odom + 13;
+  layout.tfs = layout.wrenches + 6 * layout.nForceSensors;
+  layout.nSurfaces = desc->surfaces.size();
+  layout.surfaces = layout.tfs + 12 * layout.nTfs;
+  layout.size = layout.surfaces + 12 * layout.nSurfaces;
+
+  description = desc;
+}
+
+void RobotPublisherImpl::build(const RobotDescription & desc)
+{
+  data = RobotStateData();
+
+  auto nJoints = desc.joints.size();
+  data.js.header.frame_id = "";
+  data.js.name = desc.joints;
+  data.js.position.resize(nJoints, 0);
+  data.js.velocity.resize(nJoints, 0);
+  data.js.effort.resize(nJoints, 0);
+
+  auto nJointSensors = desc.jointSensors.size();
+  data.j_sensors.header.frame_id = "";
+  data.j_sensors.name = desc.jointSensors;
+  data.j_sensors.motor_temperature.resize(nJointSensors, std::numeric_limits<double>::quiet_NaN());
+  data.j_sensors.driver_temperature.resize(nJointSensors, std::numeric_limits<double>::quiet_NaN());
+  data.j_sensors.motor_current.resize(nJointSensors, std::numeric_limits<double>::quiet_NaN());
+
+  data.odom.header.frame_id = "robot_map";
+  data.odom.child_frame_id = desc.odomFrame;
+  data.odom.pose.covariance.fill(0);
+  data.odom.twist.covariance.fill(0);
+
+  auto id = sva::PTransformd::Identity();
+  Time tm;
+  for(const auto & tf : desc.tfs) { data.tfs.push_back(PT2TF(id, tm, tf.first, tf.second, 0)); }
+  for(const auto & surf : desc.surfaces) { data.surface_tfs.push_back(PT2TF(id, tm, surf.first, surf.second, 0)); }
+
+  for(const auto & name : desc.forceSensors)
+  {
+    data.wrenches.emplace_back();
+    data.wrenches.back().header.frame_id = prefix + name;
+    if(wrenches_pub.count(name) == 0)
+    {
+#if MC_RTC_ROS_IS_ROS2
+      wrenches_pub.insert({name, this->nh.create_publisher<WrenchStamped>(prefix + "force/" + name, 1)});
+#else
+      wrenches_pub.insert({name, this->nh.advertise<WrenchStamped>(prefix + "force/" + name, 1)});
+#endif
+    }
+    data.wrench_pubs.push_back(&wrenches_pub[name]);
+  }
+}
+
+void RobotPublisherImpl::update(double, const mc_rbdyn::Robot & robot)
+{
+  if(&robot != previous_robot) { init(robot, use_real); }
+
+  if(++seq % skip) { return; }
+
+  if(!description->matches(robot))
+  {
+    // Sensors or surfaces were added, removed or replaced, this is the only case where the control thread allocates
+    describe(robot);
+  }
+  const auto & layout = description->layout;
+
+  auto * frame = msgs.acquire();
+  if(!frame)
+  {
+    mc_rtc::log::error("Full ROS message publishing queue");
+    return;
+  }
+  frame->stamp = now_ns();
+  frame->seq = seq;
+  frame->description = description;
+  frame->data.resize(layout.size);
+  double * out = frame->data.data();
+
+  const auto & mb = robot.mb();
+  const auto & mbc = robot.mbc();
+  for(size_t i = 0; i < layout.joints.size(); ++i)
+  {
+    auto jIdx = layout.joints[i];
+    out[layout.q + i] = mbc.q[jIdx][0];
+    out[layout.alpha + i] = mbc.alpha[jIdx][0];
+    out[layout.tau + i] = mbc.jointTorque[jIdx][0];
+  }
+
+  {
+    double * js_out = out + layout.jointSensors;
+    for(const auto & js : robot.jointSensors())
+    {
+      js_out[0] = js.motorTemperature();
+      js_out[1] = js.driverTemperature();
+      js_out[2] = js.motorCurrent();
+      js_out += 3;
+    }
+  }
+
+  const auto & bs = robot.bodySensor();
+  Eigen::Map<Eigen::Vector3d>(out + layout.imu) = bs.linearAcceleration();
+  Eigen::Map<Eigen::Vector3d>(out + layout.imu + 3) = bs.angularVelocity();
+  Eigen::Map<Eigen::Vector4d>(out + layout.imu + 6) = bs.orientation().coeffs();
+
+  Eigen::Map<Eigen::Vector3d>(out + layout.odom) = bs.position();
+  Eigen::Map<Eigen::Vector4d>(out + layout.odom + 3) = bs.orientation().coeffs();
+  Eigen::Map<Eigen::Vector3d>(out + layout.odom + 7) = bs.linearVelocity();
+  Eigen::Map<Eigen::Vector3d>(out + layout.odom + 10) = bs.angularVelocity();
+
+  {
+    double * w_out = out + layout.wrenches;
+    for(const auto & fs : robot.forceSensors())
+    {
+      Eigen::Map<Eigen::Vector6d>(w_out) = fs.wrench().vector();
+      w_out += 6;
+    }
+  }
+
+  {
+    double * tf_out = out + layout.tfs;
+    write(tf_out, robot.bodyTransform(0) * mbc.parentToSon[0]);
+    for(int j = 1; j < mb.nrJoints(); ++j)
+    {
+      tf_out += 12;
+      const auto & X_predp_pred = robot.bodyTransform(mb.predecessor(j));
+      const auto & X_succp_succ = robot.bodyTransform(mb.successor(j));
+      write(tf_out, X_succp_succ * mbc.parentToSon[static_cast<size_t>(j)] * X_predp_pred.inv());
+    }
+    tf_out += 12;
+    for(const auto & fs : robot.forceSensors())
+    {
+      if(!robot.hasBody(fs.name()))
+      {
+        write(tf_out, fs.X_p_f());
+        tf_out += 12;
+      }
+    }
+  }
+
+  {
+    double * surf_out = out + layout.surfaces;
+    for(const auto & s : robot.surfaces())
+    {
+      write(surf_out, s.second->X_b_s());
+      surf_out += 12;
+    }
+  }
+
+  msgs.commit();
+}
+
+RobotPublisher::RobotPublisher(const std::string & prefix, double rate, double dt) : impl(nullptr)
+{
+  auto nh = ROSBridge::get_node_handle();
+  if(nh) { impl.reset(new RobotPublisherImpl(*nh, prefix, rate, dt)); }
+}
+
+RobotPublisher::~RobotPublisher() {}
+
+void RobotPublisher::init(const mc_rbdyn::Robot & robot, bool use_real)
+{
+  if(impl) { impl->init(robot, use_real); }
+}
+
+void RobotPublisher::update(double dt, const mc_rbdyn::Robot & robot)
+{
+  if(impl) { impl->update(dt, robot); }
+}
+
+void RobotPublisher::set_rate(double rate)
+{
+  if(impl) { impl->set_rate(rate); }
+}
+
+void RobotPublisherImpl::publish(const RobotStateFrame & frame)
+{
+  if(frame.description != built)
+  {
+    build(*frame.description);
+    built = frame.description;
+  }
+  const auto & layout = built->layout;
+  auto tm = from_ns(frame.stamp);
+  const double * in = frame.data.data();
+
+  auto set_header = [&](auto & header)
+  {
+#ifndef MC_RTC_ROS_IS_ROS2
+    header.seq = frame.seq;
+#endif
+    header.stamp = tm;
+  };
+
+  set_header(data.js.header);
+  for(size_t i = 0; i < layout.joints.size(); ++i)
+  {
+    data.js.position[i] = in[layout.q + i];
+    data.js.velocity[i] = in[layout.alpha + i];
+    data.js.effort[i] = in[layout.tau + i];
+  }
+
+  set_header(data.j_sensors.header);
+  for(size_t i = 0; i < layout.nJointSensors; ++i)
+  {
+    const double * js_in = in + layout.jointSensors + 3 * i;
+    data.j_sensors.motor_temperature[i] = js_in[0];
+    data.j_sensors.driver_temperature[i] = js_in[1];
+    data.j_sensors.motor_current[i] = js_in[2];
+  }
+
+  data.imu.header = data.js.header;
+  const double * imu_in = in + layout.imu;
+  data.imu.linear_acceleration.x = imu_in[0];
+  data.imu.linear_acceleration.y = imu_in[1];
+  data.imu.linear_acceleration.z = imu_in[2];
+  data.imu.angular_velocity.x = imu_in[3];
+  data.imu.angular_velocity.y = imu_in[4];
+  data.imu.angular_velocity.z = imu_in[5];
+  data.imu.orientation.x = imu_in[6];
+  data.imu.orientation.y = imu_in[7];
+  data.imu.orientation.z = imu_in[8];
+  data.imu.orientation.w = imu_in[9];
+
+  set_header(data.odom.header);
+  const double * odom_in = in + layout.odom;
+  data.odom.pose.pose.position.x = odom_in[0];
+  data.odom.pose.pose.position.y = odom_in[1];
+  data.odom.pose.pose.position.z = odom_in[2];
+  data.odom.pose.pose.orientation.x = odom_in[3];
+  data.odom.pose.pose.orientation.y = odom_in[4];
+  data.odom.pose.pose.orientation.z = odom_in[5];
+  data.odom.pose.pose.orientation.w = odom_in[6];
+  data.odom.twist.twist.linear.x = odom_in[7];
+  data.odom.twist.twist.linear.y = odom_in[8];
+  data.odom.twist.twist.linear.z = odom_in[9];
+  data.odom.twist.twist.angular.x = odom_in[10];
+  data.odom.twist.twist.angular.y = odom_in[11];
+  data.odom.twist.twist.angular.z = odom_in[12];
+
+  for(size_t i = 0; i < layout.nForceSensors; ++i)
+  {
+    auto & msg = data.wrenches[i];
+    const double * w_in = in + layout.wrenches + 6 * i;
+    set_header(msg.header);
+    msg.wrench.torque.x = w_in[0];
+    msg.wrench.torque.y = w_in[1];
+    msg.wrench.torque.z = w_in[2];
+    msg.wrench.force.x = w_in[3];
+    msg.wrench.force.y = w_in[4];
+    msg.wrench.force.z = w_in[5];
+  }
+
+  for(size_t i = 0; i < data.tfs.size(); ++i)
+  {
+    update_tf(data.tfs[i], read(in + layout.tfs + 12 * i));
+    set_header(data.tfs[i].header);
+  }
+  for(size_t i = 0; i < data.surface_tfs.size(); ++i)
+  {
+    update_tf(data.surface_tfs[i], read(in + layout.surfaces + 12 * i));
+    set_header(data.surface_tfs[i].header);
+  }
+
+#ifdef MC_RTC_ROS_IS_ROS2
+  j_state_pub->publish(data.js);
+  j_sensor_pub->publish(data.j_sensors);
+  imu_pub->publish(data.imu);
+  odom_pub->publish(data.odom);
+#else
+  j_state_pub.publish(data.js);
+  j_sensor_pub.publish(data.j_sensors);
+  imu_pub.publish(data.imu);
+  odom_pub.publish(data.odom);
+#endif
+  tf_caster.sendTransform(data.tfs);
+  tf_caster.sendTransform(data.surface_tfs);
+  for(size_t i = 0; i < data.wrenches.size(); ++i)
+  {
+#if MC_RTC_ROS_IS_ROS2
+    (*data.wrench_pubs[i])->publish(data.wrenches[i]);
+#else
+    data.wrench_pubs[i]->publish(data.wrenches[i]);
+#endif
+  }
+}
+
+void RobotPublisherImpl::publishThread()
+{
+#ifdef MC_RTC_ROS_IS_ROS2
+  using Rate = rclcpp::Rate;
+#else
+  using Rate = ros::Rate;
+#endif
+  double sleepRate = rate;
+  auto rosRate = std::make_unique<Rate>(sleepRate);
+  while(running && ros::ok())
+  {
+    while(const auto * frame = msgs.front())
+    {
+      try
+      {
+        publish(*frame);
+      }
+#ifdef MC_RTC_ROS_IS_ROS2
+      catch(const std::exception & e)
+#else
+      catch(const ros::serialization::StreamOverrunException & e)
+#endif
+      {
+        mc_rtc::log::error("EXCEPTION WHILE PUBLISHING STATE");
+        mc_rtc::log::warning(e.what());
+      }
+      msgs.pop();
+    }
+    if(rate != sleepRate)
+    {
+      sleepRate = rate;
+      rosRate = std::make_unique<Rate>(sleepRate);
+    }
+    rosRate->sleep();
+  }
+}
+
+void RobotPublisherImpl::set_rate(double rateIn)
+{
+  double ctl_dt = 1 / (rate * skip);
+  skip = static_cast<unsigned int>(ceil(1 / (rateIn * ctl_dt)));
+  rate = rateIn;
+}
+
+inline bool ros_init([[maybe_unused]] const std::string & name)
+{
+  if(ros::ok()) { return true; }
+  int argc = 0;
+#ifdef MC_RTC_ROS_IS_ROS2
+  rclcpp::init(argc, nullptr);
+#else
+  ros::init(argc, nullptr, name.c_str(), ros::init_options::NoSigintHandler);
+  if(!ros::master::check())
+  {
+    mc_rtc::log::warning("ROS master is not available, continue without ROS functionalities");
+    return false;
+  }
+#endif
+  return true;
+}
+
+struct ROSBridgeImpl
+{
+  ROSBridgeImpl()
+  : ros_is_init(ros_init("mc_rtc")),
+#ifdef MC_RTC_ROS_IS_ROS2
+    nh(ros_is_init ? rclcpp::Node::make_shared("mc_rtc") : 0)
+#else
+    nh(ros_is_init ? new ros::NodeHandle() : 0)
+#endif
+  {
+  }
+  bool ros_is_init;
+  std::shared_ptr<NodeHandle> nh;
+  std::map<std::string, std::shared_ptr<RobotPublisher>> rpubs;
+  double publish_rate = 100;
+};
+
+ROSBridgeImpl & ROSBridge::impl_()
+{
+  static std::unique_ptr<ROSBridgeImpl> impl{new ROSBridgeImpl()};
+  return *impl;
+}
+
+NodeHandlePtr ROSBridge::get_node_handle()
+{
+  static auto & impl = impl_();
+  return impl.nh;
+}
+
+void ROSBridge::set_publisher_timestep(double timestep)
+{
+  static auto & impl = impl_();
+  impl.publish_rate = 1 / timestep;
+  for(auto & rpub_it : impl.rpubs)
+  {
+    auto & rpub = *rpub_it.second.get();
+    rpub.set_rate(impl.publish_rate);
+  }
+}
+
+void ROSBridge::init_robot_publisher(const std::string & publisher,
+                                     double dt,
+                                     const mc_rbdyn::Robot & robot,
+                                     bool use_real)
+{
+  static auto & impl = impl_();
+  if(impl.rpubs.count(publisher) == 0)
+  {
+    impl.rpubs[publisher] = std::make_shared<RobotPublisher>(publisher + "/", impl.publish_rate, dt);
+  }
+  impl.rpubs[publisher]->init(robot, use_real);
+}
+
+void ROSBridge::update_robot_publisher(const std::string & publisher, double dt, const mc_rbdyn::Robot & robot)
+{
+  static auto & impl = impl_();
+  if(impl.rpubs.count(publisher) == 0)
+  {
+    impl.rpubs[publisher] = std::make_shared<RobotPublisher>(publisher + "/", impl.publish_rate, dt);
+    impl.rpubs[publisher]->init(robot);
+  }
+  impl.rpubs[publisher]->update(dt, robot);
+}
+
+void ROSBridge::stop_robot_publisher(const std::string & publisher)
+{
+  static auto & impl = impl_();
+  auto it = impl.rpubs.find(publisher);
+  if(it == impl.rpubs.end()) { return; }
+  impl.rpubs.erase(it);
+}
+
+void ROSBridge::shutdown()
+{
+#ifdef MC_RTC_ROS_IS_ROS2
+  rclcpp::shutdown();
+#else
+  ros::shutdown();
+#endif
+}
+
+} // namespace mc_rtc
@@ -0,0 +1,9 @@
+/*
+ * Copyright 2015-2019 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <string>
+
+void mc_bin_to_rosbag(const std::string & in, const std::string & out, double dt);
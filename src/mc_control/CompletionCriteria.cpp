@@ -48,9 +48,10 @@ std::function<bool(const mc_tasks::MetaTask &, std::string &)> CompletionCriteri
   {
     double norm = config("eval");
     assert(norm > 0);
-    return [norm](const mc_tasks::MetaTask & t, std::string & out)
+    return [norm, eval = Eigen::VectorXd{}](const mc_tasks::MetaTask & t, std::string & out) mutable
     {
-      if(t.eval().norm() < norm)
+      t.evalInto(eval);
+      if(eval.norm() < norm)
       {
         out += "eval";
         return true;
@@ -62,9 +63,10 @@ std::function<bool(const mc_tasks::MetaTask &, std::string &)> CompletionCriteri
   {
     double norm = config("speed");
     assert(norm > 0);
-    return [norm](const mc_tasks::MetaTask & t, std::string & out)
+    return [norm, speed = Eigen::VectorXd{}](const mc_tasks::MetaTask & t, std::string & out) mutable
     {
-      if(t.speed().norm() < norm)
+      t.speedInto(speed);
+      if(speed.norm() < norm)
       {
         out += "speed";
         return true;
@@ -15,6 +15,7 @@
 #endif
 
 #include <chrono>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <thread>
@@ -90,6 +91,18 @@ void ControllerClient::connect(ControllerServer & server, mc_rtc::gui::StateBuil
 {
   server_ = &server;
   gui_ = &gui;
+  server_seq_ = 0;
+  run_ = true;
+}
+
+void ControllerClient::connect_shared_memory(const std::string & name)
+{
+  auto shm = GUISharedMemory::open(name);
+  if(!shm) { mc_rtc::log::error_and_throw("No GUI shared memory named {}", name); }
+  mc_rtc::log::info("Connected to GUI shared memory {}", name);
+  std::unique_lock<std::mutex> lock(shm_mutex_);
+  shm_ = std::move(shm);
+  shm_seq_ = 0;
   run_ = true;
 }
 
@@ -110,6 +123,8 @@ void ControllerClient::stop()
 #endif
   server_ = nullptr;
   gui_ = nullptr;
+  std::unique_lock<std::mutex> lock(shm_mutex_);
+  shm_.reset();
 }
 
 void ControllerClient::reconnect(const std::string & sub_conn_uri, const std::string & push_conn_uri)
@@ -131,6 +146,33 @@ void ControllerClient::run(std::vector<char> & buff, std::chrono::system_clock::
     while(nsize < s) { nsize = 2 * nsize; }
     buff.resize(nsize);
   };
+  // The lock is released before the state is handled since the callbacks may send requests
+  std::unique_lock<std::mutex> shm_lock(shm_mutex_);
+  if(shm_)
+  {
+    auto size = shm_->read(buff, shm_seq_);
+    auto now = std::chrono::system_clock::now();
+    if(size > 0)
+    {
+      shm_lock.unlock();
+      t_last_received = now;
+      run(buff.data(), size);
+    }
+    else if(timeout_ > 0 && now - t_last_received > std::chrono::duration<double>(timeout_))
+    {
+      t_last_received = now;
+      // The server might have restarted with a new segment
+      if(auto shm = GUISharedMemory::open(shm_->name()))
+      {
+        shm_ = std::move(shm);
+        shm_seq_ = 0;
+      }
+      shm_lock.unlock();
+      if(run_) { handle_gui_state(mc_rtc::Configuration{}); }
+    }
+    return;
+  }
+  shm_lock.unlock();
   if(sub_socket_ >= 0)
   {
 #ifndef MC_RTC_DISABLE_NETWORK
@@ -169,18 +211,21 @@ void ControllerClient::run(std::vector<char> & buff, std::chrono::system_clock::
   }
   else if(server_ != nullptr)
   {
-    auto recv = server_->data();
-    if(recv.second == 0) { return; }
-    resize_to_fit(recv.second);
-    memcpy(buff.data(), recv.first, recv.second * sizeof(char));
-    run(buff.data(), recv.second);
+    // Read the published state in place, the server does not re-use it while we hold it
+    auto snapshot = server_->snapshot();
+    if(!snapshot || snapshot->seq == server_seq_) { return; }
+    server_seq_ = snapshot->seq;
+    run(snapshot->buffer.data(), snapshot->size);
   }
   else { handle_gui_state(mc_rtc::Configuration{}); }
 }
 
 void ControllerClient::run(const char * buffer, size_t bufferSize)
 {
-  if(run_) { handle_gui_state(mc_rtc::Configuration::fromMessagePack(buffer, bufferSize)); }
+  if(!run_) { return; }
+  handle_gui_state(mc_rtc::Configuration::fromMessagePack(buffer, bufferSize));
+  // Renew the subscriptions well before they expire on the server
+  send_subscriptions(std::chrono::seconds(1));
 }
 
 void ControllerClient::start()
@@ -203,12 +248,64 @@ void ControllerClient::start()
 
 void ControllerClient::send_request(const ElementId & id, const mc_rtc::Configuration & data)
 {
+  if(server_)
+  {
+    server_->push_request(id.uid, {id.category, id.name, data});
+    return;
+  }
   std::string out;
   raw_request(id, data, out);
+  send(out);
+}
+
+void ControllerClient::send(const std::string & out)
+{
 #ifndef MC_RTC_DISABLE_NETWORK
   nn_send(push_socket_, out.c_str(), out.size() + 1, NN_DONTWAIT);
 #endif
-  if(server_) { server_->handle_requests(*gui_, out.c_str()); }
+  std::unique_lock<std::mutex> lock(shm_mutex_);
+  if(shm_ && !shm_->push_request(out.c_str(), out.size() + 1))
+  {
+    mc_rtc::log::error("ControllerClient failed to send a request through shared memory (queue full or request "
+                       "larger than {} bytes)",
+                       GUISharedMemory::request_capacity);
+  }
+}
+
+void ControllerClient::subscribe(const std::vector<std::vector<std::string>> & categories)
+{
+  {
+    std::unique_lock<std::mutex> lock(subscriptions_mutex_);
+    subscriptions_ = categories;
+    if(client_id_.empty())
+    {
+      std::random_device rd;
+      client_id_ = fmt::format("{:08x}{:08x}", rd(), rd());
+    }
+  }
+  send_subscriptions(std::chrono::steady_clock::duration::zero());
+}
+
+void ControllerClient::send_subscriptions(std::chrono::steady_clock::duration period)
+{
+  std::string out;
+  {
+    std::unique_lock<std::mutex> lock(subscriptions_mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if(!subscriptions_ || now - subscriptions_sent_ < period) { return; }
+    subscriptions_sent_ = now;
+    if(server_)
+    {
+      server_->subscribe(client_id_, *subscriptions_);
+      return;
+    }
+    mc_rtc::Configuration request;
+    auto subscribe = request.add("subscribe");
+    subscribe.add("client", client_id_);
+    subscribe.add("categories", *subscriptions_);
+    out = request.dump();
+  }
+  send(out);
 }
 
 void ControllerClient::send_request(const ElementId & id)
@@ -221,6 +318,8 @@ void ControllerClient::raw_request(const ElementId & id, const mc_rtc::Configura
   mc_rtc::Configuration request;
   request.add("category", id.category);
   request.add("name", id.name);
+  // Servers that know the id resolve the element without searching the category
+  if(id.uid != 0) { request.add("id", id.uid); }
   request.add("data", data);
   out = request.dump();
 }
@@ -260,6 +359,8 @@ void ControllerClient::handle_gui_state(mc_rtc::Configuration state)
     return;
   }
   data_ = state[1];
+  ids_ = 4 < state.size() ? state[4] : mc_rtc::Configuration{};
+  next_id_ = 0;
   handle_category({}, "", state[2]);
   if(3 < state.size())
   {
@@ -282,7 +383,9 @@ void ControllerClient::handle_category(const std::vector<std::string> & parent,
     auto widget_data = data[i];
     std::string widget_name = widget_data[0];
     int sid = widget_data.at(2, -1);
-    handle_widget({next_category, widget_name, sid}, widget_data);
+    uint64_t uid = next_id_ < ids_.size() ? static_cast<uint64_t>(ids_[next_id_]) : 0;
+    next_id_++;
+    handle_widget({next_category, widget_name, sid, uid}, widget_data);
   }
   if(data[data.size() - 1].size())
   {
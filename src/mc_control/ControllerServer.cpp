@@ -4,6 +4,8 @@
 
 #include <mc_control/ControllerServer.h>
 
+#include <atomic>
+
 #ifndef MC_RTC_DISABLE_NETWORK
 #  include <nanomsg/nn.h>
 #  include <nanomsg/pipeline.h>
@@ -17,6 +19,12 @@ namespace mc_control
 ControllerServer::ControllerServer(double dt, const ControllerServerConfiguration & config)
 : ControllerServer(dt, config.timestep, config.pub_uris(), config.pull_uris())
 {
+  subscriptions_ = config.subscriptions;
+  subscription_timeout_ = std::chrono::duration<double>(config.subscription_timeout);
+  if(config.shm_config)
+  {
+    shm_ = GUISharedMemory::create(config.shm_config->name, static_cast<size_t>(config.shm_config->size));
+  }
 }
 
 ControllerServer::ControllerServer(double dt,
@@ -53,10 +61,17 @@ ControllerServer::~ControllerServer()
 void ControllerServer::handle_requests(mc_rtc::gui::StateBuilder & gui_builder, const char * dataIn)
 {
   auto config = mc_rtc::Configuration::fromData(static_cast<const char *>(dataIn));
+  if(auto sub = config.find("subscribe"))
+  {
+    subscribe((*sub)("client", std::string{}), (*sub)("categories", std::vector<std::vector<std::string>>{}));
+    return;
+  }
   auto category = config("category", std::vector<std::string>{});
   auto name = config("name", std::string{});
   auto data = config("data", mc_rtc::Configuration{});
-  if(!gui_builder.handleRequest(category, name, data))
+  bool ok = config.has("id") ? gui_builder.handleRequest(static_cast<uint64_t>(config("id")), data)
+                             : gui_builder.handleRequest(category, name, data);
+  if(!ok)
   {
     mc_rtc::log::error("Invokation of the following method failed\n{}\n", config.dump(true));
   }
@@ -65,6 +80,26 @@ void ControllerServer::handle_requests(mc_rtc::gui::StateBuilder & gui_builder,
 
 void ControllerServer::handle_requests(mc_rtc::gui::StateBuilder & gui_builder)
 {
+  {
+    std::unique_lock<std::mutex> lock(pending_requests_mutex_);
+    std::swap(pending_requests_, handled_requests_);
+  }
+  for(auto & r : handled_requests_)
+  {
+    auto & event = r.second;
+    bool ok = r.first != 0 ? gui_builder.handleRequest(r.first, event.data)
+                           : gui_builder.handleRequest(event.category, event.name, event.data);
+    if(!ok)
+    {
+      mc_rtc::Configuration config;
+      config.add("category", event.category);
+      config.add("name", event.name);
+      config.add("data", event.data);
+      mc_rtc::log::error("Invokation of the following method failed\n{}\n", config.dump(true));
+    }
+    if(logger_) { logger_->addGUIEvent(std::move(event)); }
+  }
+  handled_requests_.clear();
   for(auto & r : requests_)
   {
     if(!gui_builder.handleRequest(r.category, r.name, r.data))
@@ -96,17 +131,37 @@ void ControllerServer::handle_requests(mc_rtc::gui::StateBuilder & gui_builder)
     }
   } while(recv > 0);
 #endif
+  if(shm_)
+  {
+    while(shm_->pop_request(shm_request_)) { handle_requests(gui_builder, shm_request_.data()); }
+  }
 }
 
 void ControllerServer::publish(mc_rtc::gui::StateBuilder & gui_builder)
 {
   if(iter_++ % rate_ == 0)
   {
-    buffer_size_ = gui_builder.update(buffer_);
+    if(subscriptions_) { update_subscriptions(gui_builder); }
+    const auto & snapshot = next_snapshot();
+    snapshot->size = gui_builder.update(snapshot->buffer);
+    snapshot->seq = ++published_;
+    buffer_size_ = snapshot->size;
+    {
+      std::unique_lock<std::mutex> lock(latest_mutex_);
+      latest_ = snapshot;
+    }
+    const char * buffer = snapshot->buffer.data();
 #ifndef MC_RTC_DISABLE_NETWORK
-    int err = nn_send(pub_socket_, buffer_.data(), buffer_size_, 0);
+    int err = nn_send(pub_socket_, buffer, buffer_size_, 0);
     if(err < 0) { mc_rtc::log::error("[ControllerServer] Failed to send {}", nn_strerror(nn_errno())); }
 #endif
+    if(shm_ && !shm_->write(buffer, buffer_size_) && !shm_overflow_)
+    {
+      mc_rtc::log::warning("[ControllerServer] GUI state ({} bytes) does not fit in the shared memory ({} bytes), "
+                           "increase GUIServer::SharedMemory::Size",
+                           buffer_size_, shm_->state_capacity());
+      shm_overflow_ = true;
+    }
   }
   else
   {
@@ -117,7 +172,73 @@ void ControllerServer::publish(mc_rtc::gui::StateBuilder & gui_builder)
 
 std::pair<const char *, size_t> ControllerServer::data() const
 {
-  return {buffer_.data(), buffer_size_};
+  // latest_ and buffer_size_ are only written by publish() which runs on the calling thread
+  if(!latest_) { return {nullptr, 0}; }
+  return {latest_->buffer.data(), buffer_size_};
+}
+
+std::shared_ptr<const ControllerServer::Snapshot> ControllerServer::snapshot() const
+{
+  std::unique_lock<std::mutex> lock(latest_mutex_);
+  return latest_;
+}
+
+const std::shared_ptr<ControllerServer::Snapshot> & ControllerServer::next_snapshot()
+{
+  for(const auto & s : snapshots_)
+  {
+    // latest_ holds the last snapshot so a snapshot only owned by snapshots_ cannot be acquired by a client anymore
+    if(s.use_count() == 1)
+    {
+      // Synchronize with the release of the snapshot by its last client
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return s;
+    }
+  }
+  return snapshots_.emplace_back(std::make_shared<Snapshot>());
+}
+
+void ControllerServer::push_request(uint64_t id, mc_rtc::Logger::GUIEvent request)
+{
+  std::unique_lock<std::mutex> lock(pending_requests_mutex_);
+  pending_requests_.emplace_back(id, std::move(request));
+}
+
+void ControllerServer::subscribe(const std::string & client, const std::vector<std::vector<std::string>> & categories)
+{
+  if(!subscriptions_) { return; }
+  std::unique_lock<std::mutex> lock(clients_mutex_);
+  auto & subscription = clients_[client];
+  if(subscription.categories != categories || subscription.time == std::chrono::steady_clock::time_point{})
+  {
+    subscription.categories = categories;
+    subscriptions_changed_ = true;
+  }
+  subscription.time = std::chrono::steady_clock::now();
+}
+
+void ControllerServer::update_subscriptions(mc_rtc::gui::StateBuilder & gui_builder)
+{
+  std::unique_lock<std::mutex> lock(clients_mutex_);
+  auto now = std::chrono::steady_clock::now();
+  for(auto it = clients_.begin(); it != clients_.end();)
+  {
+    if(now - it->second.time > subscription_timeout_)
+    {
+      it = clients_.erase(it);
+      subscriptions_changed_ = true;
+    }
+    else { ++it; }
+  }
+  if(!subscriptions_changed_ && subscriptions_gui_ == &gui_builder) { return; }
+  std::vector<std::vector<std::string>> categories;
+  for(const auto & c : clients_)
+  {
+    categories.insert(categories.end(), c.second.categories.begin(), c.second.categories.end());
+  }
+  gui_builder.subscriptions(categories);
+  subscriptions_changed_ = false;
+  subscriptions_gui_ = &gui_builder;
 }
 
 void ControllerServer::update_rate(double dt, double server_dt)
@@ -37,6 +37,15 @@ void ControllerServerConfiguration::load(const mc_rtc::Configuration & config)
   };
   socket_config("TCP", tcp_config);
   socket_config("WS", websocket_config);
+  if(auto shm = config.find("SharedMemory"))
+  {
+    shm_config = SharedMemoryConfiguration{};
+    (*shm)("Name", shm_config->name);
+    (*shm)("Size", shm_config->size);
+  }
+  else { shm_config = std::nullopt; }
+  config("Subscriptions", subscriptions);
+  config("SubscriptionTimeout", subscription_timeout);
 }
 
 std::vector<std::string> ControllerServerConfiguration::pub_uris() const noexcept
@@ -73,6 +82,7 @@ void ControllerServerConfiguration::print_serving_information() const noexcept
   for(const auto & pub_uri : pub_uris()) { mc_rtc::log::info("- {}", pub_uri); }
   mc_rtc::log::info("Handling requests on:");
   for(const auto & pull_uri : pull_uris()) { mc_rtc::log::info("- {}", pull_uri); }
+  if(shm_config) { mc_rtc::log::info("Publishing data and handling requests on shared memory: {}", shm_config->name); }
 }
 
 } // namespace mc_control
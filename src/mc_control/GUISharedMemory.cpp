@@ -0,0 +1,232 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_control/GUISharedMemory.h>
+
+#include <mc_rtc/logging.h>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace bip = boost::interprocess;
+
+namespace mc_control
+{
+
+namespace
+{
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared-memory transport requires lock-free atomics");
+
+/** Maximum time spent waiting for a consistent state in GUISharedMemory::read */
+constexpr std::chrono::milliseconds read_timeout{10};
+
+/** Identifies an initialized segment and the version of its layout */
+constexpr uint64_t segment_magic = 0x6d635f7274630001;
+
+/** Start of the segment, followed by the request slots and the state */
+struct Header
+{
+  /** Written last by the server once the segment is initialized */
+  std::atomic<uint64_t> magic;
+  uint64_t state_capacity;
+  /** Odd while the server writes the state */
+  alignas(64) std::atomic<uint64_t> state_seq;
+  std::atomic<uint64_t> state_size;
+  /** Bounded queue of requests, see https://www.1024cores.net/home/lock-free-algorithms/queues */
+  alignas(64) std::atomic<uint64_t> request_enqueue;
+  alignas(64) std::atomic<uint64_t> request_dequeue;
+};
+
+struct RequestSlot
+{
+  std::atomic<uint64_t> seq;
+  uint64_t size;
+  char data[GUISharedMemory::request_capacity];
+};
+
+constexpr size_t state_offset = sizeof(Header) + GUISharedMemory::request_slots * sizeof(RequestSlot);
+
+} // namespace
+
+struct GUISharedMemory::Impl
+{
+  std::string name;
+  bool owner;
+  bip::shared_memory_object shm;
+  bip::mapped_region region;
+  Header * header = nullptr;
+  RequestSlot * slots = nullptr;
+  char * state = nullptr;
+
+  Impl(const std::string & name, bool owner, bip::shared_memory_object && shm)
+  : name(name), owner(owner), shm(std::move(shm)), region(this->shm, bip::read_write)
+  {
+    auto data = static_cast<char *>(region.get_address());
+    header = reinterpret_cast<Header *>(data);
+    slots = reinterpret_cast<RequestSlot *>(data + sizeof(Header));
+    state = data + state_offset;
+  }
+
+  ~Impl()
+  {
+    if(owner) { bip::shared_memory_object::remove(name.c_str()); }
+  }
+};
+
+GUISharedMemory::GUISharedMemory(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+GUISharedMemory::~GUISharedMemory() = default;
+
+std::unique_ptr<GUISharedMemory> GUISharedMemory::create(const std::string & name, size_t state_capacity)
+{
+  std::unique_ptr<Impl> impl;
+  try
+  {
+    bip::shared_memory_object::remove(name.c_str());
+    bip::shared_memory_object shm(bip::create_only, name.c_str(), bip::read_write);
+    shm.truncate(static_cast<bip::offset_t>(state_offset + state_capacity));
+    impl = std::make_unique<Impl>(name, true, std::move(shm));
+  }
+  catch(const bip::interprocess_exception & exc)
+  {
+    mc_rtc::log::error_and_throw("Failed to create the GUI shared memory {}: {}", name, exc.what());
+  }
+  auto header = new(impl->header) Header{};
+  header->state_capacity = state_capacity;
+  for(size_t i = 0; i < request_slots; ++i) { new(&impl->slots[i]) RequestSlot{}; }
+  for(size_t i = 0; i < request_slots; ++i) { impl->slots[i].seq.store(i, std::memory_order_relaxed); }
+  header->magic.store(segment_magic, std::memory_order_release);
+  return std::unique_ptr<GUISharedMemory>(new GUISharedMemory(std::move(impl)));
+}
+
+std::unique_ptr<GUISharedMemory> GUISharedMemory::open(const std::string & name)
+{
+  std::unique_ptr<Impl> impl;
+  try
+  {
+    bip::shared_memory_object shm(bip::open_only, name.c_str(), bip::read_write);
+    bip::offset_t size = 0;
+    if(!shm.get_size(size) || static_cast<size_t>(size) < state_offset) { return nullptr; }
+    impl = std::make_unique<Impl>(name, false, std::move(shm));
+  }
+  catch(const bip::interprocess_exception &)
+  {
+    return nullptr;
+  }
+  if(impl->header->magic.load(std::memory_order_acquire) != segment_magic
+     || impl->region.get_size() < state_offset + impl->header->state_capacity)
+  {
+    return nullptr;
+  }
+  return std::unique_ptr<GUISharedMemory>(new GUISharedMemory(std::move(impl)));
+}
+
+const std::string & GUISharedMemory::name() const noexcept
+{
+  return impl_->name;
+}
+
+size_t GUISharedMemory::state_capacity() const noexcept
+{
+  return impl_->header->state_capacity;
+}
+
+bool GUISharedMemory::write(const char * data, size_t size) noexcept
+{
+  auto & header = *impl_->header;
+  if(size > header.state_capacity) { return false; }
+  auto seq = header.state_seq.load(std::memory_order_relaxed);
+  header.state_seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(impl_->state, data, size);
+  header.state_size.store(size, std::memory_order_relaxed);
+  header.state_seq.store(seq + 2, std::memory_order_release);
+  return true;
+}
+
+size_t GUISharedMemory::read(std::vector<char> & buffer, uint64_t & seq) const
+{
+  const auto & header = *impl_->header;
+  // Give up if the writer does not complete a state in time, e.g. if the server died in the middle of a write
+  auto deadline = std::chrono::steady_clock::now() + read_timeout;
+  while(true)
+  {
+    auto start = header.state_seq.load(std::memory_order_acquire);
+    if(start == seq) { return 0; }
+    if(std::chrono::steady_clock::now() > deadline) { return 0; }
+    if(start % 2 != 0)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    auto size = header.state_size.load(std::memory_order_relaxed);
+    if(size > header.state_capacity) { continue; }
+    if(buffer.size() < size) { buffer.resize(size); }
+    std::memcpy(buffer.data(), impl_->state, size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(header.state_seq.load(std::memory_order_relaxed) == start)
+    {
+      seq = start;
+      return size;
+    }
+  }
+}
+
+bool GUISharedMemory::push_request(const char * data, size_t size) noexcept
+{
+  if(size > request_capacity) { return false; }
+  auto & header = *impl_->header;
+  auto pos = header.request_enqueue.load(std::memory_order_relaxed);
+  RequestSlot * slot = nullptr;
+  while(true)
+  {
+    slot = &impl_->slots[pos % request_slots];
+    auto seq = slot->seq.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+    if(diff == 0)
+    {
+      if(header.request_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+    }
+    else if(diff < 0) { return false; }
+    else { pos = header.request_enqueue.load(std::memory_order_relaxed); }
+  }
+  slot->size = size;
+  std::memcpy(slot->data, data, size);
+  slot->seq.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool GUISharedMemory::pop_request(std::vector<char> & buffer)
+{
+  auto & header = *impl_->header;
+  auto pos = header.request_dequeue.load(std::memory_order_relaxed);
+  RequestSlot * slot = nullptr;
+  while(true)
+  {
+    slot = &impl_->slots[pos % request_slots];
+    auto seq = slot->seq.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+    if(diff == 0)
+    {
+      if(header.request_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+    }
+    else if(diff < 0) { return false; }
+    else { pos = header.request_dequeue.load(std::memory_order_relaxed); }
+  }
+  auto size = std::min<size_t>(slot->size, request_capacity);
+  if(buffer.size() < size) { buffer.resize(size); }
+  std::memcpy(buffer.data(), slot->data, size);
+  slot->seq.store(pos + request_slots, std::memory_order_release);
+  return true;
+}
+
+} // namespace mc_control
@@ -103,16 +103,20 @@ MCController::MCController(const std::vector<std::shared_ptr<mc_rbdyn::RobotModu
 {
 }
 
-static inline std::shared_ptr<mc_solver::QPSolver> make_solver(double dt, MCController::Backend backend)
+static inline std::shared_ptr<mc_solver::QPSolver> make_solver(double dt, const ControllerParameters & params)
 {
-  switch(backend)
+  switch(params.backend_)
   {
     case MCController::Backend::Tasks:
-      return std::make_shared<mc_solver::TasksQPSolver>(dt);
+    {
+      auto solver = std::make_shared<mc_solver::TasksQPSolver>(dt);
+      solver->configure(params.solver_configuration_);
+      return solver;
+    }
     case MCController::Backend::TVM:
-      return std::make_shared<mc_solver::TVMQPSolver>(dt);
+      return std::make_shared<mc_solver::TVMQPSolver>(dt, params.solver_configuration_);
     default:
-      mc_rtc::log::error_and_throw("[MCController] Backend {} is not fully supported yet", backend);
+      mc_rtc::log::error_and_throw("[MCController] Backend {} is not fully supported yet", params.backend_);
   }
 }
 
@@ -120,7 +124,7 @@ MCController::MCController(const std::vector<std::shared_ptr<mc_rbdyn::RobotModu
                            double dt,
                            const mc_rtc::Configuration & config,
                            ControllerParameters params)
-: qpsolver(make_solver(dt, params.backend_)), outputRobots_(mc_rbdyn::Robots::make()),
+: qpsolver(make_solver(dt, params)), outputRobots_(mc_rbdyn::Robots::make()),
   outputRealRobots_(mc_rbdyn::Robots::make()),
   logger_(std::make_shared<mc_rtc::Logger>(mc_rtc::Logger::Policy::NON_THREADED, "", "")),
   gui_(std::make_shared<mc_rtc::gui::StateBuilder>()), config_(config), timeStep(dt), name_(MC_CONTROLLER_NAME),
@@ -436,15 +440,12 @@ void MCController::addRobotToLog(const mc_rbdyn::Robot & r)
     logger().addLogEntry(entry("tauIn"),
                          [this, name]() -> const std::vector<double> & { return robot(name).jointTorques(); });
     std::vector<double> qOut(robot(name).refJointOrder().size(), 0);
+    // The output robots are loaded from the same modules, the flat mapping thus matches the log entries' size
     logger().addLogEntry(entry("qOut"),
                          [this, name, qOut]() mutable -> const std::vector<double> &
                          {
                            auto & robot = this->outputRobot(name);
-                           for(size_t i = 0; i < qOut.size(); ++i)
-                           {
-                             auto mbcIndex = robot.jointIndexInMBC(i);
-                             if(mbcIndex != -1) { qOut[i] = robot.mbc().q[static_cast<size_t>(mbcIndex)][0]; }
-                           }
+                           robot.refJointOrderMap().gather(robot.mbc().q, qOut);
                            return qOut;
                          });
     auto & alphaOut = qOut;
@@ -452,11 +453,7 @@ void MCController::addRobotToLog(const mc_rbdyn::Robot & r)
                          [this, name, alphaOut]() mutable -> const std::vector<double> &
                          {
                            auto & robot = this->outputRobot(name);
-                           for(size_t i = 0; i < alphaOut.size(); ++i)
-                           {
-                             auto mbcIndex = robot.jointIndexInMBC(i);
-                             if(mbcIndex != -1) { alphaOut[i] = robot.mbc().alpha[static_cast<size_t>(mbcIndex)][0]; }
-                           }
+                           robot.refJointOrderMap().gather(robot.mbc().alpha, alphaOut);
                            return alphaOut;
                          });
     auto & alphaDOut = qOut;
@@ -464,11 +461,7 @@ void MCController::addRobotToLog(const mc_rbdyn::Robot & r)
                          [this, name, alphaDOut]() mutable -> const std::vector<double> &
                          {
                            auto & robot = this->outputRobot(name);
-                           for(size_t i = 0; i < alphaDOut.size(); ++i)
-                           {
-                             auto mbcIndex = robot.jointIndexInMBC(i);
-                             if(mbcIndex != -1) { alphaDOut[i] = robot.mbc().alphaD[static_cast<size_t>(mbcIndex)][0]; }
-                           }
+                           robot.refJointOrderMap().gather(robot.mbc().alphaD, alphaDOut);
                            return alphaDOut;
                          });
     auto & tauOut = qOut;
@@ -476,14 +469,7 @@ void MCController::addRobotToLog(const mc_rbdyn::Robot & r)
                          [this, name, tauOut]() mutable -> const std::vector<double> &
                          {
                            auto & robot = this->outputRobot(name);
-                           for(size_t i = 0; i < tauOut.size(); ++i)
-                           {
-                             auto mbcIndex = robot.jointIndexInMBC(i);
-                             if(mbcIndex != -1)
-                             {
-                               tauOut[i] = robot.mbc().jointTorque[static_cast<size_t>(mbcIndex)][0];
-                             }
-                           }
+                           robot.refJointOrderMap().gather(robot.mbc().jointTorque, tauOut);
                            return tauOut;
                          });
   }
@@ -84,14 +84,53 @@ Controller::Controller(mc_rbdyn::RobotModulePtr rm,
   if(config.has("states")) { factory_.load(config("states")); }
   /** Setup executor */
   executor_.init(*this, config_);
+  /** Watch the states files, the files are read in the watcher thread and the changes applied in run() */
+  if(config("ReloadStatesFiles", false))
+  {
+    std::chrono::duration<double> period{config("ReloadStatesFilesPeriod", 1.0)};
+    states_files_watcher_ = std::thread(
+        [this, period]()
+        {
+          std::unique_lock<std::mutex> lock(states_files_watcher_mutex_);
+          while(!states_files_watcher_cv_.wait_for(lock, period, [this]() { return states_files_watcher_stop_; }))
+          {
+            if(!states_files_changed_ && factory_.read_files_changes()) { states_files_changed_ = true; }
+          }
+        });
+  }
 }
 
 Controller::~Controller()
 {
+  stopStatesFilesWatcher();
   executor_.teardown(*this);
   datastore().clear();
 }
 
+void Controller::stopStatesFilesWatcher()
+{
+  if(!states_files_watcher_.joinable()) { return; }
+  {
+    std::unique_lock<std::mutex> lock(states_files_watcher_mutex_);
+    states_files_watcher_stop_ = true;
+  }
+  states_files_watcher_cv_.notify_all();
+  states_files_watcher_.join();
+}
+
+void Controller::reloadStatesFiles()
+{
+  auto states = factory_.apply_files_changes();
+  if(states.empty()) { return; }
+  mc_rtc::log::info("[FSM] States reloaded: {}", mc_rtc::io::to_string(states));
+  if(gui_)
+  {
+    auto all_states = factory_.states();
+    std::sort(all_states.begin(), all_states.end());
+    gui_->data().add("states", all_states);
+  }
+}
+
 bool Controller::run()
 {
   return run(mc_solver::FeedbackType::None);
@@ -99,6 +138,11 @@ bool Controller::run()
 
 bool Controller::run(mc_solver::FeedbackType fType)
 {
+  if(states_files_changed_)
+  {
+    reloadStatesFiles();
+    states_files_changed_ = false;
+  }
   executor_.run(*this, idle_keep_state_);
   if(!executor_.running())
   {
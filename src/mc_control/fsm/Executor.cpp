@@ -172,6 +172,8 @@ void Executor::next(Controller & ctl)
   if(!ready_ || next_state_.empty()) { return; }
   ready_ = false;
   transition_triggered_ = false;
+  // Coalesce the structural changes made by the teardown of the current state and the start of the next one
+  mc_solver::QPSolver::Transaction transaction(ctl.solver());
   if(state_)
   {
     auto state_teardown_start = clock::now();
@@ -8,6 +8,9 @@
 #include <boost/filesystem.hpp>
 namespace bfs = boost::filesystem;
 
+#include <algorithm>
+#include <set>
+
 namespace mc_control
 {
 
@@ -103,22 +106,22 @@ void load_ud(StateFactory & factory,
   }
 }
 
-void load_file(StateFactory & factory, const std::string & file, std::vector<UDState> & ud_states, bool verbose)
+/** Read the states defined in a file */
+std::map<std::string, mc_rtc::Configuration> read_file(const std::string & file)
 {
-  if(verbose) { mc_rtc::log::info("Load {}", file); }
-  std::map<std::string, mc_rtc::Configuration> states = mc_rtc::Configuration(file);
-  load_ud(factory, states, ud_states);
+  return mc_rtc::Configuration(file);
 }
 
-void load_dir(StateFactory & factory, const std::string & dir, std::vector<UDState> & ud_states, bool verbose)
+/** List the files in a directory and its sub-directories */
+void list_dir(const std::string & dir, std::vector<std::string> & files)
 {
   bfs::directory_iterator dit(dir), endit;
   std::vector<bfs::path> drange;
   std::copy(dit, endit, std::back_inserter(drange));
   for(const auto & p : drange)
   {
-    if(bfs::is_regular_file(p)) { load_file(factory, p.string(), ud_states, verbose); }
-    else if(bfs::is_directory(p)) { load_dir(factory, p.string(), ud_states, verbose); }
+    if(bfs::is_regular_file(p)) { files.push_back(p.string()); }
+    else if(bfs::is_directory(p)) { list_dir(p.string(), files); }
   }
 }
 
@@ -126,23 +129,177 @@ void load_dir(StateFactory & factory, const std::string & dir, std::vector<UDSta
 
 void StateFactory::load_files(const std::vector<std::string> & files)
 {
-  std::vector<UDState> ud_states;
+  std::vector<std::string> paths;
   for(const auto & f : files)
   {
     if(bfs::is_directory(f))
     {
       mc_rtc::log::info("Looking for state files in {}", f);
-      load_dir(*this, f, ud_states, verbose);
+      list_dir(f, paths);
+      std::unique_lock<std::mutex> lock(files_mutex_);
+      directories_.push_back(f);
     }
     else
     {
-      if(bfs::exists(f) && bfs::is_regular_file(f)) { load_file(*this, f, ud_states, verbose); }
+      if(bfs::exists(f) && bfs::is_regular_file(f)) { paths.push_back(f); }
       else { mc_rtc::log::warning("State file {} does not exist", f); }
     }
   }
+  std::vector<UDState> ud_states;
+  for(const auto & p : paths)
+  {
+    if(verbose) { mc_rtc::log::info("Load {}", p); }
+    auto states = read_file(p);
+    {
+      std::unique_lock<std::mutex> lock(files_mutex_);
+      files_[p] = {bfs::last_write_time(p), bfs::file_size(p)};
+    }
+    auto & file_states = files_states_[p];
+    for(const auto & s : states) { file_states.push_back(s.first); }
+    load_ud(*this, states, ud_states);
+  }
   if(ud_states.size()) { resolve(*this, ud_states); }
 }
 
+bool StateFactory::read_files_changes()
+{
+  decltype(files_) files;
+  decltype(directories_) directories;
+  {
+    std::unique_lock<std::mutex> lock(files_mutex_);
+    files = files_;
+    directories = directories_;
+  }
+  // Look for new files in the watched directories
+  std::vector<std::string> paths;
+  for(const auto & d : directories)
+  {
+    if(bfs::is_directory(d)) { list_dir(d, paths); }
+  }
+  for(const auto & p : paths) { files.emplace(p, std::make_pair(std::time_t{0}, uintmax_t{0})); }
+  // Read the files that changed without holding the lock, this is the expensive part
+  std::vector<FileChange> changes;
+  std::vector<std::pair<std::string, std::pair<std::time_t, uintmax_t>>> times;
+  for(const auto & f : files)
+  {
+    boost::system::error_code ec;
+    auto time = std::make_pair(bfs::last_write_time(f.first, ec), uintmax_t{0});
+    if(!ec) { time.second = bfs::file_size(f.first, ec); }
+    if(ec)
+    {
+      if(verbose) { mc_rtc::log::info("State file {} was removed", f.first); }
+      changes.push_back({f.first, true, {}});
+      continue;
+    }
+    if(time == f.second) { continue; }
+    times.emplace_back(f.first, time);
+    try
+    {
+      if(verbose) { mc_rtc::log::info("Reload {}", f.first); }
+      changes.push_back({f.first, false, read_file(f.first)});
+    }
+    catch(const std::exception & exc)
+    {
+      // The file is not read again until it is modified
+      mc_rtc::log::error("Failed to reload states file {}: {}", f.first, exc.what());
+    }
+  }
+  if(times.empty() && changes.empty()) { return false; }
+  std::unique_lock<std::mutex> lock(files_mutex_);
+  for(const auto & t : times) { files_[t.first] = t.second; }
+  for(auto & c : changes)
+  {
+    if(c.removed) { files_.erase(c.path); }
+    files_changes_.push_back(std::move(c));
+  }
+  return files_changes_.size() != 0;
+}
+
+std::vector<std::string> StateFactory::apply_files_changes()
+{
+  std::vector<FileChange> changes;
+  {
+    std::unique_lock<std::mutex> lock(files_mutex_);
+    std::swap(changes, files_changes_);
+  }
+  if(changes.empty()) { return {}; }
+  std::set<std::string> changed;
+  // Remove the modified and removed states of every file first so that a state moving to another file is not rejected
+  for(auto & c : changes)
+  {
+    auto & file_states = files_states_[c.path];
+    for(const auto & s : file_states)
+    {
+      auto it = c.states.find(s);
+      if(it == c.states.end() || !states_configurations_.count(s)
+         || states_configurations_.at(s).config.dump() != it->second.dump())
+      {
+        unload(s);
+        changed.insert(s);
+      }
+      else
+      {
+        // The state is unchanged
+        c.states.erase(it);
+      }
+    }
+    file_states.erase(std::remove_if(file_states.begin(), file_states.end(),
+                                     [&](const std::string & s) { return changed.count(s) != 0; }),
+                      file_states.end());
+    if(c.removed) { files_states_.erase(c.path); }
+  }
+  std::map<std::string, mc_rtc::Configuration> states;
+  for(auto & c : changes)
+  {
+    if(c.removed) { continue; }
+    auto & file_states = files_states_[c.path];
+    for(auto & s : c.states)
+    {
+      if(hasState(s.first))
+      {
+        mc_rtc::log::error("State {} from {} is already provided by another file or library", s.first, c.path);
+        continue;
+      }
+      file_states.push_back(s.first);
+      changed.insert(s.first);
+      states[s.first] = s.second;
+    }
+  }
+  load(states);
+  // States inheriting from a changed state will be created with the new configuration
+  std::vector<std::string> out;
+  for(const auto & s : states_configurations_)
+  {
+    if(changed.count(s.first)) { continue; }
+    auto base = s.second.base;
+    for(size_t i = 0; i < states_configurations_.size(); ++i)
+    {
+      if(changed.count(base))
+      {
+        out.push_back(s.first);
+        if(!hasState(base))
+        {
+          mc_rtc::log::warning("State {} inherits from {} which was removed, it cannot be created until {} is back",
+                               s.first, base, base);
+        }
+        break;
+      }
+      auto it = states_configurations_.find(base);
+      if(it == states_configurations_.end()) { break; }
+      base = it->second.base;
+    }
+  }
+  out.insert(out.end(), changed.begin(), changed.end());
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+std::vector<std::string> StateFactory::reload_files()
+{
+  read_files_changes();
+  return apply_files_changes();
+}
+
 void StateFactory::load(const std::map<std::string, mc_rtc::Configuration> & states)
 {
   std::vector<UDState> ud_states;
@@ -198,7 +355,7 @@ StatePtr StateFactory::create(const std::string & state,
 StatePtr StateFactory::create(const std::string & state, const mc_rtc::Configuration & config)
 {
   StatePtr ret = create(state);
-  ret->configure_(config);
+  if(ret) { ret->configure_(config); }
   return ret;
 }
 
@@ -226,10 +383,11 @@ StatePtr StateFactory::create(const std::string & state, const std::string & fin
     if(config.arg.size())
     {
       ret = create_object(config.base, config.arg);
-      ret->name(final_name);
+      if(ret) { ret->name(final_name); }
     }
+    // The base is not available if it was removed by apply_files_changes
     else { ret = create(config.base, final_name); }
-    ret->configure_(config.config);
+    if(ret) { ret->configure_(config.config); }
   }
   if(!ret)
   {
@@ -239,6 +397,14 @@ StatePtr StateFactory::create(const std::string & state, const std::string & fin
   return ret;
 }
 
+void StateFactory::unload(const std::string & state)
+{
+  if(!states_configurations_.count(state)) { return; }
+  if(verbose) { mc_rtc::log::info("Remove state: {}", state); }
+  states_.erase(std::find(states_.begin(), states_.end(), state));
+  states_configurations_.erase(state);
+}
+
 bool StateFactory::hasState(const std::string & state) const
 {
   return std::find(states_.begin(), states_.end(), state) != states_.end();
@@ -963,6 +963,11 @@ bool MCGlobalController::AddController(const std::string & name)
     if(config.enable_log)
     {
       controllers[name]->logger().setup(config.log_policy, config.log_directory, config.log_template);
+      controllers[name]->logger().segmentation(config.log_segmentation);
+    }
+    if(config.controllers_configs[name].has("QPSolver"))
+    {
+      controllers[name]->solver().configure(config.controllers_configs[name]("QPSolver"));
     }
     controllers[name]->createObserverPipelines(config.controllers_configs[name]);
     return true;
@@ -995,6 +1000,7 @@ bool MCGlobalController::AddController(const std::string & name, std::shared_ptr
   if(config.enable_log)
   {
     controllers[name]->logger().setup(config.log_policy, config.log_directory, config.log_template);
+    controllers[name]->logger().segmentation(config.log_segmentation);
   }
   return true;
 }
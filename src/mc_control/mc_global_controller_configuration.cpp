@@ -223,6 +223,12 @@ MCGlobalController::GlobalConfiguration::GlobalConfiguration(const std::string &
     if(v.size()) { log_directory = v; }
   }
   config("LogTemplate", log_template);
+  if(auto segmentation = config.find("LogSegmentation"))
+  {
+    double size = segmentation->operator()("size", 0.0);
+    log_segmentation.max_size = static_cast<size_t>(std::max(size, 0.0) * 1024 * 1024);
+    log_segmentation.max_duration = segmentation->operator()("duration", 0.0);
+  }
 
   /////////////////////////
   //  GUI server options //
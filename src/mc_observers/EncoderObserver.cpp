@@ -48,6 +48,7 @@ void EncoderObserver::configure(const mc_control::MCController & ctl, const mc_r
     ;
   }
 
+  config("velocityCutoffPeriod", velocityCutoffPeriod_);
   config("computeFK", computeFK_);
   config("computeFV", computeFV_);
 
@@ -84,9 +85,17 @@ bool EncoderObserver::run(const mc_control::MCController & ctl)
       mc_rtc::log::error_and_throw("[EncoderObserver] requires robot {} to have encoder velocity measurements", robot_);
     }
 
+    const auto & realRobot = ctl.realRobots().robot(updateRobot_);
+    std::vector<int> jointIndices(realRobot.refJointOrder().size());
+    for(size_t i = 0; i < jointIndices.size(); ++i) { jointIndices[i] = robot.jointIndexInMBC(i); }
+    jointsMap_ = mc_rbdyn::FlatParamMap::refJointOrder(robot.mb(), jointIndices, true);
+
     if(!enc.empty())
     {
-      prevEncoders_ = enc;
+      auto size = static_cast<Eigen::Index>(enc.size());
+      velocityFilter_ = mc_filter::LowPassFiniteDifferencesBank(ctl.timeStep, size);
+      if(velocityCutoffPeriod_ > 0) { velocityFilter_.cutoffPeriod(velocityCutoffPeriod_); }
+      velocityFilter_.reset(Eigen::Map<const Eigen::VectorXd>(enc.data(), size), Eigen::VectorXd::Zero(size));
       encodersVelocity_.resize(enc.size());
       for(unsigned i = 0; i < enc.size(); ++i) { encodersVelocity_[i] = 0; }
     }
@@ -94,11 +103,8 @@ bool EncoderObserver::run(const mc_control::MCController & ctl)
   if(velUpdate_ == VelUpdate::EncoderFiniteDifferences)
   {
     const auto & enc = robot.encoderValues();
-    for(unsigned i = 0; i < enc.size(); ++i)
-    {
-      encodersVelocity_[i] = (enc[i] - prevEncoders_[i]) / ctl.timeStep;
-      prevEncoders_[i] = enc[i];
-    }
+    velocityFilter_.update(Eigen::Map<const Eigen::VectorXd>(enc.data(), static_cast<Eigen::Index>(enc.size())));
+    Eigen::Map<Eigen::VectorXd>(encodersVelocity_.data(), velocityFilter_.size()) = velocityFilter_.eval();
   }
   return true;
 }
@@ -111,28 +117,30 @@ void EncoderObserver::update(mc_control::MCController & ctl)
   const auto & q = robot.encoderValues();
 
   // Set all joint values and velocities from encoders
-  size_t nJoints = realRobot.refJointOrder().size();
-  for(size_t i = 0; i < nJoints; ++i)
+  switch(posUpdate_)
   {
-    const auto joint_index = robot.jointIndexInMBC(i);
-    if(joint_index != -1 && robot.mb().joint(joint_index).dof() == 1)
-    {
-      size_t jidx = static_cast<size_t>(joint_index);
-      // Update position
-      if(posUpdate_ == PosUpdate::Control) { realRobot.mbc().q[jidx][0] = robot.mbc().q[jidx][0]; }
-      else if(posUpdate_ == PosUpdate::EncoderValues) { realRobot.mbc().q[jidx][0] = q[i]; }
-
-      // Update velocity
-      if(velUpdate_ == VelUpdate::Control) { realRobot.mbc().alpha[jidx][0] = robot.mbc().alpha[jidx][0]; }
-      else if(velUpdate_ == VelUpdate::EncoderFiniteDifferences)
-      {
-        realRobot.mbc().alpha[jidx][0] = encodersVelocity_[i];
-      }
-      else if(velUpdate_ == VelUpdate::EncoderVelocities)
-      {
-        realRobot.mbc().alpha[jidx][0] = robot.encoderVelocities()[i];
-      }
-    }
+    case PosUpdate::Control:
+      jointsMap_.copy(robot.mbc().q, realRobot.mbc().q);
+      break;
+    case PosUpdate::EncoderValues:
+      jointsMap_.scatter(q, realRobot.mbc().q);
+      break;
+    case PosUpdate::None:
+      break;
+  }
+  switch(velUpdate_)
+  {
+    case VelUpdate::Control:
+      jointsMap_.copy(robot.mbc().alpha, realRobot.mbc().alpha);
+      break;
+    case VelUpdate::EncoderFiniteDifferences:
+      jointsMap_.scatter(encodersVelocity_, realRobot.mbc().alpha);
+      break;
+    case VelUpdate::EncoderVelocities:
+      jointsMap_.scatter(robot.encoderVelocities(), realRobot.mbc().alpha);
+      break;
+    case VelUpdate::None:
+      break;
   }
   if(computeFK_ && posUpdate_ != PosUpdate::None) { realRobot.forwardKinematics(); }
   if(computeFV_ && velUpdate_ != VelUpdate::None) { realRobot.forwardVelocity(); }
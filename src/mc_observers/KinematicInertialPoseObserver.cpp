@@ -52,17 +52,22 @@ void KinematicInertialPoseObserver::reset(const mc_control::MCController & ctl)
 
 bool KinematicInertialPoseObserver::run(const mc_control::MCController & ctl)
 {
-  if(!ctl.datastore().has(anchorFrameFunction_))
+  if(!anchorFrameHandle_.valid())
   {
-    error_ = fmt::format(
-        "Observer {} requires a \"{}\" function in the datastore to provide the observer's kinematic anchor frame.\n"
-        "Please refer to https://jrl-umi3218.github.io/mc_rtc/tutorials/recipes/observers.html for further details.",
-        name(), anchorFrameFunction_);
-    return false;
+    if(!ctl.datastore().has(anchorFrameFunction_))
+    {
+      error_ = fmt::format(
+          "Observer {} requires a \"{}\" function in the datastore to provide the observer's kinematic anchor frame.\n"
+          "Please refer to https://jrl-umi3218.github.io/mc_rtc/tutorials/recipes/observers.html for further details.",
+          name(), anchorFrameFunction_);
+      return false;
+    }
+    anchorFrameHandle_ = ctl.datastore().handle<AnchorFrameFunction>(anchorFrameFunction_);
   }
   anchorFrameJumped_ = false;
-  auto anchorFrame = ctl.datastore().call<sva::PTransformd>(anchorFrameFunction_, ctl.robot(robot_));
-  auto anchorFrameReal = ctl.datastore().call<sva::PTransformd>(anchorFrameFunction_, ctl.realRobot(realRobot_));
+  const auto & anchorFrameFn = *anchorFrameHandle_;
+  auto anchorFrame = anchorFrameFn(ctl.robot(robot_));
+  auto anchorFrameReal = anchorFrameFn(ctl.realRobot(realRobot_));
   if(firstIter_)
   { // Ignore anchor frame check on first iteration
     firstIter_ = false;
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_planning/ZMPPreviewController.h>
+
+#include <mc_rtc/constants.h>
+#include <mc_rtc/logging.h>
+
+#include <Eigen/LU>
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace mc_planning
+{
+
+namespace constants = mc_rtc::constants;
+
+ZMPPreviewGains::ZMPPreviewGains(double dt, double height, Eigen::Index horizon, double zmpWeight, double jerkWeight)
+: dt(dt), height(height)
+{
+  if(dt <= 0 || height <= 0 || horizon <= 0 || zmpWeight <= 0 || jerkWeight <= 0)
+  {
+    mc_rtc::log::error_and_throw(
+        "[ZMPPreviewGains] Invalid parameters (dt: {}, height: {}, horizon: {}, zmpWeight: {}, jerkWeight: {})", dt,
+        height, horizon, zmpWeight, jerkWeight);
+  }
+  // clang-format off
+  A << 1, dt, dt * dt / 2,
+       0,  1,          dt,
+       0,  0,           1;
+  // clang-format on
+  B << dt * dt * dt / 6, dt * dt / 2, dt;
+  C << 1, 0, -height / constants::GRAVITY;
+
+  // Solve the discrete algebraic Riccati equation by fixed-point iteration, this only happens once per set of
+  // parameters
+  Eigen::Matrix3d Q = zmpWeight * C.transpose() * C;
+  Eigen::Matrix3d P = Q;
+  bool converged = false;
+  for(size_t i = 0; i < 100000 && !converged; ++i)
+  {
+    double s = jerkWeight + B.dot(P * B);
+    Eigen::RowVector3d BtPA = B.transpose() * P * A;
+    Eigen::Matrix3d Pn = A.transpose() * P * A - BtPA.transpose() * BtPA / s + Q;
+    converged = (Pn - P).norm() <= 1e-12 * Pn.norm();
+    P = Pn;
+  }
+  if(!converged)
+  {
+    mc_rtc::log::error_and_throw("[ZMPPreviewGains] Riccati equation did not converge (dt: {}, height: {})", dt,
+                                 height);
+  }
+  double s = jerkWeight + B.dot(P * B);
+  K = B.transpose() * P * A / s;
+
+  Eigen::Matrix3d AcT = (A - B * K).transpose();
+  Eigen::Vector3d X = zmpWeight * C.transpose();
+  F.resize(horizon);
+  for(Eigen::Index j = 0; j < horizon; ++j)
+  {
+    F(j) = B.dot(X) / s;
+    X = AcT * X;
+  }
+  // The reference is assumed constant after the horizon, the remaining infinite sum of preview gains is added to the
+  // last one so that constant references are tracked without steady-state error
+  F(horizon - 1) += B.dot((Eigen::Matrix3d::Identity() - AcT).inverse() * X) / s;
+  FTail.resize(horizon + 1);
+  FTail(horizon) = 0;
+  for(Eigen::Index j = horizon - 1; j >= 0; --j) { FTail(j) = FTail(j + 1) + F(j); }
+}
+
+std::shared_ptr<const ZMPPreviewGains> ZMPPreviewGains::get(double dt,
+                                                            double height,
+                                                            Eigen::Index horizon,
+                                                            double zmpWeight,
+                                                            double jerkWeight)
+{
+  using Key = std::tuple<double, double, Eigen::Index, double, double>;
+  static std::mutex mutex;
+  static std::map<Key, std::shared_ptr<const ZMPPreviewGains>> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto & gains = cache[Key{dt, height, horizon, zmpWeight, jerkWeight}];
+  if(!gains) { gains = std::make_shared<const ZMPPreviewGains>(dt, height, horizon, zmpWeight, jerkWeight); }
+  return gains;
+}
+
+ZMPPreviewController::ZMPPreviewController(double dt, double height, double horizon, Eigen::Index capacity)
+: gains_(ZMPPreviewGains::get(dt, height, static_cast<Eigen::Index>(std::lround(horizon / dt))))
+{
+  if(capacity <= 0) { capacity = 2 * this->horizon(); }
+  refs_.resize(2, capacity);
+}
+
+void ZMPPreviewController::reset(const Eigen::Vector3d & com, const Eigen::Vector3d & comd, const Eigen::Vector3d & comdd)
+{
+  x_.row(0) = com.head<2>().transpose();
+  x_.row(1) = comd.head<2>().transpose();
+  x_.row(2) = comdd.head<2>().transpose();
+  u_.setZero();
+  zmpHeight_ = com.z() - gains_->height;
+  head_ = 0;
+  size_ = 0;
+  zmpRef_ = (gains_->C * x_).transpose();
+}
+
+bool ZMPPreviewController::push(const Eigen::Vector2d & zmp)
+{
+  if(size_ == capacity()) { return false; }
+  refs_.col(index(size_)) = zmp;
+  size_++;
+  return true;
+}
+
+Eigen::Index ZMPPreviewController::push(const Eigen::Vector2d & zmp, double duration)
+{
+  if(!(duration >= 0))
+  {
+    mc_rtc::log::error_and_throw<std::invalid_argument>("[ZMPPreviewController] Invalid push duration: {}", duration);
+  }
+  auto n = std::min(static_cast<Eigen::Index>(std::round(duration / gains_->dt)), capacity() - size_);
+  for(Eigen::Index i = 0; i < n; ++i) { push(zmp); }
+  return n;
+}
+
+void ZMPPreviewController::update()
+{
+  const auto & g = *gains_;
+  // refs_.col(index(0)) is the current reference, the preview starts at the next one
+  Eigen::Index previewed = std::min(horizon(), std::max<Eigen::Index>(size_ - 1, 0));
+  u_.noalias() = -g.K * x_;
+  if(previewed > 0)
+  {
+    // The previewed references are at most two contiguous spans of the ring buffer
+    auto start = index(1);
+    auto n = std::min(previewed, refs_.cols() - start);
+    u_.noalias() += g.F.head(n).transpose() * refs_.middleCols(start, n).transpose();
+    if(n < previewed)
+    {
+      u_.noalias() += g.F.segment(n, previewed - n).transpose() * refs_.leftCols(previewed - n).transpose();
+    }
+  }
+  if(size_ > 0) { zmpRef_ = refs_.col(index(0)); }
+  if(previewed < horizon())
+  {
+    // Hold the last known reference over the rest of the horizon
+    Eigen::Vector2d last = size_ > 0 ? Eigen::Vector2d(refs_.col(index(size_ - 1))) : zmpRef_;
+    u_.noalias() += g.FTail(previewed) * last.transpose();
+  }
+  x_ = g.A * x_ + g.B * u_;
+  if(size_ > 0)
+  {
+    head_ = index(1);
+    size_--;
+  }
+}
+
+Eigen::Vector3d ZMPPreviewController::zmp() const noexcept
+{
+  Eigen::RowVector2d p = gains_->C * x_;
+  return {p(0), p(1), zmpHeight_};
+}
+
+Eigen::Vector3d ZMPPreviewController::zmpd() const noexcept
+{
+  Eigen::RowVector2d pd = x_.row(1) - gains_->height / constants::GRAVITY * u_;
+  return {pd(0), pd(1), 0};
+}
+
+} // namespace mc_planning
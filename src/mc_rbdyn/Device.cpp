@@ -2,6 +2,8 @@
 
 #include <mc_rbdyn/Robot.h>
 
+#include <atomic>
+
 namespace mc_rbdyn
 {
 
@@ -12,6 +14,17 @@ Device::Device(const std::string & name, const std::string & parent, const sva::
 {
 }
 
+uint64_t nextGeneration() noexcept
+{
+  static std::atomic<uint64_t> generation{0};
+  return ++generation;
+}
+
+uint64_t Device::nextGeneration() noexcept
+{
+  return mc_rbdyn::nextGeneration();
+}
+
 sva::PTransformd Device::X_0_s(const mc_rbdyn::Robot & robot) const
 {
   return X_p_s() * robot.bodyPosW(parent_);
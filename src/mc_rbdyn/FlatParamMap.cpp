@@ -0,0 +1,75 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/FlatParamMap.h>
+
+#include <algorithm>
+
+namespace mc_rbdyn
+{
+
+FlatParamMap FlatParamMap::fromJoints(const rbd::MultiBody & mb, bool params)
+{
+  FlatParamMap out;
+  out.scalars_.reserve(mb.joints().size());
+  for(size_t i = 0; i < mb.joints().size(); ++i)
+  {
+    const auto & j = mb.joint(static_cast<int>(i));
+    auto size = static_cast<unsigned int>(params ? j.params() : j.dof());
+    auto offset = static_cast<unsigned int>(params ? mb.jointPosInParam(static_cast<int>(i))
+                                                   : mb.jointPosInDof(static_cast<int>(i)));
+    if(size == 0) { continue; }
+    if(size == 1) { out.scalars_.push_back({static_cast<unsigned int>(i), offset}); }
+    else { out.segments_.push_back({static_cast<unsigned int>(i), offset, size}); }
+    out.size_ = std::max<size_t>(out.size_, offset + size);
+  }
+  return out;
+}
+
+FlatParamMap FlatParamMap::params(const rbd::MultiBody & mb)
+{
+  return fromJoints(mb, true);
+}
+
+FlatParamMap FlatParamMap::dofs(const rbd::MultiBody & mb)
+{
+  return fromJoints(mb, false);
+}
+
+FlatParamMap FlatParamMap::refJointOrder(const rbd::MultiBody & mb,
+                                         const std::vector<int> & refJointIndexToMBCIndex,
+                                         bool singleDofOnly)
+{
+  FlatParamMap out;
+  out.size_ = refJointIndexToMBCIndex.size();
+  out.scalars_.reserve(refJointIndexToMBCIndex.size());
+  for(size_t i = 0; i < refJointIndexToMBCIndex.size(); ++i)
+  {
+    auto jIdx = refJointIndexToMBCIndex[i];
+    if(jIdx < 0) { continue; }
+    if(singleDofOnly && mb.joint(jIdx).dof() != 1) { continue; }
+    out.scalars_.push_back({static_cast<unsigned int>(jIdx), static_cast<unsigned int>(i)});
+  }
+  return out;
+}
+
+void FlatParamMap::gather(const param_t & param, double * out) const noexcept
+{
+  for(const auto & s : scalars_) { out[s.offset] = param[s.joint][0]; }
+  for(const auto & s : segments_) { std::copy_n(param[s.joint].data(), s.size, out + s.offset); }
+}
+
+void FlatParamMap::scatter(const double * in, param_t & param) const noexcept
+{
+  for(const auto & s : scalars_) { param[s.joint][0] = in[s.offset]; }
+  for(const auto & s : segments_) { std::copy_n(in + s.offset, s.size, param[s.joint].data()); }
+}
+
+void FlatParamMap::copy(const param_t & in, param_t & out) const noexcept
+{
+  for(const auto & s : scalars_) { out[s.joint][0] = in[s.joint][0]; }
+  for(const auto & s : segments_) { std::copy_n(in[s.joint].data(), s.size, out[s.joint].data()); }
+}
+
+} // namespace mc_rbdyn
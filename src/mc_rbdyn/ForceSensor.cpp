@@ -97,6 +97,7 @@ ForceSensor::ForceSensor(const ForceSensor & fs) : ForceSensor(fs.name_, fs.pare
 {
   wrench_ = fs.wrench_;
   calibration_ = fs.calibration_;
+  generation_ = fs.generation_;
 }
 
 ForceSensor & ForceSensor::operator=(const ForceSensor & fs)
@@ -107,6 +108,8 @@ ForceSensor & ForceSensor::operator=(const ForceSensor & fs)
   X_p_s_ = fs.X_p_s_;
   calibration_ = fs.calibration_;
   wrench_ = fs.wrench_;
+  wrenchGeneration_ = nextGeneration();
+  generation_ = fs.generation_;
   return *this;
 }
 
@@ -115,6 +118,7 @@ ForceSensor::~ForceSensor() noexcept = default;
 void ForceSensor::loadCalibrator(const detail::ForceSensorCalibData & data) noexcept
 {
   calibration_ = data;
+  generation_ = nextGeneration();
 }
 
 void ForceSensor::loadCalibrator(const std::string & calib_file, const Eigen::Vector3d & gravity)
@@ -125,16 +129,19 @@ void ForceSensor::loadCalibrator(const std::string & calib_file, const Eigen::Ve
     return;
   }
   calibration_.loadData(calib_file, gravity);
+  generation_ = nextGeneration();
 }
 
 void ForceSensor::copyCalibrator(const mc_rbdyn::ForceSensor & other)
 {
   calibration_ = other.calibration_;
+  generation_ = nextGeneration();
 }
 
 void ForceSensor::resetCalibrator()
 {
   calibration_.reset();
+  generation_ = nextGeneration();
 }
 
 const sva::PTransformd & ForceSensor::X_fsmodel_fsactual() const
@@ -159,6 +166,8 @@ const sva::ForceVecd & ForceSensor::offset() const
 
 sva::ForceVecd ForceSensor::wrenchWithoutGravity(const mc_rbdyn::Robot & robot) const
 {
+  sva::ForceVecd cached;
+  if(robot.forceSensorCache(*this, &detail::ForceSensorCache::wrenchWithoutGravity, cached)) { return cached; }
   sva::PTransformd X_0_p = robot.mbc().bodyPosW[robot.bodyIndexByName(parent_)];
   auto w = wrench_ - calibration_.wfToSensor(X_0_p, X_p_s_);
   return w;
@@ -166,6 +175,8 @@ sva::ForceVecd ForceSensor::wrenchWithoutGravity(const mc_rbdyn::Robot & robot)
 
 sva::ForceVecd ForceSensor::worldWrench(const mc_rbdyn::Robot & robot) const
 {
+  sva::ForceVecd cached;
+  if(robot.forceSensorCache(*this, &detail::ForceSensorCache::worldWrench, cached)) { return cached; }
   sva::ForceVecd w_fsactual = wrench();
   sva::PTransformd X_parent_0 = robot.mbc().bodyPosW[robot.bodyIndexByName(parent_)].inv();
   sva::PTransformd X_fsactual_0 = X_parent_0 * X_fsactual_parent();
@@ -174,6 +185,8 @@ sva::ForceVecd ForceSensor::worldWrench(const mc_rbdyn::Robot & robot) const
 
 sva::ForceVecd ForceSensor::worldWrenchWithoutGravity(const mc_rbdyn::Robot & robot) const
 {
+  sva::ForceVecd cached;
+  if(robot.forceSensorCache(*this, &detail::ForceSensorCache::worldWrenchWithoutGravity, cached)) { return cached; }
   sva::ForceVecd w_fsactual = wrenchWithoutGravity(robot);
   sva::PTransformd X_parent_0 = robot.mbc().bodyPosW[robot.bodyIndexByName(parent_)].inv();
   sva::PTransformd X_fsactual_0 = X_parent_0 * X_fsactual_parent();
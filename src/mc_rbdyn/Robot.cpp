@@ -29,6 +29,7 @@
 namespace bfs = boost::filesystem;
 
 #include <fstream>
+#include <functional>
 #include <tuple>
 
 namespace
@@ -238,6 +239,24 @@ bool VisualToConvex(const std::string & robot,
   return true;
 }
 
+/** Store the values set by \p fill in a net wrench entry that is outdated for \p key
+ *
+ * Nothing is stored if all entries are up-to-date, entries that are up-to-date are never written since they can be
+ * read concurrently without locking
+ */
+template<typename FillT>
+void cacheNetWrench(mc_rbdyn::detail::ForceSensorsCache & cache, uint64_t key, FillT && fill)
+{
+  std::unique_lock<std::mutex> lock(cache.mutex);
+  for(auto & entry : cache.netWrenches)
+  {
+    if(entry.key.load(std::memory_order_relaxed) == key) { continue; }
+    fill(entry);
+    entry.key.store(key, std::memory_order_release);
+    return;
+  }
+}
+
 } // namespace
 
 namespace mc_rbdyn
@@ -300,12 +319,16 @@ Robot::Robot(NewRobotToken,
   mass_ = 0.;
   for(const auto & b : mb().bodies()) { mass_ += b.inertia().mass(); }
 
-  bodyTransforms_.resize(mb().bodies().size());
-  const auto & bbts = mbg().bodiesBaseTransform(base_name, base_tf);
-  for(size_t i = 0; i < mb().bodies().size(); ++i)
+  // Copies get their body transforms from the reference robot in copyLoadedData
+  if(loadFiles)
   {
-    const auto & b = mb().body(static_cast<int>(i));
-    bodyTransforms_[i] = bbts.at(b.name());
+    bodyTransforms_.resize(mb().bodies().size());
+    const auto & bbts = mbg().bodiesBaseTransform(base_name, base_tf);
+    for(size_t i = 0; i < mb().bodies().size(); ++i)
+    {
+      const auto & b = mb().body(static_cast<int>(i));
+      bodyTransforms_[i] = bbts.at(b.name());
+    }
   }
 
   if(module_.bounds().size() != 6)
@@ -490,11 +513,15 @@ Robot::Robot(NewRobotToken,
     }
     else { refJointIndexToMBCIndex_[i] = -1; }
   }
+  paramMap_ = FlatParamMap::params(mb());
+  dofMap_ = FlatParamMap::dofs(mb());
+  refJointOrderMap_ = FlatParamMap::refJointOrder(mb(), refJointIndexToMBCIndex_);
 
   springs_ = module_.springs();
   flexibility_ = module_.flexibility();
 
   zmp_ = Eigen::Vector3d::Zero();
+  forceSensorsCache_->resize(data_->forceSensors.size());
 }
 
 Robot::~Robot()
@@ -614,11 +641,14 @@ const rbd::MultiBodyConfig & Robot::mbc() const
 
 rbd::MultiBodyGraph & Robot::mbg()
 {
-  return robots_->mbgs_[robots_idx_];
+  auto & mbg = robots_->mbgs_[robots_idx_];
+  // Not synchronized with concurrent copies, see the documentation in Robot.h
+  if(mbg.use_count() > 1) { mbg = std::make_shared<rbd::MultiBodyGraph>(*mbg); }
+  return *mbg;
 }
 const rbd::MultiBodyGraph & Robot::mbg() const
 {
-  return robots_->mbgs_[robots_idx_];
+  return *robots_->mbgs_[robots_idx_];
 }
 
 const std::vector<std::vector<double>> & Robot::q() const
@@ -744,8 +774,20 @@ Eigen::Vector3d Robot::copW(const std::string & name, double min_pressure) const
   return frame(name).copW(min_pressure);
 }
 
+uint64_t Robot::forceSensorsGeneration() const noexcept
+{
+  uint64_t generation = kinematicsGeneration_;
+  for(const auto & fs : data_->forceSensors) { generation = std::max(generation, forceSensorGeneration(fs)); }
+  return generation;
+}
+
 sva::ForceVecd Robot::netWrench(const std::vector<std::string> & sensorNames) const
 {
+  auto key = forceSensorsGeneration();
+  for(const auto & entry : forceSensorsCache_->netWrenches)
+  {
+    if(entry.key.load(std::memory_order_acquire) == key && entry.sensors == sensorNames) { return entry.wrench; }
+  }
   // Compute net total wrench from all sensors in contact
   sva::ForceVecd netTotalWrench{sva::ForceVecd::Zero()};
   for(const auto & sensorName : sensorNames)
@@ -753,6 +795,13 @@ sva::ForceVecd Robot::netWrench(const std::vector<std::string> & sensorNames) co
     const auto & sensor = forceSensor(sensorName);
     netTotalWrench += sensor.worldWrenchWithoutGravity(*this);
   }
+  cacheNetWrench(*forceSensorsCache_, key,
+                 [&](detail::NetWrenchCache & entry)
+                 {
+                   entry.sensors = sensorNames;
+                   entry.wrench = netTotalWrench;
+                   entry.hasZmp = false;
+                 });
   return netTotalWrench;
 }
 
@@ -793,6 +842,9 @@ Eigen::Vector3d Robot::zmp(const std::vector<std::string> & sensorNames,
                            const Eigen::Vector3d & plane_n,
                            double minimalNetNormalForce) const
 {
+  Eigen::Vector3d zmpOut;
+  if(minimalNetNormalForce > 0 && zmp(zmpOut, sensorNames, plane_p, plane_n, minimalNetNormalForce)) { return zmpOut; }
+  // Throws the appropriate error
   return zmp(netWrench(sensorNames), plane_p, plane_n, minimalNetNormalForce);
 }
 
@@ -802,7 +854,33 @@ bool Robot::zmp(Eigen::Vector3d & zmpOut,
                 const Eigen::Vector3d & plane_n,
                 double minimalNetNormalForce) const noexcept
 {
-  return zmp(zmpOut, netWrench(sensorNames), plane_p, plane_n, minimalNetNormalForce);
+  auto key = forceSensorsGeneration();
+  for(const auto & entry : forceSensorsCache_->netWrenches)
+  {
+    if(entry.key.load(std::memory_order_acquire) == key && entry.hasZmp && entry.sensors == sensorNames
+       && entry.plane_p == plane_p && entry.plane_n == plane_n && entry.minimalNetNormalForce == minimalNetNormalForce)
+    {
+      if(entry.zmpValid) { zmpOut = entry.zmp; }
+      return entry.zmpValid;
+    }
+  }
+  auto wrench = netWrench(sensorNames);
+  Eigen::Vector3d zmpValue = Eigen::Vector3d::Zero();
+  bool valid = mc_rbdyn::zmp(zmpValue, wrench, plane_p, plane_n, minimalNetNormalForce);
+  cacheNetWrench(*forceSensorsCache_, key,
+                 [&](detail::NetWrenchCache & entry)
+                 {
+                   entry.sensors = sensorNames;
+                   entry.wrench = wrench;
+                   entry.hasZmp = true;
+                   entry.plane_p = plane_p;
+                   entry.plane_n = plane_n;
+                   entry.minimalNetNormalForce = minimalNetNormalForce;
+                   entry.zmpValid = valid;
+                   entry.zmp = zmpValue;
+                 });
+  if(valid) { zmpOut = zmpValue; }
+  return valid;
 }
 
 Eigen::Vector3d Robot::zmp(const std::vector<std::string> & sensorNames,
@@ -941,6 +1019,7 @@ void Robot::addForceSensor(const mc_rbdyn::ForceSensor & fs)
   }
   data_->forceSensors.push_back(fs);
   data_->forceSensorsIndex[fs.name()] = data_->forceSensors.size() - 1;
+  for(auto & r : data_->robots) { r->forceSensorsCache_->resize(data_->forceSensors.size()); }
   auto bfs_it = data_->bodyForceSensors_.find(fs.parentBody());
   if(bfs_it == data_->bodyForceSensors_.end())
   {
@@ -953,6 +1032,48 @@ void Robot::addForceSensor(const mc_rbdyn::ForceSensor & fs)
   for(auto & r : data_->robots) { updateFrames(*r); }
 }
 
+const detail::ForceSensorCache * Robot::updateForceSensorCache(const ForceSensor & fs) const
+{
+  const auto & sensors = data_->forceSensors;
+  std::less<const ForceSensor *> less;
+  if(sensors.empty() || less(&fs, sensors.data()) || !less(&fs, sensors.data() + sensors.size())) { return nullptr; }
+  auto idx = static_cast<size_t>(&fs - sensors.data());
+  if(idx >= forceSensorsCache_->size) { return nullptr; }
+  auto & cache = forceSensorsCache_->entries[idx];
+  auto key = forceSensorGeneration(fs);
+  if(cache.key.load(std::memory_order_acquire) == key) { return &cache; }
+  std::unique_lock<std::mutex> lock(forceSensorsCache_->mutex);
+  // Another thread might have computed the values while we waited
+  if(cache.key.load(std::memory_order_relaxed) == key) { return &cache; }
+  if(cache.generation != fs.generation())
+  {
+    cache.generation = fs.generation();
+    cache.parentIndex = bodyIndexByName(fs.parentBody());
+  }
+  const auto & X_0_p = mbc().bodyPosW[cache.parentIndex];
+  cache.wrenchWithoutGravity = fs.wrench() - fs.calib().wfToSensor(X_0_p, fs.X_p_f());
+  sva::PTransformd X_fsactual_0 = X_0_p.inv() * fs.X_fsactual_parent();
+  cache.worldWrench = X_fsactual_0.dualMul(fs.wrench());
+  cache.worldWrenchWithoutGravity = X_fsactual_0.dualMul(cache.wrenchWithoutGravity);
+  cache.key.store(key, std::memory_order_release);
+  return &cache;
+}
+
+bool Robot::forceSensorCache(const ForceSensor & fs,
+                             sva::ForceVecd detail::ForceSensorCache::*value,
+                             sva::ForceVecd & out) const
+{
+  const auto * cache = updateForceSensorCache(fs);
+  if(!cache) { return false; }
+  out = cache->*value;
+  return true;
+}
+
+void Robot::refreshForceSensorsCache() const
+{
+  for(const auto & fs : data_->forceSensors) { updateForceSensorCache(fs); }
+}
+
 const ForceSensor & Robot::forceSensor(const std::string & name) const
 {
   auto it = data_->forceSensorsIndex.find(name);
@@ -1211,6 +1332,7 @@ void Robot::forwardKinematics()
 void Robot::forwardKinematics(rbd::MultiBodyConfig & mbc) const
 {
   rbd::forwardKinematics(mb(), mbc);
+  if(&mbc == &this->mbc()) { kinematicsGeneration_ = nextGeneration(); }
 
   for(const auto & cvx : convexes_)
   {
@@ -1328,6 +1450,7 @@ const sva::MotionVecd Robot::accW() const
 
 void Robot::copyLoadedData(Robot & robot) const
 {
+  robot.bodyTransforms_ = bodyTransforms_;
   for(const auto & s : surfaces_) { robot.surfaces_[s.first] = s.second->copy(); }
   robot.fixSurfaces();
   robot.makeFrames(module().frames());
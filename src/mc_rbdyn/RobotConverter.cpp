@@ -21,6 +21,7 @@ void RobotConverter::precompute(const mc_rbdyn::Robot & inputRobot, const mc_rbd
 {
   if(config_.mbcToOutMbc_)
   { // Construct list of common joints between inputRobot and outputRobot
+    commonScalarJointIndices_.reserve(std::max(inputRobot.mb().joints().size(), outputRobot.mb().joints().size()));
     commonJointIndices_.reserve(std::max(inputRobot.mb().joints().size(), outputRobot.mb().joints().size()));
     for(const auto & joint : inputRobot.mb().joints())
     {
@@ -31,7 +32,8 @@ void RobotConverter::precompute(const mc_rbdyn::Robot & inputRobot, const mc_rbd
       if(outputRobot.hasJoint(jname)
          && outputRobot.mb().joint(static_cast<int>(outputRobot.jointIndexByName(jname))).dof() == joint.dof())
       {
-        commonJointIndices_.emplace_back(inputRobot.jointIndexByName(jname), outputRobot.jointIndexByName(jname));
+        auto & indices = joint.dof() == 1 ? commonScalarJointIndices_ : commonJointIndices_;
+        indices.emplace_back(inputRobot.jointIndexByName(jname), outputRobot.jointIndexByName(jname));
       }
     }
   }
@@ -85,6 +87,10 @@ void RobotConverter::convert(const mc_rbdyn::Robot & inputRobot, mc_rbdyn::Robot
       [this](bool doit, const std::vector<std::vector<double>> & input, std::vector<std::vector<double>> & output)
   {
     if(!doit) { return; }
+    for(const auto & commonIndices : commonScalarJointIndices_)
+    {
+      output[commonIndices.second][0] = input[commonIndices.first][0];
+    }
     for(const auto & commonIndices : commonJointIndices_) { output[commonIndices.second] = input[commonIndices.first]; }
   };
   if(config_.mbcToOutMbc_)
@@ -32,6 +32,7 @@ RobotFrame::RobotFrame(NewRobotFrameToken tkn,
 void RobotFrame::resetForceSensor() noexcept
 {
   sensor_ = robot_.findBodyForceSensor(body());
+  generation_ = nextGeneration();
 }
 
 const std::string & RobotFrame::body() const noexcept
@@ -59,11 +60,20 @@ const ForceSensor & RobotFrame::forceSensor() const
   return *sensor_;
 }
 
+uint64_t RobotFrame::forceGeneration() const
+{
+  auto generation = std::max(generation_, robot_.forceSensorGeneration(forceSensor()));
+  if(parent_) { return std::max(generation, static_cast<RobotFrame *>(parent_.get())->forceGeneration()); }
+  return generation;
+}
+
 sva::ForceVecd RobotFrame::wrench() const
 {
-  if(!sensor_) { mc_rtc::log::error_and_throw("No force sensor attached to {} in {}", name_, robot_.name()); }
-  if(!parent_)
+  auto key = forceGeneration();
+  if(forceCache_.key.load(std::memory_order_acquire) == key) { return forceCache_.wrench; }
+  auto w = [this]() -> sva::ForceVecd
   {
+    if(parent_) { return position_.dualMul(static_cast<RobotFrame *>(parent_.get())->wrench()); }
     // Find the transformation from the sensor to the frame
     auto X_fsactual_body = [this]()
     {
@@ -77,27 +87,62 @@ sva::ForceVecd RobotFrame::wrench() const
       }
     }();
     return X_fsactual_body.dualMul(sensor_->wrenchWithoutGravity(robot_));
+  }();
+  std::unique_lock<std::mutex> lock(forceCache_.mutex);
+  if(forceCache_.key.load(std::memory_order_relaxed) != key)
+  {
+    forceCache_.wrench = w;
+    forceCache_.key.store(key, std::memory_order_release);
   }
-  else { return position_.dualMul(static_cast<RobotFrame *>(parent_.get())->wrench()); }
+  return w;
 }
 
-Eigen::Vector2d RobotFrame::cop(double min_pressure) const
+void RobotFrame::cachedCoP(double min_pressure, Eigen::Vector2d & cop, Eigen::Vector3d & copW) const
 {
-  // We don't check if the force sensor is attached, this will be done when we get the wrench and the stack will tell
-  // the rest of the story
+  auto key = forceGeneration();
+  if(forceCache_.copKey.load(std::memory_order_acquire) == key && forceCache_.minPressure == min_pressure)
+  {
+    cop = forceCache_.cop;
+    copW = forceCache_.copW;
+    return;
+  }
   const sva::ForceVecd w_surf = wrench();
   const double pressure = w_surf.force()(2);
-  if(pressure < min_pressure) { return Eigen::Vector2d::Zero(); }
-  const Eigen::Vector3d & tau_surf = w_surf.couple();
-  return Eigen::Vector2d(-tau_surf(1) / pressure, +tau_surf(0) / pressure);
+  if(pressure < min_pressure) { cop.setZero(); }
+  else
+  {
+    const Eigen::Vector3d & tau_surf = w_surf.couple();
+    cop = Eigen::Vector2d(-tau_surf(1) / pressure, +tau_surf(0) / pressure);
+  }
+  Eigen::Vector3d cop_s;
+  cop_s << cop, 0.;
+  const sva::PTransformd X_0_s = position();
+  copW = X_0_s.translation() + X_0_s.rotation().transpose() * cop_s;
+  std::unique_lock<std::mutex> lock(forceCache_.mutex);
+  // The values are only kept for the first pressure threshold used with a given state
+  if(forceCache_.copKey.load(std::memory_order_relaxed) != key)
+  {
+    forceCache_.minPressure = min_pressure;
+    forceCache_.cop = cop;
+    forceCache_.copW = copW;
+    forceCache_.copKey.store(key, std::memory_order_release);
+  }
+}
+
+Eigen::Vector2d RobotFrame::cop(double min_pressure) const
+{
+  Eigen::Vector2d cop;
+  Eigen::Vector3d copW;
+  cachedCoP(min_pressure, cop, copW);
+  return cop;
 }
 
 Eigen::Vector3d RobotFrame::copW(double min_pressure) const
 {
-  Eigen::Vector3d cop_s;
-  cop_s << cop(min_pressure), 0.;
-  const sva::PTransformd X_0_s = position();
-  return X_0_s.translation() + X_0_s.rotation().transpose() * cop_s;
+  Eigen::Vector2d cop;
+  Eigen::Vector3d copW;
+  cachedCoP(min_pressure, cop, copW);
+  return copW;
 }
 
 RobotFramePtr RobotFrame::makeFrame(const std::string & name, const sva::PTransformd & X_p_f, bool baked)
@@ -182,10 +182,13 @@ void Robots::robotCopy(const Robot & robot, const std::string & copyName)
     mc_rtc::log::error_and_throw("Cannot copy robot {} to {}: a robot named {} already exists", robot.name(), copyName,
                                  copyName);
   }
-  this->robot_modules_.push_back(robot.module());
+  // Immutable model data is shared with the reference robot
+  auto module = robot.robots_->robot_modules_[robot.robots_idx_];
+  auto mbg = robot.robots_->mbgs_[robot.robots_idx_];
+  this->robot_modules_.push_back(std::move(module));
   this->mbs_.push_back(robot.mb());
   this->mbcs_.push_back(robot.mbc());
-  this->mbgs_.push_back(robot.mbg());
+  this->mbgs_.push_back(std::move(mbg));
   auto referenceRobots = robot.robots_;
   auto referenceIndex = robot.robots_idx_;
   auto copyRobotIndex = static_cast<unsigned int>(this->mbs_.size()) - 1;
@@ -202,10 +205,10 @@ Robot & Robots::load(const std::string & name, const RobotModule & module, const
   {
     mc_rtc::log::error_and_throw("Robot names are required to be unique but a robot named {} already exists.", name);
   }
-  robot_modules_.emplace_back(module);
+  robot_modules_.push_back(std::make_shared<const RobotModule>(module));
   mbs_.emplace_back(module.mb);
   mbcs_.emplace_back(module.mbc);
-  mbgs_.emplace_back(module.mbg);
+  mbgs_.push_back(std::make_shared<rbd::MultiBodyGraph>(module.mbg));
   robots_.push_back(std::make_shared<Robot>(Robot::NewRobotToken{}, name, *this,
                                             static_cast<unsigned int>(mbs_.size() - 1), true, params));
   robotNameToIndex_[name] = robots_.back()->robotIndex();
@@ -377,7 +380,7 @@ mc_rbdyn::Robots::size_type mc_rbdyn::Robots::size() const noexcept
 
 const RobotModule & Robots::robotModule(size_t idx) const
 {
-  return robot_modules_[idx];
+  return *robot_modules_[idx];
 }
 
 MC_RTC_diagnostic_pop
@@ -4,6 +4,33 @@
 
 #include <mc_rbdyn/SCHAddon.h>
 
+#include <boost/filesystem.hpp>
+namespace bfs = boost::filesystem;
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace
+{
+
+/** Polyhedra loaded from files, a file is parsed again if its size or modification time change */
+struct PolyhedronFileCache
+{
+  using key_t = std::tuple<std::string, std::time_t, uintmax_t>;
+  std::mutex mutex;
+  std::map<key_t, std::shared_ptr<const sch::S_Polyhedron>> polyhedrons;
+};
+
+PolyhedronFileCache & polyhedron_file_cache()
+{
+  static PolyhedronFileCache cache;
+  return cache;
+}
+
+} // namespace
+
 namespace sch
 {
 
@@ -37,9 +64,40 @@ STP_BV * STPBV(const std::string & filename)
 
 S_Polyhedron * Polyhedron(const std::string & filename)
 {
-  S_Polyhedron * s = new S_Polyhedron;
-  s->constructFromFile(filename);
-  return s;
+  boost::system::error_code ec;
+  auto path = bfs::canonical(filename, ec);
+  if(ec)
+  {
+    S_Polyhedron * s = new S_Polyhedron;
+    s->constructFromFile(filename);
+    return s;
+  }
+  auto mtime = bfs::last_write_time(path, ec);
+  auto size = bfs::file_size(path, ec);
+  PolyhedronFileCache::key_t key{path.string(), mtime, size};
+  auto & cache = polyhedron_file_cache();
+  std::shared_ptr<const S_Polyhedron> poly;
+  {
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    auto it = cache.polyhedrons.find(key);
+    if(it != cache.polyhedrons.end()) { poly = it->second; }
+  }
+  if(!poly)
+  {
+    auto s = std::make_shared<S_Polyhedron>();
+    s->constructFromFile(filename);
+    poly = s;
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    cache.polyhedrons[key] = poly;
+  }
+  return new S_Polyhedron(*poly);
+}
+
+void clearPolyhedronCache()
+{
+  auto & cache = polyhedron_file_cache();
+  std::unique_lock<std::mutex> lock(cache.mutex);
+  cache.polyhedrons.clear();
 }
 
 double distance(CD_Pair & pair, Eigen::Vector3d & p1, Eigen::Vector3d & p2)
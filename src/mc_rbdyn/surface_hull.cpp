@@ -10,8 +10,12 @@
 #include <mc_rtc/constants.h>
 #include <mc_rtc/logging.h>
 
-#include <fstream>
-#include <stdlib.h>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 // Does not look nice but make sure it's not confused with system headers
 #include "libqhullcpp/Qhull.h"
@@ -19,58 +23,91 @@
 #include "libqhullcpp/QhullPoints.h"
 #include "libqhullcpp/QhullVertexSet.h"
 
-#ifdef WIN32
-#  include <Windows.h>
-
-inline int mkstemp(char * out)
+namespace
 {
-  char tmp_dir[MAX_PATH + 1];
-  GetTempPath(MAX_PATH + 1, tmp_dir);
-  int ret = GetTempFileName(tmp_dir, "mkstemp", 0, out);
-  if(ret == 0) { return -1; }
-  else { return 0; }
-}
-#endif
 
-namespace mc_rbdyn
+/** Hash the exact content of the qhull input */
+struct PointsHash
 {
+  size_t operator()(const std::vector<double> & points) const noexcept
+  {
+    // FNV-1a
+    uint64_t h = 14695981039346656037ULL;
+    for(double p : points)
+    {
+      // -0.0 and 0.0 compare equal so they must hash the same
+      if(p == 0.0) { p = 0.0; }
+      uint64_t bits;
+      std::memcpy(&bits, &p, sizeof(bits));
+      h = (h ^ bits) * 1099511628211ULL;
+    }
+    return static_cast<size_t>(h);
+  }
+};
 
-sch::S_Object * surface_to_sch(const mc_rbdyn::Surface & surface, const double & depth, const unsigned int & slice)
+/** Polyhedra generated by sch_polyhedron indexed by their input points
+ *
+ * Callers receive a clone of the stored polyhedron so the cached objects are never modified
+ *
+ * The least recently used hulls are discarded once \ref capacity hulls are stored
+ */
+struct HullCache
 {
-  if(dynamic_cast<const mc_rbdyn::PlanarSurface *>(&surface) != nullptr)
+  using Use = std::list<const std::vector<double> *>;
+
+  struct Entry
   {
-    return planar_hull(static_cast<const mc_rbdyn::PlanarSurface &>(surface), depth);
-  }
-  if(dynamic_cast<const mc_rbdyn::CylindricalSurface *>(&surface) != nullptr)
+    std::shared_ptr<const sch::S_Polyhedron> poly;
+    /** Position in uses */
+    Use::iterator use;
+  };
+
+  /** Enough for the surfaces of a few robots */
+  static constexpr size_t capacity = 256;
+
+  std::mutex mutex;
+  std::unordered_map<std::vector<double>, Entry, PointsHash> hulls;
+  /** Keys of hulls, most recently used first */
+  Use uses;
+
+  /** Returns the stored hull for \p points or nullptr, mutex must be held */
+  std::shared_ptr<const sch::S_Polyhedron> get(const std::vector<double> & points)
   {
-    return cylindrical_hull(static_cast<const mc_rbdyn::CylindricalSurface &>(surface), slice);
+    auto it = hulls.find(points);
+    if(it == hulls.end()) { return nullptr; }
+    uses.splice(uses.begin(), uses, it->second.use);
+    return it->second.poly;
   }
-  if(dynamic_cast<const mc_rbdyn::GripperSurface *>(&surface) != nullptr)
+
+  /** Store a hull for \p points, mutex must be held */
+  void put(std::vector<double> && points, std::shared_ptr<const sch::S_Polyhedron> poly)
   {
-    return gripper_hull(static_cast<const mc_rbdyn::GripperSurface &>(surface), slice);
+    auto it = hulls.emplace(std::move(points), Entry{std::move(poly), {}});
+    if(!it.second) { return; }
+    uses.push_front(&it.first->first);
+    it.first->second.use = uses.begin();
+    while(hulls.size() > capacity)
+    {
+      hulls.erase(hulls.find(*uses.back()));
+      uses.pop_back();
+    }
   }
-  return nullptr;
+};
+
+HullCache & hull_cache()
+{
+  static HullCache cache;
+  return cache;
 }
 
-sch::S_Object * sch_polyhedron(const std::vector<sva::PTransformd> & points_pt)
+std::shared_ptr<const sch::S_Polyhedron> compute_polyhedron(const std::vector<double> & points_in)
 {
-  sch::S_Polyhedron * poly = new sch::S_Polyhedron();
+  auto poly = std::make_shared<sch::S_Polyhedron>();
   auto & poly_algo = *(poly->getPolyhedronAlgorithm());
 
-  // Build the input for qhull
-  std::vector<double> points_in;
-  points_in.reserve(points_pt.size() * 3);
-  for(const auto & p : points_pt)
-  {
-    const auto & t = p.translation();
-    points_in.push_back(t.x());
-    points_in.push_back(t.y());
-    points_in.push_back(t.z());
-  }
-
   // Run qhull
   orgQhull::Qhull qhull;
-  qhull.runQhull("", 3, static_cast<int>(points_pt.size()), points_in.data(), "Qt");
+  qhull.runQhull("", 3, static_cast<int>(points_in.size() / 3), points_in.data(), "Qt");
 
   auto points = qhull.points();
   poly_algo.vertexes_.reserve(points.size());
@@ -110,6 +147,64 @@ sch::S_Object * sch_polyhedron(const std::vector<sva::PTransformd> & points_pt)
   return poly;
 }
 
+} // namespace
+
+namespace mc_rbdyn
+{
+
+sch::S_Object * surface_to_sch(const mc_rbdyn::Surface & surface, const double & depth, const unsigned int & slice)
+{
+  if(dynamic_cast<const mc_rbdyn::PlanarSurface *>(&surface) != nullptr)
+  {
+    return planar_hull(static_cast<const mc_rbdyn::PlanarSurface &>(surface), depth);
+  }
+  if(dynamic_cast<const mc_rbdyn::CylindricalSurface *>(&surface) != nullptr)
+  {
+    return cylindrical_hull(static_cast<const mc_rbdyn::CylindricalSurface &>(surface), slice);
+  }
+  if(dynamic_cast<const mc_rbdyn::GripperSurface *>(&surface) != nullptr)
+  {
+    return gripper_hull(static_cast<const mc_rbdyn::GripperSurface &>(surface), slice);
+  }
+  return nullptr;
+}
+
+sch::S_Object * sch_polyhedron(const std::vector<sva::PTransformd> & points_pt)
+{
+  // Build the input for qhull
+  std::vector<double> points_in;
+  points_in.reserve(points_pt.size() * 3);
+  for(const auto & p : points_pt)
+  {
+    const auto & t = p.translation();
+    points_in.push_back(t.x());
+    points_in.push_back(t.y());
+    points_in.push_back(t.z());
+  }
+
+  auto & cache = hull_cache();
+  std::shared_ptr<const sch::S_Polyhedron> poly;
+  {
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    poly = cache.get(points_in);
+  }
+  if(!poly)
+  {
+    poly = compute_polyhedron(points_in);
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    cache.put(std::move(points_in), poly);
+  }
+  return new sch::S_Polyhedron(*poly);
+}
+
+void clear_sch_hull_cache()
+{
+  auto & cache = hull_cache();
+  std::unique_lock<std::mutex> lock(cache.mutex);
+  cache.hulls.clear();
+  cache.uses.clear();
+}
+
 sch::S_Object * planar_hull(const mc_rbdyn::PlanarSurface & surface, const double & depth)
 {
   std::vector<sva::PTransformd> points = surface.points();
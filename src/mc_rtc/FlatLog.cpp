@@ -11,6 +11,8 @@ namespace bfs = boost::filesystem;
 
 #include "internals/LogEntry.h"
 #include <fstream>
+#include <functional>
+#include <iterator>
 
 namespace mc_rtc
 {
@@ -20,39 +22,39 @@ namespace log
 
 FlatLog::record::record() : type(), data(nullptr, internal::void_deleter<int>) {}
 
-FlatLog::FlatLog(const std::string & fpath)
+FlatLog::FlatLog(const std::string & fpath, size_t jobs)
 {
-  load(fpath);
+  load(fpath, jobs);
 }
 
-void FlatLog::load(const std::string & fpath)
+void FlatLog::load(const std::string & fpath, size_t jobs)
 {
   data_.clear();
-  append(fpath);
+  append(fpath, jobs);
 }
 
-void FlatLog::append(const std::string & f)
+void FlatLog::append(const std::string & f, size_t jobs)
 {
   auto fpath = bfs::path(f);
   if(fpath.extension() == ".flat") { appendFlat(f); }
-  else { appendBin(f); }
+  else { appendBin(f, jobs); }
 }
 
-void FlatLog::appendBin(const std::string & f)
+struct FlatLog::BinAppender
 {
-  std::vector<size_t> currentIndexes = {};
-  std::vector<size_t> missingIndexes = {};
-  size_t size = data_.size() ? data_[0].records.size() : 0;
-  mc_rtc::log::iterate_binary_log_callback callback = [&](IterateBinaryLogData data)
+  BinAppender(FlatLog & log) : log(log), size(log.size()) {}
+
+  bool operator()(IterateBinaryLogData data)
   {
-    if(!meta_ && data.meta) { meta_ = data.meta; }
+    auto & data_ = log.data_;
+    if(!log.meta_ && data.meta) { log.meta_ = data.meta; }
     const auto & ks = data.keys;
     auto & records = data.records;
     if(ks.size())
     {
       for(const auto & k : missingIndexes) { data_[k].records.resize(size); }
       currentIndexes.clear();
-      for(const auto & k : ks) { currentIndexes.push_back(index(k, size)); }
+      for(const auto & k : ks) { currentIndexes.push_back(log.index(k, size)); }
       missingIndexes.clear();
       for(size_t i = 0; i < data_.size(); ++i)
       {
@@ -67,12 +69,65 @@ void FlatLog::appendBin(const std::string & f)
       auto & out = data_[currentIndexes[i]].records;
       out.push_back(std::move(records[i]));
     }
-    gui_events_.push_back(std::move(data.gui_events));
+    log.gui_events_.push_back(std::move(data.gui_events));
     size += 1;
     return true;
-  };
-  iterate_binary_log(f, callback, true, "");
-  for(const auto & k : missingIndexes) { data_[k].records.resize(size); }
+  }
+
+  /** Pad the entries that are not in the last key set */
+  void finish()
+  {
+    for(const auto & k : missingIndexes) { log.data_[k].records.resize(size); }
+  }
+
+  FlatLog & log;
+  std::vector<size_t> currentIndexes = {};
+  std::vector<size_t> missingIndexes = {};
+  size_t size;
+};
+
+void FlatLog::appendBin(const std::string & f, size_t jobs)
+{
+  if(jobs <= 1)
+  {
+    BinAppender appender(*this);
+    iterate_binary_log(f, iterate_binary_log_callback(std::ref(appender)), true, "");
+    appender.finish();
+    return;
+  }
+  // Each range of the log is decoded in its own log then the logs are merged in order
+  std::vector<FlatLog> parts;
+  std::vector<BinAppender> appenders;
+  iterate_binary_log_ranges(
+      f, jobs,
+      [&](size_t n)
+      {
+        parts.resize(n);
+        appenders.reserve(n);
+        for(auto & p : parts) { appenders.emplace_back(p); }
+      },
+      [&](size_t r, IterateBinaryLogData data) { return appenders[r](std::move(data)); }, true, "");
+  for(size_t i = 0; i < parts.size(); ++i)
+  {
+    appenders[i].finish();
+    merge(std::move(parts[i]));
+  }
+}
+
+void FlatLog::merge(FlatLog && other)
+{
+  size_t s = size();
+  size_t n = other.size();
+  for(auto & e : other.data_)
+  {
+    auto & records = data_[index(e.name, s)].records;
+    std::move(e.records.begin(), e.records.end(), std::back_inserter(records));
+  }
+  for(auto & e : data_) { e.records.resize(s + n); }
+  std::move(other.gui_events_.begin(), other.gui_events_.end(), std::back_inserter(gui_events_));
+  if(!meta_) { meta_ = std::move(other.meta_); }
+  other.data_.clear();
+  other.gui_events_.clear();
 }
 
 void FlatLog::appendFlat(const std::string & f)
@@ -0,0 +1,299 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rtc/log/LogFollower.h>
+
+#include <boost/filesystem.hpp>
+namespace bfs = boost::filesystem;
+
+#include "internals/LogEntry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace mc_rtc::log
+{
+
+struct LogFollowerImpl
+{
+  LogFollowerImpl(const std::string & path, bool extract, const std::string & time)
+  : path_(path), manifest_(bfs::path(path).extension() == ".manifest"), extract_(extract), time_(time), buffer_(1024)
+  {
+  }
+
+  size_t poll()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if(file_.empty())
+    {
+      auto first = next_file();
+      if(first.empty()) { return 0; }
+      open(first);
+    }
+    size_t n = 0;
+    while(true)
+    {
+      n += read();
+      auto next = next_file();
+      if(next.empty()) { break; }
+      // The previous file is complete once the next one is announced, read what was written in the meantime
+      n += read();
+      open(next);
+    }
+    records_ += n;
+    return n;
+  }
+
+  /** Returns the file that follows the current one, empty if there is none (yet) */
+  std::string next_file()
+  {
+    boost::system::error_code ec;
+    if(manifest_)
+    {
+      // The manifest is only parsed again when the Logger rewrites it, i.e. when a new segment starts
+      auto size = bfs::file_size(path_, ec);
+      if(ec) { return ""; }
+      auto mtime = bfs::last_write_time(path_, ec);
+      if(ec) { return ""; }
+      if(size != manifest_size_ || mtime != manifest_mtime_)
+      {
+        try
+        {
+          segments_ = Logger::readManifest(path_);
+          manifest_size_ = size;
+          manifest_mtime_ = mtime;
+        }
+        catch(const mc_rtc::Configuration::Exception & exc)
+        {
+          exc.silence();
+        }
+      }
+      if(segment_ < segments_.size()) { return segments_[segment_++].file; }
+      return "";
+    }
+    auto target = bfs::canonical(path_, ec);
+    if(ec || target.string() == file_) { return ""; }
+    return target.string();
+  }
+
+  /** Start reading a new file */
+  void open(const std::string & file)
+  {
+    if(ifs_.is_open()) { ifs_.close(); }
+    file_ = file;
+    ifs_.open(file_, std::ifstream::binary);
+    offset_ = 0;
+    version_ = -1;
+    keys_.clear();
+    meta_.reset();
+    valid_ = true;
+  }
+
+  /** Decode the complete records available in the current file */
+  size_t read()
+  {
+    if(!valid_ || !ifs_.is_open()) { return 0; }
+    boost::system::error_code ec;
+    uint64_t size = bfs::file_size(file_, ec);
+    if(ec) { return 0; }
+    ifs_.clear();
+    if(version_ < 0)
+    {
+      if(size < sizeof(Logger::magic)) { return 0; }
+      ifs_.seekg(0);
+      ifs_.read(buffer_.data(), sizeof(Logger::magic));
+      if(!ifs_) { return 0; }
+      if(memcmp(buffer_.data(), &Logger::magic, sizeof(Logger::magic) - 1) != 0)
+      {
+        log::error("Log {} is not a valid mc_rtc binary log (Invalid magic number)", file_);
+        valid_ = false;
+        return 0;
+      }
+      version_ = static_cast<int8_t>(buffer_.data()[sizeof(Logger::magic) - 1] - Logger::magic[3]);
+      if(version_ < 0 || version_ > Logger::version)
+      {
+        log::error("Log {} cannot be read by this version of mc_rtc", file_);
+        valid_ = false;
+        return 0;
+      }
+      offset_ = sizeof(Logger::magic);
+    }
+    size_t n = 0;
+    while(offset_ + sizeof(uint64_t) <= size)
+    {
+      uint64_t entrySize = 0;
+      ifs_.seekg(static_cast<std::streamoff>(offset_));
+      ifs_.read((char *)&entrySize, sizeof(uint64_t));
+      // Stop at a partially written record, it will be read in the next poll
+      if(!ifs_ || offset_ + sizeof(uint64_t) + entrySize > size) { break; }
+      while(buffer_.size() < entrySize) { buffer_.resize(2 * buffer_.size()); }
+      ifs_.read(buffer_.data(), static_cast<std::streamsize>(entrySize));
+      if(!ifs_) { break; }
+      offset_ += sizeof(uint64_t) + entrySize;
+      n++;
+      if(!notify(entrySize)) { break; }
+    }
+    return n;
+  }
+
+  /** Decode the record in buffer_ and forward it to the subscribers, returns false if the record is invalid */
+  bool notify(size_t entrySize)
+  {
+    bool keys_changed = false;
+    std::vector<Logger::GUIEvent> events;
+    internal::LogEntry entry(version_, buffer_, entrySize, meta_, keys_, events, keys_changed, extract_);
+    if(!entry.valid())
+    {
+      log::error("Invalid record in {}, stop reading this log", file_);
+      valid_ = false;
+      return false;
+    }
+    std::optional<double> t;
+    if(time_.size())
+    {
+      auto t_it = std::find_if(keys_.begin(), keys_.end(), [this](const auto & k) { return k.key == time_; });
+      if(t_it != keys_.end() && t_it->type == LogType::Double)
+      {
+        t = entry.getTime(static_cast<size_t>(std::distance(keys_.begin(), t_it)));
+      }
+    }
+    std::vector<std::string> keys_str;
+    if(keys_changed)
+    {
+      keys_str.reserve(keys_.size());
+      for(const auto & k : keys_) { keys_str.push_back(k.key); }
+    }
+    copy_callback copy_cb = [&entry](mc_rtc::MessagePackBuilder & builder, const std::vector<std::string> & keys)
+    { entry.copy(builder, keys); };
+    for(auto it = subscribers_.begin(); it != subscribers_.end();)
+    {
+      if(!it->second(IterateBinaryLogData{keys_str, entry.records(), events, t, copy_cb, buffer_.data(), entrySize,
+                                          meta_}))
+      {
+        it = subscribers_.erase(it);
+      }
+      else { ++it; }
+    }
+    return true;
+  }
+
+  std::string path_;
+  bool manifest_;
+  bool extract_;
+  std::string time_;
+
+  /** Held while polling */
+  std::mutex mutex_;
+  std::vector<std::pair<size_t, iterate_binary_log_callback>> subscribers_;
+  size_t next_id_ = 0;
+
+  std::string file_;
+  std::ifstream ifs_;
+  /** Number of segments of the manifest that have been opened */
+  size_t segment_ = 0;
+  /** Segments listed in the manifest when it was last read */
+  std::vector<Logger::Segment> segments_;
+  /** Size and modification time of the manifest when it was last read */
+  uintmax_t manifest_size_ = 0;
+  std::time_t manifest_mtime_ = 0;
+  /** Offset of the first record that has not been read */
+  uint64_t offset_ = 0;
+  /** Version of the log, negative until the header is read */
+  int8_t version_ = -1;
+  std::vector<char> buffer_;
+  std::vector<internal::TypedKey> keys_;
+  std::optional<Logger::Meta> meta_;
+  std::atomic<bool> valid_{true};
+  std::atomic<size_t> records_{0};
+
+  std::thread thread_;
+  std::mutex thread_mutex_;
+  std::condition_variable thread_cv_;
+  bool run_ = false;
+};
+
+LogFollower::LogFollower(const std::string & path, bool extract, const std::string & time)
+: impl_(new LogFollowerImpl(path, extract, time))
+{
+}
+
+LogFollower::~LogFollower()
+{
+  stop();
+}
+
+size_t LogFollower::subscribe(const iterate_binary_log_callback & callback)
+{
+  std::unique_lock<std::mutex> lock(impl_->mutex_);
+  impl_->subscribers_.push_back({impl_->next_id_, callback});
+  return impl_->next_id_++;
+}
+
+void LogFollower::unsubscribe(size_t id)
+{
+  std::unique_lock<std::mutex> lock(impl_->mutex_);
+  auto & subscribers = impl_->subscribers_;
+  subscribers.erase(
+      std::remove_if(subscribers.begin(), subscribers.end(), [id](const auto & s) { return s.first == id; }),
+      subscribers.end());
+}
+
+size_t LogFollower::poll()
+{
+  return impl_->poll();
+}
+
+void LogFollower::start(std::chrono::microseconds period)
+{
+  std::unique_lock<std::mutex> lock(impl_->thread_mutex_);
+  if(impl_->run_) { return; }
+  impl_->run_ = true;
+  impl_->thread_ = std::thread(
+      [this, period]()
+      {
+        std::unique_lock<std::mutex> thread_lock(impl_->thread_mutex_);
+        while(impl_->run_)
+        {
+          thread_lock.unlock();
+          size_t n = impl_->poll();
+          thread_lock.lock();
+          // Poll again right away if the log is being written faster than we read it
+          if(n == 0) { impl_->thread_cv_.wait_for(thread_lock, period, [this]() { return !impl_->run_; }); }
+        }
+      });
+}
+
+void LogFollower::stop()
+{
+  {
+    std::unique_lock<std::mutex> lock(impl_->thread_mutex_);
+    impl_->run_ = false;
+  }
+  impl_->thread_cv_.notify_all();
+  if(impl_->thread_.joinable()) { impl_->thread_.join(); }
+}
+
+size_t LogFollower::records() const noexcept
+{
+  return impl_->records_;
+}
+
+std::string LogFollower::file() const
+{
+  std::unique_lock<std::mutex> lock(impl_->mutex_);
+  return impl_->file_;
+}
+
+bool LogFollower::valid() const noexcept
+{
+  return impl_->valid_;
+}
+
+} // namespace mc_rtc::log
@@ -8,9 +8,11 @@
 #include <boost/filesystem.hpp>
 namespace bfs = boost::filesystem;
 
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <thread>
 
 namespace mc_rtc
@@ -29,8 +31,10 @@ struct LoggerImpl
 
   virtual ~LoggerImpl() {}
 
-  virtual void initialize(const bfs::path & path) = 0;
-  virtual void write(char * data, size_t size) = 0;
+  /** Open a new log, if segmented is true the log is split into segments and the first one starts at t */
+  virtual void initialize(const bfs::path & path, bool segmented, double t) = 0;
+  /** Write a record, if new_segment is true the record is written in a new segment that starts at t */
+  virtual void write(char * data, size_t size, bool new_segment, double t) = 0;
   virtual void flush() {}
 
   std::vector<char> data_;
@@ -38,11 +42,16 @@ struct LoggerImpl
   bfs::path directory;
   std::string tmpl;
   double log_iter_ = 0;
-  bool valid_ = true;
+  /** Written by the writer thread when a segment cannot be opened */
+  std::atomic<bool> valid_{true};
   std::string path_ = "";
+  std::string manifest_ = "";
   std::ofstream log_;
 
 protected:
+  /** Segments of the current log (file name relative to the manifest and start time) */
+  std::vector<std::pair<std::string, double>> segments_;
+
   inline void fwrite(char * data, uint64_t size)
   {
     log_.write((char *)&size, sizeof(uint64_t));
@@ -52,29 +61,92 @@ protected:
   // Open file and write magic number to it right away
   void open(const std::string & path)
   {
-    path_ = path;
     log_.open(path, std::ofstream::binary);
     static_assert(sizeof(uint8_t) == sizeof(char));
     log_.write((const char *)&Logger::magic, sizeof(Logger::magic) - sizeof(uint8_t));
     const char version = static_cast<uint8_t>(Logger::magic[3] + Logger::version);
     log_.write(&version, sizeof(uint8_t));
   }
+
+  // Close the current log (if any) and open the first segment of a new log
+  void open_log(const bfs::path & path, bool segmented, double t)
+  {
+    if(log_.is_open()) { log_.close(); }
+    path_ = path.string();
+    open(path_);
+    segments_.clear();
+    if(segmented)
+    {
+      manifest_ = bfs::path(path).replace_extension(".manifest").string();
+      segments_.push_back({path.filename().string(), t});
+      write_manifest();
+    }
+    else { manifest_.clear(); }
+  }
+
+  // Close the current segment and open the next one
+  void next_segment(double t)
+  {
+    bfs::path first(path_);
+    auto segment = fmt::format("{}.{}{}", first.stem().string(), segments_.size() + 1, first.extension().string());
+    log_.close();
+    open((first.parent_path() / segment).string());
+    if(!log_.is_open())
+    {
+      valid_ = false;
+      log::error("Failed to open log segment {}, logging stops", segment);
+      return;
+    }
+    segments_.push_back({segment, t});
+    write_manifest();
+  }
+
+  // Write the manifest to a temporary file then move it in place so readers never see a partial manifest, the format
+  // is read by Logger::readManifest
+  void write_manifest()
+  {
+    mc_rtc::Configuration manifest;
+    auto segments = manifest.array("segments", segments_.size());
+    for(const auto & s : segments_)
+    {
+      auto segment = segments.object();
+      segment.add("file", s.first);
+      segment.add("start", s.second);
+    }
+    auto tmp = manifest_ + ".tmp";
+    manifest.save(tmp);
+    boost::system::error_code ec;
+    bfs::rename(tmp, manifest_, ec);
+    if(ec) { log::error("Failed to write log manifest {}: {}", manifest_, ec.message()); }
+  }
 };
 
+std::vector<Logger::Segment> Logger::readManifest(const std::string & manifest)
+{
+  auto dir = bfs::path(manifest).parent_path();
+  mc_rtc::Configuration segments = mc_rtc::Configuration(manifest)("segments");
+  std::vector<Segment> out;
+  out.reserve(segments.size());
+  for(size_t i = 0; i < segments.size(); ++i)
+  {
+    bfs::path file = segments[i]("file").operator std::string();
+    if(file.is_relative()) { file = dir / file; }
+    out.push_back({file.string(), static_cast<double>(segments[i]("start"))});
+  }
+  return out;
+}
+
 namespace
 {
 struct LoggerNonThreadedPolicyImpl : public LoggerImpl
 {
   LoggerNonThreadedPolicyImpl(const std::string & directory, const std::string & tmpl) : LoggerImpl(directory, tmpl) {}
 
-  void initialize(const bfs::path & path) final
-  {
-    if(log_.is_open()) { log_.close(); }
-    open(path.string());
-  }
+  void initialize(const bfs::path & path, bool segmented, double t) final { open_log(path, segmented, t); }
 
-  void write(char * data, size_t size) final
+  void write(char * data, size_t size, bool new_segment, double t) final
   {
+    if(valid_ && new_segment) { next_segment(t); }
     if(valid_) { fwrite(data, size); }
   }
 
@@ -86,6 +158,15 @@ struct LoggerNonThreadedPolicyImpl : public LoggerImpl
 
 struct LoggerThreadedPolicyImpl : public LoggerImpl
 {
+  /** A record waiting to be written */
+  struct Record
+  {
+    char * data;
+    size_t size;
+    bool new_segment;
+    double t;
+  };
+
   LoggerThreadedPolicyImpl(const std::string & directory, const std::string & tmpl) : LoggerImpl(directory, tmpl)
   {
     log_sync_th_ = std::thread(
@@ -109,33 +190,33 @@ struct LoggerThreadedPolicyImpl : public LoggerImpl
   // Returns true when all data has been consumed
   bool write_data()
   {
+    std::unique_lock<std::mutex> lock(file_mutex_);
     if(data_.pop(pop_))
     {
-      char * data = pop_.first;
-      size_t size = pop_.second;
-      fwrite(data, size);
-      delete[] data;
+      if(pop_.new_segment) { next_segment(pop_.t); }
+      fwrite(pop_.data, pop_.size);
+      delete[] pop_.data;
       return false;
     }
     return true;
   }
 
-  void initialize(const bfs::path & path) final
+  void initialize(const bfs::path & path, bool segmented, double t) final
   {
     if(log_.is_open())
     {
       /* Wait until the previous log is flushed */
       while(!data_.empty()) { std::this_thread::sleep_for(std::chrono::microseconds(500)); }
-      log_.close();
     }
-    open(path.string());
+    std::unique_lock<std::mutex> lock(file_mutex_);
+    open_log(path, segmented, t);
   }
 
-  void write(char * data, size_t size) final
+  void write(char * data, size_t size, bool new_segment, double t) final
   {
     char * ndata = new char[size];
     std::memcpy(ndata, data, size);
-    if(!data_.push({ndata, size}))
+    if(!data_.push({ndata, size, new_segment, t}))
     {
       mc_rtc::log::critical("Data cannot be added to the log");
       delete[] ndata;
@@ -144,8 +225,10 @@ struct LoggerThreadedPolicyImpl : public LoggerImpl
 
   std::thread log_sync_th_;
   bool log_sync_th_run_ = true;
-  CircularBuffer<std::pair<char *, size_t>, 2048> data_;
-  std::pair<char *, size_t> pop_;
+  CircularBuffer<Record, 2048> data_;
+  Record pop_;
+  /** Held by the writer thread while it works on the file, (re-)opening the log waits for the current record */
+  std::mutex file_mutex_;
 };
 } // namespace
 
@@ -197,18 +280,25 @@ void Logger::start(const std::string & ctl_name, double timestep, bool resume, d
     return log_path;
   };
   auto log_path = get_log_path();
-  impl_->initialize(log_path);
-  std::stringstream ss_sym;
-  ss_sym << impl_->tmpl << "-" << ctl_name << "-latest.bin";
-  bfs::path log_sym_path = impl_->directory / bfs::path(ss_sym.str().c_str());
-  if(bfs::is_symlink(log_sym_path)) { bfs::remove(log_sym_path); }
-  if(!bfs::exists(log_sym_path))
+  segment_size_ = 0;
+  segment_start_ = resume ? impl_->log_iter_ : start_t;
+  impl_->initialize(log_path, segmentation_.enabled(), segment_start_);
+  auto update_symlink = [this, &ctl_name](const bfs::path & target, const std::string & extension)
   {
-    boost::system::error_code ec;
-    bfs::create_symlink(log_path, log_sym_path, ec);
-    if(!ec) { log::info("Updated latest log symlink: {}", log_sym_path.string()); }
-    else { log::info("Failed to create latest log symlink: {}", ec.message()); }
-  }
+    std::stringstream ss_sym;
+    ss_sym << impl_->tmpl << "-" << ctl_name << "-latest" << extension;
+    bfs::path log_sym_path = impl_->directory / bfs::path(ss_sym.str().c_str());
+    if(bfs::is_symlink(log_sym_path)) { bfs::remove(log_sym_path); }
+    if(!bfs::exists(log_sym_path))
+    {
+      boost::system::error_code ec;
+      bfs::create_symlink(target, log_sym_path, ec);
+      if(!ec) { log::info("Updated latest log symlink: {}", log_sym_path.string()); }
+      else { log::info("Failed to create latest log symlink: {}", ec.message()); }
+    }
+  };
+  update_symlink(log_path, ".bin");
+  if(impl_->manifest_.size()) { update_symlink(impl_->manifest_, ".manifest"); }
   if(impl_->log_.is_open())
   {
     if(resume)
@@ -239,7 +329,9 @@ void Logger::start(const std::string & ctl_name, double timestep, bool resume, d
 
 void Logger::open(const std::string & file, double timestep, double start_t)
 {
-  impl_->initialize(file);
+  segment_size_ = 0;
+  segment_start_ = start_t;
+  impl_->initialize(file, segmentation_.enabled(), start_t);
   if(impl_->log_.is_open())
   {
     if(find_entry("t") == log_entries_.end())
@@ -264,6 +356,29 @@ void Logger::open(const std::string & file, double timestep, double start_t)
 
 void Logger::log()
 {
+  bool new_segment = false;
+  if(impl_->manifest_.size() && segment_size_ > 0)
+  {
+    new_segment =
+        (segmentation_.max_size > 0 && segment_size_ >= segmentation_.max_size)
+        || (segmentation_.max_duration > 0 && impl_->log_iter_ - segment_start_ >= segmentation_.max_duration);
+  }
+  if(new_segment)
+  {
+    // The new segment starts with the current set of keys, the pending GUI events and the meta data, earlier GUI events
+    // stay in the previous segments (see Segmentation)
+    std::vector<LogEvent> events;
+    events.reserve(log_entries_.size() + log_events_.size() + 1);
+    for(const auto & e : log_entries_) { events.push_back(KeyAddedEvent{e.type, e.key}); }
+    for(auto & e : log_events_)
+    {
+      if(std::holds_alternative<GUIEvent>(e)) { events.push_back(std::move(e)); }
+    }
+    events.push_back(StartEvent{});
+    log_events_ = std::move(events);
+    segment_size_ = 0;
+    segment_start_ = impl_->log_iter_;
+  }
   mc_rtc::MessagePackBuilder builder(impl_->data_);
   builder.start_array(2);
   if(log_events_.size())
@@ -321,7 +436,8 @@ void Logger::log()
   builder.finish_array();
   builder.finish_array();
   size_t s = builder.finish();
-  impl_->write(impl_->data_.data(), s);
+  segment_size_ += s + sizeof(uint64_t);
+  impl_->write(impl_->data_.data(), s, new_segment, segment_start_);
 }
 
 void Logger::removeLogEntry(const std::string & name)
@@ -370,6 +486,11 @@ const std::string & Logger::path() const
   return impl_->path_;
 }
 
+const std::string & Logger::manifest() const
+{
+  return impl_->manifest_;
+}
+
 void Logger::flush()
 {
   impl_->flush();
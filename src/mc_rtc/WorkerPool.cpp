@@ -0,0 +1,117 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rtc/WorkerPool.h>
+
+#include <mc_rtc/logging.h>
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace mc_rtc
+{
+
+WorkerPool::WorkerPool(size_t threads, const std::vector<int> & cpus)
+{
+  threads_.reserve(threads);
+  for(size_t i = 0; i < threads; ++i)
+  {
+    threads_.emplace_back([this]() { loop(); });
+    if(cpus.empty()) { continue; }
+    int cpu = cpus[i % cpus.size()];
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if(pthread_setaffinity_np(threads_.back().native_handle(), sizeof(cpu_set_t), &set) != 0)
+    {
+      mc_rtc::log::warning("[WorkerPool] Failed to pin worker {} to CPU {}", i, cpu);
+    }
+#else
+    mc_rtc::log::warning("[WorkerPool] Pinning worker {} to CPU {} is not supported on this platform", i, cpu);
+#endif
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  startCv_.notify_all();
+  for(auto & th : threads_) { th.join(); }
+}
+
+void WorkerPool::run(size_t n, const std::function<void(size_t)> & job)
+{
+  if(n == 0) { return; }
+  // Wake-up the workers only if the calling thread cannot do all the work
+  bool wakeup = n > 1 && threads_.size() > 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    jobs_ = n;
+    next_ = 0;
+    error_ = nullptr;
+    busy_ = wakeup ? threads_.size() : 0;
+    if(wakeup) { generation_++; }
+  }
+  if(wakeup) { startCv_.notify_all(); }
+  work();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock, [this]() { return busy_ == 0; });
+    job_ = nullptr;
+  }
+  if(error_)
+  {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void WorkerPool::work()
+{
+  for(size_t i = next_.fetch_add(1); i < jobs_; i = next_.fetch_add(1))
+  {
+    try
+    {
+      (*job_)(i);
+    }
+    catch(...)
+    {
+      std::lock_guard<std::mutex> lock(errorMutex_);
+      if(!error_ || i < errorIndex_)
+      {
+        error_ = std::current_exception();
+        errorIndex_ = i;
+      }
+    }
+  }
+}
+
+void WorkerPool::loop()
+{
+  size_t generation = 0;
+  while(true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      startCv_.wait(lock, [&]() { return stop_ || generation_ != generation; });
+      if(stop_) { return; }
+      generation = generation_;
+    }
+    work();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(--busy_ == 0) { doneCv_.notify_one(); }
+    }
+  }
+}
+
+} // namespace mc_rtc
@@ -6,6 +6,8 @@
 
 #include <mc_rtc/gui/plot/types.h>
 
+#include <set>
+
 namespace mc_rtc
 {
 
@@ -49,7 +51,11 @@ StateBuilder::StateBuilder()
 void StateBuilder::reset()
 {
   elements_.elements.clear();
+  elements_.elements_index.clear();
   elements_.sub.clear();
+  elements_.sub_index.clear();
+  ids_.clear();
+  sources_.clear();
 }
 
 std::string StateBuilder::cat2str(const std::vector<std::string> & cat)
@@ -79,83 +85,156 @@ void StateBuilder::removeCategory(const std::vector<std::string> & category)
   }
   size_t depth = category.size() - 1;
   auto cat = getCategory(category, depth);
-  while(cat)
-  {
-    auto it = cat->find(category[depth]);
-    if(it == cat->sub.end()) { return; }
-    cat->sub.erase(it);
-    if(cat->elements.size() == 0 && cat->sub.size() == 0 && depth > 0)
-    {
-      depth -= 1;
-      cat = getCategory(category, depth);
-    }
-    else { cat = nullptr; }
-  }
+  if(!cat) { return; }
+  auto it = cat->find(category[depth]);
+  if(it == cat->sub.end()) { return; }
+  unindex(*it);
+  cat->sub_index.erase(it->name);
+  cat->sub.erase(it);
+  prune({cat}, nullptr);
 }
 
 bool StateBuilder::hasElement(const std::vector<std::string> & category, const std::string & name)
 {
-  auto cat_ = getCategory(category);
-  if(!cat_) { return false; }
-  const auto & cat = *cat_;
-  auto it = std::find_if(cat.elements.begin(), cat.elements.end(),
-                         [&name](const ElementStore & el) { return el().name() == name; });
-  return it != cat.elements.end();
+  return elementId(category, name) != 0;
+}
+
+uint64_t StateBuilder::elementId(const std::vector<std::string> & category, const std::string & name)
+{
+  auto cat = getCategory(category);
+  if(!cat) { return 0; }
+  auto it = cat->findElement(name);
+  return it != cat->elements.end() ? it->uid : 0;
 }
 
 void StateBuilder::removeElement(const std::vector<std::string> & category, const std::string & name)
 {
-  auto cat_ = getCategory(category);
-  if(!cat_) { return; }
-  auto & cat = *cat_;
-  auto it = std::find_if(cat.elements.begin(), cat.elements.end(),
-                         [&name](const ElementStore & el) { return el().name() == name; });
-  if(it != cat.elements.end()) { cat.elements.erase(it); }
-  if(cat.elements.size() == 0 && cat.sub.size() == 0) { removeCategory(category); }
+  auto cat = getCategory(category);
+  if(!cat) { return; }
+  auto it = cat->findElement(name);
+  if(it != cat->elements.end()) { eraseElement(*cat, it); }
+  prune({cat}, nullptr);
 }
 
 void StateBuilder::removeElements(const std::vector<std::string> & category, void * source, bool recurse)
 {
   if(source == nullptr) { return; }
-  auto cat_ = getCategory(category);
-  if(!cat_) { return; }
-  auto & elements = cat_->elements;
-  if(recurse) { removeElements(*cat_, source); }
-  else
+  auto cat = getCategory(category);
+  auto source_it = sources_.find(source);
+  if(!cat || source_it == sources_.end()) { return; }
+  auto inCategory = [&](const Category * c)
   {
-    elements.erase(std::remove_if(elements.begin(), elements.end(),
-                                  [source](const ElementStore & elem) { return elem.source == source; }),
-                   elements.end());
+    if(c == cat) { return true; }
+    while(recurse && c)
+    {
+      c = c->parent;
+      if(c == cat) { return true; }
+    }
+    return false;
+  };
+  std::vector<ElementRef> remove;
+  for(auto uid : source_it->second)
+  {
+    const auto & ref = ids_.at(uid);
+    if(inCategory(ref.category)) { remove.push_back(ref); }
+  }
+  std::vector<Category *> categories;
+  categories.reserve(remove.size() + 1);
+  for(auto & ref : remove)
+  {
+    categories.push_back(ref.category);
+    eraseElement(*ref.category, ref.element);
   }
-  if(elements.size() == 0 && cat_->sub.size() == 0) { removeCategory(category); }
+  prune(std::move(categories), cat);
+  if(category.size() && cat->empty()) { removeCategory(category); }
 }
 
 void StateBuilder::removeElements(void * source)
 {
   if(source == nullptr) { return; }
-  removeElements(elements_, source);
+  auto source_it = sources_.find(source);
+  if(source_it == sources_.end()) { return; }
+  std::vector<ElementRef> remove;
+  remove.reserve(source_it->second.size());
+  for(auto uid : source_it->second) { remove.push_back(ids_.at(uid)); }
+  std::vector<Category *> categories;
+  categories.reserve(remove.size());
+  for(auto & ref : remove)
+  {
+    categories.push_back(ref.category);
+    eraseElement(*ref.category, ref.element);
+  }
+  prune(std::move(categories), nullptr);
+}
+
+void StateBuilder::indexElement(Category & category)
+{
+  auto it = std::prev(category.elements.end());
+  it->uid = next_uid_++;
+  category.elements_index[(*it)().name()] = it;
+  ids_[it->uid] = {&category, it};
+  if(it->source) { sources_[it->source].insert(it->uid); }
 }
 
-void StateBuilder::removeElements(Category & category, void * source)
+void StateBuilder::eraseElement(Category & category, std::list<ElementStore>::iterator it)
 {
-  auto & sub = category.sub;
-  sub.erase(std::remove_if(sub.begin(), sub.end(),
-                           [this, source](Category & cat)
-                           {
-                             removeElements(cat, source);
-                             return cat.elements.size() == 0 && cat.sub.size() == 0;
-                           }),
-            sub.end());
-  auto & elements = category.elements;
-  elements.erase(std::remove_if(elements.begin(), elements.end(),
-                                [source](const ElementStore & elem) { return elem.source == source; }),
-                 elements.end());
+  ids_.erase(it->uid);
+  if(it->source)
+  {
+    auto source_it = sources_.find(it->source);
+    source_it->second.erase(it->uid);
+    if(source_it->second.empty()) { sources_.erase(source_it); }
+  }
+  category.elements_index.erase((*it)().name());
+  category.elements.erase(it);
+}
+
+void StateBuilder::unindex(Category & category)
+{
+  for(auto it = category.elements.begin(); it != category.elements.end();)
+  {
+    auto next = std::next(it);
+    eraseElement(category, it);
+    it = next;
+  }
+  for(auto & sub : category.sub) { unindex(sub); }
+}
+
+void StateBuilder::prune(std::vector<Category *> categories, const Category * stop)
+{
+  auto depth = [](const Category * c)
+  {
+    size_t d = 0;
+    for(; c->parent; c = c->parent) { d++; }
+    return d;
+  };
+  // A category is only removed once all its sub-categories have been visited so no pointer is used after its removal
+  std::set<std::pair<size_t, Category *>, std::greater<std::pair<size_t, Category *>>> pending;
+  for(auto c : categories) { pending.insert({depth(c), c}); }
+  while(pending.size())
+  {
+    auto [d, cat] = *pending.begin();
+    pending.erase(pending.begin());
+    if(cat == stop || !cat->parent || !cat->empty()) { continue; }
+    auto parent = cat->parent;
+    auto it = parent->sub_index.at(cat->name);
+    parent->sub_index.erase(cat->name);
+    parent->sub.erase(it);
+    pending.insert({d - 1, parent});
+  }
+}
+
+std::vector<std::string> StateBuilder::categoryPath(const Category & category)
+{
+  std::vector<std::string> path;
+  for(auto c = &category; c->parent; c = c->parent) { path.insert(path.begin(), c->name); }
+  return path;
 }
 
 size_t StateBuilder::update(std::vector<char> & buffer)
 {
   mc_rtc::MessagePackBuilder builder(buffer);
-  builder.start_array(4);
+  builder.start_array(5);
 
   // Write protocol version
   builder.write(PROTOCOL_VERSION);
@@ -169,7 +248,8 @@ size_t StateBuilder::update(std::vector<char> & buffer)
   builder.write_object(data_buffer_.data(), data_buffer_size_);
 
   // Write elements
-  update(builder, elements_);
+  update_ids_.clear();
+  update(builder, elements_, !subscriptions_active_, 0);
 
   // Write plots
   builder.start_array(plots_.size());
@@ -181,6 +261,11 @@ size_t StateBuilder::update(std::vector<char> & buffer)
   }
   builder.finish_array();
 
+  // Write elements' ids
+  builder.start_array(update_ids_.size());
+  for(auto uid : update_ids_) { builder.write(uid); }
+  builder.finish_array();
+
   builder.finish_array();
   return builder.finish();
 }
@@ -192,17 +277,87 @@ void StateBuilder::update()
   for(auto & p : plots_) { p.second.callback(builder, p.first, true); }
 }
 
-void StateBuilder::update(mc_rtc::MessagePackBuilder & builder, Category & category)
+void StateBuilder::update(mc_rtc::MessagePackBuilder & builder, Category & category, bool visible, double rate)
 {
-  builder.start_array(1 + category.elements.size() + 1);
+  visible = visible || category.subscribed;
+  if(category.update_rate > 0) { rate = category.update_rate; }
+  builder.start_array(1 + (visible ? category.elements.size() : 0) + 1);
   builder.write(category.name);
-  for(auto & e : category.elements) { e.write(e.element(), builder); }
+  if(visible)
+  {
+    for(auto & e : category.elements)
+    {
+      write(builder, e, e.update_rate > 0 ? e.update_rate : rate);
+      update_ids_.push_back(e.uid);
+    }
+  }
   builder.start_array(category.sub.size());
-  for(auto & s : category.sub) { update(builder, s); }
+  for(auto & s : category.sub) { update(builder, s, visible, rate); }
   builder.finish_array();
   builder.finish_array();
 }
 
+void StateBuilder::write(mc_rtc::MessagePackBuilder & builder, ElementStore & element, double rate)
+{
+  if(rate <= 0)
+  {
+    element.write(element(), builder);
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if(element.cache_size == 0 || now - element.cache_time >= std::chrono::duration<double>(1.0 / rate))
+  {
+    mc_rtc::MessagePackBuilder cache_builder(element.cache);
+    element.write(element(), cache_builder);
+    element.cache_size = cache_builder.finish();
+    element.cache_time = now;
+  }
+  builder.write_object(element.cache.data(), element.cache_size);
+}
+
+void StateBuilder::updateRate(const std::vector<std::string> & category, const std::string & name, double rate)
+{
+  auto cat = getCategory(category);
+  if(!cat) { return; }
+  auto it = cat->findElement(name);
+  if(it == cat->elements.end()) { return; }
+  it->update_rate = rate;
+  it->cache_size = 0;
+}
+
+void StateBuilder::updateRate(const std::vector<std::string> & category, double rate)
+{
+  if(rate > 0) { category_rates_[category] = rate; }
+  else { category_rates_.erase(category); }
+  auto cat = getCategory(category);
+  if(cat) { cat->update_rate = rate; }
+}
+
+void StateBuilder::subscriptions(const std::vector<std::vector<std::string>> & categories)
+{
+  subscriptions_ = {categories.begin(), categories.end()};
+  // Subscribing to the root is subscribing to everything
+  subscriptions_active_ = subscriptions_.count({}) == 0;
+  std::vector<std::string> path;
+  updateSubscriptions(elements_, path);
+}
+
+void StateBuilder::clearSubscriptions()
+{
+  subscriptions({std::vector<std::string>{}});
+}
+
+void StateBuilder::updateSubscriptions(Category & category, std::vector<std::string> & path)
+{
+  category.subscribed = subscriptions_active_ && path.size() && subscriptions_.count(path);
+  for(auto & sub : category.sub)
+  {
+    path.push_back(sub.name);
+    updateSubscriptions(sub, path);
+    path.pop_back();
+  }
+}
+
 bool StateBuilder::handleRequest(const std::vector<std::string> & category,
                                  const std::string & name,
                                  const mc_rtc::Configuration & data)
@@ -214,14 +369,30 @@ bool StateBuilder::handleRequest(const std::vector<std::string> & category,
     return false;
   }
   Category & cat = *cat_;
-  auto it = std::find_if(cat.elements.begin(), cat.elements.end(),
-                         [&name](const ElementStore & el) { return el().name() == name; });
+  auto it = cat.findElement(name);
   if(it == cat.elements.end())
   {
     mc_rtc::log::error("No element {} in category {}", name, cat2str(category));
     return false;
   }
-  ElementStore & el = *it;
+  return handleRequest(cat, *it, data);
+}
+
+bool StateBuilder::handleRequest(uint64_t id, const mc_rtc::Configuration & data)
+{
+  auto it = ids_.find(id);
+  if(it == ids_.end())
+  {
+    mc_rtc::log::error("No element with id {}", id);
+    return false;
+  }
+  return handleRequest(*it->second.category, *it->second.element, data);
+}
+
+bool StateBuilder::handleRequest(const Category & category, ElementStore & el, const mc_rtc::Configuration & data)
+{
+  // The request might change the element's data
+  el.cache_size = 0;
   Element & elem = el();
   try
   {
@@ -229,7 +400,8 @@ bool StateBuilder::handleRequest(const std::vector<std::string> & category,
   }
   catch(const mc_rtc::Configuration::Exception & exc)
   {
-    mc_rtc::log::error("Failed to handle request for {}/{}\n{}", cat2str(category), name, exc.what());
+    mc_rtc::log::error("Failed to handle request for {}/{}\n{}", cat2str(categoryPath(category)), elem.name(),
+                       exc.what());
     mc_rtc::log::warning(data.dump(true));
     return false;
   }
@@ -264,8 +436,14 @@ StateBuilder::Category & StateBuilder::getOrCreateCategory(const std::vector<std
     auto it = cat.find(c);
     if(it == cat.sub.end())
     {
-      cat.sub.push_back({c, {}, {}, 0});
-      it = std::prev(cat.sub.end());
+      it = cat.sub.emplace(cat.sub.end());
+      it->name = c;
+      it->parent = &cat;
+      auto path = categoryPath(*it);
+      it->subscribed = subscriptions_active_ && subscriptions_.count(path);
+      auto rate = category_rates_.find(path);
+      if(rate != category_rates_.end()) { it->update_rate = rate->second; }
+      cat.sub_index[c] = it;
     }
     cat_ = *it;
   }
@@ -281,13 +459,16 @@ Element & StateBuilder::ElementStore::operator()()
   return element();
 }
 
-std::vector<StateBuilder::Category>::iterator StateBuilder::Category::find(const std::string & name)
+std::list<StateBuilder::Category>::iterator StateBuilder::Category::find(const std::string & name)
 {
-  for(auto it = sub.begin(); it != sub.end(); ++it)
-  {
-    if(name == it->name) { return it; }
-  }
-  return sub.end();
+  auto it = sub_index.find(name);
+  return it != sub_index.end() ? it->second : sub.end();
+}
+
+std::list<StateBuilder::ElementStore>::iterator StateBuilder::Category::findElement(const std::string & name)
+{
+  auto it = elements_index.find(name);
+  return it != elements_index.end() ? it->second : elements.end();
 }
 
 } // namespace gui
@@ -1,3 +1,4 @@
+#include <mc_rtc/WorkerPool.h>
 #include <mc_rtc/log/Logger.h>
 #include <mc_rtc/log/iterate_binary_log.h>
 
@@ -5,100 +6,283 @@
 namespace bfs = boost::filesystem;
 
 #include "internals/LogEntry.h"
+#include <atomic>
 #include <fstream>
 
 namespace mc_rtc::log
 {
 
-bool iterate_binary_log(const std::string & f,
-                        const iterate_binary_log_callback & callback,
-                        bool extract,
-                        const std::string & time)
+namespace
+{
+
+/** Open a binary log and check its header, returns the log version or -1 on failure */
+int8_t open_log(std::ifstream & ifs, const std::string & f)
 {
-  auto fpath = bfs::path(f);
   if(!bfs::exists(f) || !bfs::is_regular(f))
   {
     log::error("Could not open log {}, file does not exist", f);
-    return false;
+    return -1;
   }
-  std::ifstream ifs(f, std::ifstream::binary);
+  ifs.open(f, std::ifstream::binary);
   if(!ifs.is_open())
   {
     log::error("Failed to open {}", f);
-    return false;
+    return -1;
   }
-  std::vector<char> buffer(1024);
-  ifs.read(buffer.data(), sizeof(mc_rtc::Logger::magic));
-  if(memcmp(buffer.data(), &mc_rtc::Logger::magic, sizeof(mc_rtc::Logger::magic) - 1) != 0)
+  char magic[sizeof(mc_rtc::Logger::magic)];
+  ifs.read(magic, sizeof(mc_rtc::Logger::magic));
+  if(!ifs || memcmp(magic, &mc_rtc::Logger::magic, sizeof(mc_rtc::Logger::magic) - 1) != 0)
   {
     log::error("Log {} is not a valid mc_rtc binary log (Invalid magic number)", f);
-    return false;
+    return -1;
   }
-  int8_t version = static_cast<int8_t>(buffer.data()[sizeof(mc_rtc::Logger::magic) - 1] - mc_rtc::Logger::magic[3]);
+  int8_t version = static_cast<int8_t>(magic[sizeof(mc_rtc::Logger::magic) - 1] - mc_rtc::Logger::magic[3]);
   if(version < 0)
   {
     log::error("Log {} is not a valid mc_rtc binary log (Invalid version number)", f);
-    return false;
+    return -1;
   }
   if(version > mc_rtc::Logger::version)
   {
-    log::error("Log {} cannot be read by this version of mc_rtc ({} > {})", version, mc_rtc::Logger::version);
-    return false;
+    log::error("Log {} cannot be read by this version of mc_rtc ({} > {})", f, version, mc_rtc::Logger::version);
+    return -1;
+  }
+  return version;
+}
+
+/** Read the record at the current position of ifs into buffer, returns false at the end of the file */
+bool read_record(std::ifstream & ifs, std::vector<char> & buffer, uint64_t & entrySize)
+{
+  entrySize = 0;
+  ifs.read((char *)&entrySize, sizeof(uint64_t));
+  if(!ifs) { return false; }
+  while(buffer.size() < entrySize) { buffer.resize(2 * buffer.size()); }
+  ifs.read(buffer.data(), static_cast<int>(entrySize));
+  return static_cast<bool>(ifs);
+}
+
+/** Decode a record and forward it to the callback
+ *
+ * If force_keys is true the keys are provided to the callback even if they did not change
+ *
+ * Returns false if the record is invalid or the callback returned false
+ */
+bool process_record(int8_t version,
+                    std::vector<char> & buffer,
+                    uint64_t entrySize,
+                    std::optional<Logger::Meta> & meta,
+                    std::vector<internal::TypedKey> & keys,
+                    bool force_keys,
+                    bool extract,
+                    const std::string & time,
+                    const iterate_binary_log_callback & callback)
+{
+  bool keys_changed = false;
+  std::vector<Logger::GUIEvent> events;
+  internal::LogEntry log(version, buffer, entrySize, meta, keys, events, keys_changed, extract);
+  if(!log.valid()) { return false; }
+  std::optional<double> t;
+  if(time.size())
+  {
+    auto t_it = std::find_if(keys.begin(), keys.end(), [&](const auto & k) { return k.key == time; });
+    if(t_it == keys.end())
+    {
+      log::error("Request time key: {} not found in log", time);
+      return false;
+    }
+    if(t_it->type != LogType::Double)
+    {
+      log::error("Time key: {} not recording double", time);
+      return false;
+    }
+    t = log.getTime(static_cast<size_t>(std::distance(keys.begin(), t_it)));
   }
-  size_t t_index = 0;
-  bool extract_t = time.size() != 0;
+  auto keys_str = [&]()
+  {
+    std::vector<std::string> keys_str;
+    if(keys_changed || force_keys)
+    {
+      keys_str.reserve(keys.size());
+      for(const auto & k : keys) { keys_str.push_back(k.key); }
+    }
+    return keys_str;
+  }();
+  return callback(IterateBinaryLogData{keys_str, log.records(), events, t,
+                                       [&log](mc_rtc::MessagePackBuilder & builder,
+                                              const std::vector<std::string> & keys) { log.copy(builder, keys); },
+                                       buffer.data(), entrySize, meta});
+}
 
+bool iterate_binary_log_file(const std::string & f,
+                             const iterate_binary_log_callback & callback,
+                             bool extract,
+                             const std::string & time)
+{
+  std::ifstream ifs;
+  int8_t version = open_log(ifs, f);
+  if(version < 0) { return false; }
+  std::vector<char> buffer(1024);
   std::vector<internal::TypedKey> keys;
   std::optional<Logger::Meta> meta;
+  uint64_t entrySize = 0;
+  while(read_record(ifs, buffer, entrySize))
+  {
+    if(!process_record(version, buffer, entrySize, meta, keys, false, extract, time, callback)) { return false; }
+  }
+  return true;
+}
 
-  while(ifs)
+/** Files that make a log: the log itself or the segments listed in a manifest, empty on failure */
+std::vector<std::string> log_files(const std::string & f)
+{
+  auto fpath = bfs::path(f);
+  if(fpath.extension() != ".manifest") { return {f}; }
+  // A segmented log, each segment is a self-contained binary log
+  if(!bfs::exists(fpath))
   {
-    uint64_t entrySize = 0;
-    ifs.read((char *)&entrySize, sizeof(uint64_t));
-    if(!ifs) { break; }
-    while(buffer.size() < entrySize) { buffer.resize(2 * buffer.size()); }
-    ifs.read(buffer.data(), static_cast<int>(entrySize));
-    if(!ifs) { break; }
-    bool keys_changed = false;
-    std::vector<Logger::GUIEvent> events;
-    internal::LogEntry log(version, buffer, entrySize, meta, keys, events, keys_changed, extract);
-    if(!log.valid()) { return false; }
-    if(extract_t)
+    log::error("Could not open log {}, file does not exist", f);
+    return {};
+  }
+  std::vector<std::string> segments;
+  try
+  {
+    for(const auto & segment : Logger::readManifest(f)) { segments.push_back(segment.file); }
+  }
+  catch(const mc_rtc::Configuration::Exception & exc)
+  {
+    log::error("Log manifest {} is not valid: {}", f, exc.msg());
+    exc.silence();
+    return {};
+  }
+  return segments;
+}
+
+/** A range of records that can be decoded independently */
+struct Range
+{
+  std::string file;
+  int8_t version;
+  /** Offset of the first record */
+  uint64_t begin;
+  /** Offset past the last record */
+  uint64_t end;
+  /** Keys before the first record */
+  std::vector<internal::TypedKey> keys;
+  /** Meta data before the first record */
+  std::optional<Logger::Meta> meta;
+};
+
+/** Split the files into ranges of at most target bytes (a range does not span several files)
+ *
+ * This only decodes the records that hold events (to track the key set), the other records are skipped
+ */
+bool split_log(const std::vector<std::string> & files, uint64_t target, std::vector<Range> & ranges)
+{
+  std::vector<char> buffer(1024);
+  for(const auto & f : files)
+  {
+    std::ifstream ifs;
+    int8_t version = open_log(ifs, f);
+    if(version < 0) { return false; }
+    uint64_t fsize = bfs::file_size(f);
+    uint64_t offset = sizeof(mc_rtc::Logger::magic);
+    std::vector<internal::TypedKey> keys;
+    std::optional<Logger::Meta> meta;
+    ranges.push_back({f, version, offset, offset, {}, {}});
+    while(offset + sizeof(uint64_t) <= fsize)
     {
-      auto t_it = std::find_if(keys.begin(), keys.end(), [&](const auto & k) { return k.key == time; });
-      if(t_it == keys.end())
+      uint64_t entrySize = 0;
+      ifs.seekg(static_cast<std::streamoff>(offset));
+      ifs.read((char *)&entrySize, sizeof(uint64_t));
+      if(!ifs || offset + sizeof(uint64_t) + entrySize > fsize) { break; }
+      if(ranges.back().end - ranges.back().begin >= target)
       {
-        log::error("Request time key: {} not found in log", time);
-        return false;
+        ranges.push_back({f, version, offset, offset, keys, meta});
       }
-      if(t_it->type != LogType::Double)
+      // Records are [events, data], events is nil unless the key set changed or something happened
+      char head[2] = {0, 0};
+      ifs.read(head, static_cast<std::streamsize>(std::min<uint64_t>(entrySize, 2)));
+      if(entrySize < 2 || static_cast<uint8_t>(head[0]) != 0x92 || static_cast<uint8_t>(head[1]) != 0xc0)
       {
-        log::error("Time key: {} not recording double", time);
-        return false;
+        ifs.seekg(static_cast<std::streamoff>(offset));
+        if(!read_record(ifs, buffer, entrySize)) { break; }
+        bool keys_changed = false;
+        std::vector<Logger::GUIEvent> events;
+        internal::LogEntry log(version, buffer, entrySize, meta, keys, events, keys_changed, false);
+        if(!log.valid()) { return false; }
       }
-      t_index = static_cast<size_t>(std::distance(keys.begin(), t_it));
-    }
-    std::optional<double> t;
-    if(extract_t) { t = log.getTime(t_index); }
-    auto keys_str = [&]()
-    {
-      std::vector<std::string> keys_str;
-      if(keys_changed)
-      {
-        keys_str.reserve(keys.size());
-        for(const auto & k : keys) { keys_str.push_back(k.key); }
-      }
-      return keys_str;
-    }();
-    if(!callback(
-           IterateBinaryLogData{keys_str, log.records(), events, t,
-                                [&log](mc_rtc::MessagePackBuilder & builder, const std::vector<std::string> & keys)
-                                { log.copy(builder, keys); }, buffer.data(), entrySize, meta}))
-    {
-      return false;
+      offset += sizeof(uint64_t) + entrySize;
+      ranges.back().end = offset;
     }
+    if(ranges.back().begin == ranges.back().end) { ranges.pop_back(); }
   }
   return true;
 }
 
+} // namespace
+
+bool iterate_binary_log(const std::string & f,
+                        const iterate_binary_log_callback & callback,
+                        bool extract,
+                        const std::string & time)
+{
+  auto files = log_files(f);
+  if(files.empty()) { return false; }
+  for(const auto & file : files)
+  {
+    if(!iterate_binary_log_file(file, callback, extract, time)) { return false; }
+  }
+  return true;
+}
+
+bool iterate_binary_log_ranges(const std::string & f,
+                               size_t jobs,
+                               const std::function<void(size_t)> & on_ranges,
+                               const iterate_binary_log_range_callback & callback,
+                               bool extract,
+                               const std::string & time)
+{
+  auto files = log_files(f);
+  if(files.empty()) { return false; }
+  jobs = std::max<size_t>(jobs, 1);
+  uint64_t total = 0;
+  for(const auto & file : files)
+  {
+    boost::system::error_code ec;
+    total += bfs::file_size(file, ec);
+  }
+  std::vector<Range> ranges;
+  if(!split_log(files, total / jobs + 1, ranges)) { return false; }
+  on_ranges(ranges.size());
+  std::atomic<bool> ok{true};
+  WorkerPool pool(ranges.size() ? std::min(jobs, ranges.size()) - 1 : 0);
+  pool.run(ranges.size(),
+           [&](size_t r)
+           {
+             auto & range = ranges[r];
+             std::ifstream ifs(range.file, std::ifstream::binary);
+             ifs.seekg(static_cast<std::streamoff>(range.begin));
+             std::vector<char> buffer(1024);
+             iterate_binary_log_callback range_callback = [&](IterateBinaryLogData data)
+             { return callback(r, std::move(data)); };
+             uint64_t offset = range.begin;
+             uint64_t entrySize = 0;
+             while(ok && offset < range.end && read_record(ifs, buffer, entrySize))
+             {
+               if(!process_record(range.version, buffer, entrySize, range.meta, range.keys, offset == range.begin,
+                                  extract, time, range_callback))
+               {
+                 ok = false;
+               }
+               offset += sizeof(uint64_t) + entrySize;
+             }
+             if(ok && offset < range.end)
+             {
+               log::error("Failed to read {}", range.file);
+               ok = false;
+             }
+           });
+  return ok;
+}
+
 } // namespace mc_rtc::log
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_solver/QPProblem.h>
+
+#include <mc_rtc/logging.h>
+
+#include <array>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace mc_solver
+{
+
+namespace
+{
+
+constexpr std::array<char, 4> magic = {'M', 'C', 'Q', 'P'};
+constexpr uint32_t version = 1;
+
+/** Sizes above these limits can only come from a corrupted file */
+constexpr int64_t max_dimension = 1 << 20;
+constexpr int64_t max_elements = 1 << 28;
+
+template<typename T>
+void write_pod(std::ostream & os, const T & value)
+{
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read_pod(std::istream & is, T & value)
+{
+  is.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return static_cast<bool>(is);
+}
+
+template<typename Derived>
+void write_data(std::ostream & os, const Eigen::PlainObjectBase<Derived> & m)
+{
+  os.write(reinterpret_cast<const char *>(m.data()), static_cast<std::streamsize>(m.size() * sizeof(double)));
+}
+
+template<typename Derived>
+bool read_data(std::istream & is, Eigen::PlainObjectBase<Derived> & m)
+{
+  is.read(reinterpret_cast<char *>(m.data()), static_cast<std::streamsize>(m.size() * sizeof(double)));
+  return static_cast<bool>(is);
+}
+
+} // namespace
+
+void QPProblem::resize(Eigen::Index nrVars, Eigen::Index nrEq, Eigen::Index nrIneq)
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  Q.setZero(nrVars, nrVars);
+  c.setZero(nrVars);
+  Aeq.setZero(nrEq, nrVars);
+  beq.setZero(nrEq);
+  Aineq.setZero(nrIneq, nrVars);
+  lineq.setConstant(nrIneq, -inf);
+  uineq.setConstant(nrIneq, inf);
+  xl.setConstant(nrVars, -inf);
+  xu.setConstant(nrVars, inf);
+}
+
+void QPProblem::write(std::ostream & os) const
+{
+  write_pod(os, tick);
+  write_pod(os, solveTime);
+  write_pod(os, static_cast<int64_t>(nrVars()));
+  write_pod(os, static_cast<int64_t>(nrEq()));
+  write_pod(os, static_cast<int64_t>(nrIneq()));
+  write_data(os, Q);
+  write_data(os, c);
+  write_data(os, Aeq);
+  write_data(os, beq);
+  write_data(os, Aineq);
+  write_data(os, lineq);
+  write_data(os, uineq);
+  write_data(os, xl);
+  write_data(os, xu);
+}
+
+bool QPProblem::read(std::istream & is)
+{
+  int64_t nVars = 0;
+  int64_t nEq = 0;
+  int64_t nIneq = 0;
+  if(!read_pod(is, tick) || !read_pod(is, solveTime) || !read_pod(is, nVars) || !read_pod(is, nEq)
+     || !read_pod(is, nIneq))
+  {
+    return false;
+  }
+  auto invalid = [&]()
+  {
+    mc_rtc::log::error("[QPProblem] Invalid problem sizes ({} variables, {} equalities, {} inequalities)", nVars, nEq,
+                       nIneq);
+    return false;
+  };
+  if(nVars < 0 || nEq < 0 || nIneq < 0 || nVars > max_dimension || nEq > max_dimension || nIneq > max_dimension)
+  {
+    return invalid();
+  }
+  // Q, c, Aeq, beq, Aineq, lineq, uineq, xl and xu
+  int64_t elements = nVars * (nVars + nEq + nIneq + 3) + nEq + 2 * nIneq;
+  if(elements > max_elements) { return invalid(); }
+  // Check that the stream holds the data before allocating it
+  auto pos = is.tellg();
+  if(pos != std::istream::pos_type(-1))
+  {
+    is.seekg(0, std::ios::end);
+    auto end = is.tellg();
+    is.seekg(pos);
+    if(end - pos < static_cast<std::streamoff>(elements * static_cast<int64_t>(sizeof(double)))) { return invalid(); }
+  }
+  resize(nVars, nEq, nIneq);
+  return read_data(is, Q) && read_data(is, c) && read_data(is, Aeq) && read_data(is, beq) && read_data(is, Aineq)
+         && read_data(is, lineq) && read_data(is, uineq) && read_data(is, xl) && read_data(is, xu);
+}
+
+struct QPProblemWriter::Impl
+{
+  Impl(const std::string & path) : ofs_(path, std::ios::binary)
+  {
+    if(!ofs_.is_open()) { mc_rtc::log::error_and_throw("[QPProblemWriter] Failed to open {} for writing", path); }
+    ofs_.write(magic.data(), magic.size());
+    write_pod(ofs_, version);
+    th_ = std::thread(
+        [this]()
+        {
+          std::vector<std::string> writing;
+          std::unique_lock<std::mutex> lock(mutex_);
+          while(true)
+          {
+            cv_.wait(lock, [this]() { return !pending_.empty() || !run_; });
+            if(pending_.empty()) { break; }
+            std::swap(writing, pending_);
+            lock.unlock();
+            for(const auto & data : writing) { ofs_.write(data.data(), static_cast<std::streamsize>(data.size())); }
+            writing.clear();
+            lock.lock();
+          }
+          ofs_.flush();
+        });
+  }
+
+  ~Impl()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      run_ = false;
+    }
+    cv_.notify_one();
+    if(th_.joinable()) { th_.join(); }
+  }
+
+  void push(std::string && data)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_.push_back(std::move(data));
+    }
+    cv_.notify_one();
+  }
+
+  std::ofstream ofs_;
+  std::thread th_;
+  /** Protects pending_ and run_ */
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  /** Serialized problems waiting to be written */
+  std::vector<std::string> pending_;
+  bool run_ = true;
+};
+
+QPProblemWriter::QPProblemWriter(const std::string & path) : path_(path), impl_(new Impl(path)) {}
+
+QPProblemWriter::~QPProblemWriter() = default;
+
+void QPProblemWriter::write(const QPProblem & problem)
+{
+  std::ostringstream oss;
+  problem.write(oss);
+  impl_->push(oss.str());
+  size_++;
+}
+
+QPProblemReader::QPProblemReader(const std::string & path) : ifs_(path, std::ios::binary)
+{
+  if(!ifs_.is_open()) { mc_rtc::log::error_and_throw("[QPProblemReader] Failed to open {} for reading", path); }
+  std::array<char, 4> fmagic;
+  uint32_t fversion = 0;
+  ifs_.read(fmagic.data(), fmagic.size());
+  if(!ifs_ || fmagic != magic || !read_pod(ifs_, fversion))
+  {
+    mc_rtc::log::error_and_throw("[QPProblemReader] {} is not a QP recording", path);
+  }
+  if(fversion != version)
+  {
+    mc_rtc::log::error_and_throw("[QPProblemReader] {} has version {}, only version {} is supported", path, fversion,
+                                 version);
+  }
+}
+
+bool QPProblemReader::next(QPProblem & problem)
+{
+  return problem.read(ifs_);
+}
+
+} // namespace mc_solver
@@ -14,8 +14,11 @@
 #include <mc_rtc/gui/Force.h>
 #include <mc_rtc/gui/Form.h>
 
+#include <mc_rtc/Configuration.h>
 #include <mc_rtc/logging.h>
 
+#include <cstdlib>
+
 namespace mc_solver
 {
 
@@ -88,9 +91,14 @@ void QPSolver::addTask(mc_tasks::MetaTask * task)
                                    task->backend(), backend_);
     }
     metaTasks_.push_back(task);
+    parallelTasks_.reserve(metaTasks_.size());
     task->addToSolver(*this);
     task->resetIterInSolver();
-    if(logger_) { task->addToLogger(*logger_); }
+    if(logger_)
+    {
+      task->addToLogger(*logger_);
+      task->addUpdateToLogger(*logger_, timeStep);
+    }
     if(gui_) { addTaskToGUI(task); }
     mc_rtc::log::info("Added task {}", task->name());
   }
@@ -109,7 +117,11 @@ void QPSolver::removeTask(mc_tasks::MetaTask * task)
     }
     task->removeFromSolver(*this);
     task->resetIterInSolver();
-    if(logger_) { task->removeFromLogger(*logger_); }
+    if(logger_)
+    {
+      task->removeFromLogger(*logger_);
+      task->removeUpdateFromLogger(*logger_);
+    }
     if(gui_) { task->removeFromGUI(*gui_); }
     mc_rtc::log::info("Removed task {}", task->name());
     metaTasks_.erase(it);
@@ -119,9 +131,176 @@ void QPSolver::removeTask(mc_tasks::MetaTask * task)
   }
 }
 
+void QPSolver::configure(const mc_rtc::Configuration & config)
+{
+  if(config.has("parallelUpdate"))
+  {
+    auto parallel = config("parallelUpdate");
+    parallelUpdate(parallel("threads", 0u), parallel("cpus", std::vector<int>{}));
+  }
+  if(config.has("record"))
+  {
+    auto record = config("record");
+    QPRecordingOptions options;
+    options.threshold = record("threshold", options.threshold);
+    options.all = record("all", options.all);
+    if(record.has("ticks"))
+    {
+      for(auto tick : record("ticks").operator std::vector<unsigned int>()) { options.ticks.insert(tick); }
+    }
+    startRecording(static_cast<std::string>(record("path")), options);
+  }
+}
+
+void QPSolver::startRecording(const std::string & path, const QPRecordingOptions & options)
+{
+  if(!recordingSupported())
+  {
+    mc_rtc::log::error_and_throw(
+        "[QPSolver::startRecording] The {} backend cannot extract its problems, only the TVM backend supports recording",
+        backend_);
+  }
+  if(recorder_ && recorder_->writer.path() == path && recorder_->options == options) { return; }
+  recorder_.reset(new Recorder{QPProblemWriter(path), options});
+  mc_rtc::log::info("[QPSolver] Recording problems to {}", path);
+}
+
+void QPSolver::stopRecording() noexcept
+{
+  if(!recorder_) { return; }
+  mc_rtc::log::info("[QPSolver] Recorded {} problems to {}", recorder_->writer.size(), recorder_->writer.path());
+  recorder_.reset();
+}
+
+void QPSolver::recordNextProblem()
+{
+  if(!recorder_)
+  {
+    mc_rtc::log::error_and_throw("[QPSolver::recordNextProblem] No active recording, call startRecording first");
+  }
+  recorder_->recordNext = true;
+}
+
+void QPSolver::parallelUpdate(size_t threads, const std::vector<int> & cpus)
+{
+  updatePool_.reset();
+  if(threads == 0) { return; }
+  updatePool_.reset(new mc_rtc::WorkerPool(threads, cpus));
+  serialUpdate_ = std::getenv("MC_RTC_SERIAL_TASK_UPDATE") != nullptr;
+  if(serialUpdate_)
+  {
+    mc_rtc::log::warning("[QPSolver] MC_RTC_SERIAL_TASK_UPDATE is set, tasks are updated serially");
+    return;
+  }
+  mc_rtc::log::info("[QPSolver] Thread-safe tasks are updated on {} worker threads", threads);
+}
+
+void QPSolver::updateParallelTasks()
+{
+  if(parallelTasks_.size() > 1)
+  {
+    for(const auto & robot : robots()) { robot.refreshForceSensorsCache(); }
+    for(const auto & robot : realRobots()) { robot.refreshForceSensorsCache(); }
+    updatePool_->run(parallelTasks_.size(),
+                     [this](size_t i)
+                     {
+                       context_backend(backend_);
+                       parallelTasks_[i]->scheduledUpdate(*this);
+                     });
+  }
+  else if(parallelTasks_.size() == 1) { parallelTasks_[0]->scheduledUpdate(*this); }
+  for(auto * t : parallelTasks_) { t->incrementIterInSolver(); }
+  parallelTasks_.clear();
+}
+
+void QPSolver::updateTasks()
+{
+  parallelTasks_.clear();
+  bool parallel = updatePool_ && !serialUpdate_;
+  // Contiguous thread-safe tasks are updated together, tasks are still updated in the order they were added
+  for(auto * t : metaTasks_)
+  {
+    if(parallel && t->threadSafeUpdate())
+    {
+      parallelTasks_.push_back(t);
+      continue;
+    }
+    updateParallelTasks();
+    t->scheduledUpdate(*this);
+    t->incrementIterInSolver();
+  }
+  updateParallelTasks();
+}
+
+bool QPSolver::assembledProblem(QPProblem &) const
+{
+  return false;
+}
+
+void QPSolver::recordProblem()
+{
+  auto & rec = *recorder_;
+  uint64_t tick = rec.tick++;
+  double time = solveAndBuildTime();
+  const auto & opts = rec.options;
+  bool selected = rec.recordNext || opts.all || (opts.threshold >= 0 && time > opts.threshold)
+                  || opts.ticks.count(tick) != 0;
+  if(!selected) { return; }
+  rec.recordNext = false;
+  QPProblem problem;
+  if(!assembledProblem(problem))
+  {
+    mc_rtc::log::warning("[QPSolver] The {} backend cannot extract its problem, recording stopped", backend_);
+    stopRecording();
+    return;
+  }
+  problem.tick = tick;
+  problem.solveTime = time;
+  rec.writer.write(problem);
+}
+
+void QPSolver::beginTransaction() noexcept
+{
+  transactionDepth_++;
+}
+
+void QPSolver::commitTransaction()
+{
+  if(transactionDepth_ == 0)
+  {
+    mc_rtc::log::error_and_throw("[QPSolver::commitTransaction] Called without a matching beginTransaction");
+  }
+  if(--transactionDepth_ == 0) { applyStructuralChanges(); }
+}
+
+void QPSolver::abortTransaction() noexcept
+{
+  if(transactionDepth_ > 0) { transactionDepth_--; }
+}
+
+QPSolver::Transaction::~Transaction() noexcept
+{
+  if(std::uncaught_exceptions() > exceptions_)
+  {
+    solver_.abortTransaction();
+    return;
+  }
+  try
+  {
+    solver_.commitTransaction();
+  }
+  catch(const std::exception & exc)
+  {
+    mc_rtc::log::error("[QPSolver::Transaction] Failed to commit the transaction: {}", exc.what());
+  }
+}
+
 bool QPSolver::run(FeedbackType fType)
 {
-  return run_impl(fType);
+  applyStructuralChanges();
+  bool success = run_impl(fType);
+  if(recorder_) { recordProblem(); }
+  return success;
 }
 
 const mc_rbdyn::Robot & QPSolver::robot() const
@@ -182,12 +361,20 @@ void QPSolver::logger(std::shared_ptr<mc_rtc::Logger> logger)
 {
   if(logger_)
   {
-    for(auto t : metaTasks_) { t->removeFromLogger(*logger_); }
+    for(auto t : metaTasks_)
+    {
+      t->removeFromLogger(*logger_);
+      t->removeUpdateFromLogger(*logger_);
+    }
   }
   logger_ = logger;
   if(logger_)
   {
-    for(auto t : metaTasks_) { t->addToLogger(*logger_); }
+    for(auto t : metaTasks_)
+    {
+      t->addToLogger(*logger_);
+      t->addUpdateToLogger(*logger_, timeStep);
+    }
   }
 }
 
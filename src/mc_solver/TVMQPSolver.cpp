@@ -12,10 +12,23 @@
 #include <mc_tvm/Robot.h>
 
 #include <mc_rtc/gui/Force.h>
+#include <mc_rtc/io_utils.h>
 
+#include <tvm/constraint/abstract/LinearConstraint.h>
+#include <tvm/solver/QuadprogLeastSquareSolver.h>
 #include <tvm/solver/defaultLeastSquareSolver.h>
+#ifdef TVM_USE_QLD
+#  include <tvm/solver/QLDLeastSquareSolver.h>
+#endif
+#ifdef TVM_USE_LSSOL
+#  include <tvm/solver/LSSOLLeastSquareSolver.h>
+#endif
 #include <tvm/task_dynamics/ProportionalDerivative.h>
 
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
 namespace mc_solver
 {
 
@@ -28,12 +41,176 @@ inline static Eigen::MatrixXd discretizedFrictionCone(double muI)
   return C;
 }
 
-TVMQPSolver::TVMQPSolver(mc_rbdyn::RobotsPtr robots, double dt)
-: QPSolver(robots, dt, Backend::TVM), solver_(tvm::solver::DefaultLSSolverOptions{})
+TVMQPSolver::TVMQPSolver(mc_rbdyn::RobotsPtr robots, double dt, const mc_rtc::Configuration & config)
+: QPSolver(robots, dt, Backend::TVM)
+{
+  configure(config);
+}
+
+TVMQPSolver::TVMQPSolver(double dt, const mc_rtc::Configuration & config) : QPSolver(dt, Backend::TVM)
 {
+  configure(config);
 }
 
-TVMQPSolver::TVMQPSolver(double dt) : QPSolver(dt, Backend::TVM), solver_(tvm::solver::DefaultLSSolverOptions{}) {}
+std::vector<std::string> TVMQPSolver::availableSolvers()
+{
+  std::vector<std::string> out = {"default", "quadprog"};
+#ifdef TVM_USE_QLD
+  out.push_back("qld");
+#endif
+#ifdef TVM_USE_LSSOL
+  out.push_back("lssol");
+#endif
+  return out;
+}
+
+void TVMQPSolver::configure(const mc_rtc::Configuration & config)
+{
+  QPSolver::configure(config);
+  // Entries that are not provided keep their current value
+  if(solver_ && !config.has("solver") && !config.has("verbose") && !config.has("scalarizationWeight")) { return; }
+  auto name = config("solver", lsSolver_.empty() ? std::string("default") : lsSolver_);
+  bool verbose = config("verbose", verbose_);
+  double scalarizationWeight = config("scalarizationWeight", scalarizationWeight_);
+  tvm::scheme::WeightedLeastSquaresOptions schemeOptions;
+  schemeOptions.scalarizationWeight(scalarizationWeight);
+  auto makeScheme = [&](auto && solverOptions)
+  {
+    solverOptions.verbose(verbose);
+    solver_ = std::make_unique<tvm::scheme::WeightedLeastSquares>(solverOptions, schemeOptions);
+  };
+  auto lname = name;
+  std::transform(lname.begin(), lname.end(), lname.begin(), [](unsigned char c) { return std::tolower(c); });
+  if(lname == "default") { makeScheme(tvm::solver::DefaultLSSolverOptions{}); }
+  else if(lname == "quadprog") { makeScheme(tvm::solver::QuadprogLSSolverOptions{}); }
+#ifdef TVM_USE_QLD
+  else if(lname == "qld") { makeScheme(tvm::solver::QLDLSSolverOptions{}); }
+#endif
+#ifdef TVM_USE_LSSOL
+  else if(lname == "lssol") { makeScheme(tvm::solver::LSSOLLSSolverOptions{}); }
+#endif
+  else
+  {
+    mc_rtc::log::error_and_throw<std::invalid_argument>(
+        "[TVMQPSolver] Least-squares solver \"{}\" is not available, available solvers: [{}]", name,
+        mc_rtc::io::to_string(availableSolvers()));
+  }
+  lsSolver_ = lname;
+  verbose_ = verbose;
+  scalarizationWeight_ = scalarizationWeight;
+}
+
+bool TVMQPSolver::assembledProblem(QPProblem & out) const
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  using Type = tvm::constraint::Type;
+  const auto constraints = problem_.constraints();
+  // Gather the problem's variables and count the hard constraints
+  tvm::VariableVector x;
+  int maxLevel = 0;
+  Eigen::Index nEq = 0;
+  Eigen::Index nIneq = 0;
+  for(const auto & c : constraints)
+  {
+    for(const auto & v : c.constraint->variables().variables())
+    {
+      if(!x.contains(*v)) { x.add(v); }
+    }
+    int level = c.requirements->priorityLevel().value();
+    maxLevel = std::max(maxLevel, level);
+    if(level != 0 || c.bound) { continue; }
+    if(c.constraint->type() == Type::EQUAL) { nEq += c.constraint->size(); }
+    else { nIneq += c.constraint->size(); }
+  }
+  out.resize(x.totalSize(), nEq, nIneq);
+  auto rhs = [](const tvm::constraint::abstract::LinearConstraint & c, const Eigen::VectorXd & v) -> Eigen::VectorXd
+  {
+    switch(c.rhs())
+    {
+      case tvm::constraint::RHS::ZERO:
+        return Eigen::VectorXd::Zero(c.size());
+      case tvm::constraint::RHS::OPPOSITE:
+        return -v;
+      default:
+        return v;
+    }
+  };
+  Eigen::MatrixXd A;
+  Eigen::VectorXd l;
+  Eigen::VectorXd u;
+  Eigen::Index eqRow = 0;
+  Eigen::Index ineqRow = 0;
+  size_t skipped = 0;
+  for(const auto & c : constraints)
+  {
+    const auto & cstr = *c.constraint;
+    auto size = cstr.size();
+    auto type = cstr.type();
+    l.setConstant(size, -inf);
+    u.setConstant(size, inf);
+    if(type == Type::EQUAL) { l = u = rhs(cstr, cstr.e()); }
+    if(type == Type::GREATER_THAN || type == Type::DOUBLE_SIDED) { l = rhs(cstr, cstr.l()); }
+    if(type == Type::LOWER_THAN || type == Type::DOUBLE_SIDED) { u = rhs(cstr, cstr.u()); }
+    int level = c.requirements->priorityLevel().value();
+    if(level == 0 && c.bound)
+    {
+      // Bounds act on a single variable through a diagonal matrix
+      const auto & v = *cstr.variables().variables()[0];
+      auto start = v.getMappingIn(x).start;
+      Eigen::VectorXd d = cstr.jacobian(v).diagonal();
+      for(Eigen::Index i = 0; i < size; ++i)
+      {
+        // A zero coefficient leaves the variable unconstrained
+        if(d(i) == 0) { continue; }
+        double lb = d(i) > 0 ? l(i) / d(i) : u(i) / d(i);
+        double ub = d(i) > 0 ? u(i) / d(i) : l(i) / d(i);
+        out.xl(start + i) = std::max(out.xl(start + i), lb);
+        out.xu(start + i) = std::min(out.xu(start + i), ub);
+      }
+      continue;
+    }
+    A.setZero(size, x.totalSize());
+    for(const auto & v : cstr.variables().variables())
+    {
+      A.middleCols(v->getMappingIn(x).start, v->size()) = cstr.jacobian(*v);
+    }
+    if(level == 0)
+    {
+      if(type == Type::EQUAL)
+      {
+        out.Aeq.middleRows(eqRow, size) = A;
+        out.beq.segment(eqRow, size) = l;
+        eqRow += size;
+      }
+      else
+      {
+        out.Aineq.middleRows(ineqRow, size) = A;
+        out.lineq.segment(ineqRow, size) = l;
+        out.uineq.segment(ineqRow, size) = u;
+        ineqRow += size;
+      }
+      continue;
+    }
+    // Objectives are scalarized the same way as the weighted least-squares scheme
+    if(type != Type::EQUAL)
+    {
+      skipped++;
+      continue;
+    }
+    Eigen::VectorXd w = Eigen::VectorXd::Constant(
+        size, c.requirements->weight().value() * std::pow(scalarizationWeight_, maxLevel - level));
+    const auto & aw = c.requirements->anisotropicWeight();
+    if(!aw.isDefault()) { w = w.cwiseProduct(aw.value()); }
+    out.Q.noalias() += A.transpose() * w.asDiagonal() * A;
+    out.c.noalias() -= A.transpose() * w.asDiagonal() * l;
+  }
+  if(skipped)
+  {
+    mc_rtc::log::warning("[TVMQPSolver] {} inequality objectives cannot be represented in the recorded problem",
+                         skipped);
+  }
+  return true;
+}
 
 size_t TVMQPSolver::getContactIdx(const mc_rbdyn::Contact & contact)
 {
@@ -113,13 +290,9 @@ bool TVMQPSolver::run_impl(FeedbackType fType)
 bool TVMQPSolver::runCommon()
 {
   for(auto & c : constraints_) { c->update(*this); }
-  for(auto & t : metaTasks_)
-  {
-    t->update(*this);
-    t->incrementIterInSolver();
-  }
+  updateTasks();
   auto start_t = mc_rtc::clock::now();
-  auto r = solver_.solve(problem_);
+  auto r = solver_->solve(problem_);
   solve_dt_ = mc_rtc::clock::now() - start_t;
   return r;
 }
@@ -166,14 +339,8 @@ bool TVMQPSolver::runJointsFeedback(bool wVelocity)
         encoders_alpha_[i][j] = (encoders[j] - prev_encoders_[i][j]) / timeStep;
         prev_encoders_[i][j] = encoders[j];
       }
-      const auto & rjo = robot.module().ref_joint_order();
-      for(size_t j = 0; j < rjo.size(); ++j)
-      {
-        auto jI = robot.jointIndexInMBC(j);
-        if(jI == -1) { continue; }
-        robot.q()[static_cast<size_t>(jI)][0] = encoders[j];
-        if(wVelocity) { robot.alpha()[static_cast<size_t>(jI)][0] = encoders_alpha_[i][j]; }
-      }
+      robot.refJointOrderMap().scatter(encoders, robot.q());
+      if(wVelocity) { robot.refJointOrderMap().scatter(encoders_alpha_[i], robot.alpha()); }
       robot.forwardKinematics();
       robot.forwardVelocity();
       robot.forwardAcceleration();
@@ -244,8 +411,8 @@ bool TVMQPSolver::runClosedLoop(bool integrateControlState)
 void TVMQPSolver::updateRobot(mc_rbdyn::Robot & robot)
 {
   auto & tvm_robot = robot.tvmRobot();
-  rbd::vectorToParam(tvm_robot.tau()->value(), robot.controlTorque());
-  rbd::vectorToParam(tvm_robot.alphaD()->value(), robot.alphaD());
+  robot.dofMap().scatter(tvm_robot.tau()->value(), robot.controlTorque());
+  robot.dofMap().scatter(tvm_robot.alphaD()->value(), robot.alphaD());
   robot.eulerIntegration(timeStep);
   robot.forwardKinematics();
   robot.forwardVelocity();
@@ -122,7 +122,7 @@ void TasksQPSolver::setContacts(ControllerToken, const std::vector<mc_rbdyn::Con
     }
   }
 
-  solver_.nrVars(robots_p->mbs(), uniContacts_, biContacts_);
+  updateNrVars();
   updateConstrSize();
 }
 
@@ -190,11 +190,7 @@ bool TasksQPSolver::run_impl(FeedbackType fType)
 bool TasksQPSolver::runOpenLoop()
 {
   for(auto & c : constraints_) { c->update(*this); }
-  for(auto & t : metaTasks_)
-  {
-    t->update(*this);
-    t->incrementIterInSolver();
-  }
+  updateTasks();
   if(solver_.solveNoMbcUpdate(robots_p->mbs(), robots_p->mbcs()))
   {
     for(size_t i = 0; i < robots_p->mbs().size(); ++i)
@@ -260,11 +256,7 @@ bool TasksQPSolver::runJointsFeedback(bool wVelocity)
     }
   }
   for(auto & c : constraints_) { c->update(*this); }
-  for(auto & t : metaTasks_)
-  {
-    t->update(*this);
-    t->incrementIterInSolver();
-  }
+  updateTasks();
   if(solver_.solveNoMbcUpdate(robots_p->mbs(), robots_p->mbcs()))
   {
     for(size_t i = 0; i < robots_p->mbs().size(); ++i)
@@ -316,11 +308,7 @@ bool TasksQPSolver::runClosedLoop(bool integrateControlState)
 
   // Update tasks and constraints from estimated robots
   for(auto & c : constraints_) { c->update(*this); }
-  for(auto & t : metaTasks_)
-  {
-    t->update(*this);
-    t->incrementIterInSolver();
-  }
+  updateTasks();
 
   // Solve QP and integrate
   if(solver_.solveNoMbcUpdate(robots_p->mbs(), robots_p->mbcs()))
@@ -349,19 +337,47 @@ bool TasksQPSolver::runClosedLoop(bool integrateControlState)
 
 void TasksQPSolver::updateConstrSize()
 {
+  if(inTransaction())
+  {
+    pendingConstrSize_ = true;
+    return;
+  }
   solver_.updateConstrSize();
 }
 
 void TasksQPSolver::updateNrVars()
 {
+  if(inTransaction())
+  {
+    pendingNrVars_ = true;
+    return;
+  }
   solver_.nrVars(robots_p->mbs(), uniContacts_, biContacts_);
 }
 
 void TasksQPSolver::updateNrVars(const mc_rbdyn::Robots & robots)
 {
+  if(inTransaction())
+  {
+    pendingUpdateNrVars_ = true;
+    return;
+  }
   solver_.updateNrVars(robots.mbs());
 }
 
+void TasksQPSolver::applyStructuralChanges()
+{
+  if(!(pendingNrVars_ || pendingUpdateNrVars_ || pendingConstrSize_)) { return; }
+  // nrVars also updates the variables of every task and constraint
+  if(pendingNrVars_) { solver_.nrVars(robots_p->mbs(), uniContacts_, biContacts_); }
+  else if(pendingUpdateNrVars_) { solver_.updateNrVars(robots_p->mbs()); }
+  // Constraints' sizes might depend on the number of variables so this comes last
+  solver_.updateConstrSize();
+  pendingNrVars_ = false;
+  pendingUpdateNrVars_ = false;
+  pendingConstrSize_ = false;
+}
+
 using boost_ms = boost::chrono::duration<double, boost::milli>;
 using boost_ns = boost::chrono::duration<double, boost::nano>;
 
@@ -80,6 +80,8 @@ AddRemoveContactTask::AddRemoveContactTask(const mc_rbdyn::Robots & robots,
   type_ = std::string(direction > 0 ? "removeContact" : "addContact");
   name_ = std::string(direction > 0 ? "remove" : "add") + "_contact_" + robot.name() + "_" + contact.r1Surface()->name()
           + "_" + env.name() + "_" + contact.r2Surface()->name();
+  fastEvalEnabled_ = true;
+  fastSpeedEnabled_ = true;
   for(int i = 0; i < 5; ++i) { dofMat(i, i) = 1; }
   normal = targetTf.rotation().row(2);
 
@@ -274,38 +276,40 @@ Eigen::VectorXd AddRemoveContactTask::dimWeight() const
 }
 
 Eigen::VectorXd AddRemoveContactTask::eval() const
+{
+  return evalFromFastPath();
+}
+
+Eigen::VectorXd AddRemoveContactTask::speed() const
+{
+  return speedFromFastPath();
+}
+
+void AddRemoveContactTask::fastEval(Eigen::VectorXd & out) const
 {
   switch(backend_)
   {
     case Backend::Tasks:
-    {
-      auto linVelTask = tasks_impl(impl_)->linVelTask.get();
-      return linVelTask->eval();
-    }
+      out = tasks_impl(impl_)->linVelTask->eval();
+      break;
     case Backend::TVM:
-    {
-      auto impl = tvm_impl(impl_);
-      return impl->eval();
-    }
+      tvm_impl(impl_)->evalInto(out);
+      break;
     default:
       mc_rtc::log::error_and_throw("Not implemented");
   }
 }
 
-Eigen::VectorXd AddRemoveContactTask::speed() const
+void AddRemoveContactTask::fastSpeed(Eigen::VectorXd & out) const
 {
   switch(backend_)
   {
     case Backend::Tasks:
-    {
-      auto linVelTask = tasks_impl(impl_)->linVelTask.get();
-      return linVelTask->speed();
-    }
+      out = tasks_impl(impl_)->linVelTask->speed();
+      break;
     case Backend::TVM:
-    {
-      auto impl = tvm_impl(impl_);
-      return impl->speed();
-    }
+      tvm_impl(impl_)->speedInto(out);
+      break;
     default:
       mc_rtc::log::error_and_throw("Not implemented");
   }
@@ -70,6 +70,8 @@ ComplianceTask::ComplianceTask(const mc_rbdyn::Robots & robots,
 
   type_ = "compliance";
   name_ = "compliance_" + robots_.robot(rIndex_).name() + "_" + body;
+  fastEvalEnabled_ = true;
+  fastSpeedEnabled_ = true;
 }
 
 ComplianceTask::ComplianceTask(const mc_rbdyn::Robots & robots,
@@ -28,6 +28,8 @@ EndEffectorTask::EndEffectorTask(const mc_rbdyn::RobotFrame & frame, double stif
 
   type_ = "body6d";
   name_ = "body6d_" + frame.robot().name() + "_" + frame.name();
+  fastEvalEnabled_ = true;
+  fastSpeedEnabled_ = true;
   name(name_);
 }
 
@@ -117,16 +119,30 @@ void EndEffectorTask::resetJointsSelector(mc_solver::QPSolver & solver)
 
 Eigen::VectorXd EndEffectorTask::eval() const
 {
-  Eigen::Vector6d err;
-  err << orientationTask->eval(), positionTask->eval();
-  return err;
+  return evalFromFastPath();
 }
 
 Eigen::VectorXd EndEffectorTask::speed() const
 {
-  Eigen::Vector6d spd;
-  spd << orientationTask->speed(), positionTask->speed();
-  return spd;
+  return speedFromFastPath();
+}
+
+void EndEffectorTask::fastEval(Eigen::VectorXd & out) const
+{
+  out.resize(6);
+  orientationTask->evalInto(subTaskBuffer_);
+  out.head<3>() = subTaskBuffer_;
+  positionTask->evalInto(subTaskBuffer_);
+  out.tail<3>() = subTaskBuffer_;
+}
+
+void EndEffectorTask::fastSpeed(Eigen::VectorXd & out) const
+{
+  out.resize(6);
+  orientationTask->speedInto(subTaskBuffer_);
+  out.head<3>() = subTaskBuffer_;
+  positionTask->speedInto(subTaskBuffer_);
+  out.tail<3>() = subTaskBuffer_;
 }
 
 void EndEffectorTask::load(mc_solver::QPSolver & solver, const mc_rtc::Configuration & config)
@@ -60,6 +60,12 @@ Eigen::Vector3d LookAtTask::target() const
 {
   return target_pos_;
 }
+
+void LookAtTask::interpolate(mc_solver::QPSolver &, unsigned int)
+{
+  target(target_pos_);
+}
+
 void LookAtTask::addToLogger(mc_rtc::Logger & logger)
 {
   VectorOrientationTask::addToLogger(logger);
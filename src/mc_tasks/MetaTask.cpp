@@ -9,11 +9,39 @@
 #include <mc_rtc/gui/ArrayLabel.h>
 #include <mc_rtc/gui/Button.h>
 
+#include <mc_rtc/clock.h>
+
 namespace mc_tasks
 {
 
 MetaTask::~MetaTask() {}
 
+void MetaTask::evalInto(Eigen::VectorXd & out) const
+{
+  if(fastEvalEnabled_) { fastEval(out); }
+  else { out = eval(); }
+}
+
+void MetaTask::speedInto(Eigen::VectorXd & out) const
+{
+  if(fastSpeedEnabled_) { fastSpeed(out); }
+  else { out = speed(); }
+}
+
+Eigen::VectorXd MetaTask::evalFromFastPath() const
+{
+  Eigen::VectorXd out;
+  fastEval(out);
+  return out;
+}
+
+Eigen::VectorXd MetaTask::speedFromFastPath() const
+{
+  Eigen::VectorXd out;
+  fastSpeed(out);
+  return out;
+}
+
 void MetaTask::load(mc_solver::QPSolver & solver, const mc_rtc::Configuration & config)
 {
   if(config.has("dimWeight"))
@@ -29,13 +57,89 @@ void MetaTask::load(mc_solver::QPSolver & solver, const mc_rtc::Configuration &
   if(config.has("activeJoints")) { selectActiveJoints(solver, config("activeJoints")); }
   else if(config.has("unactiveJoints")) { selectUnactiveJoints(solver, config("unactiveJoints")); }
   if(config.has("name")) { name(config("name")); }
+  if(config.has("updatePeriod")) { updatePeriod(config("updatePeriod")); }
+  else if(config.has("updateRate"))
+  {
+    double rate = config("updateRate");
+    if(rate <= 0) { mc_rtc::log::error_and_throw("updateRate must be strictly positive (got {})", rate); }
+    updatePeriod(static_cast<unsigned int>(std::lround(1.0 / (rate * solver.dt()))));
+  }
+}
+
+void MetaTask::scheduledUpdate(mc_solver::QPSolver & solver)
+{
+  if(iterSinceUpdate_ == 0)
+  {
+    auto start = mc_rtc::clock::now();
+    update(solver);
+    updateCost_ = mc_rtc::duration_ms(mc_rtc::clock::now() - start).count();
+  }
+  else { interpolate(solver, iterSinceUpdate_); }
+  iterSinceUpdate_ = (iterSinceUpdate_ + 1) % updatePeriod_;
+}
+
+void MetaTask::updatePeriod(unsigned int period)
+{
+  updatePeriod_ = std::max(period, 1u);
+  iterSinceUpdate_ = 0;
+  updateUpdateLogEntries();
+}
+
+void MetaTask::updateUpdateLogEntries()
+{
+  if(!updateLogger_) { return; }
+  auto & logger = *updateLogger_;
+  if(updatePeriod_ > 1 && !updateLogged_)
+  {
+    double dt = updateLoggerDt_;
+    logger.addLogEntry(name_ + "_update_rate", this,
+                       [this, dt]() { return 1.0 / (static_cast<double>(updatePeriod_) * dt); });
+    logger.addLogEntry("perf_" + name_ + "_update", this, [this]() { return updateCost_; });
+    updateLogged_ = true;
+  }
+  else if(updatePeriod_ == 1 && updateLogged_)
+  {
+    logger.removeLogEntry(name_ + "_update_rate");
+    logger.removeLogEntry("perf_" + name_ + "_update");
+    updateLogged_ = false;
+  }
+}
+
+void MetaTask::addUpdateToLogger(mc_rtc::Logger & logger, double dt)
+{
+  if(updateLogger_) { removeUpdateFromLogger(*updateLogger_); }
+  updateLogger_ = &logger;
+  updateLoggerDt_ = dt;
+  updateUpdateLogEntries();
+}
+
+void MetaTask::removeUpdateFromLogger(mc_rtc::Logger & logger)
+{
+  if(updateLogged_)
+  {
+    logger.removeLogEntry(name_ + "_update_rate");
+    logger.removeLogEntry("perf_" + name_ + "_update");
+    updateLogged_ = false;
+  }
+  updateLogger_ = nullptr;
 }
 
 void MetaTask::addToGUI(mc_rtc::gui::StateBuilder & gui)
 {
   gui.addElement({"Tasks", name_}, mc_rtc::gui::Button("Reset", [this]() { this->reset(); }));
-  gui.addElement({"Tasks", name_, "Details"}, mc_rtc::gui::ArrayLabel("eval", [this]() { return this->eval(); }),
-                 mc_rtc::gui::ArrayLabel("speed", [this]() { return this->speed(); }),
+  gui.addElement({"Tasks", name_, "Details"},
+                 mc_rtc::gui::ArrayLabel("eval",
+                                         [this, eval = Eigen::VectorXd{}]() mutable -> const Eigen::VectorXd &
+                                         {
+                                           this->evalInto(eval);
+                                           return eval;
+                                         }),
+                 mc_rtc::gui::ArrayLabel("speed",
+                                         [this, speed = Eigen::VectorXd{}]() mutable -> const Eigen::VectorXd &
+                                         {
+                                           this->speedInto(speed);
+                                           return speed;
+                                         }),
                  mc_rtc::gui::Label("type", [this]() { return this->type_; }));
   if(dimWeight().size())
   {
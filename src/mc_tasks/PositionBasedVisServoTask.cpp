@@ -29,6 +29,8 @@ PositionBasedVisServoTask::PositionBasedVisServoTask(const std::string & bodyNam
 : TrajectoryTaskGeneric(robots, robotIndex, stiffness, weight), X_t_s_(X_t_s)
 {
   name_ = "pbvs_" + robots.robot(robotIndex).name() + "_" + bodyName;
+  const auto & robot = robots.robot(rIndex);
+  frame_ = robot.makeTemporaryFrame(name_, robot.frame(bodyName), X_b_s, true);
   switch(backend_)
   {
     case Backend::Tasks:
@@ -36,17 +38,13 @@ PositionBasedVisServoTask::PositionBasedVisServoTask(const std::string & bodyNam
                                                                      X_t_s, X_b_s);
       break;
     case Backend::TVM:
-    {
-      const auto & robot = robots.robot(rIndex);
-      const auto & bodyFrame = robot.frame(bodyName);
-      finalize<Backend::TVM, mc_tvm::PositionBasedVisServoFunction>(
-          *robot.makeTemporaryFrame(name_, bodyFrame, X_b_s, true));
+      finalize<Backend::TVM, mc_tvm::PositionBasedVisServoFunction>(*frame_);
       tvm_error(errorT)->error(X_t_s);
       break;
-    }
     default:
       mc_rtc::log::error_and_throw("[PBVSTask] Not implemented for solver backend: {}", backend_);
   }
+  X_0_t_ = X_t_s.inv() * frame_->position();
 }
 
 PositionBasedVisServoTask::PositionBasedVisServoTask(const std::string & surfaceName,
@@ -63,7 +61,7 @@ PositionBasedVisServoTask::PositionBasedVisServoTask(const mc_rbdyn::RobotFrame
                                                      const sva::PTransformd & X_t_s,
                                                      double stiffness,
                                                      double weight)
-: TrajectoryBase(frame, stiffness, weight), X_t_s_(X_t_s)
+: TrajectoryBase(frame, stiffness, weight), frame_(frame), X_t_s_(X_t_s), X_0_t_(X_t_s.inv() * frame.position())
 {
   switch(backend_)
   {
@@ -89,6 +87,24 @@ void PositionBasedVisServoTask::reset()
 }
 
 void PositionBasedVisServoTask::error(const sva::PTransformd & X_t_s)
+{
+  X_0_t_ = X_t_s.inv() * frame_->position();
+  setError(X_t_s);
+}
+
+void PositionBasedVisServoTask::interpolate(mc_solver::QPSolver &, unsigned int)
+{
+  setError(frame_->position() * X_0_t_.inv());
+}
+
+void PositionBasedVisServoTask::update(mc_solver::QPSolver & solver)
+{
+  TrajectoryTaskGeneric::update(solver);
+  // Otherwise the error would jump back to the last measurement on the update iterations
+  if(updatePeriod() > 1) { interpolate(solver, 0); }
+}
+
+void PositionBasedVisServoTask::setError(const sva::PTransformd & X_t_s)
 {
   X_t_s_ = X_t_s;
   switch(backend_)
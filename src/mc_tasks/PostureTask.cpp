@@ -110,6 +110,8 @@ PostureTask::PostureTask(const mc_solver::QPSolver & solver, unsigned int rIndex
   speed_ = Eigen::VectorXd::Zero(eval_.size());
   type_ = "posture";
   name_ = std::string("posture_") + robots_.robot(rIndex_).name();
+  fastEvalEnabled_ = true;
+  fastSpeedEnabled_ = true;
   for(const auto & j : robots_.robot(rIndex_).mb().joints())
   {
     if(j.isMimic())
@@ -217,24 +219,36 @@ void PostureTask::resetJointsSelector(mc_solver::QPSolver & solver)
 }
 
 Eigen::VectorXd PostureTask::eval() const
+{
+  return evalFromFastPath();
+}
+
+Eigen::VectorXd PostureTask::speed() const
+{
+  return speedFromFastPath();
+}
+
+void PostureTask::fastEval(Eigen::VectorXd & out) const
 {
   switch(backend_)
   {
     case Backend::Tasks:
     {
       auto & pt = *tasks_error(pt_);
-      return pt.dimWeight().asDiagonal() * pt.eval();
+      out.noalias() = pt.dimWeight().asDiagonal() * pt.eval();
+      break;
     }
     case Backend::TVM:
-      return tvm_error(pt_)->eval();
+      out = tvm_error(pt_)->eval();
+      break;
     default:
       mc_rtc::log::error_and_throw("Not implemented");
   }
 }
 
-Eigen::VectorXd PostureTask::speed() const
+void PostureTask::fastSpeed(Eigen::VectorXd & out) const
 {
-  return speed_;
+  out = speed_;
 }
 
 void PostureTask::refVel(const Eigen::VectorXd & refVel) noexcept
@@ -564,7 +578,12 @@ void PostureTask::target(const std::map<std::string, std::vector<double>> & join
 
 void PostureTask::addToLogger(mc_rtc::Logger & logger)
 {
-  logger.addLogEntry(name_ + "_eval", this, [this]() { return eval(); });
+  logger.addLogEntry(name_ + "_eval", this,
+                     [this, eval = Eigen::VectorXd{}]() mutable -> const Eigen::VectorXd &
+                     {
+                       evalInto(eval);
+                       return eval;
+                     });
   logger.addLogEntry(name_ + "_speed", this, [this]() -> const Eigen::VectorXd & { return speed_; });
   logger.addLogEntry(name_ + "_refVel", this, [this]() -> const Eigen::VectorXd & { return refVel(); });
   logger.addLogEntry(name_ + "_refAccel", this, [this]() -> const Eigen::VectorXd & { return refAccel(); });
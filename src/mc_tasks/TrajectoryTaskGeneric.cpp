@@ -464,41 +464,55 @@ void TrajectoryTaskGeneric::resetJointsSelector(mc_solver::QPSolver & solver)
 }
 
 Eigen::VectorXd TrajectoryTaskGeneric::eval() const
+{
+  return evalFromFastPath();
+}
+
+Eigen::VectorXd TrajectoryTaskGeneric::speed() const
+{
+  return speedFromFastPath();
+}
+
+void TrajectoryTaskGeneric::fastEval(Eigen::VectorXd & out) const
 {
   switch(backend_)
   {
     case Backend::Tasks:
     {
       const auto & dimWeight = tasks_trajectory(trajectoryT_)->dimWeight();
-      if(selectorT_) { return tasks_selector(selectorT_)->eval().cwiseProduct(dimWeight); }
-      return tasks_error(errorT)->eval().cwiseProduct(dimWeight);
+      if(selectorT_) { out = tasks_selector(selectorT_)->eval().cwiseProduct(dimWeight); }
+      else { out = tasks_error(errorT)->eval().cwiseProduct(dimWeight); }
+      break;
     }
     case Backend::TVM:
     {
       const auto & dimWeight = tvm_trajectory(trajectoryT_)->dimWeight_;
-      if(selectorT_) { return tvm_selector(selectorT_)->value().cwiseProduct(dimWeight); }
-      return tvm_error(errorT)->value().cwiseProduct(dimWeight);
+      if(selectorT_) { out = tvm_selector(selectorT_)->value().cwiseProduct(dimWeight); }
+      else { out = tvm_error(errorT)->value().cwiseProduct(dimWeight); }
+      break;
     }
     default:
       mc_rtc::log::error_and_throw("Not implemented");
   }
 }
 
-Eigen::VectorXd TrajectoryTaskGeneric::speed() const
+void TrajectoryTaskGeneric::fastSpeed(Eigen::VectorXd & out) const
 {
   switch(backend_)
   {
     case Backend::Tasks:
     {
       const auto & dimWeight = tasks_trajectory(trajectoryT_)->dimWeight();
-      if(selectorT_) { return tasks_selector(selectorT_)->speed().cwiseProduct(dimWeight); }
-      return tasks_error(errorT)->speed().cwiseProduct(dimWeight);
+      if(selectorT_) { out = tasks_selector(selectorT_)->speed().cwiseProduct(dimWeight); }
+      else { out = tasks_error(errorT)->speed().cwiseProduct(dimWeight); }
+      break;
     }
     case Backend::TVM:
     {
       const auto & dimWeight = tvm_trajectory(trajectoryT_)->dimWeight_;
-      if(selectorT_) { return tvm_selector(selectorT_)->velocity().cwiseProduct(dimWeight); }
-      return tvm_error(errorT)->velocity().cwiseProduct(dimWeight);
+      if(selectorT_) { out = tvm_selector(selectorT_)->velocity().cwiseProduct(dimWeight); }
+      else { out = tvm_error(errorT)->velocity().cwiseProduct(dimWeight); }
+      break;
     }
     default:
       mc_rtc::log::error_and_throw("Not implemented");
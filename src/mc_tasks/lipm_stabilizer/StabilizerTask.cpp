@@ -41,6 +41,8 @@ StabilizerTask::StabilizerTask(const mc_rbdyn::Robots & robots,
 {
   type_ = "lipm_stabilizer";
   name_ = type_ + "_" + robots.robot(robotIndex).name();
+  fastEvalEnabled_ = true;
+  fastSpeedEnabled_ = true;
 
   comTask.reset(new mc_tasks::CoMTask(robots, robotIndex_));
   auto leftCoP = std::allocate_shared<mc_tasks::force::CoPTask>(Eigen::aligned_allocator<mc_tasks::force::CoPTask>{},
@@ -170,20 +172,38 @@ void StabilizerTask::resetJointsSelector(mc_solver::QPSolver & /* solver */)
 
 Eigen::VectorXd StabilizerTask::eval() const
 {
-  Eigen::VectorXd res(3 + 3 * contactTasks.size());
-  res.head(3) = comTask->eval();
-  int i = 0;
-  for(const auto & task : contactTasks) { res.segment(3 + 3 * i++, 3) = task->eval(); }
-  return res;
+  return evalFromFastPath();
 }
 
 Eigen::VectorXd StabilizerTask::speed() const
 {
-  Eigen::VectorXd res(3 + 3 * contactTasks.size());
-  res.head(3) = comTask->speed();
+  return speedFromFastPath();
+}
+
+void StabilizerTask::fastEval(Eigen::VectorXd & out) const
+{
+  out.resize(static_cast<Eigen::Index>(3 + 3 * contactTasks.size()));
+  comTask->evalInto(subTaskBuffer_);
+  out.head(3) = subTaskBuffer_;
   int i = 0;
-  for(const auto & task : contactTasks) { res.segment(3 + 3 * i++, 3) = task->speed(); }
-  return res;
+  for(const auto & task : contactTasks)
+  {
+    task->evalInto(subTaskBuffer_);
+    out.segment(3 + 3 * i++, 3) = subTaskBuffer_;
+  }
+}
+
+void StabilizerTask::fastSpeed(Eigen::VectorXd & out) const
+{
+  out.resize(static_cast<Eigen::Index>(3 + 3 * contactTasks.size()));
+  comTask->speedInto(subTaskBuffer_);
+  out.head(3) = subTaskBuffer_;
+  int i = 0;
+  for(const auto & task : contactTasks)
+  {
+    task->speedInto(subTaskBuffer_);
+    out.segment(3 + 3 * i++, 3) = subTaskBuffer_;
+  }
 }
 
 void StabilizerTask::addToSolver(mc_solver::QPSolver & solver)
@@ -257,6 +277,31 @@ void StabilizerTask::update(mc_solver::QPSolver & solver)
   t_ += dt_;
 }
 
+void StabilizerTask::interpolate(mc_solver::QPSolver & solver, unsigned int)
+{
+  if(newTarget_)
+  {
+    zmpcc_.apply(comTarget_, comdTarget_, comddTarget_);
+    if(c_.extWrench.addExpectedCoMOffset) { comTarget_ -= comOffsetTarget_; }
+    newTarget_ = false;
+  }
+  else
+  {
+    comTarget_ += dt_ * comdTarget_ + 0.5 * dt_ * dt_ * comddTarget_;
+    comdTarget_ += dt_ * comddTarget_;
+  }
+  comTask->com(comTarget_);
+  comTask->refVel(comdTarget_);
+  comTask->refAccel(comddTarget_);
+
+  MetaTask::update(*comTask, solver);
+  MetaTask::update(*pelvisTask, solver);
+  MetaTask::update(*torsoTask, solver);
+  for(const auto & footTask : contactTasks) { MetaTask::update(*footTask, solver); }
+
+  t_ += dt_;
+}
+
 void StabilizerTask::enable()
 {
   mc_rtc::log::info("[StabilizerTask] enabled");
@@ -607,6 +652,7 @@ void StabilizerTask::target(const Eigen::Vector3d & com,
   double comHeight = comTarget_.z() - zmpTarget_.z();
   omega_ = std::sqrt(constants::gravity.z() / comHeight);
   dcmTarget_ = comTarget_ + comdTarget_ / omega_;
+  newTarget_ = true;
 }
 
 void StabilizerTask::setExternalWrenches(const std::vector<std::string> & surfaceNames,
@@ -768,6 +814,7 @@ void StabilizerTask::run()
   comTask->com(comTarget_);
   comTask->refVel(comdTarget_);
   comTask->refAccel(comddTarget_);
+  newTarget_ = false;
 
   // Update orientation tasks according to feet orientation
   sva::PTransformd X_0_a = anchorFrame(robot());
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_tvm/BodyJacobian.h>
+
+#include <mc_tvm/Robot.h>
+
+#include <mc_rbdyn/hat.h>
+
+namespace mc_tvm
+{
+
+BodyJacobian::BodyJacobian(NewBodyJacobianToken, Robot & robot, unsigned int bodyIdx)
+: robot_(robot), bodyIdx_(bodyIdx), jac_(robot.robot().mb(), robot.robot().mb().body(static_cast<int>(bodyIdx)).name()),
+  jacobian_(Eigen::MatrixXd::Zero(6, jac_.dof())), jacDot_(Eigen::MatrixXd::Zero(6, jac_.dof()))
+{
+  // clang-format off
+  registerUpdates(
+                  Update::Jacobian, &BodyJacobian::updateJacobian,
+                  Update::JDot, &BodyJacobian::updateJDot);
+  // clang-format off
+
+  addOutputDependency(Output::Jacobian, Update::Jacobian);
+  addInputDependency(Update::Jacobian, robot_, Robot::Output::FV);
+
+  addOutputDependency(Output::JDot, Update::JDot);
+  addInputDependency(Update::JDot, robot_, Robot::Output::FV);
+}
+
+void BodyJacobian::jacobian(const sva::PTransformd & X_0_p, Eigen::Ref<Eigen::MatrixXd> out) const
+{
+  const auto & r = robot_.robot();
+  const Eigen::Matrix3d & E = X_0_p.rotation();
+  Eigen::Matrix3d Eh = E * mc_rbdyn::hat(X_0_p.translation() - r.mbc().bodyPosW[bodyIdx_].translation());
+  out.topRows<3>().noalias() = E * jacobian_.topRows<3>();
+  out.bottomRows<3>().noalias() = E * jacobian_.bottomRows<3>();
+  out.bottomRows<3>().noalias() -= Eh * jacobian_.topRows<3>();
+}
+
+void BodyJacobian::updateJacobian()
+{
+  const auto & r = robot_.robot();
+  jacobian_ = jac_.jacobian(r.mb(), r.mbc());
+}
+
+void BodyJacobian::updateJDot()
+{
+  const auto & r = robot_.robot();
+  jacDot_ = jac_.jacobianDot(r.mb(), r.mbc());
+}
+
+} // namespace mc_tvm
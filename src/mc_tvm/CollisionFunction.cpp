@@ -52,12 +52,13 @@ CollisionFunction::CollisionFunction(Convex & c1,
     if(r.mb().nrDof() > 0)
     {
       auto & tvm_robot = r.tvmRobot();
+      auto & bodyJac = tvm_robot.bodyJacobian(convex.frame().bodyMbcIndex());
       addInputDependency<CollisionFunction>(Update::Value, convex, Convex::Output::Position);
-      addInputDependency<CollisionFunction>(Update::Jacobian, tvm_robot, mc_tvm::Robot::Output::FV);
+      addInputDependency<CollisionFunction>(Update::Jacobian, bodyJac, BodyJacobian::Output::Jacobian);
       addInputDependency<CollisionFunction>(Update::NormalAcceleration, tvm_robot,
                                             mc_tvm::Robot::Output::NormalAcceleration);
       addVariable(tvm_robot.q(), false);
-      data_.push_back({Eigen::Vector3d::Zero(), convex.frame().tvm_frame().rbdJacobian(), selector});
+      data_.push_back({Eigen::Vector3d::Zero(), &bodyJac, convex.frame().tvm_frame().rbdJacobian(), selector});
     }
     return r.mb().nrDof();
   };
@@ -111,9 +112,12 @@ void CollisionFunction::updateJacobian()
     auto & d = data_[i];
     const auto & r = object.get()->frame().robot();
     const auto & tvm_robot = r.tvmRobot();
-    const auto & jac = d.jac_.jacobian(r.mb(), r.mbc());
-    distJac_.block(0, 0, 1, d.jac_.dof()).noalias() =
-        (sign * normVecDist_).transpose() * jac.block(3, 0, 3, d.jac_.dof());
+    // Linear part of the jacobian at the nearest point: J_lin - hat(r) * J_ang with r the point in world orientation
+    const auto & jac = d.bodyJac_->jacobian();
+    Eigen::Vector3d n = sign * normVecDist_;
+    Eigen::Vector3d r_0 = r.mbc().bodyPosW[d.bodyJac_->bodyIndex()].rotation().transpose() * d.nearestPoint_;
+    distJac_.block(0, 0, 1, d.jac_.dof()).noalias() = n.transpose() * jac.bottomRows<3>();
+    distJac_.block(0, 0, 1, d.jac_.dof()).noalias() -= n.cross(r_0).transpose() * jac.topRows<3>();
     d.jac_.fullJacobian(r.mb(), distJac_.block(0, 0, 1, d.jac_.dof()), fullJac_);
     if(d.selector_.size() == 0) { jacobian_[tvm_robot.q().get()] += fullJac_.block(0, 0, 1, r.mb().nrDof()); }
     else { jacobian_[tvm_robot.q().get()] += fullJac_.block(0, 0, 1, r.mb().nrDof()) * d.selector_.asDiagonal(); }
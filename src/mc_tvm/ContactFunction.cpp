@@ -39,7 +39,8 @@ ContactFunction::ContactFunction(const mc_rbdyn::Frame & f1, const mc_rbdyn::Fra
       addInputDependency<ContactFunction>(Update::Derivatives, tvm_frame, mc_tvm::RobotFrame::Output::Velocity);
       addInputDependency<ContactFunction>(Update::Derivatives, tvm_frame,
                                           mc_tvm::RobotFrame::Output::NormalAcceleration);
-      addInputDependency<ContactFunction>(Update::Derivatives, tvm_frame, mc_tvm::RobotFrame::Output::Jacobian);
+      addInputDependency<ContactFunction>(Update::Derivatives, tvm_frame.bodyJacobian(),
+                                          mc_tvm::BodyJacobian::Output::Jacobian);
       addVariable(tvm_robot.q(), false);
       return r.mb().nrDof();
     }
@@ -99,8 +100,9 @@ void ContactFunction::updateDerivatives()
     const auto & NAB = robot.tvmRobot().normalAccB();
 
     const auto & X_0_f = X_f_cf * frame.position();
-    const auto & jacMat = jac.jacobian(mb, mbc, X_0_f);
-    jacTmp_.block(0, 0, 6, jac.dof()).noalias() = sign * dof_.asDiagonal() * jacMat;
+    auto jacMat = jacTmp_.block(0, 0, 6, jac.dof());
+    frame.bodyJacobian().jacobian(X_0_f, jacMat);
+    jacMat = (sign * dof_).asDiagonal() * jacMat;
     jac.fullJacobian(mb, jacTmp_.block(0, 0, 6, jac.dof()), jac_);
     jacobian_[tvm_robot.q().get()] += jac_.block(0, 0, 6, mb.nrDof());
 
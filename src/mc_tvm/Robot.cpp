@@ -39,6 +39,8 @@ Robot::Robot(NewRobotToken, const mc_rbdyn::Robot & robot)
   com_.reset(new CoM(CoM::NewCoMToken{}, *this));
 
   momentum_.reset(new Momentum(Momentum::NewMomentumToken{}, *com_));
+
+  bodyJacobians_.resize(robot.mb().bodies().size());
   //
   // Create TVM variables
   {
@@ -173,6 +175,17 @@ Robot::Robot(NewRobotToken, const mc_rbdyn::Robot & robot)
   addInternalDependency(Update::NormalAcceleration, Update::FV);
 }
 
+BodyJacobian & Robot::bodyJacobian(unsigned int bodyIdx)
+{
+  if(bodyIdx >= bodyJacobians_.size())
+  {
+    mc_rtc::log::error_and_throw<std::runtime_error>("{} has no body at index {}", robot_.name(), bodyIdx);
+  }
+  auto & jac = bodyJacobians_[bodyIdx];
+  if(!jac) { jac.reset(new BodyJacobian(BodyJacobian::NewBodyJacobianToken{}, *this, bodyIdx)); }
+  return *jac;
+}
+
 void Robot::updateFK()
 {
   updateVar(robot_.mbc().q, *q_);
@@ -12,7 +12,8 @@ namespace mc_tvm
 {
 
 RobotFrame::RobotFrame(NewRobotFrameToken tkn, const mc_rbdyn::RobotFrame & frame)
-: Frame(tkn, frame), jac_(frame.robot().mb(), frame.body()), blocks_(jac_.compactPath(frame.robot().mb())),
+: Frame(tkn, frame), bodyJac_(frame.robot().tvmRobot().bodyJacobian(frame.bodyMbcIndex())),
+  jac_(frame.robot().mb(), frame.body()), blocks_(jac_.compactPath(frame.robot().mb())),
   jacTmp_(6, jac_.dof()), jacobian_(6, frame.robot().mb().nrDof()), jacDot_(jacobian_)
 {
   // clang-format off
@@ -25,13 +26,14 @@ RobotFrame::RobotFrame(NewRobotFrameToken tkn, const mc_rbdyn::RobotFrame & fram
   auto & robot_ = frame.robot().tvmRobot();
 
   addOutputDependency<RobotFrame>(Output::Jacobian, Update::Jacobian);
-  addInputDependency<RobotFrame>(Update::Jacobian, robot_, Robot::Output::FV);
+  addInputDependency<RobotFrame>(Update::Jacobian, bodyJac_, BodyJacobian::Output::Jacobian);
 
   addOutputDependency<RobotFrame>(Output::NormalAcceleration, Update::NormalAcceleration);
   addInputDependency<RobotFrame>(Update::NormalAcceleration, robot_, Robot::Output::NormalAcceleration);
 
   addOutputDependency<RobotFrame>(Output::JDot, Update::JDot);
-  addInputDependency<RobotFrame>(Update::JDot, robot_, Robot::Output::FV);
+  addInputDependency<RobotFrame>(Update::JDot, bodyJac_, BodyJacobian::Output::Jacobian);
+  addInputDependency<RobotFrame>(Update::JDot, bodyJac_, BodyJacobian::Output::JDot);
 
   addInternalDependency<RobotFrame>(Update::NormalAcceleration, Update::Jacobian); // for h_
   addInternalDependency<RobotFrame>(Update::NormalAcceleration, Update::Velocity);
@@ -46,7 +48,7 @@ void RobotFrame::updateJacobian()
 {
   const auto & robot = frame().robot();
   h_ = -mc_rbdyn::hat(robot.mbc().bodyPosW[frame().bodyMbcIndex()].rotation().transpose() * frame().X_b_f().translation());
-  const auto & partialJac = jac_.jacobian(robot.mb(), robot.mbc());
+  const auto & partialJac = bodyJac_.jacobian();
   jacTmp_ = partialJac;
   jacTmp_.bottomRows<3>().noalias() += h_ * partialJac.topRows<3>();
   jacobian_.setZero();
@@ -63,11 +65,10 @@ void RobotFrame::updateNormalAcceleration()
 
 void RobotFrame::updateJDot()
 {
-  const auto & robot = frame().robot();
-  const auto & partialJac = jac_.jacobianDot(robot.mb(), robot.mbc());
+  const auto & partialJac = bodyJac_.JDot();
   jacTmp_ = partialJac;
   jacTmp_.bottomRows<3>().noalias() += h_ * partialJac.topRows<3>();
-  jacTmp_.bottomRows<3>().noalias() -= mc_rbdyn::hat(h_*velocity_.angular()) * jac_.jacobian(robot.mb(), robot.mbc()).topRows<3>();
+  jacTmp_.bottomRows<3>().noalias() -= mc_rbdyn::hat(h_*velocity_.angular()) * bodyJac_.jacobian().topRows<3>();
   jacDot_.setZero();
   jac_.addFullJacobian(blocks_, jacTmp_, jacDot_);
 }
@@ -32,7 +32,8 @@ TransformFunction::TransformFunction(const mc_rbdyn::RobotFrame & frame)
   addVariable(robot.q(), false);
   addInputDependency<TransformFunction>(Update::Value, tvm_frame_, mc_tvm::RobotFrame::Output::Position);
   addInputDependency<TransformFunction>(Update::Velocity, tvm_frame_, mc_tvm::RobotFrame::Output::Velocity);
-  addInputDependency<TransformFunction>(Update::Jacobian, tvm_frame_, mc_tvm::RobotFrame::Output::Jacobian);
+  addInputDependency<TransformFunction>(Update::Jacobian, tvm_frame_.bodyJacobian(),
+                                        mc_tvm::BodyJacobian::Output::Jacobian);
   addInputDependency<TransformFunction>(Update::NormalAcceleration, tvm_frame_,
                                         mc_tvm::RobotFrame::Output::NormalAcceleration);
   addInternalDependency<TransformFunction>(Update::Velocity, Update::Value);
@@ -65,7 +66,7 @@ void TransformFunction::updateVelocity()
 void TransformFunction::updateJacobian()
 {
   const auto & robot = frame().robot();
-  shortJacMat_ = frameJac_.jacobian(robot.mb(), robot.mbc(), tvm_frame_.position());
+  tvm_frame_.bodyJacobian().jacobian(tvm_frame_.position(), shortJacMat_);
   for(int i = 0; i < frameJac_.dof(); ++i)
   {
     shortJacMat_.col(i).head<6>() -=
@@ -286,3 +286,45 @@ BOOST_AUTO_TEST_CASE(TestCustomCriteria)
   BOOST_REQUIRE(criteria.completed(task));
   BOOST_REQUIRE(criteria.output() == "MYCRITERIA");
 }
+
+/** Implements eval() with the non-allocating path like the library tasks */
+struct FastMockTask : public MockTask
+{
+  Eigen::VectorXd eval() const override { return evalFromFastPath(); }
+
+protected:
+  void fastEval(Eigen::VectorXd & out) const override { out = eval_; }
+};
+
+/** Modifies the result of the base eval() */
+struct OffsetMockTask : public FastMockTask
+{
+  Eigen::VectorXd eval() const override
+  {
+    Eigen::VectorXd out = FastMockTask::eval();
+    out.z() += offset;
+    return out;
+  }
+
+  double offset = 1.0;
+};
+
+BOOST_AUTO_TEST_CASE(TestEvalOverride)
+{
+  OffsetMockTask task;
+  task.eval_ = Eigen::Vector3d::Zero();
+  mc_rtc::Configuration config;
+  config.add("eval", 0.5);
+  mc_control::CompletionCriteria criteria;
+  criteria.configure(task, dt, config);
+  // The overridden eval() is used on every call
+  for(size_t i = 0; i < 3; ++i)
+  {
+    Eigen::VectorXd eval;
+    task.evalInto(eval);
+    BOOST_REQUIRE(eval.isApprox(Eigen::Vector3d::UnitZ()));
+    BOOST_REQUIRE(!criteria.completed(task));
+  }
+  task.offset = 0;
+  BOOST_REQUIRE(criteria.completed(task));
+}
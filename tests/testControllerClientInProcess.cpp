@@ -0,0 +1,126 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_control/ControllerClient.h>
+#include <mc_control/ControllerServer.h>
+#include <mc_rtc/gui/NumberInput.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+
+/** Records the value of the NumberInput it receives */
+struct InProcessClient : public mc_control::ControllerClient
+{
+  using mc_control::ControllerClient::ControllerClient;
+
+  void started() override { states++; }
+
+  void number_input(const mc_control::ElementId & id, double data) override
+  {
+    if(id.name == "value")
+    {
+      value = data;
+      valueId = id;
+    }
+  }
+
+  size_t states = 0;
+  double value = 0;
+  mc_control::ElementId valueId{{}, "", 0};
+};
+
+BOOST_AUTO_TEST_CASE(TestControllerClientInProcess)
+{
+  mc_rtc::gui::StateBuilder gui;
+  double value = 0;
+  gui.addElement({"Test"}, mc_rtc::gui::NumberInput(
+                               "value", [&]() { return value; }, [&](double v) { value = v; }));
+  mc_control::ControllerServer server(0.005, 0.005, {}, {});
+  InProcessClient client(server, gui);
+
+  std::vector<char> buffer;
+  auto t_last_received = std::chrono::system_clock::now();
+  // Nothing published yet
+  client.run(buffer, t_last_received);
+  BOOST_REQUIRE(client.states == 0);
+
+  value = 42;
+  server.publish(gui);
+  auto snapshot = server.snapshot();
+  BOOST_REQUIRE(snapshot);
+  client.run(buffer, t_last_received);
+  BOOST_REQUIRE(client.states == 1);
+  BOOST_REQUIRE(client.value == 42);
+  // The client reads the published state in place
+  BOOST_REQUIRE(buffer.empty());
+  // A state is only handled once
+  client.run(buffer, t_last_received);
+  BOOST_REQUIRE(client.states == 1);
+
+  // A snapshot that is still referenced is not overwritten
+  value = 43;
+  server.publish(gui);
+  BOOST_REQUIRE(server.snapshot() != snapshot);
+  BOOST_REQUIRE(server.snapshot()->seq == snapshot->seq + 1);
+  auto held = mc_rtc::Configuration::fromMessagePack(snapshot->buffer.data(), snapshot->size);
+  client.run(buffer, t_last_received);
+  BOOST_REQUIRE(client.value == 43);
+  auto reread = mc_rtc::Configuration::fromMessagePack(snapshot->buffer.data(), snapshot->size);
+  BOOST_REQUIRE(held.dump() == reread.dump());
+
+  // Requests are handled by the server on its next iteration
+  client.send_request(client.valueId, 12.0);
+  BOOST_REQUIRE(value == 43);
+  server.handle_requests(gui);
+  BOOST_REQUIRE(value == 12);
+  client.send_request({{"Test"}, "value", 0}, 13.0);
+  server.handle_requests(gui);
+  BOOST_REQUIRE(value == 13);
+}
+
+BOOST_AUTO_TEST_CASE(TestControllerClientInProcessThreads)
+{
+  mc_rtc::gui::StateBuilder gui;
+  double value = 0;
+  size_t requests = 0;
+  // Requests go to a separate element so that the published value only increases
+  gui.addElement({"Test"}, mc_rtc::gui::NumberInput(
+                               "value", [&]() { return value; }, [](double) {}),
+                 mc_rtc::gui::NumberInput(
+                     "request", []() { return 0.0; }, [&](double) { requests++; }));
+  mc_control::ControllerServer server(0.005, 0.005, {}, {});
+  InProcessClient client(server, gui);
+
+  // The server publishes an increasing value while the client reads it and sends requests from another thread
+  std::atomic<bool> done{false};
+  std::thread controller(
+      [&]()
+      {
+        for(size_t i = 1; i <= 2000; ++i)
+        {
+          value = static_cast<double>(i);
+          server.handle_requests(gui);
+          server.publish(gui);
+        }
+        done = true;
+      });
+  std::vector<char> buffer;
+  auto t_last_received = std::chrono::system_clock::now();
+  double last = 0;
+  while(!done)
+  {
+    client.run(buffer, t_last_received);
+    BOOST_REQUIRE(client.value >= last);
+    last = client.value;
+    client.send_request({{"Test"}, "request", 0}, 1.0);
+  }
+  controller.join();
+  client.run(buffer, t_last_received);
+  BOOST_REQUIRE(client.value == 2000);
+  client.send_request({{"Test"}, "request", 0}, 1.0);
+  server.handle_requests(gui);
+  BOOST_REQUIRE(requests > 0);
+}
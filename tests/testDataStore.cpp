@@ -301,6 +301,80 @@ BOOST_AUTO_TEST_CASE(LambdaSugar)
   BOOST_CHECK(v3 == 2 * v);
 }
 
+BOOST_AUTO_TEST_CASE(TestHandle)
+{
+  DataStore store;
+  store.make<double>("value", 42.0);
+  auto h = store.handle<double>("value");
+  BOOST_REQUIRE(h.valid());
+  BOOST_CHECK(h.name() == "value");
+  BOOST_CHECK(*h == 42);
+  BOOST_CHECK_THROW(store.handle<int>("value"), std::runtime_error);
+  BOOST_CHECK_THROW(store.handle<double>("non-existing key"), std::runtime_error);
+
+  // Handle survives unrelated insertions and removals
+  for(size_t i = 0; i < 1000; ++i) { store.make<size_t>("data_" + std::to_string(i), i); }
+  store.remove("data_42");
+  BOOST_REQUIRE(h.valid());
+  *h = 12;
+  BOOST_CHECK(store.get<double>("value") == 12);
+
+  // Version tracking
+  BOOST_CHECK(!h.changed());
+  store.assign("value", 24.0);
+  BOOST_CHECK(h.changed());
+  BOOST_CHECK(!h.changed());
+  BOOST_CHECK(*h == 24);
+  store.get<double>("value") = 36;
+  BOOST_CHECK(!h.changed());
+  store.touch("value");
+  BOOST_CHECK(h.changed());
+  const auto & cstore = store;
+  auto ch = cstore.handle<double>("value");
+  BOOST_CHECK(!ch.changed());
+  h.touch();
+  BOOST_CHECK(ch.changed());
+  BOOST_CHECK(*ch == 36);
+
+  // Removal is detected
+  store.remove("value");
+  BOOST_CHECK(!h.valid());
+  BOOST_CHECK(!ch.valid());
+  BOOST_CHECK(!h.changed());
+  BOOST_CHECK_THROW(*h, std::runtime_error);
+
+  // Re-creating the object does not revive the old handle
+  store.make<double>("value", 0.0);
+  BOOST_CHECK(!h.valid());
+  h = store.handle<double>("value");
+  BOOST_CHECK(h.valid());
+  store.clear();
+  BOOST_CHECK(!h.valid());
+
+  // Default handle is invalid
+  mc_rtc::DataHandle<double> invalid;
+  BOOST_CHECK(!invalid);
+}
+
+BOOST_AUTO_TEST_CASE(TestHandleInheritance)
+{
+  struct A
+  {
+    virtual ~A() = default;
+    virtual std::string hello() const { return "A"; }
+  };
+  struct B : public A
+  {
+    std::string hello() const override { return "B"; }
+  };
+  DataStore store;
+  store.make<B, A>("data");
+  auto a = store.handle<A>("data");
+  auto b = store.handle<B>("data");
+  BOOST_CHECK(a->hello() == "B");
+  BOOST_CHECK(b->hello() == "B");
+}
+
 BOOST_AUTO_TEST_CASE(TestRemove)
 {
   struct Object
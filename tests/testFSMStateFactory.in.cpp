@@ -6,10 +6,15 @@
 #include <mc_control/fsm/StateFactory.h>
 #include <mc_rbdyn/RobotLoader.h>
 
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "testFSMStateFactoryConfig.h"
 
+#include <fstream>
+
+namespace bfs = boost::filesystem;
+
 static bool initialized = configureRobotLoader();
 
 mc_control::fsm::Controller & get_default_controller()
@@ -107,6 +112,100 @@ BOOST_AUTO_TEST_CASE(TestConfigureState)
   test_state("ConfigureState8", 42, config);
 }
 
+BOOST_AUTO_TEST_CASE(TestReloadFiles)
+{
+  auto dir = bfs::temp_directory_path() / bfs::unique_path("mc-rtc-test-fsm-%%%%-%%%%");
+  bfs::create_directories(dir);
+  auto path = (dir / "states.json").string();
+  // Write the file and make sure its modification time changes
+  auto write = [](const std::string & path, const std::string & content)
+  {
+    auto time = bfs::exists(path) ? bfs::last_write_time(path) : std::time_t{0};
+    std::ofstream(path) << content;
+    bfs::last_write_time(path, std::max(bfs::last_write_time(path), time + 1));
+  };
+  write(path, R"({
+    "ConfigureState2": { "base": "ConfigureState", "value": 2 },
+    "ConfigureState4": { "base": "ConfigureState2", "value": 4 },
+    "ConfigureState8": { "base": "ConfigureState4", "value": 8 }
+  })");
+  mc_control::fsm::StateFactory factory{{ConfigureState_DIR}, {dir.string()}, false};
+  check_states(factory, {"ConfigureState", "ConfigureState2", "ConfigureState4", "ConfigureState8"});
+  auto & ctl = get_default_controller();
+  auto create = [&](const std::string & name)
+  {
+    ConfigureState::ExpectedStateName = name;
+    auto state = std::dynamic_pointer_cast<ConfigureState>(factory.create(name, ctl));
+    BOOST_REQUIRE(state != nullptr);
+    return state;
+  };
+  auto running = create("ConfigureState4");
+  BOOST_REQUIRE(running->value() == 4);
+  // Nothing to do if the files did not change
+  BOOST_REQUIRE(factory.reload_files().empty());
+
+  // Modify ConfigureState4, remove ConfigureState8 and add ConfigureState16
+  write(path, R"({
+    "ConfigureState2": { "base": "ConfigureState", "value": 2 },
+    "ConfigureState4": { "base": "ConfigureState2", "value": 40 },
+    "ConfigureState16": { "base": "ConfigureState4" }
+  })");
+  auto changed = factory.reload_files();
+  BOOST_REQUIRE(changed == std::vector<std::string>({"ConfigureState16", "ConfigureState4", "ConfigureState8"}));
+  check_states(factory, {"ConfigureState", "ConfigureState2", "ConfigureState4", "ConfigureState16"});
+  BOOST_REQUIRE(running->value() == 4);
+  BOOST_REQUIRE(create("ConfigureState4")->value() == 40);
+  BOOST_REQUIRE(create("ConfigureState16")->value() == 40);
+
+  // Modifying a base state reports the states inheriting from it
+  write(path, R"({
+    "ConfigureState2": { "base": "ConfigureState", "value": 20 },
+    "ConfigureState4": { "base": "ConfigureState2", "value": 40 },
+    "ConfigureState16": { "base": "ConfigureState4" }
+  })");
+  changed = factory.reload_files();
+  BOOST_REQUIRE(changed == std::vector<std::string>({"ConfigureState16", "ConfigureState2", "ConfigureState4"}));
+  BOOST_REQUIRE(create("ConfigureState2")->value() == 20);
+
+  // New files in a watched directory are loaded, invalid files are ignored
+  write((dir / "more.json").string(), R"({ "ConfigureState32": { "base": "ConfigureState16", "value": 32 } })");
+  write((dir / "invalid.json").string(), "{");
+  BOOST_REQUIRE(factory.reload_files() == std::vector<std::string>({"ConfigureState32"}));
+  BOOST_REQUIRE(create("ConfigureState32")->value() == 32);
+
+  // States from deleted files are removed
+  bfs::remove(dir / "more.json");
+  BOOST_REQUIRE(factory.reload_files() == std::vector<std::string>({"ConfigureState32"}));
+  BOOST_REQUIRE(!factory.hasState("ConfigureState32"));
+
+  // States inheriting from a removed state are kept but cannot be created until their base comes back
+  auto base = (dir / "base.json").string();
+  auto child = (dir / "child.json").string();
+  write(base, R"({ "ConfigureStateBase": { "base": "ConfigureState", "value": 3 } })");
+  write(child, R"({ "ConfigureStateChild": { "base": "ConfigureStateBase" } })");
+  BOOST_REQUIRE(factory.reload_files() == std::vector<std::string>({"ConfigureStateBase", "ConfigureStateChild"}));
+  BOOST_REQUIRE(create("ConfigureStateChild")->value() == 3);
+  bfs::remove(base);
+  BOOST_REQUIRE(factory.reload_files() == std::vector<std::string>({"ConfigureStateBase", "ConfigureStateChild"}));
+  BOOST_REQUIRE(!factory.hasState("ConfigureStateBase"));
+  BOOST_REQUIRE(factory.hasState("ConfigureStateChild"));
+  BOOST_REQUIRE(factory.create("ConfigureStateChild", ctl) == nullptr);
+  write(base, R"({ "ConfigureStateBase": { "base": "ConfigureState", "value": 5 } })");
+  BOOST_REQUIRE(factory.reload_files() == std::vector<std::string>({"ConfigureStateBase", "ConfigureStateChild"}));
+  BOOST_REQUIRE(create("ConfigureStateChild")->value() == 5);
+
+  // A state can move to another file whatever the order in which the files are processed
+  write(base, "{}");
+  write(child, R"({
+    "ConfigureStateBase": { "base": "ConfigureState", "value": 5 },
+    "ConfigureStateChild": { "base": "ConfigureStateBase" }
+  })");
+  factory.reload_files();
+  BOOST_REQUIRE(factory.hasState("ConfigureStateBase"));
+  BOOST_REQUIRE(create("ConfigureStateChild")->value() == 5);
+  bfs::remove_all(dir);
+}
+
 BOOST_AUTO_TEST_CASE(TestTransitionMap)
 {
   mc_control::fsm::StateFactory factory{{MultipleStates_DIR}, {}, false};
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_control/GUISharedMemory.h>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using mc_control::GUISharedMemory;
+
+BOOST_AUTO_TEST_CASE(TestGUISharedMemoryState)
+{
+  BOOST_REQUIRE(!GUISharedMemory::open("mc_rtc_test_gui_shm"));
+  auto server = GUISharedMemory::create("mc_rtc_test_gui_shm", 1024);
+  auto client = GUISharedMemory::open("mc_rtc_test_gui_shm");
+  BOOST_REQUIRE(client);
+  BOOST_REQUIRE(client->state_capacity() == 1024);
+  std::vector<char> buffer;
+  uint64_t seq = 0;
+  // Nothing published yet
+  BOOST_REQUIRE(client->read(buffer, seq) == 0);
+  std::string state = "state";
+  BOOST_REQUIRE(server->write(state.data(), state.size()));
+  BOOST_REQUIRE(client->read(buffer, seq) == state.size());
+  BOOST_REQUIRE(std::memcmp(buffer.data(), state.data(), state.size()) == 0);
+  // Only new states are read
+  BOOST_REQUIRE(client->read(buffer, seq) == 0);
+  // Only the latest state is kept
+  server->write("a", 1);
+  server->write("bc", 2);
+  BOOST_REQUIRE(client->read(buffer, seq) == 2);
+  BOOST_REQUIRE(buffer[0] == 'b');
+  // Too large states are not published
+  std::vector<char> large(2048);
+  BOOST_REQUIRE(!server->write(large.data(), large.size()));
+  BOOST_REQUIRE(client->read(buffer, seq) == 0);
+  // The segment is removed with the server
+  server.reset();
+  BOOST_REQUIRE(!GUISharedMemory::open("mc_rtc_test_gui_shm"));
+}
+
+BOOST_AUTO_TEST_CASE(TestGUISharedMemoryConsistency)
+{
+  auto server = GUISharedMemory::create("mc_rtc_test_gui_shm", 1 << 20);
+  auto client = GUISharedMemory::open("mc_rtc_test_gui_shm");
+  std::atomic<bool> done{false};
+  std::thread writer(
+      [&]()
+      {
+        std::vector<char> state(1 << 19);
+        for(size_t i = 0; i < 1000; ++i)
+        {
+          std::fill(state.begin(), state.end(), static_cast<char>('a' + i % 26));
+          server->write(state.data(), state.size() - i % 7);
+        }
+        done = true;
+      });
+  std::vector<char> buffer;
+  uint64_t seq = 0;
+  while(!done)
+  {
+    auto size = client->read(buffer, seq);
+    // A state is never read while the server writes it
+    BOOST_REQUIRE(std::all_of(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size),
+                              [&](char c) { return c == buffer[0]; }));
+  }
+  writer.join();
+}
+
+BOOST_AUTO_TEST_CASE(TestGUISharedMemoryInterruptedWrite)
+{
+  namespace bip = boost::interprocess;
+  auto server = GUISharedMemory::create("mc_rtc_test_gui_shm", 1024);
+  auto client = GUISharedMemory::open("mc_rtc_test_gui_shm");
+  server->write("a", 1);
+  // Simulate a server that died while writing: the sequence number (at the start of the second cache line of the
+  // segment) stays odd
+  bip::shared_memory_object shm(bip::open_only, "mc_rtc_test_gui_shm", bip::read_write);
+  bip::mapped_region region(shm, bip::read_write);
+  auto & state_seq = *reinterpret_cast<std::atomic<uint64_t> *>(static_cast<char *>(region.get_address()) + 64);
+  state_seq.fetch_add(1);
+  std::vector<char> buffer;
+  uint64_t seq = 0;
+  auto start = std::chrono::steady_clock::now();
+  BOOST_REQUIRE(client->read(buffer, seq) == 0);
+  BOOST_REQUIRE(seq == 0);
+  BOOST_REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(TestGUISharedMemoryRequests)
+{
+  auto server = GUISharedMemory::create("mc_rtc_test_gui_shm", 1024);
+  auto client = GUISharedMemory::open("mc_rtc_test_gui_shm");
+  std::vector<char> buffer;
+  BOOST_REQUIRE(!server->pop_request(buffer));
+  // The queue is bounded
+  for(size_t i = 0; i < GUISharedMemory::request_slots; ++i)
+  {
+    auto request = std::to_string(i);
+    BOOST_REQUIRE(client->push_request(request.c_str(), request.size() + 1));
+  }
+  BOOST_REQUIRE(!client->push_request("full", 5));
+  for(size_t i = 0; i < GUISharedMemory::request_slots; ++i)
+  {
+    BOOST_REQUIRE(server->pop_request(buffer));
+    BOOST_REQUIRE(std::to_string(i) == buffer.data());
+  }
+  BOOST_REQUIRE(!server->pop_request(buffer));
+  std::vector<char> large(GUISharedMemory::request_capacity + 1);
+  BOOST_REQUIRE(!client->push_request(large.data(), large.size()));
+  // Requests from several clients are all received in the order of each client
+  auto client2 = GUISharedMemory::open("mc_rtc_test_gui_shm");
+  auto push = [](GUISharedMemory & shm, char id)
+  {
+    for(size_t i = 0; i < 1000;)
+    {
+      std::string request = id + std::to_string(i);
+      if(shm.push_request(request.c_str(), request.size() + 1)) { ++i; }
+    }
+  };
+  std::thread t1(push, std::ref(*client), 'a');
+  std::thread t2(push, std::ref(*client2), 'b');
+  size_t next_a = 0;
+  size_t next_b = 0;
+  while(next_a + next_b < 2000)
+  {
+    if(!server->pop_request(buffer)) { continue; }
+    auto & next = buffer[0] == 'a' ? next_a : next_b;
+    BOOST_REQUIRE(std::to_string(next++) == buffer.data() + 1);
+  }
+  t1.join();
+  t2.join();
+}
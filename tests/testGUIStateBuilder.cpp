@@ -3,6 +3,7 @@
  */
 
 #include <mc_rtc/gui/ArrayLabel.h>
+#include <mc_rtc/gui/Button.h>
 #include <mc_rtc/gui/Label.h>
 #include <mc_rtc/gui/StateBuilder.h>
 
@@ -111,3 +112,166 @@ BOOST_AUTO_TEST_CASE(TestGUIStateBuilder)
     BOOST_REQUIRE(s == empty_size);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestGUIStateBuilderIds)
+{
+  mc_rtc::gui::StateBuilder builder;
+  int source_a = 0;
+  int source_b = 0;
+  size_t clicks = 0;
+  builder.addElement(&source_a, {"a"}, mc_rtc::gui::Button("button", [&clicks]() { clicks++; }));
+  builder.addElement(&source_b, {"a", "b"}, mc_rtc::gui::Button("button", [&clicks]() { clicks += 10; }));
+  builder.addElement(&source_a, {"a", "b", "c"}, mc_rtc::gui::Button("button", [&clicks]() { clicks += 100; }));
+  BOOST_REQUIRE(builder.size() == 3);
+  auto id_a = builder.elementId({"a"}, "button");
+  auto id_b = builder.elementId({"a", "b"}, "button");
+  auto id_c = builder.elementId({"a", "b", "c"}, "button");
+  BOOST_REQUIRE(id_a != 0 && id_b != 0 && id_c != 0);
+  BOOST_REQUIRE(id_a != id_b && id_b != id_c && id_a != id_c);
+  BOOST_REQUIRE(builder.elementId({"a"}, "none") == 0);
+  BOOST_REQUIRE(builder.elementId({"none"}, "button") == 0);
+  // Requests by id and by name reach the same element
+  BOOST_REQUIRE(builder.handleRequest(id_b, {}));
+  BOOST_REQUIRE(clicks == 10);
+  BOOST_REQUIRE(builder.handleRequest({"a", "b"}, "button", {}));
+  BOOST_REQUIRE(clicks == 20);
+  // Ids are sent after the plots in the order the elements are written
+  {
+    std::vector<char> buffer;
+    auto s = builder.update(buffer);
+    auto state = mc_rtc::Configuration::fromMessagePack(buffer.data(), s);
+    BOOST_REQUIRE(state.size() == 5);
+    std::vector<uint64_t> ids = state[4];
+    BOOST_REQUIRE(ids == std::vector<uint64_t>({id_a, id_b, id_c}));
+  }
+  // Removing a source in a category does not touch the other sources
+  builder.removeElements({"a"}, &source_a, true);
+  BOOST_REQUIRE(builder.size() == 1);
+  BOOST_REQUIRE(!builder.hasElement({"a"}, "button"));
+  BOOST_REQUIRE(builder.hasElement({"a", "b"}, "button"));
+  BOOST_REQUIRE(!builder.handleRequest(id_a, {}));
+  BOOST_REQUIRE(!builder.handleRequest(id_c, {}));
+  BOOST_REQUIRE(builder.elementId({"a", "b"}, "button") == id_b);
+  // Ids are not re-used
+  builder.addElement(&source_a, {"a"}, mc_rtc::gui::Button("button", [&clicks]() { clicks++; }));
+  auto id_a2 = builder.elementId({"a"}, "button");
+  BOOST_REQUIRE(id_a2 != id_a && id_a2 != id_b && id_a2 != id_c);
+  // Removing a category removes its elements from the indexes
+  builder.removeCategory({"a", "b"});
+  BOOST_REQUIRE(builder.size() == 1);
+  BOOST_REQUIRE(!builder.handleRequest(id_b, {}));
+  builder.removeElements(&source_b);
+  BOOST_REQUIRE(builder.size() == 1);
+  builder.removeElements(&source_a);
+  BOOST_REQUIRE(builder.size() == 0);
+  std::vector<char> buffer;
+  mc_rtc::gui::StateBuilder empty;
+  std::vector<char> empty_buffer;
+  BOOST_REQUIRE(builder.update(buffer) == empty.update(empty_buffer));
+}
+
+BOOST_AUTO_TEST_CASE(TestGUIStateBuilderSubscriptions)
+{
+  mc_rtc::gui::StateBuilder builder;
+  size_t calls_a = 0;
+  size_t calls_b = 0;
+  builder.addElement({"a"}, mc_rtc::gui::Label("label",
+                                               [&calls_a]()
+                                               {
+                                                 calls_a++;
+                                                 return 0.0;
+                                               }));
+  builder.addElement({"b", "c"}, mc_rtc::gui::Label("label",
+                                                    [&calls_b]()
+                                                    {
+                                                      calls_b++;
+                                                      return 0.0;
+                                                    }));
+  std::vector<char> buffer;
+  auto elements = [&]()
+  {
+    auto s = builder.update(buffer);
+    return mc_rtc::Configuration::fromMessagePack(buffer.data(), s)[4].size();
+  };
+  // Everything is serialized by default
+  BOOST_REQUIRE(elements() == 2);
+  BOOST_REQUIRE(calls_a == 1 && calls_b == 1);
+  // Sub-categories of a subscribed category are serialized
+  builder.subscriptions({{"b"}});
+  BOOST_REQUIRE(elements() == 1);
+  BOOST_REQUIRE(calls_a == 1 && calls_b == 2);
+  {
+    // Unsubscribed categories are still sent without their elements
+    auto s = builder.update(buffer);
+    auto root = mc_rtc::Configuration::fromMessagePack(buffer.data(), s)[2];
+    auto subs = root[root.size() - 1];
+    BOOST_REQUIRE(subs.size() == 2);
+    BOOST_REQUIRE(subs[0][0].operator std::string() == "a");
+    BOOST_REQUIRE(subs[0].size() == 2);
+    BOOST_REQUIRE(subs[1][0].operator std::string() == "b");
+  }
+  // Categories created after the subscription are subscribed
+  builder.subscriptions({{"b"}, {"d", "e"}});
+  builder.addElement({"d", "e"}, mc_rtc::gui::Label("label", []() { return 0.0; }));
+  builder.addElement({"d"}, mc_rtc::gui::Label("label", []() { return 0.0; }));
+  BOOST_REQUIRE(elements() == 2);
+  // No subscription, only the structure is sent
+  builder.subscriptions({});
+  BOOST_REQUIRE(elements() == 0);
+  BOOST_REQUIRE(calls_a == 1);
+  builder.clearSubscriptions();
+  BOOST_REQUIRE(elements() == 4);
+  BOOST_REQUIRE(calls_a == 2);
+}
+
+BOOST_AUTO_TEST_CASE(TestGUIStateBuilderUpdateRate)
+{
+  mc_rtc::gui::StateBuilder builder;
+  size_t calls_a = 0;
+  size_t calls_b = 0;
+  builder.addElement({"a"}, mc_rtc::gui::Label("label",
+                                               [&calls_a]()
+                                               {
+                                                 calls_a++;
+                                                 return 0.0;
+                                               }));
+  builder.addElement({"a", "b"}, mc_rtc::gui::Label("label",
+                                                    [&calls_b]()
+                                                    {
+                                                      calls_b++;
+                                                      return 0.0;
+                                                    }));
+  std::vector<char> buffer;
+  size_t size = builder.update(buffer);
+  BOOST_REQUIRE(calls_a == 1 && calls_b == 1);
+  // Throttled elements are only serialized once in a while but the message is unchanged
+  builder.updateRate({"a"}, "label", 1e-6);
+  for(size_t i = 0; i < 5; ++i) { BOOST_REQUIRE(builder.update(buffer) == size); }
+  BOOST_REQUIRE(calls_a == 2 && calls_b == 6);
+  // The category rate applies to sub-categories
+  builder.updateRate({"a"}, 1e-6);
+  for(size_t i = 0; i < 5; ++i) { BOOST_REQUIRE(builder.update(buffer) == size); }
+  BOOST_REQUIRE(calls_a == 2 && calls_b == 7);
+  // A request forces an update
+  BOOST_REQUIRE(!builder.handleRequest(builder.elementId({"a", "b"}, "label"), mc_rtc::Configuration{}));
+  builder.update(buffer);
+  builder.update(buffer);
+  BOOST_REQUIRE(calls_a == 2 && calls_b == 8);
+  // Remove the limits
+  builder.updateRate({"a"}, 0);
+  builder.updateRate({"a"}, "label", 0);
+  builder.update(buffer);
+  BOOST_REQUIRE(calls_a == 3 && calls_b == 9);
+  // Setting the rate of a category that does not exist does not create it but applies once it is created
+  builder.updateRate({"c"}, 1e-6);
+  BOOST_REQUIRE(builder.update(buffer) == size);
+  size_t calls_c = 0;
+  builder.addElement({"c"}, mc_rtc::gui::Label("label",
+                                               [&calls_c]()
+                                               {
+                                                 calls_c++;
+                                                 return 0.0;
+                                               }));
+  for(size_t i = 0; i < 5; ++i) { builder.update(buffer); }
+  BOOST_REQUIRE(calls_c == 1);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include "mc_bin_to_lod.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
+
+#include "utils.h"
+
+namespace
+{
+
+void write(std::ostream & os, uint64_t v)
+{
+  os.write((const char *)&v, sizeof(uint64_t));
+}
+
+void write(std::ostream & os, const std::string & s)
+{
+  write(os, s.size());
+  os.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+uint64_t read_u64(std::istream & is)
+{
+  uint64_t out = 0;
+  is.read((char *)&out, sizeof(uint64_t));
+  return out;
+}
+
+std::vector<double> read_doubles(std::istream & is, size_t n)
+{
+  std::vector<double> out(n);
+  is.read((char *)out.data(), static_cast<std::streamsize>(n * sizeof(double)));
+  return out;
+}
+
+/** (min, max, mean) of each level */
+using Levels = std::vector<std::array<std::vector<double>, 3>>;
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestLOD)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> t = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<double> x = {3, 1, 4, 1, 5, 9, 2, 6, 5, nan};
+  auto flat = getTmpFile(".flat");
+  {
+    std::ofstream ofs(flat, std::ofstream::binary);
+    write(ofs, 3);
+    for(const auto & [key, data] : std::map<std::string, std::vector<double>>{{"t", t}, {"x", x}})
+    {
+      ofs.put(1);
+      write(ofs, key);
+      write(ofs, data.size());
+      ofs.write((const char *)data.data(), static_cast<std::streamsize>(data.size() * sizeof(double)));
+    }
+    // String entries are not part of the LOD
+    ofs.put(0);
+    write(ofs, std::string("s"));
+    write(ofs, t.size());
+    for(size_t i = 0; i < t.size(); ++i) { write(ofs, std::string("abc")); }
+  }
+  auto lod = flat + ".lod";
+  BOOST_REQUIRE(mc_flat_to_lod(flat, lod, 2));
+
+  std::ifstream ifs(lod, std::ifstream::binary);
+  char magic[8];
+  ifs.read(magic, sizeof(magic));
+  BOOST_REQUIRE(std::string(magic, 6) == "MC_LOD");
+  BOOST_REQUIRE(read_u64(ifs) == 10);
+  // Buckets of 2, 4 and 8 samples, 16 would leave a single bucket
+  std::vector<uint64_t> factors(read_u64(ifs));
+  for(auto & f : factors) { f = read_u64(ifs); }
+  BOOST_REQUIRE(factors == std::vector<uint64_t>({2, 4, 8}));
+  BOOST_REQUIRE(read_u64(ifs) == 2);
+  std::map<std::string, Levels> levels;
+  for(size_t i = 0; i < 2; ++i)
+  {
+    std::string key(read_u64(ifs), 0);
+    ifs.read(&key[0], static_cast<std::streamsize>(key.size()));
+    for(auto f : factors)
+    {
+      auto n = (t.size() + f - 1) / f;
+      auto & level = levels[key].emplace_back();
+      for(auto & v : level) { v = read_doubles(ifs, n); }
+    }
+  }
+  BOOST_REQUIRE(ifs);
+  BOOST_REQUIRE(levels.size() == 2 && levels.count("x"));
+  // Buckets of 4 samples: {3, 1, 4, 1}, {5, 9, 2, 6}, {5, NaN}
+  const auto & [min, max, mean] = levels["x"][1];
+  BOOST_REQUIRE(min == std::vector<double>({1, 2, 5}));
+  BOOST_REQUIRE(max == std::vector<double>({4, 9, 5}));
+  BOOST_REQUIRE_CLOSE(mean[0], 2.25, 1e-9);
+  BOOST_REQUIRE_CLOSE(mean[1], 5.5, 1e-9);
+  BOOST_REQUIRE_CLOSE(mean[2], 5, 1e-9);
+  // The time entry is averaged like the others
+  BOOST_REQUIRE(levels["t"][2][0] == std::vector<double>({0, 8}));
+  BOOST_REQUIRE(levels["t"][2][1] == std::vector<double>({7, 9}));
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rtc/log/LogFollower.h>
+#include <mc_rtc/log/Logger.h>
+
+#include <boost/filesystem.hpp>
+namespace bfs = boost::filesystem;
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <thread>
+
+/** Checks the records received from a follower */
+struct Subscriber
+{
+  std::vector<std::string> keys;
+  std::vector<double> t;
+  std::vector<bool> has_late;
+
+  mc_rtc::log::iterate_binary_log_callback callback()
+  {
+    return [this](mc_rtc::log::IterateBinaryLogData data)
+    {
+      if(data.keys.size()) { keys = data.keys; }
+      BOOST_REQUIRE(data.records.size() == keys.size());
+      BOOST_REQUIRE(data.time.has_value());
+      t.push_back(*data.time);
+      has_late.push_back(std::find(keys.begin(), keys.end(), "late") != keys.end());
+      return true;
+    };
+  }
+
+  /** Check that the first n records have been received */
+  void check(size_t n, double dt)
+  {
+    BOOST_REQUIRE(t.size() == n);
+    for(size_t i = 0; i < n; ++i)
+    {
+      BOOST_REQUIRE(std::fabs(t[i] - static_cast<double>(i) * dt) < 1e-9);
+      BOOST_REQUIRE(has_late[i] == (i >= 25 && i < 75));
+    }
+  }
+};
+
+/** Log 100 iterations, "late" is added at the 25th iteration and removed at the 75th */
+template<typename Callback>
+void log_iterations(mc_rtc::Logger & logger, Callback && on_iteration)
+{
+  double value = 0;
+  logger.addLogEntry("value", &value, [&value]() { return value; });
+  for(size_t i = 0; i < 100; ++i)
+  {
+    if(i == 25) { logger.addLogEntry("late", &i, [&i]() { return static_cast<double>(i); }); }
+    if(i == 75) { logger.removeLogEntry("late"); }
+    logger.log();
+    logger.flush();
+    value += 1.0;
+    on_iteration(i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestLogFollowerPoll)
+{
+  double dt = 0.001;
+  auto path = (bfs::temp_directory_path() / bfs::unique_path("mc-rtc-test-follower-%%%%-%%%%.bin")).string();
+  mc_rtc::log::LogFollower follower(path);
+  Subscriber subscriber;
+  follower.subscribe(subscriber.callback());
+  // The log does not exist yet
+  BOOST_REQUIRE(follower.poll() == 0);
+  {
+    mc_rtc::Logger logger(mc_rtc::Logger::Policy::NON_THREADED, "", "");
+    logger.open(path, dt);
+    log_iterations(logger,
+                   [&](size_t i)
+                   {
+                     if(i % 10 == 0)
+                     {
+                       BOOST_REQUIRE(follower.poll() == 10 - (i == 0 ? 9 : 0));
+                       subscriber.check(i + 1, dt);
+                     }
+                   });
+  }
+  BOOST_REQUIRE(follower.poll() == 9);
+  BOOST_REQUIRE(follower.records() == 100);
+  subscriber.check(100, dt);
+  BOOST_REQUIRE(follower.poll() == 0);
+  bfs::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestLogFollowerPartialRecords)
+{
+  double dt = 0.001;
+  auto path = (bfs::temp_directory_path() / bfs::unique_path("mc-rtc-test-follower-%%%%-%%%%.bin")).string();
+  {
+    mc_rtc::Logger logger(mc_rtc::Logger::Policy::NON_THREADED, "", "");
+    logger.open(path, dt);
+    log_iterations(logger, [](size_t) {});
+  }
+  std::vector<char> data(bfs::file_size(path));
+  {
+    std::ifstream ifs(path, std::ifstream::binary);
+    ifs.read(data.data(), static_cast<std::streamsize>(data.size()));
+  }
+  // Write the log a few bytes at a time, the follower only reads complete records
+  auto partial = path + ".partial.bin";
+  mc_rtc::log::LogFollower follower(partial);
+  Subscriber subscriber;
+  follower.subscribe(subscriber.callback());
+  {
+    std::ofstream ofs(partial, std::ofstream::binary);
+    for(size_t i = 0; i < data.size(); i += 7)
+    {
+      ofs.write(data.data() + i, static_cast<std::streamsize>(std::min<size_t>(7, data.size() - i)));
+      ofs.flush();
+      follower.poll();
+    }
+  }
+  subscriber.check(100, dt);
+  BOOST_REQUIRE(follower.valid());
+  bfs::remove(path);
+  bfs::remove(partial);
+}
+
+BOOST_AUTO_TEST_CASE(TestLogFollowerSegments)
+{
+  double dt = 0.001;
+  auto path = (bfs::temp_directory_path() / bfs::unique_path("mc-rtc-test-follower-%%%%-%%%%.bin")).string();
+  auto manifest = bfs::path(path).replace_extension(".manifest").string();
+  mc_rtc::log::LogFollower follower(manifest);
+  Subscriber subscriber;
+  follower.subscribe(subscriber.callback());
+  {
+    mc_rtc::Logger logger(mc_rtc::Logger::Policy::NON_THREADED, "", "");
+    mc_rtc::Logger::Segmentation segmentation;
+    segmentation.max_duration = 0.02;
+    logger.segmentation(segmentation);
+    logger.open(path, dt);
+    BOOST_REQUIRE(logger.manifest() == manifest);
+    log_iterations(logger,
+                   [&](size_t i)
+                   {
+                     if(i % 3 == 0) { follower.poll(); }
+                   });
+  }
+  follower.poll();
+  // Keys are reported again at the start of every segment and "late" is still there
+  subscriber.check(100, dt);
+  mc_rtc::Configuration segments = mc_rtc::Configuration(manifest)("segments");
+  BOOST_REQUIRE(segments.size() == 5);
+  BOOST_REQUIRE(bfs::path(follower.file()).filename().string() == segments[4]("file").operator std::string());
+  for(size_t i = 0; i < segments.size(); ++i)
+  {
+    bfs::remove(bfs::path(manifest).parent_path() / segments[i]("file").operator std::string());
+  }
+  bfs::remove(manifest);
+}
+
+BOOST_AUTO_TEST_CASE(TestLogFollowerThread)
+{
+  double dt = 0.001;
+  auto path = (bfs::temp_directory_path() / bfs::unique_path("mc-rtc-test-follower-%%%%-%%%%.bin")).string();
+  mc_rtc::log::LogFollower follower(path);
+  Subscriber subscriber;
+  follower.subscribe(subscriber.callback());
+  follower.start(std::chrono::milliseconds(1));
+  {
+    mc_rtc::Logger logger(mc_rtc::Logger::Policy::THREADED, "", "");
+    logger.open(path, dt);
+    log_iterations(logger, [](size_t) { std::this_thread::sleep_for(std::chrono::microseconds(100)); });
+  }
+  for(size_t i = 0; i < 1000 && follower.records() != 100; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  follower.stop();
+  subscriber.check(100, dt);
+  bfs::remove(path);
+}
@@ -585,3 +585,113 @@ BOOST_AUTO_TEST_CASE(TestResume)
   bfs::remove(path_1);
   bfs::remove(path_2);
 }
+
+BOOST_AUTO_TEST_CASE(TestSegmentation)
+{
+  using Policy = mc_rtc::Logger::Policy;
+  double dt = 0.001;
+  for(auto policy : {Policy::NON_THREADED, Policy::THREADED})
+  {
+    for(bool by_size : {false, true})
+    {
+      std::string manifest;
+      {
+        mc_rtc::Logger logger(policy, bfs::temp_directory_path().string(), "mc-rtc-test");
+        mc_rtc::Logger::Segmentation segmentation;
+        if(by_size) { segmentation.max_size = 4096; }
+        else { segmentation.max_duration = 0.25; }
+        logger.segmentation(segmentation);
+        logger.start("segmentation", dt);
+        manifest = logger.manifest();
+        BOOST_REQUIRE(manifest.size());
+        double value = 0;
+        logger.addLogEntry("value", &value, [&value]() { return value; });
+        for(size_t i = 0; i < 1000; ++i)
+        {
+          // Keys added and removed in the middle of a segment are carried to the next segments
+          if(i == 400) { logger.addLogEntry("late", &i, [&i]() { return static_cast<double>(i); }); }
+          if(i == 800) { logger.removeLogEntry("value"); }
+          logger.log();
+          value += 1.0;
+        }
+      }
+      auto latest = bfs::temp_directory_path() / "mc-rtc-test-segmentation-latest";
+      for(const auto & ext : {".bin", ".manifest"})
+      {
+        if(bfs::exists(latest.string() + ext)) { bfs::remove(latest.string() + ext); }
+      }
+      mc_rtc::Configuration segments = mc_rtc::Configuration(manifest)("segments");
+      if(by_size) { BOOST_REQUIRE(segments.size() > 2); }
+      else { BOOST_REQUIRE(segments.size() == 4); }
+      // Each segment is a valid log on its own
+      size_t total = 0;
+      for(size_t i = 0; i < segments.size(); ++i)
+      {
+        auto path = bfs::path(manifest).parent_path() / segments[i]("file").operator std::string();
+        mc_rtc::log::FlatLog segment(path.string());
+        BOOST_REQUIRE(segment.size() > 0);
+        BOOST_REQUIRE(segment.has("t"));
+        BOOST_REQUIRE(std::fabs(segment.get<double>("t", 0, -1.0) - static_cast<double>(segments[i]("start"))) < 1e-9);
+        total += segment.size();
+      }
+      BOOST_REQUIRE(total == 1000);
+      // The manifest is read as a single log
+      mc_rtc::log::FlatLog log(manifest);
+      for(size_t i = 0; i < segments.size(); ++i)
+      {
+        bfs::remove(bfs::path(manifest).parent_path() / segments[i]("file").operator std::string());
+      }
+      bfs::remove(manifest);
+      BOOST_REQUIRE(log.size() == 1000);
+      for(size_t i = 0; i < log.size(); ++i)
+      {
+        BOOST_REQUIRE(std::fabs(log.get<double>("t", i, -1.0) - static_cast<double>(i) * dt) < 1e-9);
+        if(i < 800) { BOOST_REQUIRE(log.get<double>("value", i, -1.0) == static_cast<double>(i)); }
+        else { BOOST_REQUIRE(log.getRaw<double>("value", i) == nullptr); }
+        if(i < 400) { BOOST_REQUIRE(log.getRaw<double>("late", i) == nullptr); }
+        else { BOOST_REQUIRE(log.get<double>("late", i, -1.0) == static_cast<double>(i)); }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelDecoding)
+{
+  double dt = 0.001;
+  std::string path;
+  {
+    mc_rtc::Logger logger(mc_rtc::Logger::Policy::NON_THREADED, bfs::temp_directory_path().string(), "mc-rtc-test");
+    logger.start("parallel", dt);
+    path = logger.path();
+    double value = 0;
+    Eigen::Vector3d vec = Eigen::Vector3d::Zero();
+    logger.addLogEntry("value", &value, [&value]() { return value; });
+    logger.addLogEntry("vec", &vec, [&vec]() -> const Eigen::Vector3d & { return vec; });
+    for(size_t i = 0; i < 1000; ++i)
+    {
+      if(i == 400) { logger.addLogEntry("late", &i, [&i]() { return static_cast<double>(i); }); }
+      if(i == 800) { logger.removeLogEntry("value"); }
+      logger.log();
+      value += 1.0;
+      vec.x() += 2.0;
+    }
+  }
+  auto latest = bfs::temp_directory_path() / "mc-rtc-test-parallel-latest.bin";
+  if(bfs::exists(latest)) { bfs::remove(latest); }
+  mc_rtc::log::FlatLog serial(path);
+  for(size_t jobs : {2u, 3u, 8u})
+  {
+    // Ranges start in the middle of the log and must pick up the keys that were added before
+    mc_rtc::log::FlatLog parallel(path, jobs);
+    BOOST_REQUIRE(parallel.size() == serial.size());
+    BOOST_REQUIRE(parallel.entries() == serial.entries());
+    for(size_t i = 0; i < parallel.size(); ++i)
+    {
+      BOOST_REQUIRE(parallel.get<double>("t", i, -1.0) == serial.get<double>("t", i, -2.0));
+      BOOST_REQUIRE(parallel.get<double>("value", i, -1.0) == serial.get<double>("value", i, -1.0));
+      BOOST_REQUIRE(parallel.get<double>("late", i, -1.0) == serial.get<double>("late", i, -1.0));
+      BOOST_REQUIRE(parallel.getRaw<Eigen::Vector3d>("vec", i)->isApprox(*serial.getRaw<Eigen::Vector3d>("vec", i)));
+    }
+  }
+  bfs::remove(path);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+
+#include <mc_solver/KinematicsConstraint.h>
+#include <mc_solver/TVMQPSolver.h>
+#include <mc_solver/TasksQPSolver.h>
+
+#include <mc_tasks/BSplineTrajectoryTask.h>
+#include <mc_tasks/PostureTask.h>
+
+#include <mc_rtc/WorkerPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+
+#include "utils.h"
+
+BOOST_AUTO_TEST_CASE(TestWorkerPool)
+{
+  for(size_t threads : {0, 1, 3})
+  {
+    mc_rtc::WorkerPool pool(threads);
+    BOOST_REQUIRE(pool.size() == threads);
+    std::vector<size_t> calls(100, 0);
+    for(size_t i = 0; i < 10; ++i)
+    {
+      pool.run(calls.size(), [&](size_t idx) { calls[idx]++; });
+    }
+    for(auto c : calls) { BOOST_REQUIRE(c == 10); }
+    // Every job runs and the exception of the lowest failing job is reported
+    std::fill(calls.begin(), calls.end(), 0);
+    try
+    {
+      pool.run(calls.size(),
+               [&](size_t idx)
+               {
+                 calls[idx]++;
+                 if(idx % 10 == 7) { throw std::runtime_error(std::to_string(idx)); }
+               });
+      BOOST_FAIL("The exception was not forwarded");
+    }
+    catch(const std::runtime_error & e)
+    {
+      BOOST_REQUIRE(std::string(e.what()) == "7");
+    }
+    for(auto c : calls) { BOOST_REQUIRE(c == 1); }
+  }
+}
+
+/** Count the calls to update and declare the update as thread-safe */
+struct ThreadSafePostureTask : public mc_tasks::PostureTask
+{
+  using mc_tasks::PostureTask::PostureTask;
+
+  bool threadSafeUpdate() const noexcept override { return true; }
+
+  void update(mc_solver::QPSolver & solver) override
+  {
+    updates++;
+    mc_tasks::PostureTask::update(solver);
+  }
+
+  size_t updates = 0;
+};
+
+template<typename SolverT>
+std::vector<std::vector<double>> runSolver(size_t threads)
+{
+  [[maybe_unused]] bool configured = configureRobotLoader();
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  SolverT solver(mc_rbdyn::loadRobot(*rm), 0.005);
+  solver.parallelUpdate(threads);
+  BOOST_REQUIRE(solver.parallelUpdate() == threads);
+  mc_solver::KinematicsConstraint kinematics(solver.robots(), 0, solver.dt());
+  solver.addConstraintSet(kinematics);
+  auto posture = std::make_shared<ThreadSafePostureTask>(solver, 0);
+  solver.addTask(posture);
+  std::vector<std::shared_ptr<mc_tasks::BSplineTrajectoryTask>> splines;
+  for(const auto & surface : {"LeftFoot", "RightFoot"})
+  {
+    const auto & frame = solver.robot().frame(surface);
+    auto target = sva::PTransformd(Eigen::Vector3d{0.1, 0.0, 0.1}) * frame.position();
+    splines.push_back(std::make_shared<mc_tasks::BSplineTrajectoryTask>(frame, 0.5, 10.0, 1000.0, target));
+    solver.addTask(splines.back());
+  }
+  for(size_t i = 0; i < 110; ++i) { BOOST_REQUIRE(solver.run()); }
+  BOOST_REQUIRE(posture->updates == 110);
+  for(const auto & s : splines) { BOOST_REQUIRE(s->timeElapsed()); }
+  return solver.robot().mbc().q;
+}
+
+template<typename SolverT>
+void testParallelUpdate()
+{
+  auto serial = runSolver<SolverT>(0);
+  for(size_t threads : {1, 2})
+  {
+    // The parallel update produces the same results as the serial update
+    BOOST_REQUIRE(runSolver<SolverT>(threads) == serial);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelTaskUpdate)
+{
+  testParallelUpdate<mc_solver::TasksQPSolver>();
+  testParallelUpdate<mc_solver::TVMQPSolver>();
+}
+
+/** A posture task that is updated in the calling thread and checks the progress of the other tasks */
+struct SerialPostureTask : public mc_tasks::PostureTask
+{
+  using mc_tasks::PostureTask::PostureTask;
+
+  void update(mc_solver::QPSolver & solver) override
+  {
+    updates++;
+    check();
+    mc_tasks::PostureTask::update(solver);
+  }
+
+  std::function<void()> check;
+  size_t updates = 0;
+};
+
+template<typename SolverT>
+void testParallelUpdateOrder()
+{
+  [[maybe_unused]] bool configured = configureRobotLoader();
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  SolverT solver(mc_rbdyn::loadRobot(*rm), 0.005);
+  solver.parallelUpdate(2);
+  mc_solver::KinematicsConstraint kinematics(solver.robots(), 0, solver.dt());
+  solver.addConstraintSet(kinematics);
+  // Two thread-safe tasks, a serial task then two thread-safe tasks
+  auto makeTask = [&]()
+  {
+    auto t = std::make_shared<ThreadSafePostureTask>(solver, 0);
+    solver.addTask(t);
+    return t;
+  };
+  auto before = std::vector{makeTask(), makeTask()};
+  auto serial = std::make_shared<SerialPostureTask>(solver, 0);
+  solver.addTask(serial);
+  auto after = std::vector{makeTask(), makeTask()};
+  serial->check = [&]()
+  {
+    for(const auto & t : before) { BOOST_REQUIRE(t->updates == serial->updates); }
+    for(const auto & t : after) { BOOST_REQUIRE(t->updates == serial->updates - 1); }
+  };
+  for(size_t i = 0; i < 10; ++i) { BOOST_REQUIRE(solver.run()); }
+  BOOST_REQUIRE(serial->updates == 10);
+  for(const auto & t : after) { BOOST_REQUIRE(t->updates == 10); }
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelTaskUpdateOrder)
+{
+  testParallelUpdateOrder<mc_solver::TasksQPSolver>();
+  testParallelUpdateOrder<mc_solver::TVMQPSolver>();
+}
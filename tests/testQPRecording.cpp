@@ -0,0 +1,166 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+
+#include <mc_solver/KinematicsConstraint.h>
+#include <mc_solver/QPProblem.h>
+#include <mc_solver/TVMQPSolver.h>
+#include <mc_solver/TasksQPSolver.h>
+
+#include <mc_tasks/PostureTask.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <vector>
+
+#include "utils.h"
+
+BOOST_AUTO_TEST_CASE(TestQPProblemIO)
+{
+  mc_solver::QPProblem in;
+  in.resize(5, 2, 3);
+  in.tick = 42;
+  in.solveTime = 1.5;
+  in.Q.setRandom();
+  in.c.setRandom();
+  in.Aeq.setRandom();
+  in.beq.setRandom();
+  in.Aineq.setRandom();
+  in.uineq.setRandom();
+  in.xl(2) = -1.0;
+  auto path = getTmpFile(".qp");
+  {
+    mc_solver::QPProblemWriter writer(path);
+    writer.write(in);
+    in.tick++;
+    writer.write(in);
+    BOOST_REQUIRE(writer.size() == 2);
+  }
+  mc_solver::QPProblemReader reader(path);
+  mc_solver::QPProblem out;
+  for(uint64_t tick : {42, 43})
+  {
+    BOOST_REQUIRE(reader.next(out));
+    BOOST_REQUIRE(out.tick == tick);
+    BOOST_REQUIRE(out.solveTime == in.solveTime);
+    BOOST_REQUIRE(out.Q == in.Q);
+    BOOST_REQUIRE(out.c == in.c);
+    BOOST_REQUIRE(out.Aeq == in.Aeq);
+    BOOST_REQUIRE(out.beq == in.beq);
+    BOOST_REQUIRE(out.Aineq == in.Aineq);
+    BOOST_REQUIRE(out.lineq == in.lineq);
+    BOOST_REQUIRE(out.uineq == in.uineq);
+    BOOST_REQUIRE(out.xl == in.xl);
+    BOOST_REQUIRE(out.xu == in.xu);
+  }
+  BOOST_REQUIRE(!reader.next(out));
+  BOOST_REQUIRE_THROW(mc_solver::QPProblemReader{makeConfigFile("{}")}, std::runtime_error);
+  // Corrupt the number of variables of the first problem, it is stored after the header (8 bytes), the tick and the
+  // solve time
+  auto corrupt = [&](int64_t nVars)
+  {
+    std::fstream fs(path, std::ios::binary | std::ios::in | std::ios::out);
+    fs.seekp(24);
+    fs.write(reinterpret_cast<const char *>(&nVars), sizeof(nVars));
+  };
+  for(int64_t nVars : {int64_t{-1}, int64_t{1} << 40, int64_t{1000}})
+  {
+    corrupt(nVars);
+    mc_solver::QPProblemReader corrupted(path);
+    BOOST_REQUIRE(!corrupted.next(out));
+  }
+}
+
+template<typename SolverT>
+std::vector<mc_solver::QPProblem> recordProblems(const mc_solver::QPRecordingOptions & options,
+                                                 size_t iters,
+                                                 bool recordNext = false)
+{
+  [[maybe_unused]] bool configured = configureRobotLoader();
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  SolverT solver(mc_rbdyn::loadRobot(*rm), 0.005);
+  mc_solver::KinematicsConstraint kinematics(solver.robots(), 0, solver.dt());
+  solver.addConstraintSet(kinematics);
+  auto posture = std::make_shared<mc_tasks::PostureTask>(solver, 0);
+  solver.addTask(posture);
+  auto path = getTmpFile(".qp");
+  solver.startRecording(path, options);
+  if(recordNext) { solver.recordNextProblem(); }
+  for(size_t i = 0; i < iters; ++i) { BOOST_REQUIRE(solver.run()); }
+  solver.stopRecording();
+  mc_solver::QPProblemReader reader(path);
+  std::vector<mc_solver::QPProblem> out;
+  mc_solver::QPProblem pb;
+  while(reader.next(pb)) { out.push_back(pb); }
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(TestQPRecording)
+{
+  mc_solver::QPRecordingOptions all;
+  all.all = true;
+  auto problems = recordProblems<mc_solver::TVMQPSolver>(all, 10);
+  BOOST_REQUIRE(problems.size() == 10);
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  auto nrDof = static_cast<Eigen::Index>(rm->mb.nrDof());
+  for(size_t i = 0; i < problems.size(); ++i)
+  {
+    const auto & pb = problems[i];
+    BOOST_REQUIRE(pb.tick == i);
+    // The only variable is the robot's acceleration
+    BOOST_REQUIRE(pb.nrVars() == nrDof);
+    BOOST_REQUIRE(pb.Q.rows() == nrDof && pb.Q.cols() == nrDof);
+    BOOST_REQUIRE(pb.Aeq.rows() == pb.nrEq() && pb.Aeq.cols() == nrDof);
+    BOOST_REQUIRE(pb.Aineq.rows() == pb.nrIneq() && pb.Aineq.cols() == nrDof);
+    // The posture task gives a symmetric objective that involves every joint
+    BOOST_REQUIRE(pb.Q.isApprox(pb.Q.transpose()));
+    BOOST_REQUIRE(pb.Q.diagonal().minCoeff() >= 0);
+    BOOST_REQUIRE(pb.Q.diagonal().maxCoeff() > 0);
+    BOOST_REQUIRE(pb.Q.allFinite() && pb.c.allFinite());
+    // Bounds and inequalities are consistent
+    BOOST_REQUIRE((pb.xl.array() <= pb.xu.array()).all());
+    BOOST_REQUIRE((pb.lineq.array() <= pb.uineq.array()).all());
+    BOOST_REQUIRE(pb.solveTime >= 0);
+  }
+  mc_solver::QPRecordingOptions ticks;
+  ticks.ticks = {2, 5, 100};
+  problems = recordProblems<mc_solver::TVMQPSolver>(ticks, 10);
+  BOOST_REQUIRE(problems.size() == 2);
+  BOOST_REQUIRE(problems[0].tick == 2);
+  BOOST_REQUIRE(problems[1].tick == 5);
+  problems = recordProblems<mc_solver::TVMQPSolver>({}, 10, true);
+  BOOST_REQUIRE(problems.size() == 1);
+  BOOST_REQUIRE(problems[0].tick == 0);
+  // The Tasks backend cannot extract its problem
+  BOOST_REQUIRE_THROW(recordProblems<mc_solver::TasksQPSolver>(all, 10), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(TestQPRecordingConfiguredTwice)
+{
+  [[maybe_unused]] bool configured = configureRobotLoader();
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  mc_rtc::Configuration config;
+  auto record = config.add("record");
+  auto path = getTmpFile(".qp");
+  record.add("path", path);
+  record.add("all", true);
+  // The configuration is applied at construction and may be applied again by the controller
+  mc_solver::TVMQPSolver solver(mc_rbdyn::loadRobot(*rm), 0.005, config);
+  mc_solver::KinematicsConstraint kinematics(solver.robots(), 0, solver.dt());
+  solver.addConstraintSet(kinematics);
+  auto posture = std::make_shared<mc_tasks::PostureTask>(solver, 0);
+  solver.addTask(posture);
+  for(size_t i = 0; i < 5; ++i) { BOOST_REQUIRE(solver.run()); }
+  solver.configure(config);
+  for(size_t i = 0; i < 5; ++i) { BOOST_REQUIRE(solver.run()); }
+  solver.stopRecording();
+  mc_solver::QPProblemReader reader(path);
+  mc_solver::QPProblem pb;
+  uint64_t tick = 0;
+  while(reader.next(pb)) { BOOST_REQUIRE(pb.tick == tick++); }
+  BOOST_REQUIRE(tick == 10);
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include "utils.h"
+
+#include <mc_rbdyn/Robots.h>
+#include <mc_rtc_ros/ros.h>
+
+#ifdef MC_RTC_ROS_IS_ROS2
+#  include <geometry_msgs/msg/wrench_stamped.hpp>
+#  include <sensor_msgs/msg/joint_state.hpp>
+
+#  include <rclcpp/rclcpp.hpp>
+#else
+#  include <geometry_msgs/WrenchStamped.h>
+#  include <sensor_msgs/JointState.h>
+
+#  include <ros/ros.h>
+
+#  include <csignal>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+static bool configured = configureRobotLoader();
+
+#ifdef MC_RTC_ROS_IS_ROS2
+
+using JointState = sensor_msgs::msg::JointState;
+using WrenchStamped = geometry_msgs::msg::WrenchStamped;
+
+/** Keep the test traffic on this host and away from other ROS 2 nodes */
+struct LocalROSCore
+{
+  LocalROSCore()
+  {
+    setenv("ROS_LOCALHOST_ONLY", "1", 1);
+    setenv("ROS_DOMAIN_ID", "97", 1);
+  }
+};
+
+#else
+
+using JointState = sensor_msgs::JointState;
+using WrenchStamped = geometry_msgs::WrenchStamped;
+
+/** Runs a private rosmaster for the duration of the test */
+struct LocalROSCore
+{
+  LocalROSCore()
+  {
+    setenv("ROS_MASTER_URI", "http://localhost:11597", 1);
+    pid = fork();
+    if(pid == 0)
+    {
+      execlp("rosmaster", "rosmaster", "--core", "-p", "11597", static_cast<char *>(nullptr));
+      std::_Exit(1);
+    }
+    int argc = 0;
+    ros::init(argc, nullptr, "mc_rtc", ros::init_options::NoSigintHandler);
+    for(size_t i = 0; i < 100 && !ros::master::check(); ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+
+  ~LocalROSCore()
+  {
+    if(pid > 0)
+    {
+      kill(pid, SIGTERM);
+      waitpid(pid, nullptr, 0);
+    }
+  }
+
+  pid_t pid = -1;
+};
+
+#endif
+
+BOOST_AUTO_TEST_CASE(TestROSRobotPublisher)
+{
+  static LocalROSCore core;
+  auto nh = mc_rtc::ROSBridge::get_node_handle();
+  BOOST_REQUIRE(nh);
+
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  auto robots = mc_rbdyn::loadRobot(*rm);
+  auto & robot = robots->robot();
+  const auto & jName = robot.refJointOrder()[0];
+  auto jIdx = static_cast<size_t>(robot.jointIndexByName(jName));
+  size_t nJoints = 0;
+  for(const auto & j : robot.mb().joints()) { nJoints += j.dof() == 1 ? 1 : 0; }
+  auto & fs = robot.data()->forceSensors[robot.data()->forceSensorsIndex.at("RightFootForceSensor")];
+
+  std::vector<JointState> states;
+  std::vector<WrenchStamped> wrenches;
+#ifdef MC_RTC_ROS_IS_ROS2
+  auto stateSub = nh->create_subscription<JointState>("test/joint_states", 100, [&](JointState::ConstSharedPtr msg)
+                                                      { states.push_back(*msg); });
+  auto wrenchSub = nh->create_subscription<WrenchStamped>("test/force/RightFootForceSensor", 100,
+                                                          [&](WrenchStamped::ConstSharedPtr msg)
+                                                          { wrenches.push_back(*msg); });
+  auto spin = [&]() { rclcpp::spin_some(nh); };
+#else
+  auto stateSub = nh->subscribe<JointState>("test/joint_states", 100, [&](const JointState::ConstPtr & msg)
+                                            { states.push_back(*msg); });
+  auto wrenchSub = nh->subscribe<WrenchStamped>("test/force/RightFootForceSensor", 100,
+                                                [&](const WrenchStamped::ConstPtr & msg) { wrenches.push_back(*msg); });
+  auto spin = []() { ros::spinOnce(); };
+#endif
+
+  constexpr double dt = 0.005;
+  mc_rtc::ROSBridge::init_robot_publisher("test", dt, robot);
+  for(size_t i = 0; i < 600; ++i)
+  {
+    robot.mbc().q[jIdx][0] = 1e-3 * static_cast<double>(i);
+    fs.wrench(sva::ForceVecd(Eigen::Vector3d::Zero(), Eigen::Vector3d{0, 0, static_cast<double>(i)}));
+    mc_rtc::ROSBridge::update_robot_publisher("test", dt, robot);
+    std::this_thread::sleep_for(std::chrono::duration<double>(dt));
+    spin();
+  }
+  for(size_t i = 0; i < 20; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    spin();
+  }
+  mc_rtc::ROSBridge::stop_robot_publisher("test");
+
+  BOOST_REQUIRE(states.size() > 10);
+  double prev = -1;
+  for(const auto & msg : states)
+  {
+    BOOST_REQUIRE(msg.name.size() == nJoints);
+    BOOST_REQUIRE(msg.position.size() == nJoints);
+    auto it = std::find(msg.name.begin(), msg.name.end(), jName);
+    BOOST_REQUIRE(it != msg.name.end());
+    double q = msg.position[static_cast<size_t>(std::distance(msg.name.begin(), it))];
+    // Every published value is one the control loop wrote, in order
+    BOOST_REQUIRE_SMALL(q * 1e3 - std::round(q * 1e3), 1e-6);
+    BOOST_REQUIRE(q > prev);
+    prev = q;
+  }
+  BOOST_REQUIRE(wrenches.size() > 10);
+  for(const auto & msg : wrenches)
+  {
+    BOOST_REQUIRE(msg.header.frame_id == "test/RightFootForceSensor");
+    BOOST_REQUIRE(msg.wrench.force.z == std::round(msg.wrench.force.z));
+    BOOST_REQUIRE(msg.wrench.torque.z == 0);
+  }
+}
@@ -5,6 +5,7 @@
 #include <mc_control/SimulationContactPair.h>
 #include <mc_rbdyn/RobotLoader.h>
 #include <mc_rbdyn/Robots.h>
+#include <mc_rbdyn/surface_hull.h>
 #include <mc_rtc/config.h>
 
 #include <boost/test/unit_test.hpp>
@@ -43,3 +44,26 @@ BOOST_AUTO_TEST_CASE(TestSimulationContactPair)
   robot.forwardKinematics();
   BOOST_REQUIRE(pair.update(robot, env) <= 0);
 }
+
+BOOST_AUTO_TEST_CASE(TestSimulationContactPairCachedHulls)
+{
+  auto & robots = get_robots();
+  auto & robot = robots.robot();
+  auto & env = robots.env();
+  robot.posW(sva::PTransformd::Identity());
+
+  // The second pair uses hulls generated by the first one
+  mc_control::SimulationContactPair pair1(robot.surfaces().at("LeftFoot"), env.surfaces().at("AllGround"));
+  mc_control::SimulationContactPair pair2(robot.surfaces().at("LeftFoot"), env.surfaces().at("AllGround"));
+  BOOST_REQUIRE_CLOSE(pair1.update(robot, env), pair2.update(robot, env), 1e-6);
+
+  // Pairs do not share their objects
+  robot.mbc().q[0].back() += 1.0;
+  robot.forwardKinematics();
+  BOOST_REQUIRE(pair1.update(robot, env) > 0.99);
+  BOOST_REQUIRE(pair2.update(robot, env) > 0.99);
+
+  mc_rbdyn::clear_sch_hull_cache();
+  mc_control::SimulationContactPair pair3(robot.surfaces().at("LeftFoot"), env.surfaces().at("AllGround"));
+  BOOST_REQUIRE_CLOSE(pair1.update(robot, env), pair3.update(robot, env), 1e-6);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+
+#include <mc_solver/ContactConstraint.h>
+#include <mc_solver/KinematicsConstraint.h>
+#include <mc_solver/TasksQPSolver.h>
+
+#include <mc_tasks/CoMTask.h>
+#include <mc_tasks/PostureTask.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "utils.h"
+
+/** This test verifies that changes made within a transaction give the same result as immediate changes */
+
+struct SolverSetup
+{
+  SolverSetup(const mc_rbdyn::RobotModule & rm, bool transaction) : solver(mc_rbdyn::loadRobot(rm), 0.005)
+  {
+    kinematics = std::make_unique<mc_solver::KinematicsConstraint>(solver.robots(), 0, solver.dt());
+    contact = std::make_unique<mc_solver::ContactConstraint>(solver.dt());
+    posture = std::make_shared<mc_tasks::PostureTask>(solver, 0);
+    com = std::make_shared<mc_tasks::CoMTask>(solver.robots(), 0);
+    com->com(com->com() + Eigen::Vector3d(0.0, 0.0, -0.05));
+    if(transaction) { solver.beginTransaction(); }
+    solver.addConstraintSet(*kinematics);
+    solver.addConstraintSet(*contact);
+    solver.addTask(posture);
+    solver.addTask(com);
+    solver.removeConstraintSet(*contact);
+    BOOST_REQUIRE(solver.inTransaction() == transaction);
+    if(transaction) { solver.commitTransaction(); }
+    BOOST_REQUIRE(!solver.inTransaction());
+  }
+
+  mc_solver::TasksQPSolver solver;
+  std::unique_ptr<mc_solver::KinematicsConstraint> kinematics;
+  std::unique_ptr<mc_solver::ContactConstraint> contact;
+  std::shared_ptr<mc_tasks::PostureTask> posture;
+  std::shared_ptr<mc_tasks::CoMTask> com;
+};
+
+BOOST_AUTO_TEST_CASE(TestSolverTransaction)
+{
+  configureRobotLoader();
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  SolverSetup immediate(*rm, false);
+  SolverSetup deferred(*rm, true);
+  for(size_t i = 0; i < 10; ++i)
+  {
+    BOOST_REQUIRE(immediate.solver.run());
+    BOOST_REQUIRE(deferred.solver.run());
+    const auto & q = immediate.solver.robot().mbc().q;
+    const auto & qDeferred = deferred.solver.robot().mbc().q;
+    for(size_t j = 0; j < q.size(); ++j)
+    {
+      for(size_t k = 0; k < q[j].size(); ++k) { BOOST_REQUIRE_CLOSE(q[j][k], qDeferred[j][k], 1e-6); }
+    }
+  }
+
+  // Nested transactions are committed by the outermost one, run applies pending changes
+  {
+    mc_solver::QPSolver::Transaction t1(deferred.solver);
+    {
+      mc_solver::QPSolver::Transaction t2(deferred.solver);
+      deferred.solver.removeTask(deferred.com);
+    }
+    BOOST_REQUIRE(deferred.solver.inTransaction());
+    BOOST_REQUIRE(deferred.solver.run());
+  }
+  BOOST_REQUIRE(!deferred.solver.inTransaction());
+  BOOST_REQUIRE_THROW(deferred.solver.commitTransaction(), std::runtime_error);
+
+  // Leaving the scope with an exception closes the transaction without applying it, the next run does
+  try
+  {
+    mc_solver::QPSolver::Transaction t(deferred.solver);
+    deferred.solver.addTask(deferred.com);
+    throw std::runtime_error("error while changing the problem");
+  }
+  catch(const std::runtime_error &)
+  {
+  }
+  BOOST_REQUIRE(!deferred.solver.inTransaction());
+  BOOST_REQUIRE(deferred.solver.run());
+}
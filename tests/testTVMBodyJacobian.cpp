@@ -0,0 +1,77 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+#include <mc_tvm/BodyJacobian.h>
+#include <mc_tvm/Robot.h>
+
+#include <RBDyn/Jacobian.h>
+
+#include <tvm/graph/CallGraph.h>
+#include <tvm/graph/internal/Inputs.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+#include "utils.h"
+
+static bool configured = configureRobotLoader();
+
+BOOST_AUTO_TEST_CASE(TestBodyJacobian)
+{
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  auto robots = mc_rbdyn::loadRobot(*rm);
+  auto & robot = robots->robot();
+  const auto & mb = robot.mb();
+  auto & mbc = robot.mbc();
+
+  // Arbitrary configuration and velocity, including the floating base
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> dist(-0.5, 0.5);
+  for(size_t i = 0; i < mbc.q.size(); ++i)
+  {
+    for(auto & qi : mbc.q[i]) { qi = dist(rng); }
+    for(auto & ai : mbc.alpha[i]) { ai = dist(rng); }
+  }
+  Eigen::Quaterniond ff(1.0, dist(rng), dist(rng), dist(rng));
+  ff.normalize();
+  mbc.q[0] = {ff.w(), ff.x(), ff.y(), ff.z(), dist(rng), dist(rng), dist(rng)};
+  robot.forwardKinematics();
+  robot.forwardVelocity();
+
+  // Update the jacobian of every body through the TVM graph
+  using Output = mc_tvm::BodyJacobian::Output;
+  auto & tvmRobot = robot.tvmRobot();
+  auto inputs = std::make_shared<tvm::graph::internal::Inputs>();
+  for(int i = 0; i < mb.nrBodies(); ++i)
+  {
+    // Non-owning pointer, the node belongs to tvmRobot
+    auto * node = &tvmRobot.bodyJacobian(static_cast<unsigned>(i));
+    std::shared_ptr<mc_tvm::BodyJacobian> jac(std::shared_ptr<void>{}, node);
+    inputs->addInput(jac, Output::Jacobian, Output::JDot);
+  }
+  tvm::graph::CallGraph graph;
+  graph.add(inputs);
+  graph.update();
+  graph.execute();
+
+  sva::PTransformd X_b_p(sva::RotX(0.3) * sva::RotZ(-0.7), Eigen::Vector3d(0.1, -0.2, 0.05));
+  for(int i = 0; i < mb.nrBodies(); ++i)
+  {
+    const auto & body = mb.body(i).name();
+    const auto & bodyJac = tvmRobot.bodyJacobian(static_cast<unsigned>(i));
+    rbd::Jacobian ref(mb, body);
+    BOOST_REQUIRE_EQUAL(bodyJac.dof(), ref.dof());
+    BOOST_REQUIRE_MESSAGE((bodyJac.jacobian() - ref.jacobian(mb, mbc)).norm() < 1e-10, "Jacobian mismatch for " << body);
+    BOOST_REQUIRE_MESSAGE((bodyJac.JDot() - ref.jacobianDot(mb, mbc)).norm() < 1e-10, "JDot mismatch for " << body);
+    // Jacobian of a frame attached to the body
+    sva::PTransformd X_0_p = X_b_p * mbc.bodyPosW[static_cast<size_t>(i)];
+    Eigen::MatrixXd jac(6, bodyJac.dof());
+    bodyJac.jacobian(X_0_p, jac);
+    BOOST_REQUIRE_MESSAGE((jac - ref.jacobian(mb, mbc, X_0_p)).norm() < 1e-10,
+                          "Frame jacobian mismatch for " << body);
+  }
+}
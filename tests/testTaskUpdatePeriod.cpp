@@ -0,0 +1,98 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_rbdyn/RobotLoader.h>
+#include <mc_rbdyn/Robots.h>
+
+#include <mc_solver/KinematicsConstraint.h>
+#include <mc_solver/TasksQPSolver.h>
+
+#include <mc_tasks/PostureTask.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "utils.h"
+
+/** Count the calls to update and interpolate */
+struct CountingPostureTask : public mc_tasks::PostureTask
+{
+  using mc_tasks::PostureTask::PostureTask;
+
+  void update(mc_solver::QPSolver & solver) override
+  {
+    updates++;
+    mc_tasks::PostureTask::update(solver);
+  }
+
+  void interpolate(mc_solver::QPSolver &, unsigned int iter) override
+  {
+    BOOST_REQUIRE(iter > 0 && iter < updatePeriod());
+    interpolations++;
+  }
+
+  size_t updates = 0;
+  size_t interpolations = 0;
+};
+
+BOOST_AUTO_TEST_CASE(TestTaskUpdatePeriod)
+{
+  [[maybe_unused]] bool configured = configureRobotLoader();
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  mc_solver::TasksQPSolver solver(mc_rbdyn::loadRobot(*rm), 0.005);
+  mc_solver::KinematicsConstraint kinematics(solver.robots(), 0, solver.dt());
+  solver.addConstraintSet(kinematics);
+  auto task = std::make_shared<CountingPostureTask>(solver, 0);
+  BOOST_REQUIRE(task->updatePeriod() == 1);
+
+  mc_rtc::Configuration config;
+  config.add("updateRate", 40.0);
+  task->load(solver, config);
+  BOOST_REQUIRE(task->updatePeriod() == 5);
+
+  solver.addTask(task);
+  for(size_t i = 0; i < 12; ++i) { BOOST_REQUIRE(solver.run()); }
+  // Updated at iterations 0, 5 and 10
+  BOOST_REQUIRE(task->updates == 3);
+  BOOST_REQUIRE(task->interpolations == 9);
+
+  // Changing the period triggers an update on the next iteration
+  task->updatePeriod(0);
+  BOOST_REQUIRE(task->updatePeriod() == 1);
+  BOOST_REQUIRE(solver.run());
+  BOOST_REQUIRE(task->updates == 4);
+  BOOST_REQUIRE(task->interpolations == 9);
+}
+
+BOOST_AUTO_TEST_CASE(TestTaskUpdatePeriodLogging)
+{
+  [[maybe_unused]] bool configured = configureRobotLoader();
+  auto rm = mc_rbdyn::RobotLoader::get_robot_module("JVRC1");
+  mc_solver::TasksQPSolver solver(mc_rbdyn::loadRobot(*rm), 0.005);
+  auto logger = std::make_shared<mc_rtc::Logger>(mc_rtc::Logger::Policy::NON_THREADED, ".", "");
+  solver.logger(logger);
+  auto task = std::make_shared<CountingPostureTask>(solver, 0);
+  auto entries = logger->size();
+  solver.addTask(task);
+  auto taskEntries = logger->size();
+  BOOST_REQUIRE(taskEntries > entries);
+
+  // The update rate and cost are logged while the period is greater than 1
+  task->updatePeriod(5);
+  BOOST_REQUIRE(logger->size() == taskEntries + 2);
+  task->updatePeriod(3);
+  BOOST_REQUIRE(logger->size() == taskEntries + 2);
+  task->updatePeriod(1);
+  BOOST_REQUIRE(logger->size() == taskEntries);
+
+  task->updatePeriod(4);
+  solver.removeTask(task);
+  BOOST_REQUIRE(logger->size() == entries);
+
+  // Added with a period greater than 1 then back to 1
+  solver.addTask(task);
+  BOOST_REQUIRE(logger->size() == taskEntries + 2);
+  task->updatePeriod(1);
+  solver.removeTask(task);
+  BOOST_REQUIRE(logger->size() == entries);
+}
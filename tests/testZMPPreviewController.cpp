@@ -0,0 +1,93 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_planning/ZMPPreviewController.h>
+
+#include <boost/test/unit_test.hpp>
+
+static constexpr double dt = 0.005;
+static constexpr double height = 0.8;
+static constexpr double horizon = 1.6;
+
+BOOST_AUTO_TEST_CASE(TestZMPPreviewGainsCache)
+{
+  auto gains = mc_planning::ZMPPreviewGains::get(dt, height, 320);
+  BOOST_REQUIRE(gains == mc_planning::ZMPPreviewGains::get(dt, height, 320));
+  BOOST_REQUIRE(gains != mc_planning::ZMPPreviewGains::get(dt, height, 200));
+  mc_planning::ZMPPreviewController a(dt, height, horizon);
+  mc_planning::ZMPPreviewController b(dt, height, horizon);
+  BOOST_REQUIRE(&a.gains() == &b.gains());
+  BOOST_REQUIRE(a.horizon() == 320);
+  // 1.12 / 0.005 is slightly above 224 in floating-point arithmetic
+  BOOST_REQUIRE(mc_planning::ZMPPreviewController(dt, height, 1.12).horizon() == 224);
+  // Constant references are tracked without steady-state error
+  BOOST_REQUIRE_CLOSE(gains->FTail(0), gains->K(0), 1e-6);
+  BOOST_CHECK_THROW(mc_planning::ZMPPreviewGains(dt, -height, 320, 1.0, 1e-6), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(TestZMPPreviewControllerBuffer)
+{
+  mc_planning::ZMPPreviewController preview(dt, height, horizon, 100);
+  preview.reset({0, 0, height});
+  BOOST_REQUIRE(preview.capacity() == 100);
+  BOOST_REQUIRE(preview.push({0, 0}, 0.3) == 60);
+  BOOST_REQUIRE(preview.push({0.1, 0}, 0.3) == 40);
+  BOOST_REQUIRE(!preview.push({0.1, 0}));
+  BOOST_REQUIRE_THROW(preview.push({0.1, 0}, -0.1), std::invalid_argument);
+  for(size_t i = 0; i < 10; ++i) { preview.update(); }
+  BOOST_REQUIRE(preview.size() == 90);
+  BOOST_REQUIRE(preview.push({0.1, 0}));
+  BOOST_REQUIRE(preview.size() == 91);
+  preview.reset({0, 0, height});
+  BOOST_REQUIRE(preview.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestZMPPreviewControllerStatic)
+{
+  mc_planning::ZMPPreviewController preview(dt, height, horizon);
+  Eigen::Vector3d com{0.1, -0.2, 0.9};
+  preview.reset(com);
+  for(size_t i = 0; i < 1000; ++i) { preview.update(); }
+  BOOST_REQUIRE(preview.com().isApprox(com, 1e-9));
+  BOOST_REQUIRE(preview.zmp().isApprox(Eigen::Vector3d{0.1, -0.2, 0.1}, 1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(TestZMPPreviewControllerWalk)
+{
+  mc_planning::ZMPPreviewController preview(dt, height, horizon);
+  preview.reset({0, 0, height});
+  // Double support, then alternate support feet every 0.8s while moving forward
+  std::vector<Eigen::Vector2d> steps = {{0, 0}, {0, 0.1}, {0.2, -0.1}, {0.4, 0.1}, {0.6, -0.1}, {0.6, 0}};
+  std::vector<Eigen::Vector2d> refs;
+  for(const auto & s : steps)
+  {
+    for(size_t i = 0; i < 160; ++i) { refs.push_back(s); }
+  }
+  for(size_t i = 0; i < 600; ++i) { refs.push_back(steps.back()); }
+
+  size_t next = 0;
+  auto fill = [&]()
+  {
+    while(next < refs.size() && preview.push(refs[next])) { next++; }
+  };
+  double maxError = 0;
+  bool anticipated = false;
+  for(size_t i = 0; i < refs.size(); ++i)
+  {
+    fill();
+    preview.update();
+    BOOST_REQUIRE(preview.zmpRef().isApprox(refs[i]));
+    // The CoM moves toward the first step before the reference changes
+    if(i == 159) { anticipated = preview.com().y() > 1e-3; }
+    const auto & p = preview.zmp();
+    BOOST_REQUIRE_SMALL(p.z(), 1e-12);
+    BOOST_REQUIRE(p.isApprox(preview.com() - height / 9.80665 * preview.comdd() - Eigen::Vector3d{0, 0, height}));
+    // The ZMP cannot jump with the reference, check tracking away from the transitions
+    if(i % 160 >= 40 && i % 160 < 120) { maxError = std::max(maxError, (p.head<2>() - refs[i]).norm()); }
+  }
+  BOOST_REQUIRE(anticipated);
+  BOOST_REQUIRE(maxError < 0.01);
+  BOOST_REQUIRE_SMALL((preview.com().head<2>() - steps.back()).norm(), 1e-3);
+  BOOST_REQUIRE_SMALL(preview.comd().norm(), 1e-3);
+}
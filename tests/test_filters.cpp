@@ -3,6 +3,11 @@
  */
 
 #include <mc_filter/ExponentialMovingAverage.h>
+#include <mc_filter/ExponentialMovingAverageBank.h>
+#include <mc_filter/LeakyIntegrator.h>
+#include <mc_filter/LeakyIntegratorBank.h>
+#include <mc_filter/LowPassFiniteDifferences.h>
+#include <mc_filter/LowPassFiniteDifferencesBank.h>
 #include <mc_filter/utils/clamp.h>
 
 #include <boost/test/unit_test.hpp>
@@ -49,6 +54,86 @@ BOOST_AUTO_TEST_CASE(TestExponentialMovingAverage)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestFilterBanks)
+{
+  using namespace mc_filter;
+  using Vector1d = Eigen::Matrix<double, 1, 1>;
+  double dt = 0.005;
+  const Eigen::Index N = 7;
+  std::vector<LowPassFiniteDifferences<Vector1d>> lpfd;
+  std::vector<ExponentialMovingAverage<Vector1d>> ema;
+  std::vector<LeakyIntegrator<Vector1d>> li;
+  LowPassFiniteDifferencesBank lpfdBank(dt, N, 0.1);
+  ExponentialMovingAverageBank emaBank(dt, N, 0.5);
+  LeakyIntegratorBank liBank(N);
+  for(Eigen::Index i = 0; i < N; ++i)
+  {
+    // Every channel has its own cutoff
+    double period = 0.1 * static_cast<double>(i + 1);
+    lpfd.emplace_back(dt, period);
+    lpfd.back().reset(Vector1d::Zero(), Vector1d::Zero());
+    lpfdBank.cutoffPeriod(i, period);
+    ema.emplace_back(dt, period);
+    emaBank.timeConstant(i, period);
+    li.emplace_back();
+    li.back().rate(period);
+    liBank.rate(i, period);
+  }
+  // The banks give the same results as the per-signal filters
+  Eigen::VectorXd value(N);
+  for(size_t k = 0; k < 1000; ++k)
+  {
+    for(Eigen::Index i = 0; i < N; ++i) { value(i) = std::sin(0.01 * static_cast<double>(k * (i + 1))); }
+    lpfdBank.update(value);
+    emaBank.append(value);
+    liBank.add(value, dt);
+    for(Eigen::Index i = 0; i < N; ++i)
+    {
+      auto idx = static_cast<size_t>(i);
+      lpfd[idx].update(Vector1d{value(i)});
+      ema[idx].append(Vector1d{value(i)});
+      li[idx].add(Vector1d{value(i)}, dt);
+      BOOST_REQUIRE_SMALL(lpfdBank.eval()(i) - lpfd[idx].eval()(0), 1e-10);
+      BOOST_REQUIRE_SMALL(emaBank.eval()(i) - ema[idx].eval()(0), 1e-10);
+      BOOST_REQUIRE_SMALL(liBank.eval()(i) - li[idx].eval()(0), 1e-10);
+    }
+  }
+  // NaN inputs hold the previous state of the channel
+  Eigen::VectorXd prevPos = lpfdBank.prevValue();
+  Eigen::VectorXd prevVel = lpfdBank.eval();
+  Eigen::VectorXd prevAvg = emaBank.eval();
+  Eigen::VectorXd prevInt = liBank.eval();
+  value(2) = std::numeric_limits<double>::quiet_NaN();
+  lpfdBank.update(value);
+  emaBank.append(value);
+  liBank.add(value, dt);
+  BOOST_REQUIRE(lpfdBank.prevValue()(2) == prevPos(2) && lpfdBank.eval()(2) == prevVel(2));
+  BOOST_REQUIRE(emaBank.eval()(2) == prevAvg(2));
+  BOOST_REQUIRE(liBank.eval()(2) == prevInt(2));
+  BOOST_REQUIRE(lpfdBank.eval().allFinite() && emaBank.eval().allFinite() && liBank.eval().allFinite());
+  BOOST_REQUIRE(lpfdBank.prevValue()(3) == value(3));
+  {
+    // After a gap, the velocity is computed over the whole gap
+    LowPassFiniteDifferencesBank fd(dt, 2);
+    Eigen::Vector2d pos(0.0, 0.0);
+    fd.update(pos);
+    pos << std::numeric_limits<double>::quiet_NaN(), 1.0;
+    fd.update(pos);
+    fd.update(pos);
+    BOOST_REQUIRE(fd.eval()(0) == 0.0);
+    pos(0) = 3 * dt;
+    fd.update(pos);
+    BOOST_REQUIRE_CLOSE(fd.eval()(0), 1.0, 1e-10);
+    BOOST_REQUIRE(fd.eval()(1) == 0.0);
+    pos(0) = 4 * dt;
+    fd.update(pos);
+    BOOST_REQUIRE_CLOSE(fd.eval()(0), 1.0, 1e-10);
+  }
+  // Reset a single channel
+  lpfdBank.reset(2, 1.0, 0.0);
+  BOOST_REQUIRE(lpfdBank.prevValue()(2) == 1.0 && lpfdBank.eval()(2) == 0.0);
+}
+
 BOOST_AUTO_TEST_CASE(test_clamp)
 {
   using namespace mc_filter;
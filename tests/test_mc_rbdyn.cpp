@@ -1,10 +1,13 @@
 #include <mc_rbdyn/RobotLoader.h>
 #include <mc_rbdyn/Robots.h>
+#include <mc_rbdyn/ZMP.h>
 #include <mc_rbdyn/rpy_utils.h>
 #include <boost/test/unit_test.hpp>
 #include "utils.h"
+#include <atomic>
 #include <chrono>
 #include <random>
+#include <thread>
 
 #include <sch/S_Object/S_Sphere.h>
 
@@ -59,6 +62,18 @@ void TestRobotLoadingCommon(mc_rbdyn::RobotModulePtr rm, mc_rbdyn::RobotModulePt
   for(const auto & s : robot.surfaces()) { BOOST_REQUIRE(robotCopy.hasSurface(s.first)); }
   for(const auto & fs : robot.forceSensors()) { BOOST_REQUIRE(robotCopy.hasForceSensor(fs.name())); }
   for(const auto & bs : robot.bodySensors()) { BOOST_REQUIRE(robotCopy.hasBodySensor(bs.name())); }
+  for(size_t i = 0; i < robot.bodyTransforms().size(); ++i)
+  {
+    BOOST_REQUIRE(robotCopy.bodyTransforms()[i] == robot.bodyTransforms()[i]);
+  }
+  // Model data is shared between copies
+  BOOST_REQUIRE(&robotCopy.module() == &robot.module());
+  const auto & constRobot = robot;
+  const auto & constRobotCopy = robotCopy;
+  BOOST_REQUIRE(&constRobotCopy.mbg() == &constRobot.mbg());
+  // Until non-const access is required
+  BOOST_REQUIRE(&robotCopy.mbg() != &constRobot.mbg());
+  BOOST_REQUIRE_EQUAL(robotCopy.mbg().nrNodes(), robot.mbg().nrNodes());
 
   robots_ptr->removeRobot("robotCopy");
   BOOST_REQUIRE(!robots_ptr->hasRobot("robotCopy"));
@@ -178,3 +193,125 @@ BOOST_AUTO_TEST_CASE(TestRobotZMPSimple)
     BOOST_CHECK_THROW(robot.zmp(sensorNames, Eigen::Vector3d::Zero(), {0., 0., 1.}), std::runtime_error);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestForceSensorCache)
+{
+  auto & robots = get_robots();
+  auto & robot = robots.robot();
+  auto & fs = robot.data()->forceSensors[robot.data()->forceSensorsIndex.at("LeftFootForceSensor")];
+  auto frame_ptr = robot.frame(fs.parentBody()).makeFrame("ForceSensorCacheFrame",
+                                                        sva::PTransformd(Eigen::Vector3d(0.0, 0.0, -0.1)));
+
+  auto check = [&]()
+  {
+    // A copy is not owned by the robot and always computes the quantities
+    mc_rbdyn::ForceSensor ref = fs;
+    BOOST_REQUIRE(fs.wrenchWithoutGravity(robot).vector().isApprox(ref.wrenchWithoutGravity(robot).vector()));
+    BOOST_REQUIRE(fs.worldWrench(robot).vector().isApprox(ref.worldWrench(robot).vector()));
+    BOOST_REQUIRE(fs.worldWrenchWithoutGravity(robot).vector().isApprox(ref.worldWrenchWithoutGravity(robot).vector()));
+    // Frame quantities
+    for(const auto * frame : {&robot.frame(fs.parentBody()), frame_ptr.get()})
+    {
+      auto w = frame->X_b_f().dualMul(fs.X_fsactual_parent().dualMul(ref.wrenchWithoutGravity(robot)));
+      BOOST_REQUIRE(frame->wrench().vector().isApprox(w.vector()));
+      Eigen::Vector2d cop = Eigen::Vector2d::Zero();
+      double pressure = w.force().z();
+      if(pressure >= 0.1) { cop = Eigen::Vector2d(-w.couple().y() / pressure, w.couple().x() / pressure); }
+      BOOST_REQUIRE(frame->cop(0.1).isApprox(cop));
+      auto X_0_f = frame->position();
+      Eigen::Vector3d copW = X_0_f.translation() + X_0_f.rotation().transpose() * Eigen::Vector3d(cop.x(), cop.y(), 0);
+      BOOST_REQUIRE(frame->copW(0.1).isApprox(copW));
+    }
+    // Net wrench and ZMP
+    auto netWrench = ref.worldWrenchWithoutGravity(robot);
+    BOOST_REQUIRE(robot.netWrench({fs.name()}).vector().isApprox(netWrench.vector()));
+    Eigen::Vector3d zmp = Eigen::Vector3d::Zero();
+    Eigen::Vector3d zmpRef = Eigen::Vector3d::Zero();
+    bool valid = mc_rbdyn::zmp(zmpRef, netWrench, Eigen::Vector3d::Zero(), Eigen::Vector3d::UnitZ(), 0.1);
+    BOOST_REQUIRE(robot.zmp(zmp, {fs.name()}, Eigen::Vector3d::Zero(), Eigen::Vector3d::UnitZ(), 0.1) == valid);
+    if(valid) { BOOST_REQUIRE(zmp.isApprox(zmpRef)); }
+  };
+
+  mc_rbdyn::detail::ForceSensorCalibData calib;
+  calib.mass = 1.0;
+  calib.worldForce = sva::ForceVecd(Eigen::Vector3d::Zero(), Eigen::Vector3d(0, 0, -9.81));
+  calib.X_f_ds = sva::PTransformd(mc_rbdyn::rpyToMat(Eigen::Vector3d(0.01, -0.02, 0.03)));
+  calib.X_p_vb = sva::PTransformd(Eigen::Vector3d(0.0, 0.0, 0.05));
+  calib.offset = sva::ForceVecd(Eigen::Vector6d::Random());
+  fs.loadCalibrator(calib);
+
+  for(int i = 0; i < 10; ++i)
+  {
+    // New reading
+    fs.wrench(sva::ForceVecd(Eigen::Vector6d::Random()));
+    check();
+    // Same reading, the robot moved
+    robot.posW({mc_rbdyn::rpyToMat(Eigen::Vector3d::Random()), Eigen::Vector3d::Random()});
+    check();
+  }
+  // Changes made through the Device interface invalidate the cache
+  auto X_p_f = fs.X_p_f();
+  mc_rbdyn::Device & device = fs;
+  device.X_p_s(sva::PTransformd(Eigen::Vector3d(0.0, 0.0, 0.1)) * X_p_f);
+  check();
+  device.X_p_s(X_p_f);
+  check();
+  // So do changes of the frames
+  frame_ptr->X_p_f({mc_rbdyn::rpyToMat(Eigen::Vector3d(0.1, 0.0, 0.0)), Eigen::Vector3d(0.0, 0.05, -0.1)});
+  check();
+  // Concurrent readers get the same values
+  fs.wrench(sva::ForceVecd(Eigen::Vector6d::Random()));
+  mc_rbdyn::ForceSensor ref = fs;
+  auto expected = ref.worldWrenchWithoutGravity(robot);
+  std::vector<std::thread> readers;
+  std::atomic<bool> ok{true};
+  for(size_t i = 0; i < 4; ++i)
+  {
+    readers.emplace_back(
+        [&]()
+        {
+          for(size_t j = 0; j < 1000; ++j)
+          {
+            if(fs.worldWrenchWithoutGravity(robot) != expected) { ok = false; }
+          }
+        });
+  }
+  for(auto & r : readers) { r.join(); }
+  BOOST_REQUIRE(ok);
+  // Calibration changed
+  fs.resetCalibrator();
+  check();
+  BOOST_REQUIRE(fs.wrenchWithoutGravity(robot).vector().isApprox(fs.wrench().vector()));
+}
+
+BOOST_AUTO_TEST_CASE(TestFlatParamMap)
+{
+  auto & robots = get_robots();
+  auto & robot = robots.robot();
+  auto q0 = robot.q();
+  auto alpha0 = robot.alpha();
+
+  Eigen::VectorXd q = Eigen::VectorXd::Random(robot.mb().nrParams());
+  rbd::vectorToParam(q, robot.q());
+  Eigen::VectorXd qFlat(robot.paramMap().size());
+  robot.paramMap().gather(robot.q(), qFlat);
+  BOOST_REQUIRE(qFlat == q);
+
+  Eigen::VectorXd alpha = Eigen::VectorXd::Random(robot.mb().nrDof());
+  robot.dofMap().scatter(alpha, robot.alpha());
+  Eigen::VectorXd alphaRBD(robot.mb().nrDof());
+  rbd::paramToVector(robot.alpha(), alphaRBD);
+  BOOST_REQUIRE(alphaRBD == alpha);
+
+  std::vector<double> qRef(robot.refJointOrder().size(), 0.0);
+  robot.refJointOrderMap().gather(robot.q(), qRef);
+  for(size_t i = 0; i < qRef.size(); ++i)
+  {
+    auto mbcIndex = robot.jointIndexInMBC(i);
+    if(mbcIndex != -1) { BOOST_REQUIRE(qRef[i] == robot.q()[static_cast<size_t>(mbcIndex)][0]); }
+    else { BOOST_REQUIRE(qRef[i] == 0.0); }
+  }
+
+  robot.q() = q0;
+  robot.alpha() = alpha0;
+}
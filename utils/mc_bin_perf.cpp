@@ -3,9 +3,15 @@
  */
 
 #include <mc_rtc/log/FlatLog.h>
+#include <mc_rtc/log/Logger.h>
 #include <mc_rtc/logging.h>
 
+#include <boost/filesystem.hpp>
+namespace bfs = boost::filesystem;
+
 #include <array>
+#include <chrono>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 
@@ -97,7 +103,17 @@ static const std::string match = "perf_";
 
 void usage(char * name)
 {
-  std::cerr << name << " [log] [entry = t]\n";
+  std::cerr << name << " [log] [entry = t] [jobs = 1]\n";
+}
+
+/** Size of the log on disk, for a segmented log this is the size of all segments */
+uint64_t logSize(const std::string & file)
+{
+  bfs::path path(file);
+  if(path.extension() != ".manifest") { return bfs::file_size(path); }
+  uint64_t size = 0;
+  for(const auto & segment : mc_rtc::Logger::readManifest(file)) { size += bfs::file_size(segment.file); }
+  return size;
 }
 
 std::pair<size_t, size_t> getRange(const mc_rtc::log::FlatLog & log, const std::string & key)
@@ -155,9 +171,16 @@ int main(int argc, char * argv[])
   std::string file = argv[1];
   std::string key = "t";
   if(argc > 2) { key = argv[2]; }
+  size_t jobs = 1;
+  if(argc > 3) { jobs = static_cast<size_t>(std::max(std::atoi(argv[3]), 1)); }
   PerfTable vt(std::array<PrettyColumn, 5>{PrettyColumn{""}, PrettyColumn{"Average"}, PrettyColumn{"StdEv"},
                                            PrettyColumn{"Min"}, PrettyColumn{"Max"}});
-  mc_rtc::log::FlatLog log(file);
+  auto start = std::chrono::steady_clock::now();
+  mc_rtc::log::FlatLog log(file, jobs);
+  std::chrono::duration<double> load = std::chrono::steady_clock::now() - start;
+  double size_mb = static_cast<double>(logSize(file)) / (1024 * 1024);
+  mc_rtc::log::info("Loaded {:.1f} MB in {:.3f} s ({:.1f} MB/s, {} jobs)", size_mb, load.count(),
+                    size_mb / load.count(), jobs);
   auto range = getRange(log, key);
   auto keys = log.entries();
   for(const auto & k : keys)
@@ -2,9 +2,12 @@
  * Copyright 2015-2019 CNRS-UM LIRMM, CNRS-AIST JRL
  */
 
+#include <mc_rtc/WorkerPool.h>
+
 #include "mc_bin_utils.h"
 #include <fstream>
 #include <map>
+#include <sstream>
 #include <type_traits>
 
 namespace utils
@@ -325,88 +328,114 @@ void write<Eigen::VectorXd>(const mc_rtc::log::FlatLog & log, const std::string
   for(size_t i = 0; i < maxS; ++i) { write(entry + "_" + std::to_string(i), &vec[i * data.size()], data.size(), os); }
 }
 
+/** Write the columns of an entry */
+void write(const mc_rtc::log::FlatLog & log, const std::string & entry, mc_rtc::log::LogType type, std::ostream & os)
+{
+  switch(type)
+  {
+    case mc_rtc::log::LogType::Bool:
+      utils::write<bool>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Int8_t:
+      utils::write<int8_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Int16_t:
+      utils::write<int16_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Int32_t:
+      utils::write<int32_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Int64_t:
+      utils::write<int64_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Uint8_t:
+      utils::write<uint8_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Uint16_t:
+      utils::write<uint16_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Uint32_t:
+      utils::write<uint32_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Uint64_t:
+      utils::write<uint64_t>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Float:
+      utils::write<float>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Double:
+      utils::write<double>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::String:
+      utils::write<std::string>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Quaterniond:
+      utils::write<Eigen::Quaterniond>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Vector3d:
+      utils::write<Eigen::Vector3d>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Vector2d:
+      utils::write<Eigen::Vector2d>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::Vector6d:
+      utils::write<Eigen::Vector6d>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::VectorXd:
+      utils::write<Eigen::VectorXd>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::PTransformd:
+      utils::write<sva::PTransformd>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::ForceVecd:
+      utils::write<sva::ForceVecd>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::MotionVecd:
+      utils::write<sva::MotionVecd>(log, entry, os);
+      break;
+    case mc_rtc::log::LogType::VectorDouble:
+      utils::write<std::vector<double>>(log, entry, os);
+      break;
+    default:
+      mc_rtc::log::error("Cannot convert {} into the flat format", entry);
+      break;
+  }
+}
+
 } // namespace utils
 
 void mc_bin_to_flat(const std::string & in,
                     const std::string & out,
-                    const std::vector<std::string> & entriesFilter = {})
+                    const std::vector<std::string> & entriesFilter,
+                    size_t jobs)
 {
-  mc_rtc::log::FlatLog log(in);
+  jobs = std::max<size_t>(jobs, 1);
+  mc_rtc::log::FlatLog log(in, jobs);
   auto entries = utils::entries(log, entriesFilter);
   std::ofstream ofs(out, std::ofstream::binary);
   utils::write(utils::nEntries(log, entries), ofs);
-  for(const auto & e : entries)
+  if(jobs == 1)
+  {
+    for(const auto & e : entries) { utils::write(log, e.first, e.second, ofs); }
+    return;
+  }
+  // Entries are independent: format a batch of entries concurrently then write them in order
+  std::vector<std::pair<std::string, mc_rtc::log::LogType>> columns(entries.begin(), entries.end());
+  std::vector<std::ostringstream> buffers(jobs);
+  mc_rtc::WorkerPool pool(jobs - 1);
+  for(size_t i = 0; i < columns.size(); i += jobs)
   {
-    const auto & entry = e.first;
-    const auto & type = e.second;
-    switch(type)
+    size_t n = std::min(jobs, columns.size() - i);
+    pool.run(n,
+             [&](size_t j)
+             {
+               buffers[j].str("");
+               utils::write(log, columns[i + j].first, columns[i + j].second, buffers[j]);
+             });
+    for(size_t j = 0; j < n; ++j)
     {
-      case mc_rtc::log::LogType::Bool:
-        utils::write<bool>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Int8_t:
-        utils::write<int8_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Int16_t:
-        utils::write<int16_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Int32_t:
-        utils::write<int32_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Int64_t:
-        utils::write<int64_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Uint8_t:
-        utils::write<uint8_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Uint16_t:
-        utils::write<uint16_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Uint32_t:
-        utils::write<uint32_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Uint64_t:
-        utils::write<uint64_t>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Float:
-        utils::write<float>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Double:
-        utils::write<double>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::String:
-        utils::write<std::string>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Quaterniond:
-        utils::write<Eigen::Quaterniond>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Vector3d:
-        utils::write<Eigen::Vector3d>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Vector2d:
-        utils::write<Eigen::Vector2d>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::Vector6d:
-        utils::write<Eigen::Vector6d>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::VectorXd:
-        utils::write<Eigen::VectorXd>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::PTransformd:
-        utils::write<sva::PTransformd>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::ForceVecd:
-        utils::write<sva::ForceVecd>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::MotionVecd:
-        utils::write<sva::MotionVecd>(log, entry, ofs);
-        break;
-      case mc_rtc::log::LogType::VectorDouble:
-        utils::write<std::vector<double>>(log, entry, ofs);
-        break;
-      default:
-        mc_rtc::log::error("Cannot convert {} into the flat format", entry);
-        break;
+      auto data = buffers[j].str();
+      ofs.write(data.data(), static_cast<std::streamsize>(data.size()));
     }
   }
 }
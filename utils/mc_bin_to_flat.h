@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -14,7 +15,10 @@
  * @param out Output path to the flatlog
  * @param entriesFilter Name of entries to convert. When empty, convert all
  * entries
+ * @param jobs Number of threads used to decode the log and format the
+ * entries
  */
 void mc_bin_to_flat(const std::string & in,
                     const std::string & out,
-                    const std::vector<std::string> & entriesFilter = {});
+                    const std::vector<std::string> & entriesFilter = {},
+                    size_t jobs = 1);
@@ -9,21 +9,27 @@ namespace bfs = boost::filesystem;
 
 #include "mc_bin_to_flat.h"
 
+#include <cstdlib>
+#include <thread>
+
 void usage(const char * bin)
 {
-  mc_rtc::log::error("Usage: {} [bin] ([flat])", bin);
+  mc_rtc::log::error("Usage: {} [bin] ([flat]) ([jobs])", bin);
+  mc_rtc::log::info("[jobs] is the number of threads used for the conversion (default: number of cores)");
 }
 
 int main(int argc, char * argv[])
 {
-  if(argc != 3 && argc != 2)
+  if(argc < 2 || argc > 4)
   {
     usage(argv[0]);
     return 1;
   }
   std::string in = argv[1];
   std::string out = "";
-  if(argc == 3) { out = argv[2]; }
+  size_t jobs = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  if(argc == 4) { jobs = static_cast<size_t>(std::max(std::atoi(argv[3]), 1)); }
+  if(argc >= 3) { out = argv[2]; }
   else
   {
     out = bfs::path(argv[1]).filename().replace_extension(".flat").string();
@@ -34,6 +40,6 @@ int main(int argc, char * argv[])
     }
     mc_rtc::log::info("Output converted log to {}", out);
   }
-  mc_bin_to_flat(in, out);
+  mc_bin_to_flat(in, out, {}, jobs);
   return 0;
 }
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include "mc_bin_to_lod.h"
+#include "mc_bin_to_flat.h"
+
+#include <mc_rtc/logging.h>
+#include <mc_rtc/path.h>
+
+#include <boost/filesystem.hpp>
+namespace bfs = boost::filesystem;
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+
+static const char magic[8] = {'M', 'C', '_', 'L', 'O', 'D', 0, 1};
+
+bool read(std::istream & is, uint64_t & out)
+{
+  return static_cast<bool>(is.read((char *)&out, sizeof(uint64_t)));
+}
+
+void write(std::ostream & os, uint64_t v)
+{
+  os.write((const char *)&v, sizeof(uint64_t));
+}
+
+void write(std::ostream & os, const std::vector<double> & v)
+{
+  os.write((const char *)v.data(), static_cast<std::streamsize>(v.size() * sizeof(double)));
+}
+
+/** Envelope of a column at a given decimation */
+struct Level
+{
+  std::vector<double> min;
+  std::vector<double> max;
+  std::vector<double> mean;
+  /** Number of non-NaN samples in each bucket */
+  std::vector<uint64_t> count;
+
+  void resize(size_t n)
+  {
+    static const double nan = std::numeric_limits<double>::quiet_NaN();
+    min.assign(n, nan);
+    max.assign(n, nan);
+    mean.assign(n, 0.0);
+    count.assign(n, 0);
+  }
+
+  /** Merge a bucket (min, max, mean, count) into bucket i */
+  void merge(size_t i, double bmin, double bmax, double bmean, uint64_t bcount)
+  {
+    if(bcount == 0) { return; }
+    if(count[i] == 0)
+    {
+      min[i] = bmin;
+      max[i] = bmax;
+    }
+    else
+    {
+      min[i] = std::min(min[i], bmin);
+      max[i] = std::max(max[i], bmax);
+    }
+    mean[i] += (bmean - mean[i]) * static_cast<double>(bcount) / static_cast<double>(count[i] + bcount);
+    count[i] += bcount;
+  }
+
+  void finalize()
+  {
+    for(size_t i = 0; i < count.size(); ++i)
+    {
+      if(count[i] == 0) { mean[i] = std::numeric_limits<double>::quiet_NaN(); }
+    }
+  }
+};
+
+/** Decimation factors for a log of n samples */
+std::vector<uint64_t> factors(uint64_t n, size_t minBuckets)
+{
+  std::vector<uint64_t> out;
+  for(uint64_t f = 2; (n + f - 1) / f >= std::max<uint64_t>(minBuckets, 1); f *= 2) { out.push_back(f); }
+  return out;
+}
+
+void write_levels(std::ostream & os, const std::vector<double> & data, const std::vector<uint64_t> & factors)
+{
+  Level prev;
+  Level next;
+  for(size_t l = 0; l < factors.size(); ++l)
+  {
+    auto f = factors[l];
+    next.resize((data.size() + f - 1) / f);
+    if(l == 0)
+    {
+      for(size_t i = 0; i < data.size(); ++i)
+      {
+        if(!std::isnan(data[i])) { next.merge(i / f, data[i], data[i], data[i], 1); }
+      }
+    }
+    else
+    {
+      // Each level halves the previous one
+      for(size_t i = 0; i < prev.count.size(); ++i)
+      {
+        next.merge(i / 2, prev.min[i], prev.max[i], prev.mean[i], prev.count[i]);
+      }
+    }
+    // Empty buckets are skipped when building the next level so they can be finalized now
+    next.finalize();
+    write(os, next.min);
+    write(os, next.max);
+    write(os, next.mean);
+    std::swap(prev, next);
+  }
+}
+
+} // namespace
+
+bool mc_flat_to_lod(const std::string & in, const std::string & out, size_t minBuckets)
+{
+  std::ifstream ifs(in, std::ifstream::binary);
+  if(!ifs)
+  {
+    mc_rtc::log::error("Failed to open {}", in);
+    return false;
+  }
+  std::ofstream ofs(out, std::ofstream::binary);
+  if(!ofs)
+  {
+    mc_rtc::log::error("Failed to open {} for writing", out);
+    return false;
+  }
+  uint64_t nEntries = 0;
+  if(!read(ifs, nEntries))
+  {
+    mc_rtc::log::error("{} is not a flat log", in);
+    return false;
+  }
+  bool header = false;
+  uint64_t nSamples = 0;
+  std::vector<uint64_t> levels;
+  std::streampos nKeysPos;
+  uint64_t nKeys = 0;
+  std::vector<double> data;
+  std::string key;
+  for(uint64_t i = 0; i < nEntries; ++i)
+  {
+    char numeric = 0;
+    uint64_t size = 0;
+    if(!ifs.get(numeric) || !read(ifs, size))
+    {
+      mc_rtc::log::error("Unexpected end of file in {}", in);
+      return false;
+    }
+    key.resize(size);
+    ifs.read(&key[0], static_cast<std::streamsize>(size));
+    read(ifs, size);
+    if(!numeric)
+    {
+      for(uint64_t j = 0; j < size; ++j)
+      {
+        uint64_t s = 0;
+        read(ifs, s);
+        ifs.seekg(static_cast<std::streamoff>(s), std::ios_base::cur);
+      }
+      continue;
+    }
+    data.resize(size);
+    if(!ifs.read((char *)data.data(), static_cast<std::streamsize>(size * sizeof(double))))
+    {
+      mc_rtc::log::error("Unexpected end of file in {}", in);
+      return false;
+    }
+    if(!header)
+    {
+      header = true;
+      nSamples = size;
+      levels = factors(nSamples, minBuckets);
+      ofs.write(magic, sizeof(magic));
+      write(ofs, nSamples);
+      write(ofs, levels.size());
+      for(auto f : levels) { write(ofs, f); }
+      nKeysPos = ofs.tellp();
+      write(ofs, nKeys);
+    }
+    if(size != nSamples)
+    {
+      mc_rtc::log::warning("{} has {} samples instead of {}, it is not included in the LOD", key, size, nSamples);
+      continue;
+    }
+    write(ofs, key.size());
+    ofs.write(key.data(), static_cast<std::streamsize>(key.size()));
+    write_levels(ofs, data, levels);
+    nKeys++;
+  }
+  if(!header)
+  {
+    mc_rtc::log::error("No numeric data in {}", in);
+    return false;
+  }
+  ofs.seekp(nKeysPos);
+  write(ofs, nKeys);
+  if(!ofs)
+  {
+    mc_rtc::log::error("Failed to write {}", out);
+    return false;
+  }
+  mc_rtc::log::info("Wrote {} levels for {} entries to {}", levels.size(), nKeys, out);
+  return true;
+}
+
+bool mc_bin_to_lod(const std::string & in,
+                   const std::string & out,
+                   const std::vector<std::string> & entriesFilter,
+                   size_t minBuckets,
+                   const std::string & flat)
+{
+  if(!flat.empty())
+  {
+    mc_bin_to_flat(in, flat, entriesFilter);
+    return mc_flat_to_lod(flat, out, minBuckets);
+  }
+  auto tmp = bfs::path(mc_rtc::temp_directory_path()) / bfs::unique_path("mc-lod-%%%%-%%%%-%%%%.flat");
+  mc_bin_to_flat(in, tmp.string(), entriesFilter);
+  bool ret = mc_flat_to_lod(tmp.string(), out, minBuckets);
+  bfs::remove(tmp);
+  return ret;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/** Level-of-detail (LOD) sidecar for plotting large logs
+ *
+ * The sidecar holds, for every numeric column of the flat representation of a log, the minimum, maximum and mean of
+ * the column over buckets of 2, 4, 8, ... samples. A plotting tool can then pick the resolution that matches the
+ * current view and only read full-rate samples for small time ranges.
+ *
+ * Layout (native endianness, integers are uint64_t, samples are double):
+ * - magic: "MC_LOD" followed by two bytes: 0 and the format version
+ * - number of samples (N)
+ * - number of levels (L) followed by the L decimation factors
+ * - number of columns, then for each column:
+ *   - key size followed by the key characters
+ *   - for each level with factor F: min, max and mean arrays of ceil(N / F) elements each
+ *
+ * NaN samples are ignored, a bucket that only holds NaN samples is NaN.
+ */
+
+/**
+ * @brief Generate the LOD sidecar of a flat log
+ *
+ * @param in Input path to the flat log
+ * @param out Output path to the sidecar
+ * @param minBuckets Coarsest level holds at least this many buckets
+ *
+ * @returns False if the input cannot be read or the output cannot be written
+ */
+bool mc_flat_to_lod(const std::string & in, const std::string & out, size_t minBuckets = 512);
+
+/**
+ * @brief Generate the LOD sidecar of a bin log
+ *
+ * The log is converted to a flat log first (see mc_bin_to_flat)
+ *
+ * @param in Input path to the bin log
+ * @param out Output path to the sidecar
+ * @param entriesFilter Name of entries to include. When empty, include all entries
+ * @param minBuckets Coarsest level holds at least this many buckets
+ * @param flat Where the flat conversion is kept, mc_log_ui reads full-rate samples from [in].flat rather than
+ * converting the log again. When empty, a temporary file is used and removed.
+ *
+ * @returns False if the input cannot be read or the output cannot be written
+ */
+bool mc_bin_to_lod(const std::string & in,
+                   const std::string & out,
+                   const std::vector<std::string> & entriesFilter = {},
+                   size_t minBuckets = 512,
+                   const std::string & flat = "");
@@ -2,8 +2,11 @@
  * Copyright 2015-2019 CNRS-UM LIRMM, CNRS-AIST JRL
  */
 
+#include <mc_rtc/WorkerPool.h>
+
 #include "mc_bin_utils.h"
 #include <fstream>
+#include <iterator>
 
 struct SizedType
 {
@@ -111,113 +114,122 @@ SizedEntries write_header(std::ofstream & ofs,
   return out;
 }
 
-// clang-format off
+using Buffer = fmt::memory_buffer;
+
 template<typename T>
-void write_data(std::ofstream & ofs, const T & data, size_t /*fsize*/)
+void write_data(Buffer & out, const T & data, size_t /*fsize*/)
 {
-  ofs << data;
+  fmt::format_to(std::back_inserter(out), "{}", data);
 }
 
+// Same output as the default formatting of std::ostream
 template<>
-void write_data<Eigen::Quaterniond>(std::ofstream & ofs, const Eigen::Quaterniond & data, size_t /*fsize*/)
+void write_data<double>(Buffer & out, const double & data, size_t /*fsize*/)
 {
-  ofs << data.w() << ";"
-      << data.x() << ";"
-      << data.y() << ";"
-      << data.z();
+  fmt::format_to(std::back_inserter(out), "{:g}", data);
 }
 
 template<>
-void write_data<Eigen::Vector2d>(std::ofstream & ofs, const Eigen::Vector2d & data, size_t /*fsize*/)
+void write_data<float>(Buffer & out, const float & data, size_t /*fsize*/)
 {
-  ofs << data.x() << ";"
-      << data.y();
+  fmt::format_to(std::back_inserter(out), "{:g}", data);
 }
 
 template<>
-void write_data<Eigen::Vector3d>(std::ofstream & ofs, const Eigen::Vector3d & data, size_t /*fsize*/)
+void write_data<bool>(Buffer & out, const bool & data, size_t /*fsize*/)
+{
+  out.push_back(data ? '1' : '0');
+}
+
+/** Write the first n values of data separated by ';' */
+void write_values(Buffer & out, const double * data, size_t n)
 {
-  ofs << data.x() << ";"
-      << data.y() << ";"
-      << data.z();
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(i != 0) { out.push_back(';'); }
+    write_data<double>(out, data[i], 1);
+  }
 }
 
 template<>
-void write_data<Eigen::Vector6d>(std::ofstream & ofs, const Eigen::Vector6d & data, size_t /*fsize*/)
+void write_data<Eigen::Quaterniond>(Buffer & out, const Eigen::Quaterniond & data, size_t /*fsize*/)
 {
-  ofs << data(0) << ";"
-      << data(1) << ";"
-      << data(2) << ";"
-      << data(3) << ";"
-      << data(4) << ";"
-      << data(5);
+  const double values[4] = {data.w(), data.x(), data.y(), data.z()};
+  write_values(out, values, 4);
 }
-// clang-format on
 
 template<>
-void write_data<Eigen::VectorXd>(std::ofstream & ofs, const Eigen::VectorXd & data, size_t fsize)
+void write_data<Eigen::Vector2d>(Buffer & out, const Eigen::Vector2d & data, size_t /*fsize*/)
 {
-  for(long i = 0; i < data.size(); ++i)
-  {
-    ofs << data(i);
-    if(i + 1 != static_cast<long>(fsize)) { ofs << ';'; }
-  }
-  for(long i = data.size(); i < static_cast<long>(fsize); ++i)
-  {
-    if(i + 1 != static_cast<long>(fsize)) { ofs << ';'; }
-  }
+  write_values(out, data.data(), 2);
 }
 
 template<>
-void write_data<std::vector<double>>(std::ofstream & ofs, const std::vector<double> & data, size_t fsize)
+void write_data<Eigen::Vector3d>(Buffer & out, const Eigen::Vector3d & data, size_t /*fsize*/)
 {
-  for(size_t i = 0; i < data.size(); ++i)
-  {
-    ofs << data[i];
-    if(i + 1 != fsize) { ofs << ';'; }
-  }
-  for(size_t i = data.size(); i < fsize; ++i)
+  write_values(out, data.data(), 3);
+}
+
+template<>
+void write_data<Eigen::Vector6d>(Buffer & out, const Eigen::Vector6d & data, size_t /*fsize*/)
+{
+  write_values(out, data.data(), 6);
+}
+
+/** Write a vector of variable size padded to fsize columns */
+void write_padded(Buffer & out, const double * data, size_t size, size_t fsize)
+{
+  write_values(out, data, size);
+  for(size_t i = size; i < fsize; ++i)
   {
-    if(i + 1 != fsize) { ofs << ';'; }
+    if(i != 0) { out.push_back(';'); }
   }
 }
 
 template<>
-void write_data<sva::PTransformd>(std::ofstream & ofs, const sva::PTransformd & data, size_t s)
+void write_data<Eigen::VectorXd>(Buffer & out, const Eigen::VectorXd & data, size_t fsize)
+{
+  write_padded(out, data.data(), static_cast<size_t>(data.size()), fsize);
+}
+
+template<>
+void write_data<std::vector<double>>(Buffer & out, const std::vector<double> & data, size_t fsize)
 {
-  write_data(ofs, Eigen::Quaterniond(data.rotation()), s);
-  ofs << ';';
-  write_data(ofs, data.translation(), s);
+  write_padded(out, data.data(), data.size(), fsize);
 }
 
 template<>
-void write_data<sva::ForceVecd>(std::ofstream & ofs, const sva::ForceVecd & data, size_t s)
+void write_data<sva::PTransformd>(Buffer & out, const sva::PTransformd & data, size_t s)
 {
-  write_data(ofs, data.vector(), s);
+  write_data(out, Eigen::Quaterniond(data.rotation()), s);
+  out.push_back(';');
+  write_data(out, data.translation(), s);
 }
 
 template<>
-void write_data<sva::MotionVecd>(std::ofstream & ofs, const sva::MotionVecd & data, size_t s)
+void write_data<sva::ForceVecd>(Buffer & out, const sva::ForceVecd & data, size_t s)
 {
-  write_data(ofs, data.vector(), s);
+  write_data(out, data.vector(), s);
+}
+
+template<>
+void write_data<sva::MotionVecd>(Buffer & out, const sva::MotionVecd & data, size_t s)
+{
+  write_data(out, data.vector(), s);
 }
 
 template<typename T>
-void write_data(std::ofstream & ofs,
-                const mc_rtc::log::FlatLog & log,
-                const std::string & entry,
-                size_t idx,
-                size_t fsize)
+void write_data(Buffer & out, const mc_rtc::log::FlatLog & log, const std::string & entry, size_t idx, size_t fsize)
 {
   const T * data = log.getRaw<T>(entry, idx);
-  if(data) { write_data<T>(ofs, *data, fsize); }
+  if(data) { write_data<T>(out, *data, fsize); }
   else
   {
-    for(size_t i = 0; i < fsize - 1; ++i) { ofs << ';'; }
+    for(size_t i = 0; i < fsize - 1; ++i) { out.push_back(';'); }
   }
 }
 
-void write_data(std::ofstream & ofs, const mc_rtc::log::FlatLog & log, const SizedEntries & entries, size_t idx)
+void write_data(Buffer & out, const mc_rtc::log::FlatLog & log, const SizedEntries & entries, size_t idx)
 {
   size_t i = 0;
   for(const auto & e : entries)
@@ -225,81 +237,100 @@ void write_data(std::ofstream & ofs, const mc_rtc::log::FlatLog & log, const Siz
     switch(e.second.type)
     {
       case mc_rtc::log::LogType::Bool:
-        write_data<bool>(ofs, log, e.first, idx, e.second.size);
+        write_data<bool>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Int8_t:
-        write_data<int8_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<int8_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Int16_t:
-        write_data<int16_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<int16_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Int32_t:
-        write_data<int32_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<int32_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Int64_t:
-        write_data<int64_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<int64_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Uint8_t:
-        write_data<uint8_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<uint8_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Uint16_t:
-        write_data<uint16_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<uint16_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Uint32_t:
-        write_data<uint32_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<uint32_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Uint64_t:
-        write_data<uint64_t>(ofs, log, e.first, idx, e.second.size);
+        write_data<uint64_t>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Float:
-        write_data<float>(ofs, log, e.first, idx, e.second.size);
+        write_data<float>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Double:
-        write_data<double>(ofs, log, e.first, idx, e.second.size);
+        write_data<double>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::String:
-        write_data<std::string>(ofs, log, e.first, idx, e.second.size);
+        write_data<std::string>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Quaterniond:
-        write_data<Eigen::Quaterniond>(ofs, log, e.first, idx, e.second.size);
+        write_data<Eigen::Quaterniond>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Vector2d:
-        write_data<Eigen::Vector2d>(ofs, log, e.first, idx, e.second.size);
+        write_data<Eigen::Vector2d>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Vector3d:
-        write_data<Eigen::Vector3d>(ofs, log, e.first, idx, e.second.size);
+        write_data<Eigen::Vector3d>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::Vector6d:
-        write_data<Eigen::Vector6d>(ofs, log, e.first, idx, e.second.size);
+        write_data<Eigen::Vector6d>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::VectorXd:
-        write_data<Eigen::VectorXd>(ofs, log, e.first, idx, e.second.size);
+        write_data<Eigen::VectorXd>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::PTransformd:
-        write_data<sva::PTransformd>(ofs, log, e.first, idx, e.second.size);
+        write_data<sva::PTransformd>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::ForceVecd:
-        write_data<sva::ForceVecd>(ofs, log, e.first, idx, e.second.size);
+        write_data<sva::ForceVecd>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::MotionVecd:
-        write_data<sva::MotionVecd>(ofs, log, e.first, idx, e.second.size);
+        write_data<sva::MotionVecd>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::VectorDouble:
-        write_data<std::vector<double>>(ofs, log, e.first, idx, e.second.size);
+        write_data<std::vector<double>>(out, log, e.first, idx, e.second.size);
         break;
       case mc_rtc::log::LogType::None:
         continue;
     }
-    if(++i != entries.size()) { ofs << ';'; }
-    else { ofs << '\n'; }
+    out.push_back(++i != entries.size() ? ';' : '\n');
   }
 }
 
-void mc_bin_to_log(const std::string & in, const std::string & out, const std::vector<std::string> & entriesFilter)
+void mc_bin_to_log(const std::string & in,
+                   const std::string & out,
+                   const std::vector<std::string> & entriesFilter,
+                   size_t jobs)
 {
-  mc_rtc::log::FlatLog log(in);
+  jobs = std::max<size_t>(jobs, 1);
+  mc_rtc::log::FlatLog log(in, jobs);
   std::ofstream ofs(out);
   if(!ofs.is_open()) { mc_rtc::log::error_and_throw("Failed to open {} for conversion from bin to log", out); }
   auto entries = write_header(ofs, log, entriesFilter);
-  for(size_t i = 0; i < log.size(); ++i) { write_data(ofs, log, entries, i); }
+  // Rows are formatted by blocks, jobs blocks are formatted concurrently then written in order
+  static constexpr size_t block = 1024;
+  std::vector<Buffer> buffers(jobs);
+  mc_rtc::WorkerPool pool(jobs - 1);
+  for(size_t start = 0; start < log.size(); start += jobs * block)
+  {
+    size_t n = std::min(jobs, (log.size() - start + block - 1) / block);
+    pool.run(n,
+             [&](size_t j)
+             {
+               buffers[j].clear();
+               size_t begin = start + j * block;
+               size_t end = std::min(begin + block, log.size());
+               for(size_t i = begin; i < end; ++i) { write_data(buffers[j], log, entries, i); }
+             });
+    for(size_t j = 0; j < n; ++j) { ofs.write(buffers[j].data(), static_cast<std::streamsize>(buffers[j].size())); }
+  }
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -14,5 +15,9 @@
  * @param out Output path to the csv file
  * @param entriesFilter Name of entries to convert. When empty, convert all
  * entries
+ * @param jobs Number of threads used to decode the log and format the rows
  */
-void mc_bin_to_log(const std::string & in, const std::string & out, const std::vector<std::string> & entiesFilter = {});
+void mc_bin_to_log(const std::string & in,
+                   const std::string & out,
+                   const std::vector<std::string> & entiesFilter = {},
+                   size_t jobs = 1);
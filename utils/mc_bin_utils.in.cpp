@@ -7,6 +7,7 @@
  * - Split the file into N parts
  * - Extract the part(s) where a given entry was recorded
  * - Convert to csv/flat/bag format
+ * - Generate a level-of-detail sidecar for plotting
  */
 
 #include <mc_rtc/config.h>
@@ -22,12 +23,14 @@ namespace bfs = boost::filesystem;
 namespace po = boost::program_options;
 
 #include "mc_bin_to_flat.h"
+#include "mc_bin_to_lod.h"
 #include "mc_bin_to_log.h"
 
 #include <bitset>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 
 #include "../src/mc_rtc/internals/LogEntry.h"
 
@@ -104,6 +107,7 @@ void usage()
   std::cout << "    split     Split a log into N part\n";
   std::cout << "    extract   Extra part of a log\n";
   std::cout << "    convert   Convert binary logs to various formats\n";
+  std::cout << "    lod       Generate a level-of-detail sidecar used by mc_log_ui to plot large logs\n";
   std::cout << "\nUse mc_bin_utils <command> --help for usage of each command\n";
 }
 
@@ -629,6 +633,7 @@ int convert(int argc, char * argv[])
   po::variables_map vm;
   po::options_description tool("mc_bin_utils convert options");
   double dt = 0.005;
+  size_t jobs = std::max<size_t>(std::thread::hardware_concurrency(), 1);
   // clang-format off
   tool.add_options()
     ("help", "Produce this message")
@@ -636,7 +641,8 @@ int convert(int argc, char * argv[])
     ("out", po::value<std::string>(), "Output file or template")
     ("format", po::value<std::string>(), "Log format (csv|flat|bag), can be deduced from [out]")
     ("entries", po::value<std::vector<std::string>>()->multitoken(), "Name of entries to log (all if ommitted)")
-    ("dt", po::value<double>(&dt), "Log timestep (only for bag conversion)");
+    ("dt", po::value<double>(&dt), "Log timestep (only for bag conversion)")
+    ("jobs,j", po::value<size_t>(&jobs), "Conversion threads (csv and flat only, default: number of cores)");
   // clang-format on
   po::positional_options_description pos;
   pos.add("in", 1);
@@ -710,8 +716,8 @@ int convert(int argc, char * argv[])
   std::vector<std::string> entries;
   if(vm.count("entries")) { entries = vm["entries"].as<std::vector<std::string>>(); }
 
-  if(format == ".flat") { mc_bin_to_flat(in, out_p.string(), entries); }
-  else if(format == ".csv" || format == ".log") { mc_bin_to_log(in, out_p.string(), entries); }
+  if(format == ".flat") { mc_bin_to_flat(in, out_p.string(), entries, jobs); }
+  else if(format == ".csv" || format == ".log") { mc_bin_to_log(in, out_p.string(), entries, jobs); }
   else if(format == ".bag")
   {
     if(bfs::exists(MC_BIN_TO_ROSBAG))
@@ -731,6 +737,53 @@ int convert(int argc, char * argv[])
   return 0;
 }
 
+int lod(int argc, char * argv[])
+{
+  po::variables_map vm;
+  po::options_description tool("mc_bin_utils lod options");
+  size_t min_buckets = 512;
+  bool no_flat = false;
+  // clang-format off
+  tool.add_options()
+    ("help", "Produce this message")
+    ("in", po::value<std::string>(), "Input file (bin or flat)")
+    ("out", po::value<std::string>(), "Output file (defaults to [in].lod)")
+    ("entries", po::value<std::vector<std::string>>()->multitoken(), "Name of entries to include (all if ommitted)")
+    ("min-buckets", po::value<size_t>(&min_buckets)->default_value(512), "Minimum number of buckets in the coarsest level")
+    ("no-flat", po::bool_switch(&no_flat), "Do not keep the flat conversion of a bin log ([in].flat)");
+  // clang-format on
+  po::positional_options_description pos;
+  pos.add("in", 1);
+  pos.add("out", 1);
+  po::store(po::command_line_parser(argc, argv).options(tool).positional(pos).run(), vm);
+  po::notify(vm);
+  if(vm.count("help") || !vm.count("in"))
+  {
+    std::cout << "Usage: mc_bin_utils lod [in] ([out])\n\n";
+    std::cout << tool << "\n";
+    std::cout << "mc_log_ui uses [in].lod when it exists and is newer than [in]\n";
+    std::cout << "For a bin log, the flat conversion is kept as [in].flat so mc_log_ui does not convert the log again\n";
+    return !vm.count("help");
+  }
+  auto in = vm["in"].as<std::string>();
+  auto out = vm.count("out") ? vm["out"].as<std::string>() : in + ".lod";
+  bfs::path in_p(in);
+  if(!bfs::exists(in_p) || !bfs::is_regular_file(in_p))
+  {
+    std::cerr << in << " does not exist or is not file, aborting...\n";
+    return 1;
+  }
+  if(in_p.extension() == ".flat")
+  {
+    if(vm.count("entries")) { mc_rtc::log::warning("--entries is ignored for flat logs"); }
+    return mc_flat_to_lod(in, out, min_buckets) ? 0 : 1;
+  }
+  std::vector<std::string> entries;
+  if(vm.count("entries")) { entries = vm["entries"].as<std::vector<std::string>>(); }
+  auto flat = no_flat ? std::string{} : in + ".flat";
+  return mc_bin_to_lod(in, out, entries, min_buckets, flat) ? 0 : 1;
+}
+
 int main(int argc, char * argv[])
 {
   if(argc < 2)
@@ -745,6 +798,7 @@ int main(int argc, char * argv[])
   else if(tool == "split") { return split(argc, argv); }
   else if(tool == "extract") { return extract(argc, argv); }
   else if(tool == "convert") { return convert(argc, argv); }
+  else if(tool == "lod") { return lod(argc, argv); }
   else
   {
     usage();
@@ -11,6 +11,8 @@ class Data(QtCore.QObject):
     def __init__(self, data={}):
         QtCore.QObject.__init__(self)
         self.data = data
+        # Level-of-detail index of the loaded log (see mc_log_lod)
+        self.lod = None
 
     def notify_update(self):
         self.data_updated.emit()
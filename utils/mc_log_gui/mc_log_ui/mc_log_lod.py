@@ -0,0 +1,211 @@
+#
+# Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+#
+
+import os
+import numpy as np
+
+MAGIC = b"MC_LOD\x00\x01"
+
+
+class LODIndex(object):
+    """Level-of-detail sidecar generated by mc_bin_utils lod
+
+    For each numeric entry of a log, the sidecar holds the minimum, maximum and
+    mean over buckets of 2, 4, 8, ... samples. The data is memory-mapped so only
+    the parts that are plotted are read from the disk.
+    """
+
+    def __init__(self, fpath):
+        u64 = np.dtype(np.uint64)
+        with open(fpath, "rb") as fd:
+            if fd.read(len(MAGIC)) != MAGIC:
+                raise RuntimeError("{} is not a LOD file".format(fpath))
+
+            def read_u64(count=1):
+                return np.frombuffer(fd.read(count * u64.itemsize), u64)
+
+            self.size = int(read_u64()[0])
+            nLevels = int(read_u64()[0])
+            self.factors = [int(f) for f in read_u64(nLevels)]
+            nKeys = int(read_u64()[0])
+            offsets = {}
+            for _ in range(nKeys):
+                key = fd.read(int(read_u64()[0])).decode("ascii")
+                offsets[key] = fd.tell()
+                for f in self.factors:
+                    fd.seek(3 * self.buckets(f) * 8, os.SEEK_CUR)
+        self._levels = {}
+        for key, offset in offsets.items():
+            levels = []
+            for f in self.factors:
+                n = self.buckets(f)
+                levels.append(
+                    np.memmap(fpath, np.double, "r", offset=offset, shape=(3, n))
+                )
+                offset += 3 * n * 8
+            self._levels[key] = levels
+        # Derived entries: key -> function(level, b0, bN) returning (min, max, mean)
+        self._derived = {}
+
+    def buckets(self, factor):
+        return (self.size + factor - 1) // factor
+
+    def __contains__(self, key):
+        return key in self._levels or key in self._derived
+
+    def level(self, key, i, b0=0, bN=None):
+        """Returns the (min, max, mean) arrays of the given level for the buckets in [b0, bN)"""
+        if key in self._levels:
+            return self._levels[key][i][:, b0:bN]
+        return self._derived[key](i, b0, bN)
+
+    def add_difference(self, key, a, b):
+        """Add the entry a - b computed from the levels of a and b
+
+        The mean is exact when neither entry has NaN samples, min and max bound
+        the difference within each bucket
+        """
+        if a not in self or b not in self:
+            return
+
+        def level(i, b0, bN):
+            la = self.level(a, i, b0, bN)
+            lb = self.level(b, i, b0, bN)
+            return np.stack((la[0] - lb[1], la[1] - lb[0], la[2] - lb[2]))
+
+        self._derived[key] = level
+
+    def add_constant(self, key, column):
+        """Add a ConstantColumn, its levels follow the column's value"""
+
+        def level(i, b0, bN):
+            n = len(range(self.buckets(self.factors[i]))[b0:bN])
+            return np.full((3, n), column.value)
+
+        self._derived[key] = level
+
+    def select(self, i0, iN, max_points):
+        """Select the finest level such that the samples in [i0, iN) are
+        represented by at most max_points points (two per bucket)
+
+        Returns None if the samples should be drawn at full rate
+        """
+        if iN - i0 <= max_points:
+            return None
+        for i, f in enumerate(self.factors):
+            if 2 * ((iN - i0) // f + 1) <= max_points:
+                return i
+        if len(self.factors):
+            return len(self.factors) - 1
+        return None
+
+    def envelope(self, x_key, y_key, x, y, xmin, xmax, max_points):
+        """Returns the data to plot y_key over x_key in [xmin, xmax] with at
+        most max_points points (approximately)
+
+        x and y are the full-rate data of the corresponding entries, x is used
+        to locate the view in the log and y is only read when the view is small
+        enough to be drawn at full rate.
+
+        The envelope is drawn as a single line going through the minimum and
+        the maximum of each bucket at the bucket's mean time.
+        """
+        i0 = max(int(np.searchsorted(x, xmin, side="left")) - 1, 0)
+        iN = min(int(np.searchsorted(x, xmax, side="right")) + 1, len(x))
+        level = self.select(i0, iN, max_points)
+        if level is None:
+            return x[i0:iN], y[i0:iN]
+        f = self.factors[level]
+        b0 = i0 // f
+        bN = (iN + f - 1) // f
+        xs = self.level(x_key, level, b0, bN)[2]
+        ys = self.level(y_key, level, b0, bN)
+        return np.repeat(xs, 2), np.stack((ys[0], ys[1]), axis=1).ravel()
+
+
+class LazyColumn(object):
+    """A column computed from other columns when it is accessed
+
+    Only the accessed samples of the source columns are read, which keeps
+    memory-mapped sources on the disk
+    """
+
+    def __init__(self, fn, *columns):
+        self._fn = fn
+        self._columns = columns
+
+    def __len__(self):
+        return len(self._columns[0])
+
+    @property
+    def shape(self):
+        return (len(self),)
+
+    def __getitem__(self, idx):
+        return self._fn(*[c[idx] for c in self._columns])
+
+    def __array__(self, dtype=None):
+        return np.asarray(self[:], dtype=dtype)
+
+
+class ConstantColumn(object):
+    """A column that holds the same value for every sample (e.g. joint limits)
+
+    The value can be changed with fill like a numpy array
+    """
+
+    def __init__(self, size, value=0.0):
+        self.size = size
+        self.value = value
+
+    def fill(self, value):
+        self.value = value
+
+    def __len__(self):
+        return self.size
+
+    @property
+    def shape(self):
+        return (self.size,)
+
+    def __getitem__(self, idx):
+        if isinstance(idx, slice):
+            return np.full(len(range(self.size)[idx]), self.value)
+        if np.isscalar(idx):
+            range(self.size)[idx]
+            return self.value
+        return np.full(np.shape(np.arange(self.size)[idx]), self.value)
+
+    def __array__(self, dtype=None):
+        return np.full(self.size, self.value, dtype=dtype)
+
+
+def lod_path(fpath):
+    """Path of the LOD sidecar for a given log"""
+    return fpath + ".lod"
+
+
+def flat_cache_path(fpath):
+    """Path of the flat conversion kept by mc_bin_utils lod for a bin log"""
+    return fpath + ".flat"
+
+
+def read_flat_cache(fpath):
+    """Returns the flat conversion of a bin log if it is up-to-date, None otherwise"""
+    flat = flat_cache_path(fpath)
+    if not os.path.exists(flat) or os.path.getmtime(flat) < os.path.getmtime(fpath):
+        return None
+    return flat
+
+
+def read_lod(fpath):
+    """Returns the LOD index of a log if an up-to-date sidecar exists"""
+    lod = lod_path(fpath)
+    if not os.path.exists(lod) or os.path.getmtime(lod) < os.path.getmtime(fpath):
+        return None
+    try:
+        return LODIndex(lod)
+    except Exception as e:
+        print("Failed to load {}: {}".format(lod, e))
+        return None
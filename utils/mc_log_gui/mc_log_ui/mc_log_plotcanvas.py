@@ -312,6 +312,10 @@ class PlotYAxis(object):
         self.source = {}
         self.data = {}
         self.filtered = {}
+        # Plots drawn from the level-of-detail index: y_label -> (x key, y key)
+        self.lod = {}
+        self._lod_callbacks = []
+        self.animating = False
 
     def __len__(self):
         return len(self.plots)
@@ -319,6 +323,43 @@ class PlotYAxis(object):
     def _data(self):
         return self.figure.data
 
+    def _lod_index(self):
+        return getattr(self._data(), "lod", None)
+
+    def _lod_max_points(self):
+        return max(1000, int(2 * self._axis.bbox.width))
+
+    def _lod_data(self, y_label, xmin, xmax):
+        x_key, y_key = self.lod[y_label]
+        return self._lod_index().envelope(
+            x_key,
+            y_key,
+            self.data[y_label][0],
+            self.data[y_label][1],
+            xmin,
+            xmax,
+            self._lod_max_points(),
+        )
+
+    def _connect_lod(self):
+        # Clearing an axis resets its callbacks so this is checked for every new plot
+        registries = []
+        for axis in [self._axis, self._x_axis]:
+            if any(r is axis.callbacks for r in registries):
+                continue
+            if not any(r is axis.callbacks for r in self._lod_callbacks):
+                axis.callbacks.connect("xlim_changed", self._update_lod)
+            registries.append(axis.callbacks)
+        self._lod_callbacks = registries
+
+    def _update_lod(self, *args):
+        if self.animating or not len(self.lod) or self._lod_index() is None:
+            return
+        xmin, xmax = self._x_axis.get_xlim()
+        for y_label in self.lod:
+            if y_label in self.plots:
+                self.plots[y_label].set_data(*self._lod_data(y_label, xmin, xmax))
+
     def _legend_fontsize(self):
         return self.figure._legend_fontsize
 
@@ -542,7 +583,9 @@ class PlotYAxis(object):
                 out[i] = np.nan
         return out
 
-    def _plot(self, x, y, y_label, style=None, filter_=None, z=None, source=None):
+    def _plot(
+        self, x, y, y_label, style=None, filter_=None, z=None, source=None, lod=None
+    ):
         if type(y[0]) is unicode:
             if filter_ is not None:
                 return False
@@ -556,6 +599,7 @@ class PlotYAxis(object):
                 filter_=filter_,
                 z=z,
                 source=source,
+                lod=lod,
             )
         if y_label in self.plots:
             return False
@@ -569,6 +613,11 @@ class PlotYAxis(object):
         else:
             self.filtered[y_label] = None
         self.source[y_label] = source
+        if lod is not None:
+            # Draw the envelope of the whole log, the view is refined when the limits change
+            self.lod[y_label] = lod
+            self._connect_lod()
+            x, y = self._lod_data(y_label, x[0], x[-1])
         if z is None:
             self.plots[y_label] = self._axis.plot(
                 x,
@@ -592,6 +641,7 @@ class PlotYAxis(object):
         return True
 
     def startAnimation(self, i0):
+        self.animating = True
         for y_label in self.plots.keys():
             plotStyle = self.style(y_label)
             self.plots[y_label].remove()
@@ -631,9 +681,18 @@ class PlotYAxis(object):
                     self.data[y_label][0], self.data[y_label][1], label=y_label
                 )[0]
             self.style(y_label, plotStyle)
+        self.animating = False
+        self._update_lod()
 
     def add_plot(self, x, y, y_label, style=None):
-        return self._plot(self._data()[x], self._data()[y], y_label, style, source=y)
+        lod = self._lod_index()
+        if lod is not None and not self._3D and x in lod and y in lod:
+            lod = (x, y)
+        else:
+            lod = None
+        return self._plot(
+            self._data()[x], self._data()[y], y_label, style, source=y, lod=lod
+        )
 
     def add_plot_xy(self, x, y, y_label, t, style=None):
         return self._plot(
@@ -728,6 +787,7 @@ class PlotYAxis(object):
         del self.data[y]
         del self.filtered[y]
         del self.source[y]
+        self.lod.pop(y, None)
         if len(self.plots):
             self._axis.relim()
             self.legend()
@@ -737,6 +797,7 @@ class PlotYAxis(object):
 
     def clear(self):
         self.plots = {}
+        self.lod = {}
         self._axis.clear()
 
     # Get or set the style of a given plot
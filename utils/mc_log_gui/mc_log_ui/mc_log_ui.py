@@ -22,6 +22,7 @@ from PyQt5 import QtCore, QtGui, QtWidgets
 
 from . import ui
 from .mc_log_data import Data
+from .mc_log_lod import ConstantColumn, LazyColumn, read_flat_cache, read_lod
 from .mc_log_tab import MCLogTab
 from .mc_log_types import (
     ColorsSchemeConfiguration,
@@ -46,7 +47,7 @@ def safe_float(v):
         return None
 
 
-def read_flat(f, tmp=False):
+def read_flat(f, tmp=False, mmap=False):
     def read_size(fd):
         return ctypes.c_size_t.from_buffer_copy(
             fd.read(ctypes.sizeof(ctypes.c_size_t))
@@ -63,11 +64,18 @@ def read_flat(f, tmp=False):
         return fd.read(size).decode("ascii")
 
     def read_array(fd, size):
+        if mmap:
+            offset = fd.tell()
+            fd.seek(size * ctypes.sizeof(ctypes.c_double), os.SEEK_CUR)
+            return np.memmap(f, np.double, "r", offset=offset, shape=(size,))
         return np.frombuffer(fd.read(size * ctypes.sizeof(ctypes.c_double)), np.double)
 
     def read_string_array(fd, size):
         return [read_string(fd, read_size(fd)) for i in range(size)]
 
+    # Memory-mapped files cannot be removed on Windows
+    if mmap and tmp and os.name != "posix":
+        mmap = False
     data = {}
     with open(f, "rb") as fd:
         nrEntries = read_size(fd)
@@ -108,14 +116,20 @@ def read_csv(fpath, tmp=False):
     return data
 
 
-def read_log(fpath, tmp=False):
-    if fpath.endswith(".bin"):
+# When mmap is True, the numeric entries of bin and flat logs are memory-mapped
+# rather than read so only the parts that are accessed are loaded
+def read_log(fpath, tmp=False, mmap=False):
+    # mc_bin_utils lod keeps the flat conversion of a bin log next to it
+    flat = read_flat_cache(fpath) if mmap and fpath.endswith(".bin") else None
+    if flat is not None:
+        return read_flat(flat, False, mmap)
+    if fpath.endswith(".bin") or fpath.endswith(".manifest"):
         tmpf = tempfile.mkstemp(suffix=".flat")
         os.close(tmpf[0])
         os.system("mc_bin_to_flat {} {}".format(fpath, tmpf[1]))
-        return read_log(tmpf[1], True)
+        return read_log(tmpf[1], True, mmap)
     elif fpath.endswith(".flat"):
-        return read_flat(fpath, tmp)
+        return read_flat(fpath, tmp, mmap)
     else:
         return read_csv(fpath, tmp)
 
@@ -873,6 +887,69 @@ class LabelsTitleEditDialog(QtWidgets.QDialog):
         self.apply()
 
 
+def add_derived_entries(data, lod=None):
+    """Add the entries computed from the log (tracking error, limits...)
+
+    With a level-of-detail index the data is memory-mapped, the entries are
+    then computed when they are accessed and their levels are derived from the
+    index so that plotting them does not read the whole log
+    """
+    if lod is None:
+
+        def difference(a, b):
+            return data[a] - data[b]
+
+        def constant(like):
+            return np.full_like(data[like], 0)
+
+    else:
+
+        def difference(a, b):
+            return LazyColumn(np.subtract, data[a], data[b])
+
+        def constant(like):
+            return ConstantColumn(len(data[like]))
+
+    def add_difference(key, a, b):
+        data[key] = difference(a, b)
+        if lod is not None:
+            lod.add_difference(key, a, b)
+
+    def add_constant(key, like):
+        data[key] = constant(like)
+        if lod is not None:
+            lod.add_constant(key, data[key])
+
+    def add_alias(key, source):
+        data[key] = data[source]
+        if lod is not None:
+            lod.add_constant(key, data[key])
+
+    i = 0
+    while "qIn_{}".format(i) in data and "qOut_{}".format(i) in data:
+        add_difference(
+            "error_q_{}".format(i), "qOut_{}".format(i), "qIn_{}".format(i)
+        )
+        add_constant("qIn_limits_lower_{}".format(i), "qIn_{}".format(i))
+        add_constant("qIn_limits_upper_{}".format(i), "qIn_{}".format(i))
+        add_alias("qOut_limits_lower_{}".format(i), "qIn_limits_lower_{}".format(i))
+        add_alias("qOut_limits_upper_{}".format(i), "qIn_limits_upper_{}".format(i))
+        i += 1
+    i = 0
+    while "tauIn_{}".format(i) in data:
+        add_constant("tauIn_limits_lower_{}".format(i), "tauIn_{}".format(i))
+        add_constant("tauIn_limits_upper_{}".format(i), "tauIn_{}".format(i))
+        i += 1
+    while "tauOut_{}".format(i) in data:
+        add_constant("tauOut_limits_lower_{}".format(i), "tauOut_{}".format(i))
+        add_constant("tauOut_limits_upper_{}".format(i), "tauOut_{}".format(i))
+        i += 1
+    if "perf_SolverBuildAndSolve" in data and "perf_SolverSolve" in data:
+        add_difference(
+            "perf_SolverBuild", "perf_SolverBuildAndSolve", "perf_SolverSolve"
+        )
+
+
 class MCLogUI(QtWidgets.QMainWindow):
     def __init__(self, parent=None):
         super(MCLogUI, self).__init__(parent)
@@ -1442,7 +1519,9 @@ class MCLogUI(QtWidgets.QMainWindow):
     def load_csv(self, fpath, clear=True):
         if clear:
             self.loaded_files = []
-        data = read_log(fpath)
+        # With a level-of-detail sidecar (mc_bin_utils lod) the full-rate data is only loaded for the plotted ranges
+        lod = read_lod(fpath)
+        data = read_log(fpath, mmap=lod is not None)
         if "t" not in data:
             print(
                 "This GUI assumes a time-entry named t is available in the log, failed loading {}".format(
@@ -1467,45 +1546,7 @@ class MCLogUI(QtWidgets.QMainWindow):
             end_t = max(self.data["t"][-1], data["t"][-1])
         fpath = os.path.basename(fpath).replace("_", "-")
         self.loaded_files.append(fpath)
-        i = 0
-        while "qIn_{}".format(i) in data and "qOut_{}".format(i) in data:
-            data["error_q_{}".format(i)] = (
-                data["qOut_{}".format(i)] - data["qIn_{}".format(i)]
-            )
-            data["qIn_limits_lower_{}".format(i)] = np.full_like(
-                data["qIn_{}".format(i)], 0
-            )
-            data["qIn_limits_upper_{}".format(i)] = np.full_like(
-                data["qIn_{}".format(i)], 0
-            )
-            data["qOut_limits_lower_{}".format(i)] = data[
-                "qIn_limits_lower_{}".format(i)
-            ]
-            data["qOut_limits_upper_{}".format(i)] = data[
-                "qIn_limits_upper_{}".format(i)
-            ]
-            i += 1
-        i = 0
-        while "tauIn_{}".format(i) in data:
-            data["tauIn_limits_lower_{}".format(i)] = np.full_like(
-                data["tauIn_{}".format(i)], 0
-            )
-            data["tauIn_limits_upper_{}".format(i)] = np.full_like(
-                data["tauIn_{}".format(i)], 0
-            )
-            i += 1
-        while "tauOut_{}".format(i) in data:
-            data["tauOut_limits_lower_{}".format(i)] = np.full_like(
-                data["tauOut_{}".format(i)], 0
-            )
-            data["tauOut_limits_upper_{}".format(i)] = np.full_like(
-                data["tauOut_{}".format(i)], 0
-            )
-            i += 1
-        if "perf_SolverBuildAndSolve" in data and "perf_SolverSolve" in data:
-            data["perf_SolverBuild"] = (
-                data["perf_SolverBuildAndSolve"] - data["perf_SolverSolve"]
-            )
+        add_derived_entries(data, lod)
         if len(self.loaded_files) > 1:
             if len(self.loaded_files) == 2:
                 keys = list(self.data.keys())
@@ -1548,6 +1589,7 @@ class MCLogUI(QtWidgets.QMainWindow):
                 self.data["t"] = np.arange(start_t, end_t, ndt)
         else:
             self.data.data = data
+        self.data.lod = lod if len(self.loaded_files) == 1 else None
         self.update_data()
         self.setWindowTitle("MC Log Plotter - {}".format("/".join(self.loaded_files)))
 
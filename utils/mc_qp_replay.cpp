@@ -0,0 +1,95 @@
+/*
+ * Copyright 2015-2024 CNRS-UM LIRMM, CNRS-AIST JRL
+ */
+
+#include <mc_solver/QPProblem.h>
+
+#include <mc_rtc/clock.h>
+#include <mc_rtc/logging.h>
+
+#include <eigen-quadprog/QuadProgDense.h>
+
+#include <cmath>
+#include <iostream>
+
+/** This utility re-solves the problems recorded by mc_solver::QPSolver::startRecording and outputs timing
+ * information, it is meant to compare solvers and solver options offline on problems produced by real controllers */
+
+void usage(char * name)
+{
+  std::cerr << name << " [recording] [repeat = 10]\n";
+}
+
+/** Re-formulate a recorded problem in the form expected by QuadProgDense (Aineq x <= bineq) */
+struct DenseProblem
+{
+  DenseProblem(const mc_solver::QPProblem & pb)
+  {
+    auto n = pb.nrVars();
+    // Recorded problems might only be semi-definite
+    Q = pb.Q + 1e-8 * Eigen::MatrixXd::Identity(n, n);
+    std::vector<std::pair<Eigen::RowVectorXd, double>> rows;
+    for(Eigen::Index i = 0; i < pb.nrIneq(); ++i)
+    {
+      if(std::isfinite(pb.uineq(i))) { rows.emplace_back(pb.Aineq.row(i), pb.uineq(i)); }
+      if(std::isfinite(pb.lineq(i))) { rows.emplace_back(-pb.Aineq.row(i), -pb.lineq(i)); }
+    }
+    for(Eigen::Index i = 0; i < n; ++i)
+    {
+      if(std::isfinite(pb.xu(i))) { rows.emplace_back(Eigen::RowVectorXd::Unit(n, i), pb.xu(i)); }
+      if(std::isfinite(pb.xl(i))) { rows.emplace_back(-Eigen::RowVectorXd::Unit(n, i), -pb.xl(i)); }
+    }
+    Aineq.resize(static_cast<Eigen::Index>(rows.size()), n);
+    bineq.resize(static_cast<Eigen::Index>(rows.size()));
+    for(size_t i = 0; i < rows.size(); ++i)
+    {
+      Aineq.row(static_cast<Eigen::Index>(i)) = rows[i].first;
+      bineq(static_cast<Eigen::Index>(i)) = rows[i].second;
+    }
+  }
+
+  Eigen::MatrixXd Q;
+  Eigen::MatrixXd Aineq;
+  Eigen::VectorXd bineq;
+};
+
+int main(int argc, char * argv[])
+{
+  if(argc < 2)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+  int repeat = 10;
+  if(argc > 2) { repeat = std::max(1, std::stoi(argv[2])); }
+  mc_solver::QPProblemReader reader(argv[1]);
+  mc_solver::QPProblem pb;
+  size_t count = 0;
+  size_t failures = 0;
+  double total = 0;
+  std::cout << "tick, variables, equalities, inequalities, recorded (ms), replay (ms), status\n";
+  while(reader.next(pb))
+  {
+    DenseProblem dense(pb);
+    Eigen::QuadProgDense qp;
+    qp.problem(static_cast<int>(pb.nrVars()), static_cast<int>(pb.nrEq()), static_cast<int>(dense.bineq.size()));
+    bool success = true;
+    auto start = mc_rtc::clock::now();
+    for(int i = 0; i < repeat; ++i) { success = qp.solve(dense.Q, pb.c, pb.Aeq, pb.beq, dense.Aineq, dense.bineq); }
+    mc_rtc::duration_ms elapsed = mc_rtc::clock::now() - start;
+    double replay = elapsed.count() / repeat;
+    std::cout << fmt::format("{}, {}, {}, {}, {:.3f}, {:.3f}, {}\n", pb.tick, pb.nrVars(), pb.nrEq(),
+                             dense.bineq.size(), pb.solveTime, replay, success ? "ok" : "failed");
+    count++;
+    failures += success ? 0 : 1;
+    total += replay;
+  }
+  if(count == 0)
+  {
+    mc_rtc::log::warning("No problem in {}", argv[1]);
+    return 0;
+  }
+  mc_rtc::log::info("Replayed {} problems ({} failures), average solve time: {:.3f} ms", count, failures,
+                    total / static_cast<double>(count));
+  return failures == 0 ? 0 : 1;
+}